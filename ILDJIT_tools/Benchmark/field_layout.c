@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Generator of the translation-time benchmark of the field layouts.
+ *
+ * It writes a C# program with a class and a subclass that declare many instance and static fields, and with methods
+ * that access every field; the CIL->IR translation of these methods fetches the layout of one field per access.
+ * The program prints the time spent by the first call of each method, which includes its translation, and by the second one.
+ *
+ * Usage: field_layout [fields per class] > FieldLayout.cs
+ *        mcs FieldLayout.cs && iljit FieldLayout.exe
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+static void printClass (const char *name, const char *superName, const char *prefix, int fields) {
+    int	count;
+
+    printf("class %s%s%s {\n", name, (superName != NULL) ? " : " : "", (superName != NULL) ? superName : "");
+    for (count = 0; count < fields; count++) {
+        printf("    public int %s%d;\n", prefix, count);
+        printf("    public static int %sStatic%d;\n", prefix, count);
+    }
+    printf("}\n\n");
+}
+
+static void printAccesses (const char *prefix, const char *className, int fields) {
+    int	count;
+
+    for (count = 0; count < fields; count++) {
+        printf("        o.%s%d = o.%s%d + %d;\n", prefix, count, prefix, (count + 1) % fields, count);
+        printf("        %s.%sStatic%d += o.%s%d;\n", className, prefix, count, prefix, count);
+    }
+}
+
+int main (int argc, char **argv) {
+    int	fields;
+
+    fields	= 512;
+    if (argc > 1) {
+        fields	= atoi(argv[1]);
+    }
+    if (fields <= 0) {
+        fprintf(stderr, "Usage: %s [fields per class]\n", argv[0]);
+        return 1;
+    }
+
+    printf("using System;\n\n");
+    printClass("Base", NULL, "b", fields);
+    printClass("Derived", "Base", "d", fields);
+
+    printf("class FieldLayout {\n");
+    printf("    static int AccessBase (Derived o) {\n");
+    printAccesses("b", "Base", fields);
+    printf("        return o.b0;\n");
+    printf("    }\n\n");
+    printf("    static int AccessDerived (Derived o) {\n");
+    printAccesses("d", "Derived", fields);
+    printAccesses("b", "Base", fields);
+    printf("        return o.d0;\n");
+    printf("    }\n\n");
+    printf("    static void Measure (String name, Derived o, bool derived) {\n");
+    printf("        int start = Environment.TickCount;\n");
+    printf("        int result = derived ? AccessDerived(o) : AccessBase(o);\n");
+    printf("        int first = Environment.TickCount - start;\n");
+    printf("        start = Environment.TickCount;\n");
+    printf("        result += derived ? AccessDerived(o) : AccessBase(o);\n");
+    printf("        int second = Environment.TickCount - start;\n");
+    printf("        Console.WriteLine(name + \": first call \" + first + \" ms, second call \" + second + \" ms (\" + result + \")\");\n");
+    printf("    }\n\n");
+    printf("    static void Main () {\n");
+    printf("        Derived o = new Derived();\n");
+    printf("        Console.WriteLine(\"%d instance and %d static fields per class\");\n", fields, fields);
+    printf("        Measure(\"base fields\", o, false);\n");
+    printf("        Measure(\"all fields\", o, true);\n");
+    printf("    }\n");
+    printf("}\n");
+
+    return 0;
+}
@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Benchmark of the file accesses of the Platform.FileMethods internal calls (Read, Write and Seek).
+ * Every access pattern is run both with one system call per call, as the internal calls did before the handles were buffered,
+ * and through the buffers of the handles; the number of system calls and the throughput are reported.
+ * The data read and written is checked to be the same for both paths.
+ *
+ * Usage: file_io [directory of the temporary file] [megabytes of the file]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <file_buffer.h>
+
+#define CHUNK_SIZE_MAX		65536
+
+typedef enum {
+    SEQUENTIAL_READ = 0,
+    RANDOM_READ,
+    SEQUENTIAL_WRITE,
+    PATTERNS_NUMBER
+} pattern_t;
+
+static const char *patternNames[PATTERNS_NUMBER] = {
+    "sequential read",
+    "random read",
+    "sequential write"
+};
+
+static const int chunkSizes[] = { 16, 128, 1024, 8192, CHUNK_SIZE_MAX };
+
+static JITUINT8	chunk[CHUNK_SIZE_MAX];
+
+static double now (void) {
+    struct timespec	t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+
+    return (double) t.tv_sec + ((double) t.tv_nsec / 1000000000.0);
+}
+
+static JITUINT32 checksum (JITUINT32 sum, JITUINT8 *data, int size) {
+    int	count;
+
+    for (count = 0; count < size; count++) {
+        sum	= (sum * 31) + data[count];
+    }
+
+    return sum;
+}
+
+/* Read with one system call per call, as internal_FileRead did	*/
+static JITINT32 directRead (int fd, void *buf, JITINT32 size, JITUINT64 *syscalls) {
+    JITINT32	result;
+
+    do {
+        result	= read(fd, buf, size);
+        (*syscalls)++;
+    } while ((result < 0) && (errno == EINTR));
+
+    return result;
+}
+
+/* Write with one system call per call, as internal_Write did	*/
+static JITINT32 directWrite (int fd, void *buf, JITINT32 size, JITUINT64 *syscalls) {
+    JITINT32	written;
+
+    written	= 0;
+    while (written < size) {
+        JITINT32	result;
+        result	= write(fd, ((JITUINT8 *) buf) + written, size - written);
+        (*syscalls)++;
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        written	+= result;
+    }
+
+    return written;
+}
+
+static JITUINT32 run (pattern_t pattern, const char *path, long fileSize, int chunkSize, JITBOOLEAN buffered, JITBOOLEAN verify, JITUINT64 *syscalls) {
+    ILFileBuffer	*file;
+    JITUINT32	sum;
+    long		done;
+    int		fd;
+
+    (*syscalls)	= 0;
+    sum		= 0;
+    file		= NULL;
+    fd		= open(path, (pattern == SEQUENTIAL_WRITE) ? (O_WRONLY | O_TRUNC) : O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        exit(1);
+    }
+    if (buffered) {
+        file	= ILFILENew(fd, pattern == SEQUENTIAL_READ);
+    }
+
+    switch (pattern) {
+        case SEQUENTIAL_READ:
+            while (JITTRUE) {
+                JITINT32	result;
+                result	= buffered ? ILFILERead(file, chunk, chunkSize) : directRead(fd, chunk, chunkSize, syscalls);
+                if (result <= 0) {
+                    break;
+                }
+                if (verify) {
+                    sum	= checksum(sum, chunk, result);
+                }
+            }
+            break;
+        case RANDOM_READ:
+            srand(42);
+            for (done = 0; done < fileSize; done += chunkSize) {
+                off_t		position;
+                JITINT32	result;
+                position	= ((off_t) (rand() % (fileSize / chunkSize))) * chunkSize;
+                if (buffered) {
+                    ILFILESeek(file, position, SEEK_SET);
+                    result	= ILFILERead(file, chunk, chunkSize);
+                } else {
+                    lseek(fd, position, SEEK_SET);
+                    (*syscalls)++;
+                    result	= directRead(fd, chunk, chunkSize, syscalls);
+                }
+                if (	(verify)	&&
+                        (result > 0)	) {
+                    sum	= checksum(sum, chunk, result);
+                }
+            }
+            break;
+        case SEQUENTIAL_WRITE:
+            for (done = 0; done < fileSize; done += chunkSize) {
+                memset(chunk, (int) (done / chunkSize), chunkSize);
+                if (buffered) {
+                    ILFILEWrite(file, chunk, chunkSize);
+                } else {
+                    directWrite(fd, chunk, chunkSize, syscalls);
+                }
+            }
+            break;
+        default:
+            abort();
+    }
+
+    if (buffered) {
+        ILFILEFlush(file);
+        (*syscalls)	+= file->syscalls;
+        ILFILEDestroy(file);
+    }
+    close(fd);
+
+    /* Check what has been written	*/
+    if (	(verify)				&&
+            (pattern == SEQUENTIAL_WRITE)		) {
+        JITINT32	result;
+        fd	= open(path, O_RDONLY);
+        while ((result = read(fd, chunk, CHUNK_SIZE_MAX)) > 0) {
+            sum	= checksum(sum, chunk, result);
+        }
+        close(fd);
+    }
+
+    return sum;
+}
+
+int main (int argc, char **argv) {
+    char		path[4096];
+    const char	*directory;
+    long		fileSize;
+    pattern_t	pattern;
+    int		errors;
+    int		fd;
+    long		done;
+
+    directory	= "/tmp";
+    fileSize	= 64;
+    if (argc > 1) {
+        directory	= argv[1];
+    }
+    if (argc > 2) {
+        fileSize	= atol(argv[2]);
+    }
+    fileSize	*= 1024 * 1024;
+    snprintf(path, sizeof(path), "%s/ildjit_file_io.XXXXXX", directory);
+    fd	= mkstemp(path);
+    if (fd < 0) {
+        perror(path);
+        return 1;
+    }
+    close(fd);
+    errors	= 0;
+
+    printf("%-18s %8s %-10s %12s %12s %10s\n", "PATTERN", "CHUNK", "PATH", "SYSCALLS", "NS/CALL", "MB/S");
+    for (pattern = 0; pattern < PATTERNS_NUMBER; pattern++) {
+        int	chunkIndex;
+        for (chunkIndex = 0; chunkIndex < (int) (sizeof(chunkSizes) / sizeof(chunkSizes[0])); chunkIndex++) {
+            JITUINT32	expected;
+            int		chunkSize;
+            int		buffered;
+            chunkSize	= chunkSizes[chunkIndex];
+            expected	= 0;
+
+            /* Fill the file with random data before the first read	*/
+            if (	(pattern == SEQUENTIAL_READ)	&&
+                    (chunkIndex == 0)		) {
+                fd	= open(path, O_WRONLY | O_TRUNC);
+                srand(42);
+                for (done = 0; done < fileSize; done += CHUNK_SIZE_MAX) {
+                    int	count;
+                    for (count = 0; count < CHUNK_SIZE_MAX; count++) {
+                        chunk[count]	= rand();
+                    }
+                    write(fd, chunk, CHUNK_SIZE_MAX);
+                }
+                close(fd);
+            }
+
+            for (buffered = JITFALSE; buffered <= JITTRUE; buffered++) {
+                JITUINT64	syscalls;
+                JITUINT32	sum;
+                double		start;
+                double		elapsed;
+                long		calls;
+
+                /* Check the data, then measure without computing checksums	*/
+                sum	= run(pattern, path, fileSize, chunkSize, buffered, JITTRUE, &syscalls);
+                if (!buffered) {
+                    expected	= sum;
+                } else if (sum != expected) {
+                    fprintf(stderr, "ERROR: %s with chunks of %d bytes: the buffered path returns different data\n", patternNames[pattern], chunkSize);
+                    errors++;
+                }
+                start	= now();
+                run(pattern, path, fileSize, chunkSize, buffered, JITFALSE, &syscalls);
+                elapsed	= now() - start;
+                calls	= fileSize / chunkSize;
+                printf("%-18s %8d %-10s %12llu %12.2f %10.2f\n", patternNames[pattern], chunkSize, buffered ? "buffered" : "direct", (unsigned long long) syscalls, (elapsed * 1000000000.0) / calls, ((double) fileSize / (1024 * 1024)) / elapsed);
+            }
+        }
+    }
+    unlink(path);
+
+    return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Benchmark of the peephole optimizer of the x86-64 backend of libjit.
+ *
+ * It builds the kernels below the way the IR virtual machine does (i.e., conditions are stored in local variables
+ * before branching on them), compiles each of them with and without JIT_OPTION_DONT_PEEPHOLE, and prints the size of
+ * the generated code and the time spent running it.
+ *
+ * Usage: libjit_peephole [iterations]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <jit/jit.h>
+
+#define ELEMENTS	4096
+
+typedef jit_int (*kernel_t) (jit_int *array, jit_int elements, jit_int key);
+
+typedef struct {
+    const char	*name;
+    void		(*build) (jit_function_t function, jit_value_t array, jit_value_t elements, jit_value_t key);
+} Kernel;
+
+static jit_value_t constant (jit_function_t function, jit_int value) {
+    return jit_value_create_nint_constant(function, jit_type_int, value);
+}
+
+/* Branch to label if the condition stored in a local variable is false	*/
+static void branchIfNot (jit_function_t function, jit_value_t condition, jit_label_t *label) {
+    jit_value_t	local;
+
+    local	= jit_value_create(function, jit_type_int);
+    jit_insn_store(function, local, condition);
+    jit_insn_branch_if_not(function, local, label);
+}
+
+/* Sum of the elements	*/
+static void buildSum (jit_function_t function, jit_value_t array, jit_value_t elements, jit_value_t key) {
+    jit_label_t	loop	= jit_label_undefined;
+    jit_label_t	done	= jit_label_undefined;
+    jit_value_t	i;
+    jit_value_t	sum;
+
+    i	= jit_value_create(function, jit_type_int);
+    sum	= jit_value_create(function, jit_type_int);
+    jit_insn_store(function, i, constant(function, 0));
+    jit_insn_store(function, sum, constant(function, 0));
+    jit_insn_label(function, &loop);
+    branchIfNot(function, jit_insn_lt(function, i, elements), &done);
+    jit_insn_store(function, sum, jit_insn_add(function, sum, jit_insn_load_elem(function, array, i, jit_type_int)));
+    jit_insn_store(function, i, jit_insn_add(function, i, constant(function, 1)));
+    jit_insn_branch(function, &loop);
+    jit_insn_label(function, &done);
+    jit_insn_return(function, sum);
+}
+
+/* Number of elements smaller than key	*/
+static void buildCount (jit_function_t function, jit_value_t array, jit_value_t elements, jit_value_t key) {
+    jit_label_t	loop	= jit_label_undefined;
+    jit_label_t	next	= jit_label_undefined;
+    jit_label_t	done	= jit_label_undefined;
+    jit_value_t	i;
+    jit_value_t	count;
+
+    i	= jit_value_create(function, jit_type_int);
+    count	= jit_value_create(function, jit_type_int);
+    jit_insn_store(function, i, constant(function, 0));
+    jit_insn_store(function, count, constant(function, 0));
+    jit_insn_label(function, &loop);
+    branchIfNot(function, jit_insn_lt(function, i, elements), &done);
+    branchIfNot(function, jit_insn_lt(function, jit_insn_load_elem(function, array, i, jit_type_int), key), &next);
+    jit_insn_store(function, count, jit_insn_add(function, count, constant(function, 1)));
+    jit_insn_label(function, &next);
+    jit_insn_store(function, i, jit_insn_add(function, i, constant(function, 1)));
+    jit_insn_branch(function, &loop);
+    jit_insn_label(function, &done);
+    jit_insn_return(function, count);
+}
+
+/* Nested loops that combine the induction variables with adds and shifts	*/
+static void buildMix (jit_function_t function, jit_value_t array, jit_value_t elements, jit_value_t key) {
+    jit_label_t	outer	= jit_label_undefined;
+    jit_label_t	inner	= jit_label_undefined;
+    jit_label_t	innerExit	= jit_label_undefined;
+    jit_label_t	done	= jit_label_undefined;
+    jit_value_t	i;
+    jit_value_t	j;
+    jit_value_t	hash;
+    jit_value_t	t;
+
+    i	= jit_value_create(function, jit_type_int);
+    j	= jit_value_create(function, jit_type_int);
+    hash	= jit_value_create(function, jit_type_int);
+    jit_insn_store(function, i, constant(function, 0));
+    jit_insn_store(function, hash, key);
+    jit_insn_label(function, &outer);
+    branchIfNot(function, jit_insn_lt(function, i, constant(function, 64)), &done);
+    jit_insn_store(function, j, constant(function, 0));
+    jit_insn_label(function, &inner);
+    branchIfNot(function, jit_insn_lt(function, j, elements), &innerExit);
+    t	= jit_insn_add(function, jit_insn_shl(function, hash, constant(function, 1)), j);
+    t	= jit_insn_add(function, t, jit_insn_add(function, i, j));
+    t	= jit_insn_xor(function, t, jit_insn_add(function, hash, constant(function, 7)));
+    jit_insn_store(function, hash, t);
+    jit_insn_store(function, j, jit_insn_add(function, j, constant(function, 1)));
+    jit_insn_branch(function, &inner);
+    jit_insn_label(function, &innerExit);
+    jit_insn_store(function, i, jit_insn_add(function, i, constant(function, 1)));
+    jit_insn_branch(function, &outer);
+    jit_insn_label(function, &done);
+    jit_insn_return(function, hash);
+}
+
+static Kernel kernels[] = {
+    {"sum", buildSum},
+    {"count", buildCount},
+    {"mix", buildMix},
+};
+
+static jit_function_t compileKernel (jit_context_t context, Kernel *kernel) {
+    jit_type_t	params[3];
+    jit_type_t	signature;
+    jit_function_t	function;
+
+    params[0]	= jit_type_void_ptr;
+    params[1]	= jit_type_int;
+    params[2]	= jit_type_int;
+    signature	= jit_type_create_signature(jit_abi_cdecl, jit_type_int, params, 3, 1);
+    jit_context_build_start(context);
+    function	= jit_function_create(context, signature);
+    kernel->build(function, jit_value_get_param(function, 0), jit_value_get_param(function, 1), jit_value_get_param(function, 2));
+    if (!jit_function_compile(function)) {
+        function	= NULL;
+    }
+    jit_context_build_end(context);
+    jit_type_free(signature);
+
+    return function;
+}
+
+static double run (jit_function_t function, jit_int *array, int iterations, jit_int *result) {
+    kernel_t	code;
+    struct timespec	start;
+    struct timespec	end;
+    int		count;
+
+    code	= (kernel_t) jit_function_to_closure(function);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (count = 0; count < iterations; count++) {
+        (*result)	= code(array, ELEMENTS, count);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    return ((end.tv_sec - start.tv_sec) * 1000.0) + ((end.tv_nsec - start.tv_nsec) / 1000000.0);
+}
+
+int main (int argc, char **argv) {
+    jit_int		*array;
+    int		iterations;
+    int		count;
+
+    iterations	= 2000;
+    if (argc > 1) {
+        iterations	= atoi(argv[1]);
+    }
+    if (iterations <= 0) {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+    array	= malloc(sizeof(jit_int) * ELEMENTS);
+    for (count = 0; count < ELEMENTS; count++) {
+        array[count]	= (count * 7919) % 1000;
+    }
+
+    jit_init();
+    printf("%-8s %12s %12s %12s %12s\n", "kernel", "bytes", "peep bytes", "ms", "peep ms");
+    for (count = 0; count < (int) (sizeof(kernels) / sizeof(Kernel)); count++) {
+        jit_context_t	plainContext;
+        jit_context_t	peepholeContext;
+        jit_function_t	plain;
+        jit_function_t	peephole;
+        jit_int		plainResult;
+        jit_int		peepholeResult;
+        double		plainTime;
+        double		peepholeTime;
+
+        plainContext	= jit_context_create();
+        peepholeContext	= jit_context_create();
+        jit_context_set_meta_numeric(plainContext, JIT_OPTION_DONT_PEEPHOLE, 1);
+        plain		= compileKernel(plainContext, &(kernels[count]));
+        peephole	= compileKernel(peepholeContext, &(kernels[count]));
+        if ((plain == NULL) || (peephole == NULL)) {
+            fprintf(stderr, "%s: compilation failed\n", kernels[count].name);
+            return 1;
+        }
+        plainTime	= run(plain, array, iterations, &plainResult);
+        peepholeTime	= run(peephole, array, iterations, &peepholeResult);
+        printf("%-8s %12u %12u %12.2f %12.2f%s\n", kernels[count].name, jit_function_get_code_size(plain), jit_function_get_code_size(peephole), plainTime, peepholeTime, (plainResult != peepholeResult) ? "  RESULTS DIFFER" : "");
+        jit_context_destroy(plainContext);
+        jit_context_destroy(peepholeContext);
+    }
+    free(array);
+
+    return 0;
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Benchmark of the UTF-16 primitives used by the System.String internal calls (IndexOf, IndexOfAny, LastIndexOf, Equals,
+ * InternalOrdinal, Replace, FindInRange and GetHashCode).
+ * Every primitive is run with every implementation supported by the CPU; results are checked against the scalar one.
+ *
+ * Usage: string_primitives [minimum milliseconds per measure]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <utf16_primitives.h>
+
+#define TEXT_LENGTH_MAX		65536
+#define PATTERN_LENGTH		12
+#define SET_LENGTH		4
+
+typedef enum {
+    INDEX_OF = 0,
+    LAST_INDEX_OF,
+    INDEX_OF_ANY,
+    LAST_INDEX_OF_ANY,
+    MISMATCH,
+    FIND,
+    FIND_LAST,
+    HASH,
+    PRIMITIVES_NUMBER
+} primitive_t;
+
+static const char *primitiveNames[PRIMITIVES_NUMBER] = {
+    "IndexOf",
+    "LastIndexOf",
+    "IndexOfAny",
+    "LastIndexOfAny",
+    "Mismatch (Equals, InternalOrdinal)",
+    "Find (Replace, FindInRange)",
+    "FindLast (FindInRange)",
+    "Hash (GetHashCode)"
+};
+
+static const int textLengths[] = { 16, 64, 256, 4096, TEXT_LENGTH_MAX };
+
+static JITINT16	text[TEXT_LENGTH_MAX];
+static JITINT16	copy[TEXT_LENGTH_MAX];
+static JITINT16	text0[TEXT_LENGTH_MAX];
+static JITINT16	pattern[PATTERN_LENGTH];
+static JITINT16	lastPattern[PATTERN_LENGTH];
+static JITINT16	set[SET_LENGTH] = { '{', '[', ']', '|' };
+static JITINT16	lastSet[SET_LENGTH] = { '}', '[', ']', '|' };
+
+static double now (void) {
+    struct timespec	t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+
+    return (double) t.tv_sec + ((double) t.tv_nsec / 1000000000.0);
+}
+
+static JITUINT32 run (primitive_t primitive, int length) {
+    switch (primitive) {
+        case INDEX_OF:
+            return ILUTF16IndexOf(text, length, '{');
+        case LAST_INDEX_OF:
+            return ILUTF16LastIndexOf(text, length, '}');
+        case INDEX_OF_ANY:
+            return ILUTF16IndexOfAny(text, length, set, SET_LENGTH);
+        case LAST_INDEX_OF_ANY:
+            return ILUTF16LastIndexOfAny(text, length, lastSet, SET_LENGTH);
+        case MISMATCH:
+            return ILUTF16Mismatch(text, copy, length);
+        case FIND:
+            return ILUTF16Find(text, length, pattern, PATTERN_LENGTH);
+        case FIND_LAST:
+            return ILUTF16FindLast(text, length, lastPattern, PATTERN_LENGTH);
+        case HASH:
+            return ILUTF16Hash(text, length);
+        default:
+            abort();
+    }
+}
+
+static void initText (void) {
+    int	count;
+
+    /* Log-like text: lowercase words, where the first and the last character of the patterns are frequent.
+     */
+    srand(42);
+    for (count = 0; count < TEXT_LENGTH_MAX; count++) {
+        text0[count]	= ((rand() % 8) == 0) ? ' ' : ('a' + (rand() % 26));
+    }
+    for (count = 0; count < PATTERN_LENGTH; count++) {
+        pattern[count]		= 'a' + (count % 26);
+        lastPattern[count]	= 'z' - (count % 26);
+    }
+    pattern[0]				= 'e';
+    pattern[PATTERN_LENGTH - 1]		= 't';
+    lastPattern[0]				= 't';
+    lastPattern[PATTERN_LENGTH - 1]	= 'e';
+}
+
+static void placeNeedles (int length) {
+
+    /* Every search walks the whole text: what the forward searches look for is at the end, what the backward ones look for is at the beginning.
+     */
+    memcpy(text, text0, sizeof(text));
+    if (length >= ((2 * PATTERN_LENGTH) + 2)) {
+        memcpy(text + length - PATTERN_LENGTH - 1, pattern, PATTERN_LENGTH * sizeof(JITINT16));
+        memcpy(text + 1, lastPattern, PATTERN_LENGTH * sizeof(JITINT16));
+    }
+    text[length - 1]	= '{';
+    text[0]			= '}';
+    memcpy(copy, text, length * sizeof(JITINT16));
+}
+
+int main (int argc, char **argv) {
+    JITUINT32	expected[PRIMITIVES_NUMBER][sizeof(textLengths) / sizeof(textLengths[0])];
+    double		minimumTime;
+    int		implementation;
+    int		errors;
+
+    minimumTime	= 0.2;
+    if (argc > 1) {
+        minimumTime	= atof(argv[1]) / 1000.0;
+    }
+    initText();
+    errors	= 0;
+
+    printf("%-36s %8s %-8s %12s %10s\n", "PRIMITIVE", "LENGTH", "IMPL", "NS/CALL", "UNITS/NS");
+    for (implementation = ILUTF16_IMPLEMENTATION_SCALAR; implementation <= ILUTF16_IMPLEMENTATION_AVX2; implementation++) {
+        int	lengthIndex;
+        if (ILUTF16SelectImplementation(implementation) != implementation) {
+            printf("%s is not supported by this CPU\n", (implementation == ILUTF16_IMPLEMENTATION_SSE2) ? "sse2" : "avx2");
+            continue ;
+        }
+        for (lengthIndex = 0; lengthIndex < (int) (sizeof(textLengths) / sizeof(textLengths[0])); lengthIndex++) {
+            int		length;
+            primitive_t	primitive;
+            length	= textLengths[lengthIndex];
+            placeNeedles(length);
+            for (primitive = 0; primitive < PRIMITIVES_NUMBER; primitive++) {
+                volatile JITUINT32	sink;
+                long			iterations;
+                long			count;
+                double			start;
+                double			elapsed;
+
+                /* Check the result	*/
+                sink	= run(primitive, length);
+                if (implementation == ILUTF16_IMPLEMENTATION_SCALAR) {
+                    expected[primitive][lengthIndex]	= sink;
+                } else if (expected[primitive][lengthIndex] != sink) {
+                    fprintf(stderr, "ERROR: %s on %d code units: %s returns %u, scalar returns %u\n", primitiveNames[primitive], length, ILUTF16GetImplementationName(), sink, expected[primitive][lengthIndex]);
+                    errors++;
+                }
+
+                /* Measure		*/
+                iterations	= 16;
+                do {
+                    iterations	*= 2;
+                    start		= now();
+                    for (count = 0; count < iterations; count++) {
+                        sink	= run(primitive, length);
+                    }
+                    elapsed		= now() - start;
+                } while (elapsed < minimumTime);
+                printf("%-36s %8d %-8s %12.2f %10.2f\n", primitiveNames[primitive], length, ILUTF16GetImplementationName(), (elapsed * 1000000000.0) / iterations, ((double) length * iterations) / (elapsed * 1000000000.0));
+            }
+        }
+    }
+
+    return (errors == 0) ? 0 : 1;
+}
@@ -47,6 +47,7 @@ static inline JITBOOLEAN clrbase_getNameAndFunctionPointerOfMethod (JITINT8 *sig
 
 extern t_system *ildjitSystem;
 XanHashTable *filesOpened   = NULL;
+JITBOOLEAN sequentialFileHint   = JITFALSE;
 
 clr_interface_t plugin_interface = {
     clrbase_init					,
@@ -64,6 +65,9 @@ clr_interface_t plugin_interface = {
 static inline void clrbase_init (t_system *system) {
     filesOpened   = xanHashTable_new(11, 0, allocFunction, dynamicReallocFunction, freeFunction, NULL, NULL);
 
+    /* Check whether the kernel has to be told that files are read sequentially	*/
+    sequentialFileHint  = (getenv("ILDJIT_FILE_SEQUENTIAL_HINT") != NULL);
+
     return ;
 }
 
@@ -96,6 +100,7 @@ static inline void clrbase_shutdown (void) {
         file_t  *f;
         f       = item->element;
         assert(f != NULL);
+        ILFILEDestroy(f->buffer);
         PLATFORM_close(f->fileDescriptor);
         item    = xanHashTable_next(filesOpened, item);
     }
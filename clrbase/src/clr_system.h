@@ -18,6 +18,8 @@
 #ifndef CLR_SYSTEM_H
 #define CLR_SYSTEM_H
 
+#include <file_buffer.h>
+
 #ifdef PRINTDEBUG
 #define PDEBUG(fmt, args ...) fprintf(stderr, fmt, ## args)
 #else
@@ -28,8 +30,11 @@
 
 typedef struct {
     JITINT32    fileDescriptor;
+    ILFileBuffer    *buffer;
+    JITUINT32   references;     /**< One for the table of the opened files, plus one for every call that is using the buffer	*/
 } file_t;
 
 extern XanHashTable *filesOpened;
+extern JITBOOLEAN sequentialFileHint;
 
 #endif
@@ -194,6 +194,10 @@ JITINT32 internal_Write (JITNINT handle, void *buf, JITINT32 size);
 JITINT32 internal_FileRead (JITNINT handle, void *buf, JITINT32 size);
 JITBOOLEAN internal_CheckHandleAccess (JITNINT handle, JITINT32 access);
 static inline JITINT64 internal_Seek (JITNINT handle, JITINT64 offset, JITINT32 whence);
+static inline file_t * internal_acquireFile (JITNINT handle);
+static inline JITINT32 internal_releaseFile (file_t *f);
+static inline JITBOOLEAN internal_SetLength (JITNINT handle, JITINT64 length);
+static inline JITINT64 internal_GetLength (JITNINT handle);
 static JITINT8 * internal_GetFileInBasePath (const char *tail1, const char *tail2);
 static inline JITINT32 internal_Copy (JITINT8 *src, JITINT8 *dest);
 static inline JITINT8 *GetBasePath (void);
@@ -535,15 +539,25 @@ JITINT32 Platform_FileMethods_GetErrno (void) {
 
 JITBOOLEAN Platform_FileMethods_Close (JITNINT handle) {
     JITINT32 result;
+    file_t  *f;
 
     METHOD_BEGIN(ildjitSystem, "Platform.FileMethods.Close");
 
-    while ((result = PLATFORM_close(handle)) < 0) {
-        if (errno != EINTR) {
-            break;
+    /* Buffered handles are closed, after writing the data still buffered, by the last call that uses them	*/
+    xanHashTable_lock(filesOpened);
+    f = xanHashTable_lookup(filesOpened, (void *)(JITNUINT)handle);
+    xanHashTable_removeElement(filesOpened, (void *)(JITNUINT)handle);
+    xanHashTable_unlock(filesOpened);
+    if (f != NULL) {
+        result = internal_releaseFile(f);
+
+    } else {
+        while ((result = PLATFORM_close(handle)) < 0) {
+            if (errno != EINTR) {
+                break;
+            }
         }
     }
-    xanHashTable_removeElement(filesOpened, (void *)(JITNUINT)handle);
 
     /* Return                       */
     METHOD_END(ildjitSystem, "Platform.FileMethods.Close");
@@ -663,8 +677,15 @@ JITINT32 Platform_FileMethods_Read (JITNINT handle, void* buffer,  JITINT32 offs
 }
 
 JITINT32 internal_FileRead (JITNINT handle, void *buf, JITINT32 size) {
+    file_t  *f;
     JITINT32 result;
 
+    f = internal_acquireFile(handle);
+    if (f != NULL) {
+        result = ILFILERead(f->buffer, buf, size);
+        internal_releaseFile(f);
+        return result;
+    }
     while ((result = PLATFORM_read((JITINT32) (JITNINT) handle,  buf, (JITINT32) size)) < 0) {
         // Retry if the system call was interrupted
         if (errno != EINTR) {
@@ -719,14 +740,24 @@ JITINT32 Platform_FileMethods_CreateLink (void *oldpath, void *newpath) {
 }
 
 // Flush all data that was previously written, in response
-// to a user-level "Flush" request.  Normally this will do
-// nothing unless the platform provides its own buffering.
+// to a user-level "Flush" request: the data waiting in the
+// write-behind buffer of the handle is written.
 // Returns false if an I/O error occurred.
 JITBOOLEAN Platform_FileMethods_FlushWrite (JITNINT handle) {
+    file_t  *f;
+    JITBOOLEAN result;
+
     METHOD_BEGIN(ildjitSystem, "Platform.FileMethods.FlushWrite");
 
+    result = JITTRUE;
+    f = internal_acquireFile(handle);
+    if (f != NULL) {
+        result = ILFILEFlush(f->buffer);
+        internal_releaseFile(f);
+    }
+
     METHOD_END(ildjitSystem, "Platform.FileMethodos.FlushWrite");
-    return JITTRUE;
+    return result;
 }
 
 // Set the length of a file to a new value.  Returns false
@@ -736,15 +767,10 @@ JITBOOLEAN Platform_FileMethods_SetLength (JITNINT handle, JITINT64 value) {
 
     METHOD_BEGIN(ildjitSystem, "Platform.FileMethods.SetLength");
 
-    while ((result = PLATFORM_ftruncate((JITINT32) (JITNINT) handle, (off_t) value)) < 0) {
+    result = internal_SetLength(handle, value);
 
-        /* Retry if the ildjitSystem call was interrupted */
-        if (errno != EINTR) {
-            break;
-        }
-    }
     METHOD_END(ildjitSystem, "Platform.FileMethods.SetLength");
-    return result == 0;
+    return result;
 }
 
 JITBOOLEAN Platform_FileMethods_Lock (JITNINT handle, JITINT64 position, JITINT64 length) {
@@ -767,10 +793,18 @@ JITBOOLEAN Platform_FileMethods_Lock (JITNINT handle, JITINT64 position, JITINT6
 }
 
 JITBOOLEAN Platform_FileMethods_Unlock (JITNINT handle, JITINT64 position, JITINT64 length) {
+    file_t  *f;
     struct flock cntl_data;
 
     METHOD_BEGIN(ildjitSystem, "Platform.FileMethodos.Unlock");
 
+    /* Other processes have to see the data written while holding the lock */
+    f = internal_acquireFile(handle);
+    if (f != NULL) {
+        ILFILEFlush(f->buffer);
+        internal_releaseFile(f);
+    }
+
     /* set fields individually...who knows what extras are there? */
     cntl_data.l_type = F_UNLCK;
     cntl_data.l_whence = SEEK_SET;
@@ -1781,16 +1815,26 @@ JITNINT internal_OpenFile (const char *path, JITINT32 mode, JITINT32 access, JIT
         file_t  *f;
         f                   = allocFunction(sizeof(file_t));
         f->fileDescriptor   = result;
-        xanHashTable_insert(filesOpened, (void *)(JITNUINT)(f->fileDescriptor), (void *)f);
+        f->buffer           = ILFILENew(result, sequentialFileHint);
+        f->references       = 1;
+        xanHashTable_syncInsert(filesOpened, (void *)(JITNUINT)(f->fileDescriptor), (void *)f);
     }
 
     return (JITNINT) result;
 }
 
 JITINT32 internal_Write (JITNINT handle, void *buf, JITINT32 size) {
+    file_t  *f;
     JITINT32 written = 0;
     JITINT32 result = 0;
 
+    f = internal_acquireFile(handle);
+    if (f != NULL) {
+        result = ILFILEWrite(f->buffer, buf, size);
+        internal_releaseFile(f);
+        return result;
+    }
+
     while (size > 0) {
 
         /* Write as much as we can, and retry if ildjitSystem call was interrupted */
@@ -1831,8 +1875,17 @@ JITBOOLEAN internal_CheckHandleAccess (JITNINT handle, JITINT32 access) {
 }
 
 static inline JITINT64 internal_Seek (JITNINT handle, JITINT64 offset, JITINT32 whence) {
+    file_t  *f;
     JITINT64 result;
 
+    /* Buffered handles keep their own position */
+    f = internal_acquireFile(handle);
+    if (f != NULL) {
+        result = ILFILESeek(f->buffer, offset, whence);
+        internal_releaseFile(f);
+        return result;
+    }
+
     while ((result = (JITINT64) (PLATFORM_lseek((JITINT32) (JITNINT) handle, (off_t) offset, whence))) == (JITINT64) (-1)) {
         /* Retry if the ildjitSystem call was interrupted */
         if (errno != EINTR) {
@@ -1842,6 +1895,90 @@ static inline JITINT64 internal_Seek (JITNINT handle, JITINT64 offset, JITINT32
     return result;
 }
 
+static inline file_t * internal_acquireFile (JITNINT handle) {
+    file_t  *f;
+
+    /* Handles that have not been opened by Platform.FileMethods.Open (e.g., the standard streams) are not buffered.
+     * The reference is taken while holding the lock of the table, so a concurrent close cannot free the buffer meanwhile */
+    xanHashTable_lock(filesOpened);
+    f = xanHashTable_lookup(filesOpened, (void *)(JITNUINT)handle);
+    if (f != NULL) {
+        __atomic_add_fetch(&(f->references), 1, __ATOMIC_RELAXED);
+    }
+    xanHashTable_unlock(filesOpened);
+
+    return f;
+}
+
+static inline JITINT32 internal_releaseFile (file_t *f) {
+    JITINT32 result;
+
+    /* The last reference is dropped once the handle has been closed and no call is using its buffer */
+    if (__atomic_sub_fetch(&(f->references), 1, __ATOMIC_ACQ_REL) > 0) {
+        return 0;
+    }
+    ILFILEDestroy(f->buffer);
+    while ((result = PLATFORM_close(f->fileDescriptor)) < 0) {
+        if (errno != EINTR) {
+            break;
+        }
+    }
+    freeFunction(f);
+
+    return result;
+}
+
+static inline JITBOOLEAN internal_SetLength (JITNINT handle, JITINT64 length) {
+    file_t  *f;
+    JITINT32 result;
+
+    /* Buffered data would be written after the length changed	*/
+    f = internal_acquireFile(handle);
+    if (f != NULL) {
+        if (!ILFILEFlush(f->buffer)) {
+            internal_releaseFile(f);
+            return JITFALSE;
+        }
+    }
+
+    while ((result = PLATFORM_ftruncate((JITINT32) (JITNINT) handle, (off_t) length)) < 0) {
+
+        /* Retry if the ildjitSystem call was interrupted */
+        if (errno != EINTR) {
+            break;
+        }
+    }
+    if (f != NULL) {
+        internal_releaseFile(f);
+    }
+
+    return result == 0;
+}
+
+static inline JITINT64 internal_GetLength (JITNINT handle) {
+    file_t  *f;
+    struct stat stat;
+    JITINT32 result;
+
+    /* The data waiting in the buffer is part of the file */
+    f = internal_acquireFile(handle);
+    if (f != NULL) {
+        if (!ILFILEFlush(f->buffer)) {
+            internal_releaseFile(f);
+            return -1;
+        }
+    }
+    result = PLATFORM_fstat(handle, &stat);
+    if (f != NULL) {
+        internal_releaseFile(f);
+    }
+    if (result != 0) {
+        return -1;
+    }
+
+    return stat.st_size;
+}
+
 static inline JITINT32 internal_CreateDir (JITINT8 *path) {
     if (!path) {
         return IL_ERRNO_ENOENT;
@@ -3483,11 +3620,10 @@ JITBOOLEAN System_IO_MonoIO_SetLength (JITNINT handle, JITINT64 length, JITINT32
 
     METHOD_BEGIN(ildjitSystem, "System.IO.MonoIO.SetLength");
 
-    if (PLATFORM_ftruncate(handle, length) == 0) {
-        success = JITTRUE;
+    success = internal_SetLength(handle, length);
+    if (success) {
         *error = MONO_ERROR_SUCCESS;
     } else {
-        success = JITFALSE;
         *error = translateToMonoErrorCode(errno);
     }
 
@@ -3498,16 +3634,14 @@ JITBOOLEAN System_IO_MonoIO_SetLength (JITNINT handle, JITINT64 length, JITINT32
 
 /* Get the length of a file */
 JITINT64 System_IO_MonoIO_GetLength (JITNINT handle, JITINT32* error) {
-    struct stat stat;
     JITINT64 length;
 
     METHOD_BEGIN(ildjitSystem, "System.IO.MonoIO.GetLength");
 
-    if (PLATFORM_fstat(handle, &stat) == 0) {
-        length = stat.st_size;
+    length = internal_GetLength(handle);
+    if (length != -1) {
         *error = MONO_ERROR_SUCCESS;
     } else {
-        length = -1;
         *error = translateToMonoErrorCode(errno);
     }
 
@@ -19,17 +19,19 @@
 #include <stdio.h>
 #include <lib_array.h>
 #include <ildjit.h>
+#include <memory_primitives.h>
 
 // My headers
 #include <internal_calls_object.h>
 #include <internal_calls_utilities.h>
 // End
 
+static inline void internal_copyArrayElements (void *sourceArray, JITINT32 sourceIndex, void *destArray, JITINT32 destIndex, JITINT32 length, JITUINT32 arraySlotSize);
+
 extern t_system *ildjitSystem;
 
 void System_Array_Clear (void *array, JITINT32 index, JITINT32 length) {
-    JITUINT32 internalIndex;
-    void            *element;
+    JITUINT32 arraySlotSize;
 
     /* Assertions                   */
     assert(array != NULL);
@@ -47,16 +49,14 @@ void System_Array_Clear (void *array, JITINT32 index, JITINT32 length) {
     }
     /*end of exceptions part*/
 
+    /* Fetch the size of each singe	*
+     * element of the array		*/
+    arraySlotSize = (ildjitSystem->cliManager).CLR.arrayManager.getArrayElementSize(array);
+    assert(arraySlotSize > 0);
 
-    for (internalIndex = index; internalIndex < index + length; internalIndex++) {
-
-        element = ((ildjitSystem->cliManager).CLR.arrayManager.getArrayElement(array, internalIndex));
-
-        assert(element != NULL);
-
-        (*(JITNINT *) element) = 0;
-
-    }
+    /* Clear the elements as a      *
+     * single block                 */
+    ILMEMSet((void *) (((JITNUINT) array) + (index * arraySlotSize)), 0, ((JITNUINT) length) * arraySlotSize);
 
     /* Return                       */
     METHOD_END(ildjitSystem, "System.Array.Clear");
@@ -420,7 +420,7 @@ void System_Array_Set (void *array, void *value, JITINT32 index1, JITINT32 index
         abort();
     }
 
-    (ildjitSystem->cliManager).CLR.arrayManager.setValueArrayElement(array, globalIndex, value);
+    (ildjitSystem->cliManager).CLR.arrayManager.setBoxedArrayElement(array, globalIndex, value);
 
     /* Return                       */
     METHOD_END(ildjitSystem, "System.Array.Set");
@@ -465,7 +465,7 @@ void System_Array_Seti (void *array, void *value, void *indices) {
     }
     //FIXME multidimensional case
 
-    (ildjitSystem->cliManager).CLR.arrayManager.setValueArrayElement(array, globalIndex, value);
+    (ildjitSystem->cliManager).CLR.arrayManager.setBoxedArrayElement(array, globalIndex, value);
 
     /* Return                       */
     METHOD_END(ildjitSystem, "System.Array.Set");
@@ -544,11 +544,7 @@ void System_Array_InternalCopy (void *sourceArray, JITINT32 sourceIndex, void *d
     assert(arraySlotSize > 0);
 
     /* Copy the array		*/
-    if (sourceArray == destArray) {
-        memmove((void *) (((JITNUINT) destArray) + (destIndex * arraySlotSize)), (void *) (((JITNUINT) sourceArray) + (sourceIndex * arraySlotSize)), length * arraySlotSize );
-    } else {
-        memcpy((void *) (((JITNUINT) destArray) + (destIndex * arraySlotSize)), (void *) (((JITNUINT) sourceArray) + (sourceIndex * arraySlotSize)), length * arraySlotSize );
-    }
+    internal_copyArrayElements(sourceArray, sourceIndex, destArray, destIndex, length, arraySlotSize);
 
     /* Return                       */
     METHOD_END(ildjitSystem, "System.Array.InternalCopy");
@@ -651,9 +647,9 @@ void* System_Array_GetValueImpl (void* self, JITINT32 position) {
 void System_Array_SetValueImpl (void* self, void* value, JITINT32 position) {
 
     METHOD_BEGIN(ildjitSystem, "System.Array.SetValueImpl");
-    print_err("The internal call System.Array.SetValueImpl "
-              "is not yet implemented", 0);
-    abort();
+
+    System_Array_Set(self, value, position, 0, 0);
+
     METHOD_END(ildjitSystem, "System.Array.SetValueImpl");
 }
 
@@ -684,16 +680,60 @@ void System_Array_ClearInternal (void* array, JITINT32 start, JITINT32 count) {
 
 /* Copies between two arrays */
 JITBOOLEAN System_Array_FastCopy (void* source, JITINT32 sourceStart, void* destination, JITINT32 destinationStart, JITINT32 count) {
-    JITBOOLEAN copyDone;
-
+    JITUINT32 arraySlotSize;
+    t_arrayManager          *arrayManager;
 
+    /* Assertions			*/
+    assert(source != NULL);
+    assert(destination != NULL);
     METHOD_BEGIN(ildjitSystem, "System.Array.FastCopy");
 
-    print_err("The System.Array.FastCopy internal call is not yet implemented",
-              0);
-    abort();
+    /* Cache some pointers		*/
+    arrayManager = &((ildjitSystem->cliManager).CLR.arrayManager);
+
+    /* Only arrays of the same element type	*
+     * are copied here; the caller handles	*
+     * conversions and checks the arguments	*/
+    if (    (arrayManager->getRank(source) != 1)                                                            ||
+            (arrayManager->getRank(destination) != 1)                                                       ||
+            (arrayManager->getArrayElementsILType(source) != arrayManager->getArrayElementsILType(destination))	||
+            (sourceStart < 0)                                                                               ||
+            (destinationStart < 0)                                                                          ||
+            (count < 0)                                                                                     ||
+            ((sourceStart + count) > arrayManager->getArrayLength(source, 0))                              ||
+            ((destinationStart + count) > arrayManager->getArrayLength(destination, 0))                    ) {
+        METHOD_END(ildjitSystem, "System.Array.FastCopy");
+        return JITFALSE;
+    }
+
+    /* Copy the elements		*/
+    arraySlotSize = arrayManager->getArrayElementSize(source);
+    assert(arraySlotSize > 0);
+    internal_copyArrayElements(source, sourceStart, destination, destinationStart, count, arraySlotSize);
 
     METHOD_END(ildjitSystem, "System.Array.FastCopy");
+    return JITTRUE;
+}
 
-    return copyDone;
+static inline void internal_copyArrayElements (void *sourceArray, JITINT32 sourceIndex, void *destArray, JITINT32 destIndex, JITINT32 length, JITUINT32 arraySlotSize) {
+    JITUINT32 arraySlotType;
+    void                    *source;
+    void                    *dest;
+
+    source = (void *) (((JITNUINT) sourceArray) + (sourceIndex * arraySlotSize));
+    dest = (void *) (((JITNUINT) destArray) + (destIndex * arraySlotSize));
+
+    /* References are moved one word at a time	*
+     * with a single barrier for the whole copy;	*
+     * values are copied as a block of bytes	*/
+    arraySlotType = (ildjitSystem->garbage_collectors).gc.getArraySlotIRType(sourceArray);
+    if (    (arraySlotType == IROBJECT)     ||
+            (arraySlotType == IRMPOINTER)   ) {
+        assert(arraySlotSize == sizeof(void *));
+        ILMEMCopyReferences((void **) dest, (void **) source, length);
+    } else {
+        ILMEMCopy(dest, source, ((JITNUINT) length) * arraySlotSize);
+    }
+
+    return;
 }
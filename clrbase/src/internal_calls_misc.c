@@ -24,6 +24,7 @@
 #include <errno.h>
 #include <ir_language.h>
 #include <ildjit_locale.h>
+#include <memory_primitives.h>
 #include <jitsystem.h>
 #include <metadata_manager.h>
 #include <platform_API.h>
@@ -61,7 +62,7 @@ void System_Buffer_Copy (void *src, JITINT32 srcOffset, void *dst, JITINT32 dstO
     }
     /*end of exceptions part*/
 
-    memcpy(dst + dstOffset, src + srcOffset, count);
+    ILMEMCopy(dst + dstOffset, src + srcOffset, count);
 
     /* Return               */
     METHOD_END(ildjitSystem, "System.Buffer.Copy");
@@ -29,6 +29,7 @@
 // My headers
 #include <internal_calls_net.h>
 #include <internal_calls_utilities.h>
+#include <lib_socket_poll.h>
 // End
 
 #define GET_TIME(curr_sec, curr_nsec)  { \
@@ -358,6 +359,7 @@ JITBOOLEAN Platform_SocketMethods_Create (JITINT32 af, JITINT32 st, JITINT32 pt,
     }
 #endif
     if (*handle >= 0) {
+        SOCKETPOLL_socketOpened(*handle);
         result = 1;
     } else {
         result = 0;
@@ -420,8 +422,10 @@ JITBOOLEAN Platform_SocketMethods_Accept (JITNINT handle, void* addr, JITNINT* n
         METHOD_END(ildjitSystem, "Platform.SocketMethods.Accept");
         return 0;
     }
+    SOCKETPOLL_socketOpened(*new_handle);
 
     if (!(ildjitSystem->cliManager).CLR.netManager.convertSockAddrToAddress(addr, &sa_addr)) {
+        SOCKETPOLL_socketClosed(*new_handle);
         close(*new_handle);
         errno = EINVAL;
         METHOD_END(ildjitSystem, "Platform.SocketMethods.Accept");
@@ -566,6 +570,7 @@ JITBOOLEAN Platform_SocketMethods_Close (JITNINT handle) {
 
     METHOD_BEGIN(ildjitSystem, "Platform.SocketMethods.GetInvalidHandle");
 
+    SOCKETPOLL_socketClosed(handle);
     result = (close((int) handle) == 0);
 
     /* Return			*/
@@ -581,6 +586,7 @@ JITINT32 Platform_SocketMethods_Select (void* readarray, void* writearray, void*
     fd_set *readPtr, *writePtr, *exceptPtr;
     int highest = -1;
     int fd, result;
+    JITINT32 polled;
     JITUINT32 numRead = 0;
     JITUINT32 numWrite = 0;
     JITUINT32 numExcept = 0;
@@ -604,6 +610,12 @@ JITINT32 Platform_SocketMethods_Select (void* readarray, void* writearray, void*
         numExcept = (ildjitSystem->cliManager).CLR.arrayManager.getArrayLength(errorarray, 0);
     }
 
+    /* Wait on the epoll instance of the current thread; use select if the handles cannot be polled by it */
+    if (SOCKETPOLL_select(readarrayn, numRead, writearrayn, numWrite, errorarrayn, numExcept, timeout, &polled)) {
+        METHOD_END(ildjitSystem, "Platform.SocketMethods.Select");
+        return polled;
+    }
+
     /* Convert the read array into an "fd_set" */
     FD_ZERO(&readSet);
     if (readarrayn) {
@@ -1069,26 +1081,18 @@ void* Platform_SocketMethods_GetErrnoMessage (JITINT32 error) {
 }
 
 JITBOOLEAN Platform_SocketMethods_QueueCompletionItem (void* callback, void* state) {
-    JITBOOLEAN*     result;
-    TypeDescriptor* threadpool_type;
-    MethodDescriptor* queuecomplitem_method;
-    XanList* method_list, *parameters_array_list;
-    void* parameters_array;
-    t_methods *methods = &((ildjitSystem->cliManager).methods);
+    t_threadsManager *threadsManager;
+    JITBOOLEAN queued;
 
     METHOD_BEGIN(ildjitSystem, "Platform.SocketMethods.QueueCompletionItem");
-    parameters_array_list = xanList_new(allocFunction, freeFunction, NULL);
-    xanList_append(parameters_array_list, callback);
-    xanList_append(parameters_array_list, state);
-    parameters_array = (ildjitSystem->cliManager).CLR.arrayManager.newInstanceFromList(parameters_array_list, ((ildjitSystem->cliManager).metadataManager->System_Object)->descriptor);
-    xanList_destroyList(parameters_array_list);
-    threadpool_type = (ildjitSystem->cliManager).metadataManager->getTypeDescriptorFromName((ildjitSystem->cliManager).metadataManager, (JITINT8*) "System.Threading", (JITINT8*) "ThreadPool");
-    method_list = threadpool_type->getMethodFromName(threadpool_type, (JITINT8*) "QueueCompletionItem");
-    queuecomplitem_method = (MethodDescriptor *) xanList_first(method_list)->data;
-    result = (JITBOOLEAN*) InvokeMethod(methods->fetchOrCreateMethod(methods, queuecomplitem_method, JITTRUE), NULL, parameters_array);
+
+    /* The callback is an AsyncCallback: run it on the native thread pool,
+     * which resolves its Invoke method once per delegate type */
+    threadsManager = &((ildjitSystem->cliManager).CLR.threadsManager);
+    queued = threadsManager->queueWorkItem(callback, state);
     METHOD_END(ildjitSystem, "Platform.SocketMethods.QueueCompletionItem");
 
-    return *result;
+    return queued;
 }
 
 void* Platform_SocketMethods_CreateManualResetEvent () {
@@ -1924,18 +1924,12 @@ void * System_Reflection_ClrConstructor_Invoke (void *_this, JITINT32 invokeAttr
     PDEBUG("Internal calls: System.Reflection.ClrConstructor.Invoke:        Constructor to call	= %s\n", name);
 #endif
 
-    /* Put the method inside the pipeline	*/
+    /* Fetch the method to invoke		*/
     PDEBUG("Internal calls: System.Reflection.ClrConstructor.Invoke:        Fetch the constructor\n");
     t_methods *methods = &((ildjitSystem->cliManager).methods);
     method = methods->fetchOrCreateMethod(methods, clrConstructor->ID, JITTRUE);
     assert(method != NULL);
-    PDEBUG("Internal calls: System.Reflection.ClrConstructor.Invoke:        Put the constructor inside the pipeline\n");
-    (ildjitSystem->pipeliner).synchInsertMethod(&(ildjitSystem->pipeliner), method, MAX_METHOD_PRIORITY);
-    if (	(!(ildjitSystem->IRVM).behavior.aot) 		&&
-            ((ildjitSystem->IRVM).behavior.pgc == 1)	) {
-        MANFRED_appendMethodToProfile(&(ildjitSystem->manfred), method);
-    }
-    newObject = InvokeMethod(method, NULL, parametersArray);
+    newObject = InvokeMethodWithStub(method, &(clrConstructor->invokeStub), NULL, parametersArray);
 
     /* Exit				*/
     METHOD_END(ildjitSystem, "System.Reflection.ClrConstructor.Invoke");
@@ -2018,12 +2012,12 @@ void * System_Reflection_ClrMethod_Invoke (void *_this, void *object, JITINT32 i
     PDEBUG("Internal calls: System.Reflection.ClrMethod.Invoke:     Method to call	= %s\n", name);
 #endif
 
-    /* Put the method inside the pipeline	*/
+    /* Fetch the method to invoke		*/
     PDEBUG("Internal calls: System.Reflection.ClrMethod.Invoke:     Fetch the method\n");
     t_methods *methods = &((ildjitSystem->cliManager).methods);
     method = methods->fetchOrCreateMethod(methods, clrMethod->ID, JITTRUE);
     assert(method != NULL);
-    newObject = InvokeMethod(method, object, parametersArray);
+    newObject = InvokeMethodWithStub(method, &(clrMethod->invokeStub), object, parametersArray);
 
     /* Exit				*/
     METHOD_END(ildjitSystem, "System.Reflection.ClrMethod.Invoke");
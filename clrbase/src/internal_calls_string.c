@@ -19,6 +19,7 @@
  */
 #include <stdio.h>
 #include <ildjit_locale.h>
+#include <utf16_primitives.h>
 #include <platform_API.h>
 #include <ildjit.h>
 
@@ -29,11 +30,6 @@
 #include <clr_system.h>
 // End
 
-#define EqualRange(literal1, posn1, count, literal2, posn2) \
-	(!memcmp(literal1 + (posn1), \
-		 literal2 + (posn2), \
-		 (count) * sizeof(JITINT16)))
-
 typedef enum {
     Mono_StringSplitOption_None = 0,
     Mono_StringSplitOption_RemoveEmptyEntries = 1
@@ -121,7 +117,7 @@ JITBOOLEAN System_String_Equals (void *str1, void *str2) {
         assert(literal1 != NULL);
         literal2 = (ildjitSystem->cliManager).CLR.stringManager.toLiteral(str2);
         assert(literal2 != NULL);
-        result = memcmp(literal1, literal2, length1 * sizeof(JITINT16));
+        result = (ILUTF16Mismatch(literal1, literal2, length1) != length1);
     }
 
     METHOD_END(ildjitSystem, "System.String.Equals");
@@ -414,6 +410,8 @@ JITINT32 System_String_InternalOrdinal (void *strA, JITINT32 indexA, JITINT32 le
     JITINT32 result = 0;
     JITINT16        *bufA;
     JITINT16        *bufB;
+    JITINT32 compared;
+    JITINT32 position;
 
     METHOD_BEGIN(ildjitSystem, "System.String.InternalOrdinal");
 
@@ -433,23 +431,18 @@ JITINT32 System_String_InternalOrdinal (void *strA, JITINT32 indexA, JITINT32 le
         bufB = (ildjitSystem->cliManager).CLR.stringManager.toLiteral(strB) + indexB;
         assert(bufB != NULL);
 
-        while (lengthA > 0 && lengthB > 0) {
-            result = (*bufA) - (*bufB);
-
-            if (result) {
-                break;
-            }
-
-            ++bufA;
-            ++bufB;
-            --lengthA;
-            --lengthB;
+        /* Find the first character that differs within the common prefix */
+        compared = (lengthA < lengthB) ? lengthA : lengthB;
+        if (compared < 0) {
+            compared = 0;
         }
-
-        if (result == 0) { /* Determine the ordering based on the tail sections */
-            if (lengthA > 0) {
+        position = ILUTF16Mismatch(bufA, bufB, compared);
+        if (position < compared) {
+            result = bufA[position] - bufB[position];
+        } else { /* Determine the ordering based on the tail sections */
+            if (lengthA > compared) {
                 result = 1;
-            } else if (lengthB > 0) {
+            } else if (lengthB > compared) {
                 result = -1;
             } else {
                 result = 0;
@@ -499,7 +492,8 @@ JITINT32 System_String_Compare (void *str1, void *str2) { //TEST OK
 
 void * System_String_ReplaceStringString (void *_this, void *oldValue, void *newValue) {
     JITINT32 posn;
-    JITBOOLEAN foundMatch = 0;
+    JITINT32 match;
+    JITINT32 matches;
     JITINT32 old_length;
     JITINT32 new_length;
     JITINT32 this_length;
@@ -522,17 +516,16 @@ void * System_String_ReplaceStringString (void *_this, void *oldValue, void *new
     this_length = (ildjitSystem->cliManager).CLR.stringManager.getLength(_this);
     assert(this_length >= 0);
 
-    old_literal = (ildjitSystem->cliManager).CLR.stringManager.toLiteral(oldValue);
-    assert(old_literal != NULL);
-    old_length = (ildjitSystem->cliManager).CLR.stringManager.getLength(oldValue);
-    assert(old_length >= 0);
-
-
     /* Validate the parameters */
     if (oldValue == NULL) {
         ILDJIT_throwExceptionWithName((JITINT8 *) "System", (JITINT8 *) "NullReferenceException");
         result = _this;
     } else {
+        old_literal = (ildjitSystem->cliManager).CLR.stringManager.toLiteral(oldValue);
+        assert(old_literal != NULL);
+        old_length = (ildjitSystem->cliManager).CLR.stringManager.getLength(oldValue);
+        assert(old_length >= 0);
+
         /* If "oldValue" is an empty string, then the
            string will not be changed */
         if (old_length == 0) {
@@ -549,41 +542,35 @@ void * System_String_ReplaceStringString (void *_this, void *oldValue, void *new
                 new_length = 0;
             }
 
-            /* Determine the length of the final string */
-            finalLen = 0;
+            /* Count the non-overlapping occurrences of "oldValue", from left to right */
+            matches = 0;
             posn = 0;
-            while ((posn + old_length) <= this_length) {
-                if (EqualRange(this_literal, posn, old_length, old_literal, 0)) {
-                    finalLen += new_length;
-                    posn += old_length;
-                    foundMatch = 1;
-                } else {
-                    ++finalLen;
-                    ++posn;
-                }
+            while ((match = ILUTF16Find(this_literal + posn, this_length - posn, old_literal, old_length)) >= 0) {
+                matches++;
+                posn += match + old_length;
             }
-            if (!foundMatch) { /* no match found */
+            if (matches == 0) { /* no match found */
                 result = _this;
             } else {
-                finalLen += this_length - posn;
+                finalLen = this_length + matches * (new_length - old_length);
 
-                buf = (JITINT16*) allocMemory(finalLen * sizeof(JITINT16));
+                buf = (JITINT16*) allocMemory((finalLen + 1) * sizeof(JITINT16));
                 assert(buf != NULL);
 
                 /* Scan the input string again and perform the replacement */
                 finalLen = 0;
                 posn = 0;
-                while ((posn) < this_length) {
-                    if ((posn + old_length) <= this_length && EqualRange(this_literal, posn, old_length, old_literal, 0)) {
-                        if (new_length > 0) {
-                            memcpy(buf + finalLen, new_literal, new_length * sizeof(JITINT16));
-                        }
-                        finalLen += new_length;
-                        posn += old_length;
-                    } else {
-                        buf[finalLen++] = this_literal[posn++];
+                while ((match = ILUTF16Find(this_literal + posn, this_length - posn, old_literal, old_length)) >= 0) {
+                    memcpy(buf + finalLen, this_literal + posn, match * sizeof(JITINT16));
+                    finalLen += match;
+                    if (new_length > 0) {
+                        memcpy(buf + finalLen, new_literal, new_length * sizeof(JITINT16));
                     }
+                    finalLen += new_length;
+                    posn += match + old_length;
                 }
+                memcpy(buf + finalLen, this_literal + posn, (this_length - posn) * sizeof(JITINT16));
+                finalLen += this_length - posn;
 
                 result = (ildjitSystem->cliManager).CLR.stringManager.newInstance(buf, finalLen);
                 assert(result != NULL);
@@ -687,7 +674,6 @@ JITINT32 System_String_IndexOf (void *string, JITINT16 value, JITINT32 startInde
     JITINT32 result = -1;
     JITINT16        *literal;
     JITINT32 len;
-    JITINT32 i;
 
     /* Assertions			*/
     assert(string != NULL);
@@ -707,11 +693,9 @@ JITINT32 System_String_IndexOf (void *string, JITINT16 value, JITINT32 startInde
         literal = (ildjitSystem->cliManager).CLR.stringManager.toLiteral(string);
         assert(literal != NULL);
 
-        for (i = startIndex; i < startIndex + count; i++) {
-            if (literal[i] == value) {
-                result = i;
-                break;
-            }
+        result = ILUTF16IndexOf(literal + startIndex, count, value);
+        if (result >= 0) {
+            result += startIndex;
         }
     }
     /* Exit				*/
@@ -721,8 +705,7 @@ JITINT32 System_String_IndexOf (void *string, JITINT16 value, JITINT32 startInde
 
 JITINT32 System_String_IndexOfAny (void *string, void *array, JITINT32 startIndex, JITINT32 count) { //TEST OK
     JITINT32 arrayLength;
-    JITINT32 j;
-    JITINT32 i;
+    JITINT32 result;
     JITINT16        *literal;
     JITINT16        *arrayBuf;
     JITINT32 len;
@@ -755,13 +738,10 @@ JITINT32 System_String_IndexOfAny (void *string, void *array, JITINT32 startInde
         literal = (ildjitSystem->cliManager).CLR.stringManager.toLiteral(string);
         assert(literal != NULL);
 
-        for (i = startIndex; i < startIndex + count; i++) {
-            for (j = 0; j < arrayLength; j++) {
-                if ( literal[i] == arrayBuf[j] ) {
-                    METHOD_END(ildjitSystem, "System.String.IndexOfAny");
-                    return i;
-                }
-            }
+        result = ILUTF16IndexOfAny(literal + startIndex, count, arrayBuf, arrayLength);
+        if (result >= 0) {
+            METHOD_END(ildjitSystem, "System.String.IndexOfAny");
+            return startIndex + result;
         }
     }
     /* Exit				*/
@@ -772,6 +752,7 @@ JITINT32 System_String_IndexOfAny (void *string, void *array, JITINT32 startInde
 JITINT32 System_String_LastIndexOf (void *_this, JITINT16 value, JITINT32 startIndex, JITINT32 count) { //TEST OK
     JITINT16        *buf;
     JITINT32 len;
+    JITINT32 result;
 
     /* Assertions			*/
     assert(_this != NULL);
@@ -793,17 +774,15 @@ JITINT32 System_String_LastIndexOf (void *_this, JITINT16 value, JITINT32 startI
         startIndex = len - 1;
     }
 
-    /* Search for the value */
-    buf = (ildjitSystem->cliManager).CLR.stringManager.toLiteral(_this) + startIndex;
-    assert(buf != NULL);
-
-    while (count > 0) {
-        if (*buf-- == value) {
+    /* Search for the value within [startIndex - count + 1, startIndex] */
+    if (count > 0) {
+        buf = (ildjitSystem->cliManager).CLR.stringManager.toLiteral(_this) + startIndex - count + 1;
+        assert(buf != NULL);
+        result = ILUTF16LastIndexOf(buf, count, value);
+        if (result >= 0) {
             METHOD_END(ildjitSystem, "System.String.LastIndexOf");
-            return startIndex;
+            return startIndex - count + 1 + result;
         }
-        --startIndex;
-        --count;
     }
 
     METHOD_END(ildjitSystem, "System.String.LastIndexOf");
@@ -814,7 +793,7 @@ JITINT32 System_String_LastIndexOfAny (void *_this, void *anyOfArray, JITINT32 s
     JITINT16        *buf;
     JITINT16        *anyBuf;
     JITINT32 anyLength;
-    JITINT32 i;
+    JITINT32 result;
     JITINT32 len;
 
     /* Assertions			*/
@@ -840,6 +819,7 @@ JITINT32 System_String_LastIndexOfAny (void *_this, void *anyOfArray, JITINT32 s
     assert(anyLength >= 0);
 
     if (anyLength == 0) {     /* Bail out because there is nothing to find */
+        METHOD_END(ildjitSystem, "System.String.LastIndexOfAny");
         return -1;
     }
 
@@ -852,20 +832,15 @@ JITINT32 System_String_LastIndexOfAny (void *_this, void *anyOfArray, JITINT32 s
         startIndex = len - 1;
     }
 
-    /* Search for the value */
-    buf = (ildjitSystem->cliManager).CLR.stringManager.toLiteral(_this) + startIndex;
-    assert(buf != NULL);
-
-    while (count > 0) {
-        for (i = 0; i < anyLength; i++) {
-            if (*buf == anyBuf[i]) {
-                METHOD_END(ildjitSystem, "System.String.LastIndexOfAny");
-                return startIndex;
-            }
+    /* Search for the value within [startIndex - count + 1, startIndex] */
+    if (count > 0) {
+        buf = (ildjitSystem->cliManager).CLR.stringManager.toLiteral(_this) + startIndex - count + 1;
+        assert(buf != NULL);
+        result = ILUTF16LastIndexOfAny(buf, count, anyBuf, anyLength);
+        if (result >= 0) {
+            METHOD_END(ildjitSystem, "System.String.LastIndexOfAny");
+            return startIndex - count + 1 + result;
         }
-        --buf;
-        --startIndex;
-        --count;
     }
 
     METHOD_END(ildjitSystem, "System.String.LastIndexOfAny");
@@ -995,6 +970,7 @@ JITINT32 System_String_FindInRange (void *this, JITINT32 srcFirst, JITINT32 srcL
     JITINT16        *literal;
     JITINT16        *this_literal;
     JITINT32 length;
+    JITINT32 position;
 
     /* Assertions				*/
     assert(this != NULL);
@@ -1008,11 +984,6 @@ JITINT32 System_String_FindInRange (void *this, JITINT32 srcFirst, JITINT32 srcL
     assert(this_literal != NULL);
     length = (ildjitSystem->cliManager).CLR.stringManager.getLength(dest);
 
-    /* Drop out the first srcFirst character*
-     * of the this string			*/
-    this_literal = this_literal + srcFirst;
-    assert(this_literal != NULL);
-
     /* Check the destination string		*/
     if (length == 0) {
         METHOD_END(ildjitSystem, "System.String.FindInRange");
@@ -1021,58 +992,24 @@ JITINT32 System_String_FindInRange (void *this, JITINT32 srcFirst, JITINT32 srcL
 
     if (srcStep > 0) {
 
-        /* Scan forward to the string	*/
-        if (length == 1) {
-            while (srcFirst <= srcLast) {
-                if (this_literal[0] == literal[0]) {
-                    METHOD_END(ildjitSystem, "System.String.FindInRange");
-                    return srcFirst;
-                }
-
-                this_literal++;
-                srcFirst++;
-            }
-        } else {
-            while (srcFirst <= srcLast) {
-                if (    (this_literal[0] == literal[0])                         &&
-                        (!memcmp(this_literal, literal, sizeof(JITINT16) * length))     ) {
-                    METHOD_END(ildjitSystem, "System.String.FindInRange");
-                    return srcFirst;
-                }
-
-                this_literal++;
-                srcFirst++;
+        /* Scan forward to the string: the candidate positions are srcFirst .. srcLast	*/
+        if (srcFirst <= srcLast) {
+            position = ILUTF16Find(this_literal + srcFirst, srcLast - srcFirst + length, literal, length);
+            if (position >= 0) {
+                METHOD_END(ildjitSystem, "System.String.FindInRange");
+                return srcFirst + position;
             }
         }
-        METHOD_END(ildjitSystem, "System.String.FindInRange");
-        return -1;
     } else {
 
-        /* Scan backwards for the string	*/
-        if (length == 1) {
-            while (srcFirst >= srcLast) {
-                if (this_literal[0] == literal[0]) {
-                    METHOD_END(ildjitSystem, "System.String.FindInRange");
-                    return srcFirst;
-                }
-
-                this_literal--;
-                srcFirst--;
-            }
-        } else {
-            while (srcFirst >= srcLast) {
-                if (    (this_literal[0] == literal[0])                         &&
-                        (!memcmp(this_literal, literal, sizeof(JITINT16) * length))     ) {
-                    METHOD_END(ildjitSystem, "System.String.FindInRange");
-                    return srcFirst;
-                }
-
-                this_literal--;
-                srcFirst--;
+        /* Scan backwards for the string: the candidate positions are srcFirst .. srcLast	*/
+        if (srcFirst >= srcLast) {
+            position = ILUTF16FindLast(this_literal + srcLast, srcFirst - srcLast + length, literal, length);
+            if (position >= 0) {
+                METHOD_END(ildjitSystem, "System.String.FindInRange");
+                return srcLast + position;
             }
         }
-        METHOD_END(ildjitSystem, "System.String.FindInRange");
-        return -1;
     }
 
     METHOD_END(ildjitSystem, "System.String.FindInRange");
@@ -30,6 +30,10 @@
 
 extern t_system *ildjitSystem;
 
+static inline InvokeStub * internal_makeInvokeStub (Method method);
+static inline JITINT32 internal_invokeWithStub (Method method, InvokeStub *stub, void *_this, void *parametersArray, void **returned);
+static inline void internal_rethrowUncaughtException (void);
+
 MethodDescriptor *ILMethodSemGetByType (CLRMember *clrMember, JITINT32 type) {
     MethodDescriptor                                *method;
 
@@ -75,32 +79,68 @@ MethodDescriptor *ILMethodSemGetByType (CLRMember *clrMember, JITINT32 type) {
 }
 
 void * InvokeMethod (Method method, void *_this, void *parametersArray) {
-    JITUINT32 		numParameters;
-    JITUINT32 		signNumParameters;
+    InvokeStub	*stub;
+    void		*result;
+    JITINT32	error;
+
+    /* Assertions						*/
+    assert(method != NULL);
+    PDEBUG("Internal call: internal_InvokeMethod: Start\n");
+
+    /* Call the method with a stub used only once		*/
+    stub = internal_makeInvokeStub(method);
+    error = internal_invokeWithStub(method, stub, _this, parametersArray, &result);
+    freeFunction(stub);
+    if (error == 0) {
+        internal_rethrowUncaughtException();
+    }
+
+    return result;
+}
+
+void * InvokeMethodWithStub (Method method, void **invokeStub, void *_this, void *parametersArray) {
+    InvokeStub	*stub;
+    void		*result;
+    JITINT32	error;
+
+    /* Assertions						*/
+    assert(method != NULL);
+    assert(invokeStub != NULL);
+
+    /* Make the stub at the first call			*/
+    stub = __atomic_load_n((InvokeStub **) invokeStub, __ATOMIC_ACQUIRE);
+    if (stub == NULL) {
+        InvokeStub	*expected;
+        expected = NULL;
+        stub = internal_makeInvokeStub(method);
+        if (!__atomic_compare_exchange_n((InvokeStub **) invokeStub, &expected, stub, JITFALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+
+            /* Another thread stored its stub first		*/
+            freeFunction(stub);
+            stub = expected;
+        }
+    }
+    assert(stub != NULL);
+
+    /* Call the method					*/
+    error = internal_invokeWithStub(method, stub, _this, parametersArray, &result);
+    if (error == 0) {
+        internal_rethrowUncaughtException();
+    }
+
+    return result;
+}
+
+static inline InvokeStub * internal_makeInvokeStub (Method method) {
+    InvokeStub		*stub;
     ir_signature_t          *IRSignature;
     MethodDescriptor        *cil_method;
+    XanListItem		*item;
+    JITUINT32		parametersNumber;
     JITUINT32 		count;
-    JITINT32 		error;
-    JITBOOLEAN 		hasThis;
-    JITBOOLEAN 		is_primitive_result;
-    void                    *exception_uncaught;
-    void                    *result;
-    void                    **args;
-    void			*resultToReturn;
 
     /* Assertions						*/
     assert(method != NULL);
-    PDEBUG("Internal call: internal_InvokeMethod: Start\n");
-
-    /* Initialize the variables				*/
-    IRSignature = NULL;
-    exception_uncaught = NULL;
-    args = NULL;
-    result = NULL;
-    is_primitive_result = 1;
-    numParameters = 0;
-    signNumParameters = 0;
-    hasThis = 0;
 
     /* Compile the method		                        */
     (ildjitSystem->pipeliner).synchInsertMethod(&(ildjitSystem->pipeliner), method, MAX_METHOD_PRIORITY);
@@ -113,239 +153,210 @@ void * InvokeMethod (Method method, void *_this, void *parametersArray) {
     /* Fetch the CIL signature of the method to call	*/
     cil_method = method->getID(method);
     assert(cil_method != NULL);
-    PDEBUG("Internal call: internal_InvokeMethod:   Method to call	= %s\n", cil_method->getSignatureInString(cil_method));
-
-    /* Fetch the number of parameters			*/
-    if (parametersArray != NULL) {
-        numParameters = (ildjitSystem->cliManager).CLR.arrayManager.getArrayLength(parametersArray, 0);
-    }
-
-    /* Fetch the number of parameters declared inside the   *
-     * signature of the method to call			*/
-    signNumParameters = method->getParametersNumber(method);
-
-    /* Consider the "this" parameter                        */
-    if (!(cil_method->attributes->is_static)) {
-        numParameters++;
-        hasThis = JITTRUE;
-    }
-
-    /* Check that the parameters given in input are equal	*
-     * to the parameters declared in the signature of the	*
-     * method to call					*/
-    if (numParameters != signNumParameters) {
-        ILDJIT_throwExceptionWithName((JITINT8 *) "System", (JITINT8 *) "ArgumentException");
-        abort();
-    }
-    assert(numParameters == signNumParameters);
+    PDEBUG("Internal call: internal_InvokeMethod:   Make the stub of %s\n", cil_method->getSignatureInString(cil_method));
 
     /* Fetch the IR signature of the method to call		*/
     IRSignature = method->getSignature(method);
     assert(IRSignature != NULL);
 
-    /* Make the arguments of the call			*/
-    args = NULL;
-    if (numParameters > 0) {
-        PDEBUG("Internal call: internal_InvokeMethod: there are parameters\n");
-        args = (void **) allocMemory(sizeof(void *) * numParameters);
-        assert(args != NULL);
-        memset(args, 0, sizeof(void *) * numParameters);
-    }
-
-    if (hasThis) {
-        assert(_this != NULL);
-        assert(numParameters > 0);
-        assert(args != NULL);
-        PDEBUG("Internal call: internal_InvokeMethod: the parameter 0 is THIS \n");
-        args[0] = &(_this);
-    }
-
-    /* Make the parameters to give at the invocation of the	*
-     * method to call				*/
-    XanList *params = cil_method->getParams(cil_method);
-    XanListItem *item = xanList_first(params);
-    for (count = hasThis; count < numParameters; count++) {
-
-        /* The type of the current parameter is a normal object	*/
+    /* Allocate the stub					*/
+    parametersNumber = method->getParametersNumber(method);
+    stub = allocFunction(sizeof(InvokeStub) + (sizeof(InvokeParameter) * parametersNumber));
+    assert(stub != NULL);
+    stub->parametersNumber = parametersNumber;
+    stub->hasThis = !(cil_method->attributes->is_static);
+    assert((!stub->hasThis) || (parametersNumber > 0));
+
+    /* Decide how each parameter is taken from the array	*/
+    item = xanList_first(cil_method->getParams(cil_method));
+    for (count = stub->hasThis; count < parametersNumber; count++) {
         ParamDescriptor *currentParam;
+        InvokeParameter	*parameter;
 
         /* Retrieve the parameter informations			*/
         currentParam = (ParamDescriptor *) item->data;
         assert(currentParam != NULL);
+        assert(currentParam->type != NULL);
+        parameter = &(stub->parameters[count]);
+        parameter->IRType = IRSignature->parameterTypes[count];
+
+        /* Null elements given for value types are boxed	*/
+        if (!is_byReference_or_Object_IRType(parameter->IRType)) {
+            parameter->boxNull = JITTRUE;
+            if (parameter->IRType == IRVALUETYPE) {
+                parameter->valueType = currentParam->type;
+            }
+        }
 
+        /* Choose how the element is given			*/
         if (currentParam->type->isByRef) {
-            /* The current parameter is a byref element	*/
             PDEBUG("Internal call: internal_InvokeMethod: The parameter #%d is byref\n", count);
+            parameter->step = INVOKE_STEP_BYREF;
+        } else if (currentParam->getIRType(currentParam) == IROBJECT) {
+            parameter->step = INVOKE_STEP_REFERENCE;
+        } else {
+            PDEBUG("Internal call: internal_InvokeMethod: The parameter #%d requires a builtin type\n", count);
+            parameter->step = INVOKE_STEP_UNBOX;
+        }
+        item = item->next;
+    }
 
-            /* Initialize the current argument		*/
-            args[count] = (void *) allocMemory(sizeof(void *));
-            assert(args[count] != NULL);
-
-            /* Test if the parameter is a null reference	*/
-            if (*((void **) (parametersArray + (count - hasThis))) == NULL) {
-                PDEBUG("Internal call: internal_InvokeMethod: the parameter #%d is a NULL reference\n", count - hasThis);
-
-                /* Preconditions			*/
-                assert(currentParam->type != NULL);
+    /* Decide how the result is returned			*/
+    switch (IRSignature->resultType) {
+        case IRVALUETYPE:
+            stub->resultValueType = cil_method->getResult(cil_method)->type;
+            assert(stub->resultValueType != NULL);
+            stub->isPrimitiveResult = JITTRUE;
+            break;
+        case IRINT8:
+        case IRINT16:
+        case IRINT32:
+        case IRINT64:
+        case IRNINT:
+        case IRUINT8:
+        case IRUINT16:
+        case IRUINT32:
+        case IRUINT64:
+        case IRNUINT:
+        case IRFLOAT32:
+        case IRFLOAT64:
+        case IRNFLOAT:
+            stub->isPrimitiveResult = JITTRUE;
+            break;
+        default:
+            stub->isPrimitiveResult = JITFALSE;
+    }
 
-                (*((JITNUINT *) args[count])) = (JITNUINT) NULL;
+    return stub;
+}
 
-                /* test if the current parameter is a valueType */
-                if (!is_byReference_or_Object_IRType(IRSignature->parameterTypes[count]) ) {
-                    if (IRSignature->parameterTypes[count] == IRVALUETYPE) {
-                        TypeDescriptor  *value_type_infos;
+static inline JITINT32 internal_invokeWithStub (Method method, InvokeStub *stub, void *_this, void *parametersArray, void **returned) {
+    void		*args[stub->parametersNumber + 1];
+    void		*cells[stub->parametersNumber + 1];
+    void		**elements;
+    void		*result;
+    JITUINT64	resultArea;
+    JITUINT32	argumentsNumber;
+    JITUINT32	count;
+    JITINT32	error;
 
-                        /* retrieve the metadata infos associated with the current
-                         * valueType */
-                        TypeDescriptor *param_type = currentParam->type;
-                        value_type_infos = param_type;
-                        assert(value_type_infos != NULL);
+    /* Assertions						*/
+    assert(method != NULL);
+    assert(stub != NULL);
+    assert(returned != NULL);
 
-                        /* box the valueType */
-                        (*((JITNUINT *) args[count])) = (JITNUINT) ILDJIT_boxNullValueType(value_type_infos);
-                        assert((void *) (*((JITNUINT *) args[count])) != NULL);
+    /* Check that the parameters given in input are equal	*
+     * to the parameters declared in the signature of the	*
+     * method to call					*/
+    elements = NULL;
+    argumentsNumber = stub->hasThis;
+    if (parametersArray != NULL) {
+        argumentsNumber += (ildjitSystem->cliManager).CLR.arrayManager.getArrayLength(parametersArray, 0);
+        elements = (void **) parametersArray;
+    }
+    if (argumentsNumber != stub->parametersNumber) {
+        ILDJIT_throwExceptionWithName((JITINT8 *) "System", (JITINT8 *) "ArgumentException");
+        abort();
+    }
 
-                    } else {
-                        /* box the valueType */
-                        (*((JITNUINT *) args[count])) = (JITNUINT) ILDJIT_boxNullPrimitiveType(IRSignature->parameterTypes[count]);
-                        assert((void *) (*((JITNUINT *) args[count])) != NULL);
-                    }
-                }
+    /* Make the arguments of the call			*/
+    if (stub->hasThis) {
+        assert(_this != NULL);
+        args[0] = &(_this);
+    }
+    for (count = stub->hasThis; count < stub->parametersNumber; count++) {
+        InvokeParameter	*parameter;
+        void		**element;
+
+        parameter = &(stub->parameters[count]);
+        element = &(elements[count - stub->hasThis]);
+
+        /* Box the default value of null value types		*/
+        if (	((*element) == NULL)	&&
+                (parameter->boxNull)	) {
+            void	*boxed;
+            if (parameter->valueType != NULL) {
+                boxed = ILDJIT_boxNullValueType(parameter->valueType);
             } else {
-                PDEBUG("Internal call: internal_InvokeMethod: the parameter #%d is NOT a NULL reference\n", count - hasThis);
-                (*((void **) args[count])) = (ildjitSystem->cliManager).CLR.arrayManager.getArrayElement(parametersArray, count - hasThis);
+                boxed = ILDJIT_boxNullPrimitiveType(parameter->IRType);
             }
-
-        } else {
-            PDEBUG("Internal call: internal_InvokeMethod: The parameter #%d is NOT byref \n", count - hasThis);
-
-            /* Test if the parameter is a null reference */
-            if ( (void *) (((JITNUINT *) parametersArray )[count - hasThis]) == NULL) {
-                PDEBUG("Internal call: internal_InvokeMethod: the parameter #%d is a NULL reference\n", count - hasThis);
-
-                /* preconditions */
-                assert(currentParam->type != NULL);
-
-                /* initialize the current argument */
-                args[count] = NULL;
-
-                if (!is_byReference_or_Object_IRType(IRSignature->parameterTypes[count]) ) {
-                    if (IRSignature->parameterTypes[count] == IRVALUETYPE) {
-                        TypeDescriptor  *value_type_infos;
-
-                        /* retrieve the metadata infos associated with the current
-                         * valueType */
-                        TypeDescriptor *param_type = currentParam->type;
-                        value_type_infos = param_type;
-                        assert(value_type_infos != NULL);
-
-                        /* box the valueType */
-                        args[count] = ILDJIT_boxNullValueType(value_type_infos);
-                        assert(args[count] != NULL);
-
-                    } else {
-
-                        /* box the valueType */
-                        args[count] = ILDJIT_boxNullPrimitiveType(IRSignature->parameterTypes[count]);
-                        assert(args[count] != NULL);
-                    }
-                }
-
+            assert(boxed != NULL);
+            if (parameter->step == INVOKE_STEP_BYREF) {
+                cells[count] = boxed;
+                args[count] = &(cells[count]);
             } else {
-                PDEBUG("Internal call: internal_InvokeMethod: the parameter #%d is NOT a NULL reference\n", count - hasThis);
-                args[count] = (ildjitSystem->cliManager).CLR.arrayManager.getArrayElement(parametersArray, count - hasThis);
-
-                JITUINT32 current_param_IRType = currentParam->getIRType(currentParam);
-                PDEBUG("Internal call: internal_InvokeMethod: the param IR type is %d\n", current_param_IRType);
-                switch (current_param_IRType) {
-                    case IROBJECT:
-                        PDEBUG("Internal call: internal_InvokeMethod: nothing to be done here, the parameter is OK\n");
-                        break;
-                    default:
-                        PDEBUG("Internal call: internal_InvokeMethod: the parameter requires a builtin type, dereferencing...\n");
-                        args[count] = *((void **) (ildjitSystem->cliManager).CLR.arrayManager.getArrayElement(parametersArray, count - hasThis));
-                        break;
-                }
+                args[count] = boxed;
             }
+            continue;
         }
-        item = item->next;
-    }
-
-    TypeDescriptor *result_type = cil_method->getResult(cil_method)->type;
-    if (IRSignature->resultType == IRVALUETYPE) {
-        PDEBUG("Internal call: internal_InvokeMethod: result type is VALUETYPE\n");
-        TypeDescriptor  *value_type_infos;
-
-        /* Retrieve the metadata infos associated with the current valueType	*/
-        value_type_infos = result_type;
-        assert(value_type_infos != NULL);
-
-        /* Box the valueType							*/
-        result = ILDJIT_boxNullValueType(value_type_infos);
-        assert(result != NULL);
 
-    } else {
-
-        /* Allocate the result area					*/
-        PDEBUG("Internal call: internal_InvokeMethod: making the result area\n");
-        result = allocMemory(sizeof(JITUINT64));
-
-        switch (IRSignature->resultType) {
-            case IRINT8:
-            case IRINT16:
-            case IRINT32:
-            case IRINT64:
-            case IRNINT:
-            case IRUINT8:
-            case IRUINT16:
-            case IRUINT32:
-            case IRUINT64:
-            case IRNUINT:
-            case IRFLOAT32:
-            case IRFLOAT64:
-            case IRNFLOAT:
+        /* Unpack the element					*/
+        switch (parameter->step) {
+            case INVOKE_STEP_REFERENCE:
+                args[count] = element;
+                break;
+            case INVOKE_STEP_UNBOX:
+                args[count] = *element;
                 break;
-            case IROBJECT:
-            case IRMPOINTER:
-            case IRTPOINTER:
-                is_primitive_result = 0;
+            case INVOKE_STEP_BYREF:
+                cells[count] = element;
+                args[count] = &(cells[count]);
                 break;
             default:
-                is_primitive_result = 0;
+                abort();
         }
     }
 
     /* Check if we need to execute the code.
      */
     if ((ildjitSystem->program).disableExecution) {
-        return 0;
+        (*returned) = NULL;
+        return 1;
     }
 
-    /* Call the method				*/
-    error = IRVM_run(&(ildjitSystem->IRVM), *(method->jit_function), args, result);
+    /* Allocate the result area				*/
+    if (stub->resultValueType != NULL) {
+        result = ILDJIT_boxNullValueType(stub->resultValueType);
+        assert(result != NULL);
+    } else if (stub->isPrimitiveResult) {
+        result = allocMemory(sizeof(JITUINT64));
+        assert(result != NULL);
+    } else {
+        resultArea = 0;
+        result = &resultArea;
+    }
 
-    /* Check if an exception occur				*/
+    /* Call the method					*/
+    error = IRVM_run(&(ildjitSystem->IRVM), *(method->jit_function), args, result);
     if (error == 0) {
-        /* An exception occurs				*/
-        /* Take the exception occurs			*/
-        exception_uncaught = ((ildjitSystem->program).thread_exception_infos)->exception_thrown;
-        assert(exception_uncaught != NULL);
-
-        /* Rethrow the exception			*/
-        IRVM_throwException(&(ildjitSystem->IRVM), exception_uncaught);
-        print_err("ERROR = The execution should not come at this point. ", 0);
-        abort();
+        if (	(stub->resultValueType == NULL)	&&
+                (stub->isPrimitiveResult)	) {
+            freeMemory(result);
+        }
+        return error;
     }
 
-    /* Fetch the result				*/
-    if (is_primitive_result) {
-        resultToReturn	= result;
+    /* Fetch the result					*/
+    if (stub->isPrimitiveResult) {
+        (*returned) = result;
     } else {
-        resultToReturn	= *((void **) result);
-        freeFunction(result);
+        (*returned) = *((void **) result);
     }
 
-    return resultToReturn;
+    return error;
+}
+
+static inline void internal_rethrowUncaughtException (void) {
+    void	*exception_uncaught;
+
+    /* Take the exception occurs				*/
+    exception_uncaught = ((ildjitSystem->program).thread_exception_infos)->exception_thrown;
+    assert(exception_uncaught != NULL);
+
+    /* Rethrow the exception				*/
+    IRVM_throwException(&(ildjitSystem->IRVM), exception_uncaught);
+    print_err("ERROR = The execution should not come at this point. ", 0);
+    abort();
 }
 
 JITINT32 reflectionStringCmp (JITINT8 *name1, JITINT8 *name2, JITBOOLEAN ignoreCase) {
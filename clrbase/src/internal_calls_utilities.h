@@ -34,8 +34,41 @@
 #define LOAD_ERROR_BAD_IMAGE                    3
 #define LOAD_ERROR_SECURITY                     4
 
+#define INVOKE_STEP_REFERENCE			0	/**< The element of the array is given as it is			*/
+#define INVOKE_STEP_UNBOX			1	/**< The element of the array is a boxed value to give by value	*/
+#define INVOKE_STEP_BYREF			2	/**< The address of the element of the array is given		*/
+
+/**
+ * How a parameter of a method called through reflection is taken from the array of arguments
+ */
+typedef struct {
+    JITUINT8		step;			/**< INVOKE_STEP_*								*/
+    JITUINT32		IRType;			/**< IR type declared by the signature					*/
+    JITBOOLEAN		boxNull;		/**< JITTRUE if a null element is replaced by a boxed default value	*/
+    TypeDescriptor		*valueType;		/**< Value type to box for a null element, NULL otherwise		*/
+} InvokeParameter;
+
+/**
+ * Steps to call a method through reflection, computed once from its metadata
+ */
+typedef struct {
+    JITUINT32		parametersNumber;	/**< Parameters of the signature, including "this"			*/
+    JITBOOLEAN		hasThis;
+    JITBOOLEAN		isPrimitiveResult;	/**< JITTRUE if the result is returned by address			*/
+    TypeDescriptor		*resultValueType;	/**< Type of the result if it is a value type, NULL otherwise		*/
+    InvokeParameter		parameters[];
+} InvokeStub;
+
 MethodDescriptor *ILMethodSemGetByType (CLRMember *clrMember, JITINT32 type);
 void * InvokeMethod (Method method, void *_this, void *parametersArray);
+
+/**
+ * Call a method through reflection.
+ *
+ * The stub is made and stored in invokeStub at the first call, which also compiles the method; the later calls only unpack the arguments.
+ * The stub has to be freed by freeFunction.
+ */
+void * InvokeMethodWithStub (Method method, void **invokeStub, void *_this, void *parametersArray);
 JITINT32 reflectionStringCmp (JITINT8 *name1, JITINT8 *name2, JITBOOLEAN ignoreCase);
 void * GetTypeName (void *object, JITINT16 fullyQualified);
 void * GetTypeNamespace (void *object);
@@ -13,6 +13,12 @@ BZ2ParserState::BZ2ParserState(const char * _filename
   ) : f(NULL)
     , fPosition(0)
     , eof(false)
+    , codecKnown(false)
+    , codec(CAM_CODEC_BZIP2)
+    , lzBlock(NULL)
+    , lzCompressed(NULL)
+    , lzPosition(0)
+    , lzLength(0)
     , bzf(NULL)
     , unused(malloc(BZ_MAX_UNUSED))
     , nUnused(0)
@@ -33,6 +39,13 @@ BZ2ParserState::BZ2ParserState(const char * _filename
 BZ2ParserState::~BZ2ParserState(){
   free(filename);
   free(unused);
+  free(lzBlock);
+  free(lzCompressed);
+}
+
+/* Nothing is left buffered between the file and the scanner */
+bool BZ2ParserState::drained(){
+  return nUnused == 0 && bzf == NULL && lzPosition == lzLength;
 }
 
 int BZ2ParserState::doLexing(int bufLength){
@@ -48,7 +61,7 @@ int BZ2ParserState::doLexing(int bufLength){
   else{
     activeParser = false;
     delete_buffer(yybuf);
-    if((eof || feof(f)) && nUnused == 0 && bzf == NULL)
+    if((eof || feof(f)) && drained())
       return 0;
     else
       return 1;
@@ -63,6 +76,17 @@ void BZ2ParserState::openFile(){
     abort();
   }
   fseeko(f, fPosition, SEEK_SET);
+  if(!codecKnown)
+    detectCodec();
+}
+
+void BZ2ParserState::detectCodec(){
+  char header[TRACE_LZ_MAGIC_LENGTH];
+  size_t n = fread(header, 1, sizeof(header), f);
+  codec = traceCodecFromHeader(header, n);
+  codecKnown = true;
+  clearerr(f);
+  fseeko(f, fPosition, SEEK_SET);
 }
 
 void BZ2ParserState::closeFile(){
@@ -78,42 +102,30 @@ int BZ2ParserState::parseBlock2(){
   if(activeParser){
     return doLexing();
   }
-  else if(!(eof && nUnused == 0 && bzf == NULL)){
+  else if(!(eof && drained())){
     /* copy any remaining chars into buf */
     memcpy(buf, remainder, rem);
-    /* If there is no stream open, open a new stream */
-    if(bzf == NULL){
-      bzf = BZ2_bzReadOpen(&status, f, 0, 0, unused, nUnused);
-      if(status != BZ_OK){
-        cout << "Error opening for decompression: " << filename << " ( error:" << status << " ) " << endl;
-        abort();
-      }
-      if(*(FILE**)bzf != f){
-        cout << "bzf format not as expected\n";
-        abort();
-      }
-    }
-    /* This is a horrible hack due to the fact that f must be closed and reopened while 
-     * the compression stream remains open. There is no way in the bzlib API to bind the reopened
-     * file stream to the open compression stream so I do so manually here. Hopefully the format
-     * of BZFILE (currently has the file handle as first field) will not change.
-    */
-    (*(FILE**)bzf) = f;
     /* Fill the rest of buf with new data */
-    count = BZ2_bzRead(&status, bzf, buf + rem, BZ_BUFSIZE - rem) + rem;
-    /* Check if we reached the end of this stream */
-    if(status != BZ_OK){
-      if(status != BZ_STREAM_END){ abort(); }
-      void *unusedTemp;
-      BZ2_bzReadGetUnused(&status, bzf, &unusedTemp, &nUnused );
-      memcpy(unused, unusedTemp, nUnused);
-      if(status != BZ_OK){ abort(); }
-      BZ2_bzReadClose(&status, bzf);
-      if(status != BZ_OK){ abort(); }
-      bzf = NULL;
-      if(count == 0) //empty stream
-        return 1;
+    size_t n;
+    switch(codec){
+      case CAM_CODEC_RAW:
+        n = fread(buf + rem, 1, BZ_BUFSIZE - rem, f);
+        break;
+      case CAM_CODEC_LZ:
+        n = readLZ(buf + rem, BZ_BUFSIZE - rem);
+        break;
+      default:
+        n = readBZ2(buf + rem, BZ_BUFSIZE - rem);
+        /* Check if we reached the end of an empty stream */
+        if(n == 0 && bzf == NULL && rem == 0)
+          return 1;
+        break;
     }
+    if(n == 0 && codec != CAM_CODEC_BZIP2){
+      /* End of file, the remainder is parsed by the next call */
+      return 1;
+    }
+    count = n + rem;
     /* Find a token to split on near the back and copy the remainder */
     rem = 1;
     while(buf[count - rem] != ' ' && buf[count-rem] != ')' && buf[count-rem] != ',' && buf[count-rem] != '\n'){
@@ -137,6 +149,126 @@ int BZ2ParserState::parseBlock2(){
   }
 }
 
+/**
+ * Read the next decompressed bytes of the current bzip2 stream, opening a new
+ * stream if needed.
+ **/
+size_t BZ2ParserState::readBZ2(char *dst, size_t length){
+  /* If there is no stream open, open a new stream */
+  if(bzf == NULL){
+    bzf = BZ2_bzReadOpen(&status, f, 0, 0, unused, nUnused);
+    if(status != BZ_OK){
+      cout << "Error opening for decompression: " << filename << " ( error:" << status << " ) " << endl;
+      abort();
+    }
+    if(*(FILE**)bzf != f){
+      cout << "bzf format not as expected\n";
+      abort();
+    }
+  }
+  /* This is a horrible hack due to the fact that f must be closed and reopened while 
+   * the compression stream remains open. There is no way in the bzlib API to bind the reopened
+   * file stream to the open compression stream so I do so manually here. Hopefully the format
+   * of BZFILE (currently has the file handle as first field) will not change.
+  */
+  (*(FILE**)bzf) = f;
+  size_t n = BZ2_bzRead(&status, bzf, dst, length);
+  /* Check if we reached the end of this stream */
+  if(status != BZ_OK){
+    if(status != BZ_STREAM_END){ abort(); }
+    void *unusedTemp;
+    BZ2_bzReadGetUnused(&status, bzf, &unusedTemp, &nUnused );
+    memcpy(unused, unusedTemp, nUnused);
+    if(status != BZ_OK){ abort(); }
+    BZ2_bzReadClose(&status, bzf);
+    if(status != BZ_OK){ abort(); }
+    bzf = NULL;
+  }
+  return n;
+}
+
+/**
+ * Decompress an LZ block (see TraceCodec.h) and return its length.
+ **/
+static size_t lzDecompress(const char *src, size_t length, char *dst, size_t dstLength){
+  const unsigned char *ip = (const unsigned char *)src;
+  const unsigned char *end = ip + length;
+  size_t op = 0;
+
+  while(ip < end){
+    unsigned char token = *ip++;
+    size_t numLiterals = token >> 4;
+    if(numLiterals == 15){
+      unsigned char b;
+      do{ b = *ip++; numLiterals += b; } while(b == 255 && ip < end);
+    }
+    if(numLiterals > (size_t)(end - ip) || numLiterals > dstLength - op){
+      cerr << "Corrupted LZ block\n";
+      abort();
+    }
+    memcpy(dst + op, ip, numLiterals);
+    ip += numLiterals;
+    op += numLiterals;
+    /* The last sequence has no match */
+    if(ip >= end)
+      break;
+    size_t offset = ip[0] | (ip[1] << 8);
+    ip += 2;
+    size_t matchLength = (token & 15);
+    if(matchLength == 15){
+      unsigned char b;
+      do{ b = *ip++; matchLength += b; } while(b == 255 && ip < end);
+    }
+    matchLength += TRACE_LZ_MIN_MATCH;
+    if(offset == 0 || offset > op || matchLength > dstLength - op){
+      cerr << "Corrupted LZ block\n";
+      abort();
+    }
+    /* Byte by byte, matches may overlap their own output */
+    for(size_t i = 0; i < matchLength; i++, op++)
+      dst[op] = dst[op - offset];
+  }
+  return op;
+}
+
+/**
+ * Read the next decompressed bytes, decompressing the next block if the
+ * current one has been consumed.
+ **/
+size_t BZ2ParserState::readLZ(char *dst, size_t length){
+  if(lzPosition == lzLength){
+    TraceLZBlockHeader header;
+    if(fread(&header, sizeof(header), 1, f) != 1)
+      return 0;
+    if(memcmp(header.magic, TRACE_LZ_MAGIC, TRACE_LZ_MAGIC_LENGTH) != 0
+       || header.rawLength > TRACE_LZ_BLOCK_SIZE
+       || header.compressedLength > TRACE_LZ_BOUND(TRACE_LZ_BLOCK_SIZE)){
+      cerr << "Bad LZ block in " << filename << endl;
+      abort();
+    }
+    if(lzBlock == NULL){
+      lzBlock = (char *)malloc(TRACE_LZ_BLOCK_SIZE);
+      lzCompressed = (char *)malloc(TRACE_LZ_BOUND(TRACE_LZ_BLOCK_SIZE));
+    }
+    if(fread(lzCompressed, 1, header.compressedLength, f) != header.compressedLength){
+      cerr << "Truncated LZ block in " << filename << endl;
+      abort();
+    }
+    lzLength = lzDecompress(lzCompressed, header.compressedLength, lzBlock, TRACE_LZ_BLOCK_SIZE);
+    lzPosition = 0;
+    if(lzLength != header.rawLength){
+      cerr << "Bad LZ block in " << filename << endl;
+      abort();
+    }
+  }
+  size_t n = lzLength - lzPosition;
+  if(n > length)
+    n = length;
+  memcpy(dst, lzBlock + lzPosition, n);
+  lzPosition += n;
+  return n;
+}
+
 int BZ2ParserState::parseBlock(){
   openFile();
   int res = parseBlock2();
@@ -3,6 +3,7 @@
 
 #include <sys/types.h>
 #include <bzlib.h>
+#include "TraceCodec.h"
 //#include "memory_trace_parser.h"
 
 #define BZ_BUFSIZE 1000000
@@ -84,11 +85,22 @@ struct yy_buffer_state
 #endif /* !YY_STRUCT_YY_BUFFER_STATE */
 
 
+/**
+ * Parses a trace file in chunks with a flex scanner.  Despite the name, any of
+ * the trace codecs is accepted: the container is recognised from the first
+ * bytes of the file.
+ **/
 class BZ2ParserState{
   char * filename;
   FILE *f;
   off_t fPosition;
   bool eof;
+  bool codecKnown;
+  cam_codec_t codec;
+  char *lzBlock;
+  char *lzCompressed;
+  size_t lzPosition;
+  size_t lzLength;
   BZFILE *bzf;
   void *unused;
   int nUnused;
@@ -107,6 +119,10 @@ class BZ2ParserState{
 
   int doLexing(int bufLength = 0);
   int parseBlock2();
+  bool drained();
+  void detectCodec();
+  size_t readBZ2(char *dst, size_t length);
+  size_t readLZ(char *dst, size_t length);
   void openFile();
   void closeFile();
 
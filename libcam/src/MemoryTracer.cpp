@@ -1,6 +1,7 @@
-#include <bzlib.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <assert.h>
+#include <pthread.h>
 #define __STDC_FORMAT_MACROS
 #include <inttypes.h>
 
@@ -11,10 +12,12 @@
 #include "MemoryTracer.h"
 #include "memory_allocator.hh"
 #include "TimeoutCounter.h"
+#include "TraceStream.h"
 
+#include <deque>
 #include <fstream>
 #include <iostream>
-#include <map>
+#include <unordered_map>
 #include <vector>
 
 using namespace std;
@@ -25,18 +28,30 @@ using namespace std;
  **/
 #define LIBCAM_DEFAULT_MAX_MEM_USAGE ((JITUINT64)1073741824ULL)
 
+/**
+ * Number of interrupted patterns remembered by every memory set, so that an
+ * access stream broken by a few stray accesses can be resumed.
+ **/
+#define LIBCAM_MEM_TRACE_LOOKBACK 4
+
 class TracerMemSetEntry {
   uintptr_t base;
   intptr_t stride;
   uint64_t length;
   uint64_t start;
   uint64_t end;
+  /* Rows of a nested pattern: row i starts at base + i*outerStride */
+  intptr_t outerStride;
+  uint64_t outerCount;
 public:
   void init(uintptr_t b, intptr_t s, uint64_t l, uint64_t st, uint64_t e);
 
   /* Return the next address as predicted by the pattern */
   uintptr_t prediction();
 
+  /* True if the stride has been decided, i.e. the next access can be matched */
+  bool isEstablished() const;
+
   uintptr_t getBase() const;
   intptr_t getStride() const;
   uintptr_t getLength() const;
@@ -48,84 +63,199 @@ public:
   void setStart(uint64_t);
   void setEnd(uint64_t);
 
+  intptr_t getOuterStride() const;
+  uint64_t getOuterCount() const;
+
   uintptr_t getNumInstances();
+  uint64_t getRowInstances();
   void incEnd();
-  void dumpInitialEntry(BZFILE *compressedFile);
-  void dumpEntry(BZFILE *compressedFile, TracerMemSetEntry* prev);
+
+  /* Append row, which has the same shape, as the next row of the pattern */
+  bool foldRow(TracerMemSetEntry *row);
+  void dumpOuterPattern(TraceStream *stream);
+  void dumpInitialEntry(TraceStream *stream);
+  void dumpEntry(TraceStream *stream, TracerMemSetEntry* prev);
 };
 
 
+class MemTraceMemory : public CamMemoryAllocator
+{
+  JITUINT64 dumpTraceMemUsage;   /**< Memory size trigger for dumping the trace. */
+
+public:
+  MemTraceMemory()
+    : dumpTraceMemUsage(LIBCAM_DEFAULT_MAX_MEM_USAGE)
+  {
+    char *env = getenv("LIBCAM_MEM_TRACE_MAX_MEM_USAGE");
+    if (env) {
+      dumpTraceMemUsage = atoi(env);
+    }
+  }
+
+  bool mustDumpTrace(void) { return memUsed > dumpTraceMemUsage; }
+};
+
+
+/**
+ * Next address, stride and length of a pattern that has been interrupted.
+ **/
+struct TracerInterruptedPattern {
+  uintptr_t next;
+  intptr_t stride;
+  uint64_t length;
+};
+
 class TracerMemSet : public std::vector<TracerMemSetEntry *>{
+  MemTraceMemory *allocator;
+  TracerInterruptedPattern lookback[LIBCAM_MEM_TRACE_LOOKBACK];
+  unsigned int lookbackNext;
+
+  /* Close the last entry and start a new one from addr */
+  void startEntry(uintptr_t addr, uint64_t len);
+  void foldLastRow();
+  void rememberPattern(TracerMemSetEntry *entry);
+  TracerInterruptedPattern *findPattern(uintptr_t addr, uint64_t len);
 public:
+  TracerMemSet(MemTraceMemory *a) : allocator(a), lookbackNext(0) {
+    memset(lookback, 0, sizeof(lookback));
+  }
   ~TracerMemSet();
   void newMemSetEntry(uintptr_t b, intptr_t s, uint64_t l, uint64_t st, uint64_t e);
   void recordMemoryReference(uintptr_t addr, uint64_t len);
-  void dumpSet(BZFILE *compressedFile);
+  void dumpSet(TraceStream *stream);
 };
 
 class TracerStaticInstRec {
   TracerMemSet readSet;
   TracerMemSet writeSet;
 public:
+  TracerStaticInstRec(MemTraceMemory *allocator) : readSet(allocator), writeSet(allocator) {}
   TracerMemSet &getReadSet();
   TracerMemSet &getWriteSet();
-  void dumpRecord(BZFILE *compressedFile);
-  void dumpReadSet(BZFILE *compressedFile);
-  void dumpWriteSet(BZFILE *compressedFile);
+  void dumpRecord(TraceStream *stream);
+  void dumpReadSet(TraceStream *stream);
+  void dumpWriteSet(TraceStream *stream);
 };
 
 
-class TracerMemoryTrace : public std::map<uintptr_t, TracerStaticInstRec *>{
-  string outputDirectory;
+/**
+ * Dense indices of the traced instructions.  Instructions are registered once,
+ * normally when they are instrumented, so that recording an access only has to
+ * index a vector.  Indices are never recycled, so they stay valid across
+ * CAM_init/CAM_shutdown cycles.
+ **/
+class TracerInstructionIndices {
+  pthread_mutex_t lock;
+  vector<inst_id_t> instructions;                 /**< Instruction ID of each index. */
+  unordered_map<inst_id_t, inst_index_t> indices; /**< Index of each instruction ID. */
 public:
-  TracerMemoryTrace() : outputDirectory(".") {
-    char *env = getenv("LIBCAM_OUTPUT_DIRECTORY");
-    if (env) {
-      outputDirectory = env;
-    }
-    // Ensure the memtrace directory exists and is empty
-    if(system(("mkdir -p " + outputDirectory + "/memory_accesses").c_str())){ cerr << "mkdir memory_accesses failed\n"; abort(); }
-    if(system(("rm -f " + outputDirectory + "/memory_accesses/memory_accesses.*.*.txt.bz2").c_str())) { cerr << "clean memory_accesses failed\n"; abort(); }
-  }
+  TracerInstructionIndices() { pthread_mutex_init(&lock, NULL); }
+  ~TracerInstructionIndices() { pthread_mutex_destroy(&lock); }
+  inst_index_t registerInstruction(inst_id_t id);
+  inst_id_t getID(inst_index_t index);
+};
+
+
+/**
+ * Memory accesses of a single thread, indexed by instruction index.  Only the
+ * owning thread records into it, so no lock is taken on the fast path.  Each
+ * thread owns two of them: while one is handed to the writer thread, the
+ * thread keeps recording into its partner.
+ **/
+class TracerMemoryTrace : public std::vector<TracerStaticInstRec *>{
+  MemTraceMemory allocator;                       /**< Memory used by this buffer's records. */
+  unordered_map<inst_id_t, inst_index_t> indices; /**< Indices already looked up by CAM_mem. */
+  TracerMemoryTrace *partner;                     /**< The other buffer of the same thread. */
+  bool pending;                                   /**< Queued for the writer thread. */
+public:
+  TracerMemoryTrace() : partner(NULL), pending(false) {}
   ~TracerMemoryTrace();
-  void dumpMemoryTrace(void);
+  TracerStaticInstRec *getRecord(inst_index_t index);
+  TracerStaticInstRec *findRecord(inst_index_t index) const;
+  inst_index_t getIndex(inst_id_t id);
+  bool mustDumpTrace(void) { return allocator.mustDumpTrace(); }
+  TracerMemoryTrace *getPartner(void) { return partner; }
+  void setPartner(TracerMemoryTrace *p) { partner = p; }
+  bool isPending(void) { return pending; }
+  void setPending(bool p) { pending = p; }
   void clear();
-  string getOutputDirectory(){ return outputDirectory; }
 };
 
 
-class MemTraceMemory : public CamMemoryAllocator
-{
-  JITUINT64 dumpTraceMemUsage;   /**< Memory size trigger for dumping the trace. */
-
+/**
+ * The traces of all threads.  Full buffers are written by a background thread
+ * so that the traced program only stalls if it fills a buffer before the
+ * writer has emptied the previous one.  At shutdown the writer is drained and
+ * the remaining buffers of all threads are merged into a single stream per
+ * file.  The codec is chosen with LIBCAM_MEM_TRACE_CODEC (bzip2, lz or raw).
+ **/
+class TracerMemoryTraces {
+  string outputDirectory;
+  cam_codec_t codec;
+  pthread_mutex_t lock;
+  pthread_cond_t pendingCond;               /**< Signalled when a buffer is queued. */
+  pthread_cond_t writtenCond;               /**< Signalled when a buffer has been written. */
+  pthread_t writer;
+  bool stopWriter;
+  bool writerExited;                        /**< The writer has written every queued buffer and returned. */
+  bool recorded;                            /**< Some access has been written. */
+  deque<TracerMemoryTrace *> pendingTraces; /**< Full buffers, oldest first. */
+  vector<TracerMemoryTrace *> threadTraces;
 public:
-  MemTraceMemory()
-    : dumpTraceMemUsage(LIBCAM_DEFAULT_MAX_MEM_USAGE)
-  {
-    char *env = getenv("LIBCAM_MEM_TRACE_MAX_MEM_USAGE");
+  TracerMemoryTraces() : outputDirectory("."), stopWriter(false), writerExited(false), recorded(false) {
+    char *env = getenv("LIBCAM_OUTPUT_DIRECTORY");
     if (env) {
-      dumpTraceMemUsage = atoi(env);
+      outputDirectory = env;
     }
+    codec = traceCodecFromName(getenv("LIBCAM_MEM_TRACE_CODEC"));
+    // Ensure the memtrace directory exists and is empty
+    if(system(("mkdir -p " + outputDirectory + "/memory_accesses").c_str())){ cerr << "mkdir memory_accesses failed\n"; abort(); }
+    if(system(("rm -f " + outputDirectory + "/memory_accesses/memory_accesses.*.*.txt*").c_str())) { cerr << "clean memory_accesses failed\n"; abort(); }
+    pthread_mutex_init(&lock, NULL);
+    pthread_cond_init(&pendingCond, NULL);
+    pthread_cond_init(&writtenCond, NULL);
+    if (pthread_create(&writer, NULL, writerThread, this)) { cerr << "LIBCAM: cannot create the memory trace writer\n"; abort(); }
   }
-
-  void checkDumpTrace(void);
+  ~TracerMemoryTraces();
+  TracerMemoryTrace *newThreadTrace(void);
+  TracerMemoryTrace *swapThreadTrace(TracerMemoryTrace *trace);
+  bool dumpMemoryTrace(void);
+  string getOutputDirectory(){ return outputDirectory; }
+private:
+  static void *writerThread(void *arg);
+  void stopWriterThread(void);
+  void writeThreadTrace(TracerMemoryTrace *trace);
+  string getFileName(inst_id_t id, const char *kind);
 };
 
 
-static TracerMemoryTrace *memoryTrace = NULL;
-static MemTraceMemory *memoryAllocator = NULL;
+static TracerInstructionIndices instructionIndices;
+static TracerMemoryTraces *memoryTraces = NULL;
 static TimeoutCounter *timeoutCounter = NULL;
 
+/**
+ * Trace of the calling thread.  It belongs to the current run only when its
+ * generation matches the global one, which is bumped by every initialisation.
+ **/
+static JITUINT32 traceGeneration = 0;
+static __thread TracerMemoryTrace *threadTrace = NULL;
+static __thread JITUINT32 threadTraceGeneration = 0;
+
 void
 TracerMemSetEntry::init(uintptr_t b, intptr_t s, uint64_t l, uint64_t st, uint64_t e)
 {
   base = b; stride = s; length = l; start = st; end = e;
+  outerStride = 0; outerCount = 1;
 }
 
 uintptr_t TracerMemSetEntry::prediction(){
   return base + stride*getNumInstances();
 }
 
+bool TracerMemSetEntry::isEstablished() const {
+  return start != end || stride != 0;
+}
+
 uintptr_t TracerMemSetEntry::getBase() const { return base; }
 intptr_t TracerMemSetEntry::getStride() const { return stride; }
 uintptr_t TracerMemSetEntry::getLength() const { return length; }
@@ -137,24 +267,93 @@ void TracerMemSetEntry::setLength(uint64_t x) { length = x; }
 void TracerMemSetEntry::setStart(uint64_t x) { start = x; }
 void TracerMemSetEntry::setEnd(uint64_t x) { end = x; }
 
+intptr_t TracerMemSetEntry::getOuterStride() const { return outerStride; }
+uint64_t TracerMemSetEntry::getOuterCount() const { return outerCount; }
+
 uintptr_t TracerMemSetEntry::getNumInstances(){
   return end - start + 1;
 }
+uint64_t TracerMemSetEntry::getRowInstances(){
+  return getNumInstances() / outerCount;
+}
 void TracerMemSetEntry::incEnd() { end++; }
 
+bool TracerMemSetEntry::foldRow(TracerMemSetEntry *row){
+  if (row->stride != stride || row->length != length || row->getNumInstances() != getRowInstances()) {
+    return false;
+  }
+  if (outerCount == 1) {
+    /* The second row decides the outer stride */
+    outerStride = row->base - base;
+  } else if (row->base != base + outerStride*outerCount) {
+    return false;
+  }
+  outerCount++;
+  end = row->end;
+  return true;
+}
+
 TracerMemSet::~TracerMemSet(){
   for(TracerMemSet::const_iterator i = begin(); i != end(); i++) {
-    memoryAllocator->deleteMem(*i);
+    allocator->deleteMem(*i);
   }
   erase(begin(), end());
 }
 
 void TracerMemSet::newMemSetEntry(uintptr_t b, intptr_t s, uint64_t l, uint64_t st, uint64_t e){
-    TracerMemSetEntry *entry = memoryAllocator->newMem<TracerMemSetEntry>();
+    TracerMemSetEntry *entry = allocator->newMem<TracerMemSetEntry>();
     entry->init(b, s, l, st, e);
     push_back(entry);
 }
 
+/* If the last entry is the next row of the one before it, merge the two */
+void TracerMemSet::foldLastRow(){
+  if (size() < 2) {
+    return;
+  }
+  TracerMemSetEntry *row = back();
+  if ((*this)[size() - 2]->foldRow(row)) {
+    pop_back();
+    allocator->deleteMem(row);
+  }
+}
+
+void TracerMemSet::rememberPattern(TracerMemSetEntry *entry){
+  TracerInterruptedPattern *p = &lookback[lookbackNext];
+  p->next = entry->prediction();
+  p->stride = entry->getStride();
+  p->length = entry->getLength();
+  lookbackNext = (lookbackNext + 1) % LIBCAM_MEM_TRACE_LOOKBACK;
+}
+
+TracerInterruptedPattern *TracerMemSet::findPattern(uintptr_t addr, uint64_t len){
+  for (unsigned int i = 0; i < LIBCAM_MEM_TRACE_LOOKBACK; i++) {
+    if (lookback[i].length == len && lookback[i].next == addr) {
+      return &lookback[i];
+    }
+  }
+  return NULL;
+}
+
+void TracerMemSet::startEntry(uintptr_t addr, uint64_t len){
+  TracerMemSetEntry *prev = back();
+  uint64_t instance = prev->getEnd() + 1;
+  intptr_t stride = 0;
+
+  if (prev->isEstablished()) {
+    rememberPattern(prev);
+  }
+  foldLastRow();
+
+  /* Resume an interrupted pattern if addr is its next access */
+  TracerInterruptedPattern *p = findPattern(addr, len);
+  if (p != NULL) {
+    stride = p->stride;
+    p->length = 0;
+  }
+  newMemSetEntry(addr, stride, len, instance, instance);
+}
+
 void TracerMemSet::recordMemoryReference(uintptr_t addr, uint64_t len){
   if (size() == 0) {
     newMemSetEntry(addr, 0, len, 0, 0);
@@ -162,19 +361,24 @@ void TracerMemSet::recordMemoryReference(uintptr_t addr, uint64_t len){
     TracerMemSetEntry *prev = back();
     if (prev->getLength() != len) {
       /* Data widths do not match, a new pattern must be started */
-      newMemSetEntry(addr, 0, len, prev->getEnd() + 1, prev->getEnd() + 1);
+      startEntry(addr, len);
     }
-    else if(prev->getStart() == prev->getEnd()){
-      /* prev is the first entry for this pattern, establish the stride */
-      prev->setStride(addr - prev->getBase());
-      prev->incEnd();
+    else if(!prev->isEstablished()){
+      /* prev is the first entry for this pattern: it was a stray access if
+       * addr continues an interrupted pattern, otherwise establish the stride */
+      if (findPattern(addr, len) != NULL) {
+        startEntry(addr, len);
+      } else {
+        prev->setStride(addr - prev->getBase());
+        prev->incEnd();
+      }
     }
     else{
       /* A pattern is already established, check if we can match it */
       if(prev->prediction() == addr)
         prev->incEnd();
       else {
-        newMemSetEntry(addr, 0, len, prev->getEnd() + 1, prev->getEnd() + 1);
+        startEntry(addr, len);
       }
     }
   }
@@ -184,175 +388,431 @@ TracerMemSet &TracerStaticInstRec::getReadSet() { return readSet; }
 TracerMemSet &TracerStaticInstRec::getWriteSet() { return writeSet; }
 
 
+inst_index_t
+TracerInstructionIndices::registerInstruction(inst_id_t id)
+{
+  inst_index_t index;
+
+  pthread_mutex_lock(&lock);
+  unordered_map<inst_id_t, inst_index_t>::const_iterator i = indices.find(id);
+  if (i == indices.end()) {
+    index = instructions.size();
+    instructions.push_back(id);
+    indices[id] = index;
+  } else {
+    index = i->second;
+  }
+  pthread_mutex_unlock(&lock);
+  return index;
+}
+
+inst_id_t
+TracerInstructionIndices::getID(inst_index_t index)
+{
+  inst_id_t id;
+
+  pthread_mutex_lock(&lock);
+  assert(index < instructions.size());
+  id = instructions[index];
+  pthread_mutex_unlock(&lock);
+  return id;
+}
+
+
 TracerMemoryTrace::~TracerMemoryTrace()
 {
+  clear();
+}
+
+inline TracerStaticInstRec *
+TracerMemoryTrace::getRecord(inst_index_t index)
+{
+  if (index >= size()) {
+    resize(index + 1, NULL);
+  }
+  TracerStaticInstRec *rec = (*this)[index];
+  if (rec == NULL) {
+    rec = allocator.newMem<TracerStaticInstRec>(&allocator);
+    (*this)[index] = rec;
+  }
+  return rec;
+}
+
+TracerStaticInstRec *
+TracerMemoryTrace::findRecord(inst_index_t index) const
+{
+  if (index >= size()) {
+    return NULL;
+  }
+  return (*this)[index];
 }
 
+inst_index_t
+TracerMemoryTrace::getIndex(inst_id_t id)
+{
+  unordered_map<inst_id_t, inst_index_t>::const_iterator i = indices.find(id);
+  if (i != indices.end()) {
+    return i->second;
+  }
+  inst_index_t index = instructionIndices.registerInstruction(id);
+  indices[id] = index;
+  return index;
+}
 
+
+/**
+ * Free the records but keep the slots: the same instructions are likely to be
+ * traced again after a dump.
+ **/
 void
 TracerMemoryTrace::clear(void)
 {
-  for(TracerMemoryTrace::const_iterator i = begin(); i != end(); i++) {
-    memoryAllocator->deleteMem(i->second);
+  for(TracerMemoryTrace::iterator i = begin(); i != end(); i++) {
+    if (*i != NULL) {
+      allocator.deleteMem(*i);
+      *i = NULL;
+    }
   }
-  erase(begin(), end());
 }
 
 
+/* Nested patterns are prefixed by "x outerStride outerCount", their count is the one of a row */
 void
-TracerMemSetEntry::dumpInitialEntry(BZFILE *compressedFile)
+TracerMemSetEntry::dumpOuterPattern(TraceStream *stream)
 {
   char buf[DIM_BUF];
-  snprintf(buf, DIM_BUF, "%"PRIuPTR " %"PRIdPTR " %"PRIu64 " %"PRIu64 ",", base, stride, length, end - start + 1);
-  writeCompressedFile(compressedFile, buf);
+  if (outerCount > 1) {
+    snprintf(buf, DIM_BUF, "x %"PRIdPTR " %"PRIu64 " ", outerStride, outerCount);
+    stream->write(buf);
+  }
 }
 
 void
-TracerMemSetEntry::dumpEntry(BZFILE *compressedFile, TracerMemSetEntry* prev)
+TracerMemSetEntry::dumpInitialEntry(TraceStream *stream)
 {
   char buf[DIM_BUF];
-  snprintf(buf, DIM_BUF, "%"PRIdPTR " %"PRIdPTR " %"PRIu64 " %"PRIu64 ",", (intptr_t)(base) - (intptr_t)(prev->base), stride, length, end - start + 1);
-  writeCompressedFile(compressedFile, buf);
+  dumpOuterPattern(stream);
+  snprintf(buf, DIM_BUF, "%"PRIuPTR " %"PRIdPTR " %"PRIu64 " %"PRIu64 ",", base, stride, length, getRowInstances());
+  stream->write(buf);
+}
+
+void
+TracerMemSetEntry::dumpEntry(TraceStream *stream, TracerMemSetEntry* prev)
+{
+  char buf[DIM_BUF];
+  dumpOuterPattern(stream);
+  snprintf(buf, DIM_BUF, "%"PRIdPTR " %"PRIdPTR " %"PRIu64 " %"PRIu64 ",", (intptr_t)(base) - (intptr_t)(prev->base), stride, length, getRowInstances());
+  stream->write(buf);
 }
 
 
 void
-TracerMemSet::dumpSet(BZFILE *compressedFile)
+TracerMemSet::dumpSet(TraceStream *stream)
 {
   char buf[DIM_BUF];
+  foldLastRow();
   snprintf(buf, DIM_BUF, "%zu ", size());
-  writeCompressedFile(compressedFile, buf);
+  stream->write(buf);
   if(!empty()){
-    front()->dumpInitialEntry(compressedFile);
+    front()->dumpInitialEntry(stream);
     for(const_iterator i = next(begin(), 1); i != end(); i++) {
-      (*i)->dumpEntry(compressedFile, *next(i, -1));
+      (*i)->dumpEntry(stream, *next(i, -1));
     }
   }
   snprintf(buf, DIM_BUF, "\n");
-  writeCompressedFile(compressedFile, buf);
+  stream->write(buf);
 }
 
 
 void
-TracerStaticInstRec::dumpRecord(BZFILE *compressedFile)
+TracerStaticInstRec::dumpRecord(TraceStream *stream)
 {
-  readSet.dumpSet(compressedFile);
-  writeSet.dumpSet(compressedFile);
+  readSet.dumpSet(stream);
+  writeSet.dumpSet(stream);
 }
 
 void
-TracerStaticInstRec::dumpReadSet(BZFILE *compressedFile)
+TracerStaticInstRec::dumpReadSet(TraceStream *stream)
 {
-  readSet.dumpSet(compressedFile);
+  readSet.dumpSet(stream);
 }
 
 void
-TracerStaticInstRec::dumpWriteSet(BZFILE *compressedFile)
+TracerStaticInstRec::dumpWriteSet(TraceStream *stream)
+{
+  writeSet.dumpSet(stream);
+}
+
+static void
+dumpReadTrace(TraceStream *stream, inst_id_t id, TracerStaticInstRec *rec)
 {
-  writeSet.dumpSet(compressedFile);
+  char buf[DIM_BUF];
+  snprintf(buf, DIM_BUF, "%"PRIuPTR"\n", id);
+  stream->write(buf);
+  rec->dumpReadSet(stream);
+  snprintf(buf, DIM_BUF, "0\n");
+  stream->write(buf);
 }
 
-pair<FILE *, BZFILE *> openCompressedStream(string filename){
-  /* Open file for appending */
-  FILE *f = fopen(filename.c_str(), "a");
-  if (!f) {
-    perror("Error opening file: ");
-    abort();
+static void
+dumpWriteTrace(TraceStream *stream, inst_id_t id, TracerStaticInstRec *rec)
+{
+  char buf[DIM_BUF];
+  snprintf(buf, DIM_BUF, "%"PRIuPTR"\n", id);
+  stream->write(buf);
+  snprintf(buf, DIM_BUF, "0\n");
+  stream->write(buf);
+  rec->dumpWriteSet(stream);
+}
+
+
+TracerMemoryTraces::~TracerMemoryTraces()
+{
+  stopWriterThread();
+  for(vector<TracerMemoryTrace *>::const_iterator t = threadTraces.begin(); t != threadTraces.end(); t++) {
+    delete *t;
   }
+  pthread_cond_destroy(&writtenCond);
+  pthread_cond_destroy(&pendingCond);
+  pthread_mutex_destroy(&lock);
+}
 
-  /* Prepare to write compressed data */
-  int status;
-  BZFILE *bzf = BZ2_bzWriteOpen(&status, f, 9, 0, 250);
-  if (status != BZ_OK) {
-    if(status == BZ_MEM_ERROR)
-      cerr << "BZ2: Cannot allocate memory\n";
-    abort();
+/**
+ * Create the two buffers of a new thread and return the first one.
+ **/
+TracerMemoryTrace *
+TracerMemoryTraces::newThreadTrace(void)
+{
+  TracerMemoryTrace *trace = new TracerMemoryTrace();
+  TracerMemoryTrace *partner = new TracerMemoryTrace();
+  trace->setPartner(partner);
+  partner->setPartner(trace);
+  pthread_mutex_lock(&lock);
+  threadTraces.push_back(trace);
+  threadTraces.push_back(partner);
+  pthread_mutex_unlock(&lock);
+  return trace;
+}
+
+/**
+ * Queue a full buffer for the writer thread and return the buffer the thread
+ * must record into from now on, waiting for the writer to empty it if needed.
+ * Once the writer has returned, the buffer is written here and kept.
+ **/
+TracerMemoryTrace *
+TracerMemoryTraces::swapThreadTrace(TracerMemoryTrace *trace)
+{
+  TracerMemoryTrace *next = trace->getPartner();
+
+  pthread_mutex_lock(&lock);
+  if (writerExited) {
+    writeThreadTrace(trace);
+    trace->clear();
+    pthread_mutex_unlock(&lock);
+    return trace;
+  }
+  trace->setPending(true);
+  pendingTraces.push_back(trace);
+  pthread_cond_signal(&pendingCond);
+  while (next->isPending()) {
+    pthread_cond_wait(&writtenCond, &lock);
   }
-  return pair<FILE *, BZFILE *>(f, bzf);
+  pthread_mutex_unlock(&lock);
+  return next;
 }
 
-void closeCompressedStream(pair<FILE *, BZFILE *> stream){
-  /* Flush and close compressed stream (reduces memory consumption) */
-  int status;
-  BZ2_bzWriteClose(&status, stream.second, 0, NULL, NULL);
-  if(status != BZ_OK){
-    cerr << "BZ2: BZ2_bzWriteClose error: " << status << endl;
-    abort();
+void *
+TracerMemoryTraces::writerThread(void *arg)
+{
+  TracerMemoryTraces *traces = (TracerMemoryTraces *)arg;
+
+  pthread_mutex_lock(&traces->lock);
+  while (true) {
+    while (traces->pendingTraces.empty() && !traces->stopWriter) {
+      pthread_cond_wait(&traces->pendingCond, &traces->lock);
+    }
+    if (traces->pendingTraces.empty()) {
+      break;
+    }
+    TracerMemoryTrace *trace = traces->pendingTraces.front();
+    traces->pendingTraces.pop_front();
+    pthread_mutex_unlock(&traces->lock);
+
+    traces->writeThreadTrace(trace);
+    trace->clear();
+
+    pthread_mutex_lock(&traces->lock);
+    trace->setPending(false);
+    pthread_cond_broadcast(&traces->writtenCond);
   }
-  fclose(stream.first);
+  traces->writerExited = true;
+  pthread_mutex_unlock(&traces->lock);
+  return NULL;
 }
 
+/**
+ * Let the writer thread write the buffers already queued and wait for it.
+ **/
 void
-TracerMemoryTrace::dumpMemoryTrace(void)
+TracerMemoryTraces::stopWriterThread(void)
 {
-  char buf[DIM_BUF];
+  pthread_mutex_lock(&lock);
+  if (stopWriter) {
+    pthread_mutex_unlock(&lock);
+    return;
+  }
+  stopWriter = true;
+  pthread_cond_signal(&pendingCond);
+  pthread_mutex_unlock(&lock);
+  pthread_join(writer, NULL);
+}
+
+string
+TracerMemoryTraces::getFileName(inst_id_t id, const char *kind)
+{
+  return outputDirectory + "/memory_accesses/memory_accesses." + to_string(id) + "." + kind + traceCodecSuffix(codec);
+}
+
+
+/**
+ * Append a buffer to the files.  Only the writer thread writes files while
+ * the program runs; once it has returned, threads that fill a buffer write it
+ * while holding the lock.
+ **/
+void
+TracerMemoryTraces::writeThreadTrace(TracerMemoryTrace *trace)
+{
+  for(inst_index_t index = 0; index < trace->size(); index++) {
+    TracerStaticInstRec *rec = (*trace)[index];
+    if (rec == NULL) {
+      continue;
+    }
+    inst_id_t id = instructionIndices.getID(index);
+    recorded = true;
 
-  /* Dump the trace. */
-  for(TracerMemoryTrace::const_iterator i = begin(); i != end(); i++) {
-    
     /* Dump read trace */
-    if(i->second->getReadSet().size() > 0){
-      pair<FILE *, BZFILE*> stream = openCompressedStream(
-        outputDirectory + "/memory_accesses/memory_accesses." + to_string(i->first) + ".r.txt.bz2");
-      /* Write compressed data */
-      snprintf(buf, DIM_BUF, "%"PRIuPTR"\n", i->first);
-      writeCompressedFile(stream.second, buf);
-      i->second->dumpReadSet(stream.second);
-      snprintf(buf, DIM_BUF, "0\n");
-      writeCompressedFile(stream.second, buf);
-      closeCompressedStream(stream);
+    if(rec->getReadSet().size() > 0){
+      TraceStream *stream = TraceStream::open(getFileName(id, "r"), codec);
+      dumpReadTrace(stream, id, rec);
+      stream->close();
+      delete stream;
     }
     /* Dump write trace */
-    if(i->second->getWriteSet().size() > 0){
-      pair<FILE *, BZFILE*> stream = openCompressedStream(
-        outputDirectory + "/memory_accesses/memory_accesses." + to_string(i->first) + ".w.txt.bz2");
-      /* Write compressed data */
-      snprintf(buf, DIM_BUF, "%"PRIuPTR"\n", i->first);
-      writeCompressedFile(stream.second, buf);
-      snprintf(buf, DIM_BUF, "0\n");
-      writeCompressedFile(stream.second, buf);
-      i->second->dumpWriteSet(stream.second);
-      closeCompressedStream(stream);
+    if(rec->getWriteSet().size() > 0){
+      TraceStream *stream = TraceStream::open(getFileName(id, "w"), codec);
+      dumpWriteTrace(stream, id, rec);
+      stream->close();
+      delete stream;
     }
   }
 }
 
 
-void
-MemTraceMemory::checkDumpTrace(void)
+/**
+ * Write the queued buffers, then merge the remaining ones of all threads.
+ * Each file gets a single stream holding one entry per buffer that recorded
+ * the instruction.  Returns false if no thread recorded anything.
+ **/
+bool
+TracerMemoryTraces::dumpMemoryTrace(void)
 {
-  // static JITNINT numDumps = 0;
-  if (memUsed > dumpTraceMemUsage) {
-    // cerr << "Dumping memory trace " << numDumps << " with allocation of " << memUsed  << endl;
-    memoryTrace->dumpMemoryTrace();
-    memoryTrace->clear();
-    // numDumps += 1;
+  inst_index_t numIndices = 0;
+
+  stopWriterThread();
+  for(vector<TracerMemoryTrace *>::const_iterator t = threadTraces.begin(); t != threadTraces.end(); t++) {
+    if ((*t)->size() > numIndices) {
+      numIndices = (*t)->size();
+    }
   }
+  for(inst_index_t index = 0; index < numIndices; index++) {
+    TraceStream *readStream = NULL;
+    TraceStream *writeStream = NULL;
+    inst_id_t id = 0;
+    bool found = false;
+
+    for(vector<TracerMemoryTrace *>::const_iterator t = threadTraces.begin(); t != threadTraces.end(); t++) {
+      TracerStaticInstRec *rec = (*t)->findRecord(index);
+      if (rec == NULL) {
+        continue;
+      }
+      if (!found) {
+        id = instructionIndices.getID(index);
+        found = true;
+        recorded = true;
+      }
+
+      /* Dump read trace */
+      if(rec->getReadSet().size() > 0){
+        if (readStream == NULL) {
+          readStream = TraceStream::open(getFileName(id, "r"), codec);
+        }
+        dumpReadTrace(readStream, id, rec);
+      }
+      /* Dump write trace */
+      if(rec->getWriteSet().size() > 0){
+        if (writeStream == NULL) {
+          writeStream = TraceStream::open(getFileName(id, "w"), codec);
+        }
+        dumpWriteTrace(writeStream, id, rec);
+      }
+    }
+    if (readStream != NULL) {
+      readStream->close();
+      delete readStream;
+    }
+    if (writeStream != NULL) {
+      writeStream->close();
+      delete writeStream;
+    }
+  }
+  for(vector<TracerMemoryTrace *>::const_iterator t = threadTraces.begin(); t != threadTraces.end(); t++) {
+    (*t)->clear();
+  }
+  return recorded;
+}
+
+
+/**
+ * Return the trace of the calling thread, creating it the first time the
+ * thread records an access in the current run.
+ **/
+static inline TracerMemoryTrace *
+getThreadTrace(void)
+{
+  if (threadTraceGeneration != traceGeneration) {
+    threadTrace = memoryTraces->newThreadTrace();
+    threadTraceGeneration = traceGeneration;
+  }
+  return threadTrace;
 }
 
 void 
 CAM_forceMemTraceDump(){
-  memoryTrace->dumpMemoryTrace();
-  memoryTrace->clear();
+  threadTrace = memoryTraces->swapThreadTrace(getThreadTrace());
 }
 
 
 /**
- * Record an instruction accessing memory.
+ * Register an instruction that will be traced.
+ **/
+inst_index_t
+CAM_registerMemInstruction(inst_id_t id)
+{
+  return instructionIndices.registerInstruction(id);
+}
+
+
+/**
+ * Record an instruction accessing memory, given its registered index.
  **/
 void
-CAM_mem(inst_id_t id, uintptr_t raddr1, uint64_t rlen1, uintptr_t raddr2, uint64_t rlen2, uintptr_t waddr, uint64_t wlen)
+CAM_memIndexed(inst_index_t index, uintptr_t raddr1, uint64_t rlen1, uintptr_t raddr2, uint64_t rlen2, uintptr_t waddr, uint64_t wlen)
 {
   if(timeoutCounter->recordOperation())
     return;
 
-  TracerStaticInstRec *rec;
-  if (memoryTrace->find(id) == memoryTrace->end()) {
-    rec = memoryAllocator->newMem<TracerStaticInstRec>();
-    (*memoryTrace)[id] = rec;
-  } else {
-    rec = (*memoryTrace)[id];
-  }
+  TracerMemoryTrace *trace = getThreadTrace();
+  TracerStaticInstRec *rec = trace->getRecord(index);
   if(rlen1 > 0) {
     rec->getReadSet().recordMemoryReference(raddr1, rlen1);
   }
@@ -362,7 +822,19 @@ CAM_mem(inst_id_t id, uintptr_t raddr1, uint64_t rlen1, uintptr_t raddr2, uint64
   if(wlen > 0) {
     rec->getWriteSet().recordMemoryReference(waddr, wlen);
   }
-  memoryAllocator->checkDumpTrace();
+  if (trace->mustDumpTrace()) {
+    threadTrace = memoryTraces->swapThreadTrace(trace);
+  }
+}
+
+
+/**
+ * Record an instruction accessing memory.
+ **/
+void
+CAM_mem(inst_id_t id, uintptr_t raddr1, uint64_t rlen1, uintptr_t raddr2, uint64_t rlen2, uintptr_t waddr, uint64_t wlen)
+{
+  CAM_memIndexed(getThreadTrace()->getIndex(id), raddr1, rlen1, raddr2, rlen2, waddr, wlen);
 }
 
 
@@ -372,8 +844,8 @@ CAM_mem(inst_id_t id, uintptr_t raddr1, uint64_t rlen1, uintptr_t raddr2, uint64
 void
 memory_trace_init(void)
 {
-  memoryAllocator = new MemTraceMemory();
-  memoryTrace = memoryAllocator->newMem<TracerMemoryTrace>();
+  memoryTraces = new TracerMemoryTraces();
+  traceGeneration++;
 
   timeoutCounter = new TimeoutCounter();
 }
@@ -385,17 +857,15 @@ memory_trace_init(void)
 void
 memory_trace_shutdown(void)
 {
-  timeoutCounter->dumpStats(memoryTrace->getOutputDirectory());
+  timeoutCounter->dumpStats(memoryTraces->getOutputDirectory());
   delete timeoutCounter;
 
-  if (memoryTrace) {
-    if(memoryTrace->size() > 0) {
-      memoryTrace->dumpMemoryTrace();
-    } else {
+  if (memoryTraces) {
+    if(!memoryTraces->dumpMemoryTrace()) {
       cerr << "LIBCAM: Memory tracer recorded no instructions\n";
     }
-    memoryAllocator->deleteMem(memoryTrace);
-    delete memoryAllocator;
+    delete memoryTraces;
+    memoryTraces = NULL;
   } else {
     cerr << "LIBCAM: Attempt to shut down non-existent memory tracer\n";
   }
@@ -25,27 +25,28 @@ public:
   TimeoutCounter(int t) 
     : initTime(time(NULL)), timeout(t), timedOut(false), numOperations(0), numOperationsAtTimeout(0), outputFileName("timeout_stats.csv") {}
 
-  bool isTimedOut(){ return timedOut; }
+  // The operations can be recorded by several threads at once, so the counters are updated atomically
+  bool isTimedOut(){ return __atomic_load_n(&timedOut, __ATOMIC_RELAXED); }
 
   void checkTime(){ 
     if(time(NULL) > initTime + timeout){
-      timedOut = true;
-      numOperationsAtTimeout = numOperations;
+      __atomic_store_n(&numOperationsAtTimeout, getNumOperations(), __ATOMIC_RELAXED);
+      __atomic_store_n(&timedOut, true, __ATOMIC_RELAXED);
     }
   }
 
-  void addOperation(){ numOperations++; }
+  uint64_t addOperation(){ return __atomic_add_fetch(&numOperations, 1, __ATOMIC_RELAXED); }
 
-  uint64_t getNumOperations() { return numOperations; }
-  uint64_t getNumOperationsAtTimeout() { return numOperationsAtTimeout; }
+  uint64_t getNumOperations() { return __atomic_load_n(&numOperations, __ATOMIC_RELAXED); }
+  uint64_t getNumOperationsAtTimeout() { return __atomic_load_n(&numOperationsAtTimeout, __ATOMIC_RELAXED); }
 
   bool recordOperation() {
-    addOperation();
+    uint64_t operations = addOperation();
     if(isTimedOut()){
       return true;
     }
     else{
-      if(numOperations % 1000000 == 0)
+      if(operations % 1000000 == 0)
         checkTime();
       return false;
     }
@@ -56,12 +57,12 @@ public:
     outputFile.open(outputDirectory + "/" + outputFileName);
     outputFile << "timeout,has_timed_out,operations_processed,total_operations\n";
     outputFile << timeout << ","
-               << timedOut << ","
-               << numOperationsAtTimeout << ","
-               << numOperations 
+               << isTimedOut() << ","
+               << getNumOperationsAtTimeout() << ","
+               << getNumOperations() 
                << endl << endl;
     outputFile.close();
-    if(timedOut){
+    if(isTimedOut()){
       cerr << "Trace timed out after " << timeout << " seconds. See timeout_stats.csv for details." << endl;
       cerr << "Timeout value can be set with LIBCAM_TIMEOUT." << endl;
     }
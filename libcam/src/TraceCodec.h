@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TRACECODEC_H
+#define TRACECODEC_H
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * Codecs of the trace files.  The content is the same text in all cases, only
+ * the container changes:
+ *   raw    plain text, appended as is.
+ *   lz     sequence of blocks, each one a TraceLZBlockHeader followed by the
+ *          block compressed with a byte-oriented LZ77 (LZ4-like sequences).
+ *   bzip2  sequence of concatenated bzip2 streams.
+ * Readers recognise the container from its first bytes, so the file suffix is
+ * only a hint for humans.
+ **/
+typedef enum {CAM_CODEC_RAW, CAM_CODEC_LZ, CAM_CODEC_BZIP2} cam_codec_t;
+
+#define TRACE_LZ_MAGIC            "CLZ1"
+#define TRACE_LZ_MAGIC_LENGTH     4
+#define TRACE_LZ_BLOCK_SIZE       (1 << 20)
+#define TRACE_LZ_MIN_MATCH        4
+#define TRACE_LZ_MAX_OFFSET       65535
+
+/* Worst case size of a compressed block of the given length */
+#define TRACE_LZ_BOUND(len)       ((len) + ((len) / 255) + 16)
+
+struct TraceLZBlockHeader {
+  char magic[TRACE_LZ_MAGIC_LENGTH];
+  uint32_t rawLength;
+  uint32_t compressedLength;
+};
+
+/* Suffix of the files written with the codec */
+static inline const char *
+traceCodecSuffix(cam_codec_t codec)
+{
+  switch (codec) {
+    case CAM_CODEC_RAW:
+      return ".txt";
+    case CAM_CODEC_LZ:
+      return ".txt.lz";
+    default:
+      return ".txt.bz2";
+  }
+}
+
+/* Codec named by a string (e.g., an environment variable), bzip2 by default */
+static inline cam_codec_t
+traceCodecFromName(const char *name)
+{
+  if (name != NULL) {
+    if (strcmp(name, "raw") == 0) {
+      return CAM_CODEC_RAW;
+    }
+    if (strcmp(name, "lz") == 0) {
+      return CAM_CODEC_LZ;
+    }
+  }
+  return CAM_CODEC_BZIP2;
+}
+
+/* Codec of a file given its first bytes */
+static inline cam_codec_t
+traceCodecFromHeader(const char *header, size_t length)
+{
+  if (length >= TRACE_LZ_MAGIC_LENGTH && memcmp(header, TRACE_LZ_MAGIC, TRACE_LZ_MAGIC_LENGTH) == 0) {
+    return CAM_CODEC_LZ;
+  }
+  if (length >= 3 && memcmp(header, "BZh", 3) == 0) {
+    return CAM_CODEC_BZIP2;
+  }
+  return CAM_CODEC_RAW;
+}
+
+#endif
@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <bzlib.h>
+#include <stdlib.h>
+
+#include "TraceStream.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+#define TRACE_LZ_HASH_BITS 16
+
+/**
+ * Plain text.
+ **/
+class RawTraceStream : public TraceStream {
+public:
+  RawTraceStream(FILE *f) : TraceStream(f) {}
+
+  void write(const char *buf, size_t length){
+    if (fwrite(buf, 1, length, file) != length) {
+      perror("Failed writing trace file");
+      abort();
+    }
+  }
+
+  void close(){
+    fclose(file);
+  }
+};
+
+
+/**
+ * A new bzip2 stream appended to the file.
+ **/
+class BZ2TraceStream : public TraceStream {
+  BZFILE *bzf;
+public:
+  BZ2TraceStream(FILE *f) : TraceStream(f) {
+    int status;
+    bzf = BZ2_bzWriteOpen(&status, f, 9, 0, 250);
+    if (status != BZ_OK) {
+      if(status == BZ_MEM_ERROR)
+        cerr << "BZ2: Cannot allocate memory\n";
+      abort();
+    }
+  }
+
+  void write(const char *buf, size_t length){
+    int status;
+    BZ2_bzWrite(&status, bzf, (void *)buf, length);
+    if (status != BZ_OK) {
+      cerr << "Failed writing compressed file with error code " << status << endl;
+      perror(NULL);
+      abort();
+    }
+  }
+
+  void close(){
+    /* Flush and close compressed stream (reduces memory consumption) */
+    int status;
+    BZ2_bzWriteClose(&status, bzf, 0, NULL, NULL);
+    if(status != BZ_OK){
+      cerr << "BZ2: BZ2_bzWriteClose error: " << status << endl;
+      abort();
+    }
+    fclose(file);
+  }
+};
+
+
+/**
+ * Blocks of up to TRACE_LZ_BLOCK_SIZE bytes, compressed independently.
+ **/
+class LZTraceStream : public TraceStream {
+  vector<char> block;
+  vector<char> compressed;
+
+  void flushBlock(){
+    TraceLZBlockHeader header;
+    if (block.empty()) {
+      return;
+    }
+    memcpy(header.magic, TRACE_LZ_MAGIC, TRACE_LZ_MAGIC_LENGTH);
+    header.rawLength = block.size();
+    header.compressedLength = traceLZCompress(&block[0], block.size(), &compressed[0]);
+    if (fwrite(&header, sizeof(header), 1, file) != 1 ||
+        fwrite(&compressed[0], 1, header.compressedLength, file) != header.compressedLength) {
+      perror("Failed writing trace file");
+      abort();
+    }
+    block.clear();
+  }
+
+public:
+  LZTraceStream(FILE *f) : TraceStream(f), compressed(TRACE_LZ_BOUND(TRACE_LZ_BLOCK_SIZE)) {
+    block.reserve(TRACE_LZ_BLOCK_SIZE);
+  }
+
+  void write(const char *buf, size_t length){
+    while (length > 0) {
+      size_t n = TRACE_LZ_BLOCK_SIZE - block.size();
+      if (n > length) {
+        n = length;
+      }
+      block.insert(block.end(), buf, buf + n);
+      buf += n;
+      length -= n;
+      if (block.size() == TRACE_LZ_BLOCK_SIZE) {
+        flushBlock();
+      }
+    }
+  }
+
+  void close(){
+    flushBlock();
+    fclose(file);
+  }
+};
+
+
+TraceStream *
+TraceStream::open(string filename, cam_codec_t codec)
+{
+  /* Open file for appending */
+  FILE *f = fopen(filename.c_str(), "a");
+  if (!f) {
+    perror("Error opening file: ");
+    abort();
+  }
+  switch (codec) {
+    case CAM_CODEC_RAW:
+      return new RawTraceStream(f);
+    case CAM_CODEC_LZ:
+      return new LZTraceStream(f);
+    default:
+      return new BZ2TraceStream(f);
+  }
+}
+
+
+static inline uint32_t
+read32(const char *p)
+{
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline char *
+writeLength(char *op, size_t length)
+{
+  while (length >= 255) {
+    *op++ = (char)255;
+    length -= 255;
+  }
+  *op++ = (char)length;
+  return op;
+}
+
+/* Emit the literals [literals, literals+numLiterals) followed by a match, if matchLength is not zero */
+static inline char *
+writeSequence(char *op, const char *literals, size_t numLiterals, size_t offset, size_t matchLength)
+{
+  char *token = op++;
+  size_t extraMatch = matchLength > 0 ? matchLength - TRACE_LZ_MIN_MATCH : 0;
+  *token = (char)(((numLiterals < 15 ? numLiterals : 15) << 4) | (extraMatch < 15 ? extraMatch : 15));
+  if (numLiterals >= 15) {
+    op = writeLength(op, numLiterals - 15);
+  }
+  memcpy(op, literals, numLiterals);
+  op += numLiterals;
+  if (matchLength > 0) {
+    *op++ = (char)(offset & 0xff);
+    *op++ = (char)(offset >> 8);
+    if (extraMatch >= 15) {
+      op = writeLength(op, extraMatch - 15);
+    }
+  }
+  return op;
+}
+
+/**
+ * Greedy LZ77 with a single-entry hash table of the last position of every
+ * 4-byte sequence: much faster than bzip2 at a lower compression ratio.
+ **/
+size_t
+traceLZCompress(const char *src, size_t length, char *dst)
+{
+  vector<uint32_t> table(1 << TRACE_LZ_HASH_BITS, 0);
+  size_t ip = 0;
+  size_t anchor = 0;
+  char *op = dst;
+
+  while (ip + TRACE_LZ_MIN_MATCH <= length) {
+    uint32_t sequence = read32(src + ip);
+    uint32_t hash = (sequence * 2654435761U) >> (32 - TRACE_LZ_HASH_BITS);
+    size_t candidate = table[hash];
+    table[hash] = ip + 1;
+    if (candidate != 0 && ip - (candidate - 1) <= TRACE_LZ_MAX_OFFSET && read32(src + candidate - 1) == sequence) {
+      size_t match = candidate - 1;
+      size_t matchLength = TRACE_LZ_MIN_MATCH;
+      while (ip + matchLength < length && src[match + matchLength] == src[ip + matchLength]) {
+        matchLength++;
+      }
+      op = writeSequence(op, src + anchor, ip - anchor, ip - match, matchLength);
+      ip += matchLength;
+      anchor = ip;
+    } else {
+      ip++;
+    }
+  }
+  op = writeSequence(op, src + anchor, length - anchor, 0, 0);
+  return op - dst;
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TRACESTREAM_H
+#define TRACESTREAM_H
+
+#include <stdio.h>
+#include <string>
+#include "TraceCodec.h"
+
+/**
+ * Output stream appending to a trace file through one of the codecs.
+ **/
+class TraceStream {
+protected:
+  FILE *file;
+
+  TraceStream(FILE *f) : file(f) {}
+
+public:
+  /* Open filename for appending */
+  static TraceStream *open(std::string filename, cam_codec_t codec);
+
+  virtual ~TraceStream() {}
+
+  virtual void write(const char *buf, size_t length) = 0;
+
+  void write(const char *buf) { write(buf, strlen(buf)); }
+
+  /* Flush the data and close the file */
+  virtual void close() = 0;
+};
+
+/* Compress src into dst, which must hold TRACE_LZ_BOUND(length) bytes */
+size_t traceLZCompress(const char *src, size_t length, char *dst);
+
+#endif
@@ -10,6 +10,7 @@ extern "C" {
 #endif
 
 typedef uintptr_t inst_id_t;
+typedef uint32_t inst_index_t;
 
 /**
  * Global library functions.
@@ -28,6 +29,12 @@ void CAM_shutdown (cam_mode_t mode);
  * Memory address profiling.
  **/
 
+// Register an instruction to trace, returning its dense index
+inst_index_t CAM_registerMemInstruction(inst_id_t id);
+
+// Register a memory reference of an instruction given its dense index
+void CAM_memIndexed(inst_index_t index, uintptr_t raddr1, uint64_t rlen1, uintptr_t raddr2, uint64_t rlen2, uintptr_t waddr, uint64_t wlen);
+
 // Register a memory reference
 void CAM_mem(inst_id_t id, uintptr_t raddr1, uint64_t rlen1, uintptr_t raddr2, uint64_t rlen2, uintptr_t waddr, uint64_t wlen);
 
@@ -38,6 +45,8 @@ void CAM_mem(inst_id_t id, uintptr_t raddr1, uint64_t rlen1, uintptr_t raddr2, u
 // New line
 //
 // Each loc is: [a b length, startx, endx]
+// A loc prefixed by "x c n" is repeated n times, the base of every row
+// moving by c (e.g., the rows of a 2D array walk)
 
 
 /**
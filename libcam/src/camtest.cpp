@@ -835,14 +835,10 @@ void testMemoryTraceStreamer(uint64_t chunkSize){
   pair<vector<uintptr_t>, vector<uintptr_t>> instrs = findMemoryTraces();
   list<MemoryTraceStreamer*> streamers;
   for(auto id = instrs.first.begin(); id != instrs.first.end(); id++){
-    char path[1024];
-    sprintf(path, "memory_accesses/memory_accesses.%"PRIuPTR".r.txt.bz2", *id);
-    streamers.push_back( new MemoryTraceStreamer(*id, path, false));
+    streamers.push_back( new MemoryTraceStreamer(*id, memoryTraceFileName(*id, false), false));
   }
   for(auto id = instrs.second.begin(); id != instrs.second.end(); id++){
-    char path[1024];
-    sprintf(path, "memory_accesses/memory_accesses.%"PRIuPTR".w.txt.bz2", *id);
-    streamers.push_back( new MemoryTraceStreamer(*id, path, true));
+    streamers.push_back( new MemoryTraceStreamer(*id, memoryTraceFileName(*id, true), true));
   }
   while(!streamers.empty()){
     for(auto s = streamers.begin(); s != streamers.end(); ){
@@ -861,9 +857,7 @@ void getTraceStats(){
   pair<vector<uintptr_t>, vector<uintptr_t>> instrs = findMemoryTraces();
   map<pair<uintptr_t, bool>, uint64_t> memoryTraceCounts;
   for(auto id = instrs.first.begin(); id != instrs.first.end(); id++){
-    char path[1024];
-    sprintf(path, "memory_accesses/memory_accesses.%"PRIuPTR".r.txt.bz2", *id);
-    MemoryTraceStreamer s(*id, path, false);
+    MemoryTraceStreamer s(*id, memoryTraceFileName(*id, false), false);
     uint64_t count = 0;
     do{
       MemSet ms = s.getNextChunk(1000, true);
@@ -873,9 +867,7 @@ void getTraceStats(){
     memoryTraceCounts[pair<uintptr_t, bool>(*id, false)] = count;
   }
   for(auto id = instrs.second.begin(); id != instrs.second.end(); id++){
-    char path[1024];
-    sprintf(path, "memory_accesses/memory_accesses.%"PRIuPTR".w.txt.bz2", *id);
-    MemoryTraceStreamer s(*id, path, true);
+    MemoryTraceStreamer s(*id, memoryTraceFileName(*id, true), true);
     uint64_t count = 0;
     do{
       MemSet ms = s.getNextChunk(1000, true);
@@ -833,9 +833,9 @@ void loop_analysis_memeff(map<string, unsigned int> &args, StreamParseCallTrace&
   /* Create the memory trace streamers */
   map<pair<uintptr_t, bool>, MemoryTraceStreamer*> memtraceStreamers;
   for(auto i = memtraceInstrIDs.first.begin(); i != memtraceInstrIDs.first.end(); i++)
-    memtraceStreamers[pair<uintptr_t, bool>(*i, false)] = new MemoryTraceStreamer(*i, "memory_accesses/memory_accesses." + to_string(*i) + ".r.txt.bz2",false);
+    memtraceStreamers[pair<uintptr_t, bool>(*i, false)] = new MemoryTraceStreamer(*i, memoryTraceFileName(*i, false),false);
   for(auto i = memtraceInstrIDs.second.begin(); i != memtraceInstrIDs.second.end(); i++)
-    memtraceStreamers[pair<uintptr_t, bool>(*i, true)] = new MemoryTraceStreamer(*i, "memory_accesses/memory_accesses." + to_string(*i) + ".w.txt.bz2",true);
+    memtraceStreamers[pair<uintptr_t, bool>(*i, true)] = new MemoryTraceStreamer(*i, memoryTraceFileName(*i, true),true);
 
   /* Create a map of dynamic instruction counts (count how many instances we've accounted for so far */
   map<uintptr_t, uint64_t> instrCounts;
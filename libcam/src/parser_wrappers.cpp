@@ -13,6 +13,7 @@
 #include <vector>
 #include <cassert>
 #include <bzlib.h>
+#include <unistd.h>
 #define __STDC_FORMAT_MACROS
 #include <inttypes.h>
 using namespace std;
@@ -383,30 +384,42 @@ pair<set<uintptr_t>, set<uintptr_t>> parseCallTraceForInstrList(){
 pair<vector<uintptr_t>, vector<uintptr_t>> findMemoryTraces(){
   pair<vector<uintptr_t>, vector<uintptr_t>> instrIDs;
   char path[1024];
-  FILE *fp  = popen("find memory_accesses -name memory_accesses.*.r.txt.bz2", "r");
+  FILE *fp  = popen("find memory_accesses -name 'memory_accesses.*.r.txt*'", "r");
   while (fgets(path, sizeof(path)-1, fp) != NULL) {
     int id;
-    sscanf(path, "memory_accesses/memory_accesses.%i.r.txt.bz2", &id);
+    sscanf(path, "memory_accesses/memory_accesses.%i.r.txt", &id);
     instrIDs.first.push_back(id);
   }
   pclose(fp);
-  fp  = popen("find memory_accesses -name memory_accesses.*.w.txt.bz2", "r");
+  fp  = popen("find memory_accesses -name 'memory_accesses.*.w.txt*'", "r");
   while (fgets(path, sizeof(path)-1, fp) != NULL) {
     int id;
-    sscanf(path, "memory_accesses/memory_accesses.%i.w.txt.bz2", &id);
+    sscanf(path, "memory_accesses/memory_accesses.%i.w.txt", &id);
     instrIDs.second.push_back(id);
   }
   pclose(fp);
   return instrIDs;
 }
 
+/*
+ * Return the path of the memory trace of an instruction, whatever the codec it was written with
+*/
+string memoryTraceFileName(uintptr_t id, bool write){
+  const cam_codec_t codecs[] = {CAM_CODEC_BZIP2, CAM_CODEC_LZ, CAM_CODEC_RAW};
+  string base = "memory_accesses/memory_accesses." + to_string(id) + (write ? ".w" : ".r");
+  for(unsigned int i = 0; i < sizeof(codecs) / sizeof(codecs[0]); i++){
+    string path = base + traceCodecSuffix(codecs[i]);
+    if(access(path.c_str(), R_OK) == 0)
+      return path;
+  }
+  return base + traceCodecSuffix(CAM_CODEC_BZIP2);
+}
+
 MemoryTrace parse_memory_trace(){
   MemoryTrace t;
   pair<vector<uintptr_t>, vector<uintptr_t>> instrIDs = findMemoryTraces();
   for(auto id = instrIDs.first.begin(); id != instrIDs.first.end(); id++){
-    char path[1024];
-    sprintf(path, "memory_accesses/memory_accesses.%"PRIuPTR".r.txt.bz2", *id);
-    MemoryTraceStreamer streamer(*id, path, false);
+    MemoryTraceStreamer streamer(*id, memoryTraceFileName(*id, false), false);
     MemSet ms;
     do{
       ms = streamer.getNextChunk(0);
@@ -415,9 +428,7 @@ MemoryTrace parse_memory_trace(){
     } while(!ms.empty());
   }
   for(auto id = instrIDs.second.begin(); id != instrIDs.second.end(); id++){
-    char path[1024];
-    sprintf(path, "memory_accesses/memory_accesses.%"PRIuPTR".w.txt.bz2", *id);
-    MemoryTraceStreamer streamer(*id, path, true);
+    MemoryTraceStreamer streamer(*id, memoryTraceFileName(*id, true), true);
     MemSet ms;
     do{
       ms = streamer.getNextChunk(0);
@@ -433,14 +444,10 @@ MemoryTrace parse_memory_trace_parallel(){
   pair<vector<uintptr_t>, vector<uintptr_t>> instrIDs = findMemoryTraces();
   list<MemoryTraceStreamer*> streamers;
   for(auto id = instrIDs.first.begin(); id != instrIDs.first.end(); id++){
-    char path[1024];
-    sprintf(path, "memory_accesses/memory_accesses.%"PRIuPTR".r.txt.bz2", *id);
-    streamers.push_back(new MemoryTraceStreamer(*id, path, false));
+    streamers.push_back(new MemoryTraceStreamer(*id, memoryTraceFileName(*id, false), false));
   }
   for(auto id = instrIDs.second.begin(); id != instrIDs.second.end(); id++){
-    char path[1024];
-    sprintf(path, "memory_accesses/memory_accesses.%"PRIuPTR".w.txt.bz2", *id);
-    streamers.push_back(new MemoryTraceStreamer(*id, path, true));
+    streamers.push_back(new MemoryTraceStreamer(*id, memoryTraceFileName(*id, true), true));
   }
   //for(auto p = parsers.begin(); p != parsers.end(); p++){
   //  (*p)->parseAll();
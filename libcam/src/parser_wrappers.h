@@ -29,6 +29,7 @@ int callTraceGetNextEntry(CallTraceLoopInvocationGroup& callEntry);
 MemoryTrace parse_memory_trace();
 MemoryTrace parse_memory_trace_parallel();
 pair<vector<uintptr_t>, vector<uintptr_t>> findMemoryTraces();
+string memoryTraceFileName(uintptr_t id, bool write);
 
 /* DDG */
 pair<set<pair<uintptr_t, uintptr_t>>, set<pair<uintptr_t, uintptr_t>>> parse_dependence_pairs();
@@ -43,11 +43,60 @@ static JITINT32 debugLevel = 5;
 #define PDECL(decl) decl
 
 
+/**
+ * Shadow memory geometry.  Application memory is shadowed in 4 KiB pages of
+ * 8-byte slots, and pages are grouped in regions of 4 MiB.
+ **/
+#define SHADOW_PAGE_BITS 12
+#define SHADOW_SLOT_BITS 3
+#define SHADOW_REGION_BITS 22
+#define SHADOW_SLOTS_PER_PAGE (1 << (SHADOW_PAGE_BITS - SHADOW_SLOT_BITS))
+#define SHADOW_PAGES_PER_REGION (1 << (SHADOW_REGION_BITS - SHADOW_PAGE_BITS))
+#define SHADOW_SLOT_STAMPS 2
+
+
+/**
+ * A shadow page records the last accesses to each 8-byte slot of an
+ * application page.  Each slot has two stamps: the iteration an access happened
+ * in, the instruction that made it and which bytes of the slot it owns (the
+ * width mask, empty for unused stamps).  Stamp 0 is the latest access to the
+ * slot and stamp 1 an older one that still owns bytes the latest did not
+ * touch; their width masks never overlap.  Pages of a shadow memory are chained
+ * together so that they can all be visited or cleared without looking at the
+ * regions.
+ **/
+typedef struct shadow_page_t {
+    JITUINT8 widths[SHADOW_SLOT_STAMPS][SHADOW_SLOTS_PER_PAGE];
+    JITINT32 iterations[SHADOW_SLOT_STAMPS][SHADOW_SLOTS_PER_PAGE];
+    ir_instruction_t *insts[SHADOW_SLOT_STAMPS][SHADOW_SLOTS_PER_PAGE];
+    JITUINT32 usedSlots;
+    struct shadow_page_t *next;
+} shadow_page_t;
+
+
+/**
+ * A two-level shadow page table.  The first level maps region numbers (plus
+ * one, to avoid null keys) to the second level, a dense array of the shadow
+ * pages of the region.  The last region used is cached, since consecutive
+ * accesses are likely to fall within the same one.
+ **/
+typedef struct shadow_region_t {
+    shadow_page_t *pages[SHADOW_PAGES_PER_REGION];
+} shadow_region_t;
+
+typedef struct shadow_memory_t {
+    XanHashTable *regions;
+    JITNUINT lastRegionNumber;
+    shadow_region_t *lastRegion;
+    shadow_page_t *pages;
+} shadow_memory_t;
+
+
 /**
  * A shadow state structure holds information about the current state of
  * memory for a sequential segment.  Stores are recorded here by placing their
- * iteration number and a pointer the their IR instruction in the hash table at
- * the addresses they touch.  When a dependence is identified, the relevant
+ * iteration number and a pointer the their IR instruction in the shadow memory
+ * at the addresses they touch.  When a dependence is identified, the relevant
  * instructions are placed into the other hash table, along with their
  * iteration numbers.  There is a single shadow state for each sequential
  * segment within each parallelised loop.
@@ -60,8 +109,8 @@ static JITINT32 debugLevel = 5;
  * dependence.
  **/
 typedef struct shadow_state_t {
-    XanHashTable *memReads;
-    XanHashTable *memWrites;
+    shadow_memory_t *memReads;
+    shadow_memory_t *memWrites;
     XanHashTable *allocations;
     XanHashTable *dependences;
     ir_instruction_t *libraryCall;
@@ -143,6 +192,134 @@ freeHashTable(XanHashTable *table) {
 }
 
 
+/**
+ * Allocate a new, empty, shadow memory.
+ **/
+static shadow_memory_t *
+newShadowMemory(void) {
+    shadow_memory_t *mem = allocFunction(sizeof(shadow_memory_t));
+    mem->regions = newHashTable();
+    mem->lastRegionNumber = 0;
+    mem->lastRegion = NULL;
+    mem->pages = NULL;
+    return mem;
+}
+
+
+/**
+ * Get the shadow page of an address.  If there isn't one, it is created when
+ * create is set, otherwise NULL is returned.
+ **/
+static inline shadow_page_t *
+getShadowPage(shadow_memory_t *mem, JITNUINT addr, JITBOOLEAN create) {
+    JITNUINT regionNumber = (addr >> SHADOW_REGION_BITS) + 1;
+    JITUINT32 pageIndex = (addr >> SHADOW_PAGE_BITS) & (SHADOW_PAGES_PER_REGION - 1);
+    shadow_region_t *region;
+    shadow_page_t *page;
+
+    /* Find the region. */
+    if (regionNumber == mem->lastRegionNumber) {
+        region = mem->lastRegion;
+    } else {
+        region = xanHashTable_lookup(mem->regions, uintToPtr(regionNumber));
+        if (!region) {
+            if (!create) {
+                return NULL;
+            }
+            region = allocFunction(sizeof(shadow_region_t));
+            memset(region, 0, sizeof(shadow_region_t));
+            xanHashTable_insert(mem->regions, uintToPtr(regionNumber), region);
+        }
+        mem->lastRegionNumber = regionNumber;
+        mem->lastRegion = region;
+    }
+
+    /* Find the page. */
+    page = region->pages[pageIndex];
+    if (!page && create) {
+        page = allocFunction(sizeof(shadow_page_t));
+        memset(page->widths, 0, sizeof(page->widths));
+        page->usedSlots = 0;
+        page->next = mem->pages;
+        mem->pages = page;
+        region->pages[pageIndex] = page;
+    }
+    return page;
+}
+
+
+/**
+ * Empty a shadow memory.  Pages are kept for later reuse, so this only costs
+ * one pass over the pages that have accesses recorded.
+ **/
+static void
+clearShadowMemory(shadow_memory_t *mem) {
+    shadow_page_t *page = mem->pages;
+    while (page) {
+        if (page->usedSlots > 0) {
+            memset(page->widths, 0, sizeof(page->widths));
+            page->usedSlots = 0;
+        }
+        page = page->next;
+    }
+}
+
+
+/**
+ * Mask of the bytes of the slot at slotStart that fall within [start, end).
+ **/
+static inline JITUINT8
+getSlotWidthMask(JITNUINT slotStart, JITNUINT start, JITNUINT end) {
+    JITUINT32 first = start > slotStart ? start - slotStart : 0;
+    JITUINT32 last = end < slotStart + (1 << SHADOW_SLOT_BITS) ? end - slotStart : (1 << SHADOW_SLOT_BITS);
+    return (JITUINT8)(((1 << last) - 1) & ~((1 << first) - 1));
+}
+
+
+/**
+ * Bytes of a slot that have an access recorded.
+ **/
+static inline JITUINT8
+getSlotWidths(shadow_page_t *page, JITUINT32 slot) {
+    return page->widths[0][slot] | page->widths[1][slot];
+}
+
+
+/**
+ * Forget the accesses recorded to the given bytes of a slot.
+ **/
+static inline void
+forgetSlotAccesses(shadow_page_t *page, JITUINT32 slot, JITUINT8 width) {
+    page->widths[0][slot] &= ~width;
+    page->widths[1][slot] &= ~width;
+}
+
+
+/**
+ * Record an access by inst in the current iteration to the given bytes of a
+ * slot.  Bytes the access does not cover keep their stamp, so that a partial
+ * access does not hide a loop-carried dependence through the rest of the slot.
+ * When both older stamps still own bytes they are merged into the one of the
+ * earlier iteration: a later dependence through those bytes may then be blamed
+ * on the wrong instruction, but never missed.
+ **/
+static inline void
+stampSlot(shadow_page_t *page, JITUINT32 slot, JITUINT8 width, ir_instruction_t *inst) {
+    forgetSlotAccesses(page, slot, width);
+    if (page->widths[0][slot] != 0 && (page->iterations[0][slot] != currShadowState->iteration || page->insts[0][slot] != inst)) {
+        if (page->widths[1][slot] == 0 || page->iterations[0][slot] <= page->iterations[1][slot]) {
+            page->iterations[1][slot] = page->iterations[0][slot];
+            page->insts[1][slot] = page->insts[0][slot];
+        }
+        page->widths[1][slot] |= page->widths[0][slot];
+        page->widths[0][slot] = 0;
+    }
+    page->widths[0][slot] |= width;
+    page->iterations[0][slot] = currShadowState->iteration;
+    page->insts[0][slot] = inst;
+}
+
+
 /**
  * Allocate a parameter with no fields set.
  **/
@@ -281,52 +458,138 @@ recordDataDependence(ir_instruction_t *fromInst, ir_instruction_t *toInst, JITIN
 }
 
 
+/**
+ * Record a dependence with the last library call, since it might have accessed
+ * memory not recorded in the shadow memory.
+ **/
+static inline void
+recordLibraryCallDependence(ir_instruction_t *inst) {
+    if (currShadowState->libraryCall && currShadowState->libraryIter < currShadowState->iteration) {
+        recordDataDependence(currShadowState->libraryCall, inst, currShadowState->libraryIter, currShadowState->iteration);
+    }
+}
+
+
 /**
  * Determine whether there are any dependences arising from accesses to memory
- * through the given table that records reads or writes.
+ * through the given shadow memory that records reads or writes.  Accesses are
+ * then recorded, if add is set, or forgotten, if remove is set.
  **/
 static void
-identifyMemoryDataDependences(ir_method_t *method, ir_instruction_t *inst, void *addr, JITUINT32 size, XanHashTable *table, JITBOOLEAN add, JITBOOLEAN remove) {
-    JITUINT32 s;
-    for (s = 0; s < size; ++s) {
-        XanHashTableItem *memItem = xanHashTable_lookupItem(table, addr + s);
-        if (memItem) {
-            if (ptrToInt(memItem->element) < currShadowState->iteration) {
-                recordDataDependence(memItem->elementID, inst, ptrToInt(memItem->element), currShadowState->iteration);
-            } else {
-                assert(ptrToInt(memItem->element) == currShadowState->iteration);
+identifyMemoryDataDependences(ir_method_t *method, ir_instruction_t *inst, void *addr, JITUINT32 size, shadow_memory_t *mem, JITBOOLEAN add, JITBOOLEAN remove) {
+    JITNUINT start = (JITNUINT)addr;
+    JITNUINT end = start + size;
+    JITNUINT pageStart = start;
+    while (pageStart < end) {
+        JITNUINT pageEnd = (pageStart | ((1 << SHADOW_PAGE_BITS) - 1)) + 1;
+        JITNUINT slotStart = pageStart & ~(JITNUINT)((1 << SHADOW_SLOT_BITS) - 1);
+        shadow_page_t *page = getShadowPage(mem, pageStart, add);
+        if (pageEnd > end) {
+            pageEnd = end;
+        }
+
+        /* Nothing recorded within this page. */
+        if (!page) {
+            recordLibraryCallDependence(inst);
+            pageStart = pageEnd;
+            continue;
+        }
+
+        /* Check each slot touched. */
+        for (; slotStart < pageEnd; slotStart += (1 << SHADOW_SLOT_BITS)) {
+            JITUINT32 slot = (slotStart >> SHADOW_SLOT_BITS) & (SHADOW_SLOTS_PER_PAGE - 1);
+            JITUINT8 width = getSlotWidthMask(slotStart, pageStart, pageEnd);
+            JITUINT8 found = 0;
+            JITUINT32 stamp;
+            for (stamp = 0; stamp < SHADOW_SLOT_STAMPS; ++stamp) {
+                if (page->widths[stamp][slot] & width) {
+                    if (page->iterations[stamp][slot] < currShadowState->iteration) {
+                        recordDataDependence(page->insts[stamp][slot], inst, page->iterations[stamp][slot], currShadowState->iteration);
+                    } else {
+                        assert(page->iterations[stamp][slot] == currShadowState->iteration);
+                    }
+                    found |= page->widths[stamp][slot] & width;
+                }
+            }
+            if (found != width) {
+                recordLibraryCallDependence(inst);
             }
             if (add) {
-                memItem->element = intToPtr(currShadowState->iteration);
-            } else if (remove) {
-                xanHashTable_removeElement(table, memItem->elementID);
+                if (getSlotWidths(page, slot) == 0) {
+                    page->usedSlots += 1;
+                }
+                stampSlot(page, slot, width, inst);
+            } else if (remove && found) {
+                forgetSlotAccesses(page, slot, found);
+                if (getSlotWidths(page, slot) == 0) {
+                    page->usedSlots -= 1;
+                }
             }
-        } else {
-            if (currShadowState->libraryCall && currShadowState->libraryIter < currShadowState->iteration) {
-                recordDataDependence(currShadowState->libraryCall, inst, currShadowState->libraryIter, currShadowState->iteration);
+        }
+        pageStart = pageEnd;
+    }
+}
+
+
+/**
+ * Add a memory access to a shadow memory, or remove it if inst is NULL.
+ **/
+static void
+addMemoryAccess(ir_instruction_t *inst, void *addr, JITUINT32 size, shadow_memory_t *mem) {
+    JITNUINT start = (JITNUINT)addr;
+    JITNUINT end = start + size;
+    JITNUINT pageStart = start;
+    while (pageStart < end) {
+        JITNUINT pageEnd = (pageStart | ((1 << SHADOW_PAGE_BITS) - 1)) + 1;
+        JITNUINT slotStart = pageStart & ~(JITNUINT)((1 << SHADOW_SLOT_BITS) - 1);
+        shadow_page_t *page = getShadowPage(mem, pageStart, inst != NULL);
+        if (pageEnd > end) {
+            pageEnd = end;
+        }
+        if (!page) {
+            pageStart = pageEnd;
+            continue;
+        }
+        for (; slotStart < pageEnd; slotStart += (1 << SHADOW_SLOT_BITS)) {
+            JITUINT32 slot = (slotStart >> SHADOW_SLOT_BITS) & (SHADOW_SLOTS_PER_PAGE - 1);
+            JITUINT8 width = getSlotWidthMask(slotStart, pageStart, pageEnd);
+            JITUINT8 old = getSlotWidths(page, slot);
+            if (inst) {
+                stampSlot(page, slot, width, inst);
+            } else {
+                forgetSlotAccesses(page, slot, width);
             }
-            if (add) {
-                xanHashTable_insert(table, addr + s, intToPtr(currShadowState->iteration));
+            if (old == 0 && getSlotWidths(page, slot) != 0) {
+                page->usedSlots += 1;
+            } else if (old != 0 && getSlotWidths(page, slot) == 0) {
+                page->usedSlots -= 1;
             }
         }
+        pageStart = pageEnd;
     }
 }
 
 
 /**
- * Add a memory access to a table of them.
+ * Record a dependence from every access in a shadow memory to the given
+ * instruction, then empty the shadow memory.
  **/
 static void
-addMemoryAccess(void *addr, JITUINT32 size, XanHashTable *table) {
-    JITUINT32 s;
-    for (s = 0; s < size; ++s) {
-        XanHashTableItem *memItem = xanHashTable_lookupItem(table, addr + s);
-        if (memItem) {
-            memItem->element = intToPtr(currShadowState->iteration);
-        } else {
-            xanHashTable_insert(table, addr + s, intToPtr(currShadowState->iteration));
+recordAllMemoryDataDependences(ir_instruction_t *inst, shadow_memory_t *mem) {
+    shadow_page_t *page = mem->pages;
+    while (page) {
+        JITUINT32 slot;
+        for (slot = 0; slot < SHADOW_SLOTS_PER_PAGE && page->usedSlots > 0; ++slot) {
+            JITUINT32 stamp;
+            for (stamp = 0; stamp < SHADOW_SLOT_STAMPS; ++stamp) {
+                if (page->widths[stamp][slot]) {
+                    recordDataDependence(page->insts[stamp][slot], inst, page->iterations[stamp][slot], currShadowState->iteration);
+                }
+            }
         }
+        page = page->next;
     }
+    clearShadowMemory(mem);
 }
 
 
@@ -342,7 +605,7 @@ nativeMemReadProfile(ir_method_t *method, ir_instruction_t *inst, void *addr, JI
 
     /* Add the read, if required. */
     if (profileInfo->identifyDataDepsMWAR) {
-        addMemoryAccess(addr, size, currShadowState->memReads);
+        addMemoryAccess(inst, addr, size, currShadowState->memReads);
     }
 }
 
@@ -410,7 +673,7 @@ nativeMemFreeProfile(ir_method_t *method, ir_instruction_t *inst, void *addr) {
     }
 
     /* Record writes to detect dependences. */
-    addMemoryAccess(addr, size, currShadowState->memWrites);
+    addMemoryAccess(inst, addr, size, currShadowState->memWrites);
 }
 
 
@@ -424,13 +687,7 @@ nativeMemAllocProfile(ir_method_t *method, ir_instruction_t *inst, void *addr, J
 
     /* Clear out old reads hanging about since they don't affect dependences. */
     if (profileInfo->identifyDataDepsMWAR) {
-        JITUINT32 s;
-        for (s = 0; s < size; ++s) {
-            XanHashTableItem *readItem = xanHashTable_lookupItem(currShadowState->memReads, addr + s);
-            if (readItem) {
-                xanHashTable_removeElement(currShadowState->memReads, readItem->elementID);
-            }
-        }
+        addMemoryAccess(NULL, addr, size, currShadowState->memReads);
     }
 
     /* Record the allocation. */
@@ -442,7 +699,7 @@ nativeMemAllocProfile(ir_method_t *method, ir_instruction_t *inst, void *addr, J
     }
 
     /* Record writes to detect later dependences. */
-    addMemoryAccess(addr, size, currShadowState->memWrites);
+    addMemoryAccess(inst, addr, size, currShadowState->memWrites);
 }
 
 
@@ -452,30 +709,16 @@ nativeMemAllocProfile(ir_method_t *method, ir_instruction_t *inst, void *addr, J
  **/
 static void
 nativeLibraryCallProfile(ir_method_t *method, ir_instruction_t *inst, ir_method_t *callee) {
-    XanHashTableItem *memItem;
-
     /* Mark data dependences with all prior reads. */
     if (profileInfo->identifyDataDepsMWAR) {
-        memItem = xanHashTable_first(currShadowState->memReads);
-        while (memItem) {
-            recordDataDependence(memItem->elementID, inst, ptrToInt(memItem->element), currShadowState->iteration);
-            memItem = xanHashTable_next(currShadowState->memReads, memItem);
-        }
-        xanHashTable_emptyOutTable(currShadowState->memReads);
+        recordAllMemoryDataDependences(inst, currShadowState->memReads);
     }
 
     /* Mark data dependences with all prior writes. */
-    memItem = xanHashTable_first(currShadowState->memWrites);
-    while (memItem) {
-        recordDataDependence(memItem->elementID, inst, ptrToInt(memItem->element), currShadowState->iteration);
-        memItem = xanHashTable_next(currShadowState->memWrites, memItem);
-    }
-    xanHashTable_emptyOutTable(currShadowState->memWrites);
+    recordAllMemoryDataDependences(inst, currShadowState->memWrites);
 
     /* A dependence with the last library call. */
-    if (currShadowState->libraryCall && currShadowState->libraryIter < currShadowState->iteration) {
-        recordDataDependence(currShadowState->libraryCall, inst, currShadowState->libraryIter, currShadowState->iteration);
-    }
+    recordLibraryCallDependence(inst);
 
     /* Record the library call. */
     currShadowState->libraryCall = inst;
@@ -501,9 +744,9 @@ static shadow_state_t *
 createShadowState(void) {
     shadow_state_t *state = allocFunction(sizeof(shadow_state_t));
     if (profileInfo->identifyDataDepsMWAR) {
-        state->memReads = newHashTable();
+        state->memReads = newShadowMemory();
     }
-    state->memWrites = newHashTable();
+    state->memWrites = newShadowMemory();
     state->allocations = newHashTable();
     state->dependences = newHashTable();
     state->libraryCall = NULL;
@@ -519,9 +762,9 @@ createShadowState(void) {
 static void
 clearShadowState(shadow_state_t *state, JITBOOLEAN clearDependences) {
     if (profileInfo->identifyDataDepsMWAR) {
-        xanHashTable_emptyOutTable(state->memReads);
+        clearShadowMemory(state->memReads);
     }
-    xanHashTable_emptyOutTable(state->memWrites);
+    clearShadowMemory(state->memWrites);
     xanHashTable_emptyOutTable(state->allocations);
     if (clearDependences) {
         xanHashTable_emptyOutTable(state->dependences);
@@ -103,9 +103,9 @@ void init_CLIManager (CLIManager_t *lib, IRVM_t *irVM, t_running_garbage_collect
     lib->binaries = xanList_new(sharedAllocFunction, freeFunction, NULL);
     assert(lib->binaries != NULL);
 
-    /* Initialize the hash table pairing    *
+    /* Initialize the map pairing           *
     * functions and entry points           */
-    (lib->methods).functionsEntryPoint = xanHashTable_new(11, 0, allocFunction, dynamicReallocFunction, freeFunction, NULL, NULL);
+    (lib->methods).codeMap = ILCODEMAP_new();
 
     cliManager = lib;
 
@@ -208,7 +208,7 @@ void CLIMANAGER_shutdown (CLIManager_t *lib) {
 
     /* Destroy the tables.
      */
-    xanHashTable_destroyTable((lib->methods).functionsEntryPoint);
+    ILCODEMAP_destroy((lib->methods).codeMap);
 
     /* Destroy the layout manager.
      */
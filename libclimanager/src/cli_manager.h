@@ -5,6 +5,7 @@
 #include <metadata/metadata_types.h>
 #include <ir_virtual_machine.h>
 #include <jit_metadata.h>
+#include <code_map.h>
 
 // My headers
 #include <lib_delegates.h>
@@ -61,7 +62,7 @@ typedef struct t_methods {
     XanHashTable            *anonymousContainer;
     XanHashTable            *methods;
     XanList                 *container;
-    XanHashTable *functionsEntryPoint;                                   /**< The hashtable associating entry points to jit functions       */
+    ILCodeMap               *codeMap;                                    /**< Map from the code of the methods to their Method; it includes their entry points	*/
 
     XanList * (*findCompatibleMethods)(struct t_methods *methods, ir_signature_t *signature);
     Method (*fetchOrCreateMethod)(struct t_methods *methods, MethodDescriptor *methodID, JITBOOLEAN isExternallyCallable);
@@ -549,14 +549,10 @@ static inline JITUINT32 getLocalsNumber (Method method) {
 
 static inline void * getFunctionPointer (Method method) {
     void    *entryPoint;
-    XanHashTable *table;
 
     /* Assertions				*/
     assert(method != NULL);
 
-    /* Cache some pointer	*/
-    table = (cliManager->methods).functionsEntryPoint;
-
     if (IRVM_isANativeFunction(cliManager->IRVM, *(method->jit_function))) {
         entryPoint = IRVM_getEntryPoint(cliManager->IRVM, *(method->jit_function));
     } else {
@@ -564,11 +560,10 @@ static inline void * getFunctionPointer (Method method) {
         entryPoint = IRVM_getFunctionPointer(cliManager->IRVM, jitFunction);
     }
 
-    xanHashTable_lock(table);
-    if (xanHashTable_lookup(table, entryPoint) == NULL) {
-        xanHashTable_insert(table, entryPoint, (void *) method);
+    /* Map the entry point to the method; the code that follows it is mapped once the backend knows its size	*/
+    if (ILCODEMAP_lookup((cliManager->methods).codeMap, entryPoint) == NULL) {
+        ILCODEMAP_insert((cliManager->methods).codeMap, entryPoint, entryPoint + 1, (void *) method);
     }
-    xanHashTable_unlock(table);
 
     /* Return		*/
     return entryPoint;
@@ -72,6 +72,8 @@ static inline void insertIntoIMT (IMTElem *bucket, MethodDescriptor *method, voi
 static inline void *getFromIMT (IMTElem *bucket, MethodDescriptor *method);
 static inline ILFieldLayout * fetchFieldLayout (ILLayout *layout, FieldDescriptor *field);
 static inline ILFieldLayout * fetchStaticFieldLayout (ILLayoutStatic *layout, FieldDescriptor *field);
+static inline ILFieldLayout * internal_searchFieldLayout (XanList *fieldsLayout, FieldDescriptor *field);
+static inline ILFieldLayout ** internal_indexFieldsLayout (XanList *fieldsLayout, JITUINT32 *fieldsNumber);
 static inline ILLayout * getRuntimeFieldHandleLayout (ILLayout_manager *manager);
 static inline ILLayout * getRuntimeMethodHandleLayout (ILLayout_manager *manager);
 static inline ILLayout * getRuntimeTypeHandleLayout (ILLayout_manager *manager);
@@ -79,6 +81,15 @@ static inline ILLayout * getRuntimeArgumentHandleLayout (ILLayout_manager *manag
 static inline void internal_layout_manager_initialize (void);
 static inline void internal_layout_manager_load_handle (void);
 static inline void internal_dumpStaticLayout (ILLayoutStatic *layout);
+static inline void internal_notifyNewImplementations (ILLayout_manager *manager, ILLayout *layout);
+static inline void internal_deferNewImplementationsNotification (ILLayout_manager *manager, ILLayout *layout);
+static inline void internal_notifyDeferredImplementations (ILLayout_manager *manager);
+
+/* Layouts are created while holding the metadata ticket of their type, and they can recursively lay out other types.
+ * New implementations are notified only once the outermost layout request of the thread has released its ticket.
+ */
+static __thread JITUINT32	layoutDepth		= 0;
+static __thread XanList		*layoutsToNotify	= NULL;
 
 void LAYOUT_initManager (ILLayout_manager *manager) {
 
@@ -86,6 +97,7 @@ void LAYOUT_initManager (ILLayout_manager *manager) {
     manager->methodImplementationInfos = xanHashTable_new(11, 0, sharedAllocFunction, dynamicReallocFunction, freeFunction, NULL, NULL);
     assert(manager->methodImplementationInfos != NULL);
 
+    manager->newImplementationNotifier	= NULL;
     manager->cachedVirtualMethodRequests	= xanList_new(allocFunction, freeFunction, NULL);
     manager->cachedVirtualTableSets         = xanList_new(allocFunction, freeFunction, NULL);
 
@@ -123,6 +135,12 @@ void LAYOUT_setCachingRequestsForVirtualMethodTables (ILLayout_manager *manager,
     return ;
 }
 
+void LAYOUT_setNewImplementationNotifier (ILLayout_manager *manager, void (*notifier)(MethodDescriptor *declaration, MethodDescriptor *body)) {
+    manager->newImplementationNotifier	= notifier;
+
+    return ;
+}
+
 void LAYOUT_setMethodTables (TypeDescriptor *ilType, void *vTable, IMTElem *IMT) {
     ILLayout 	*layout;
     JITBOOLEAN	cache;
@@ -377,55 +395,60 @@ static inline ILLayoutStatic *layoutStaticType (ILLayout_manager *manager, TypeD
 }
 
 static inline ILFieldLayout * fetchStaticFieldLayout (ILLayoutStatic *layout, FieldDescriptor *field) {
-    ILFieldLayout   *currentFieldLayout;
-    XanListItem     *currentItem;
+    JITINT32	index;
 
     /* assertions */
     assert(layout != NULL);
     assert(field != NULL);
     assert(layout->fieldsLayout != NULL);
 
-    /* initialize the local variables */
-    currentFieldLayout = NULL;
-    currentItem = NULL;
+    /* fetch the field by its position within the layout */
+    index = field->layoutIndex;
+    if (	(index >= 0)				&&
+            (((JITUINT32) index) < layout->fieldsNumber)	&&
+            (layout->fieldsByIndex[index]->field == field)	) {
+        return layout->fieldsByIndex[index];
+    }
 
-    /* retrieve the first field layout information */
-    currentItem = xanList_first(layout->fieldsLayout);
-    assert(currentItem != NULL);
-    while (currentItem != NULL) {
-        /* retrieve the layout infos for the current field */
-        currentFieldLayout = (ILFieldLayout *) currentItem->data;
-        assert(currentFieldLayout != NULL);
-        assert(currentFieldLayout->field != NULL);
+    /* the field has not been laid out within this type */
+    return internal_searchFieldLayout(layout->fieldsLayout, field);
+}
 
-        /* verify if the field is found */
-        if (currentFieldLayout->field == field) {
-            return currentFieldLayout;
-        }
+static inline ILFieldLayout * fetchFieldLayout (ILLayout *layout, FieldDescriptor *field) {
+    JITINT32	index;
 
-        /* retrieve the next field informations */
-        currentItem = currentItem->next;
+    /* assertions */
+    assert(layout != NULL);
+    assert(field != NULL);
+    assert(layout->fieldsLayout != NULL);
+
+    /* fetch the field by its position within the layout; the fields inherited	*
+     * keep the position they have within the layout of the supertype		*/
+    index = field->layoutIndex;
+    if (	(index >= 0)				&&
+            (((JITUINT32) index) < layout->fieldsNumber)	&&
+            (layout->fieldsByIndex[index]->field == field)	) {
+        return layout->fieldsByIndex[index];
     }
 
-    return NULL;
+    /* the field has not been laid out within this type */
+    return internal_searchFieldLayout(layout->fieldsLayout, field);
 }
 
-static inline ILFieldLayout * fetchFieldLayout (ILLayout *layout, FieldDescriptor *field) {
+static inline ILFieldLayout * internal_searchFieldLayout (XanList *fieldsLayout, FieldDescriptor *field) {
     XanListItem     *currentItem;
     ILFieldLayout   *currentFieldLayout;
 
     /* assertions */
-    assert(layout != NULL);
+    assert(fieldsLayout != NULL);
     assert(field != NULL);
-    assert(layout->fieldsLayout != NULL);
 
     /* initialize the local variables */
     currentFieldLayout = NULL;
     currentItem = NULL;
 
     /* retrieve the first field layout information */
-    currentItem = xanList_first(layout->fieldsLayout);
-    assert(currentItem != NULL);
+    currentItem = xanList_first(fieldsLayout);
     while (currentItem != NULL) {
         /* retrieve the layout infos for the current field */
         currentFieldLayout = (ILFieldLayout *) xanList_getData(currentItem);
@@ -444,6 +467,44 @@ static inline ILFieldLayout * fetchFieldLayout (ILLayout *layout, FieldDescripto
     return NULL;
 }
 
+static inline ILFieldLayout ** internal_indexFieldsLayout (XanList *fieldsLayout, JITUINT32 *fieldsNumber) {
+    ILFieldLayout	**fieldsByIndex;
+    XanListItem     *currentItem;
+    JITUINT32	index;
+
+    /* assertions */
+    assert(fieldsNumber != NULL);
+
+    /* check if there are fields */
+    (*fieldsNumber) = 0;
+    if (fieldsLayout == NULL) {
+        return NULL;
+    }
+    (*fieldsNumber) = xanList_length(fieldsLayout);
+    if ((*fieldsNumber) == 0) {
+        return NULL;
+    }
+
+    /* store the fields following the order of the layout and number them */
+    fieldsByIndex = (ILFieldLayout **) sharedAllocFunction(sizeof(ILFieldLayout *) * (*fieldsNumber));
+    assert(fieldsByIndex != NULL);
+    index = 0;
+    currentItem = xanList_first(fieldsLayout);
+    while (currentItem != NULL) {
+        ILFieldLayout   *currentFieldLayout;
+        currentFieldLayout = (ILFieldLayout *) xanList_getData(currentItem);
+        assert(currentFieldLayout != NULL);
+        assert(currentFieldLayout->field != NULL);
+        fieldsByIndex[index] = currentFieldLayout;
+        currentFieldLayout->field->layoutIndex = index;
+        index++;
+        currentItem = currentItem->next;
+    }
+    assert(index == (*fieldsNumber));
+
+    return fieldsByIndex;
+}
+
 static inline VCallPath prepareVirtualMethodInvocation (ILLayout_manager *manager, MethodDescriptor *methodID) {
     VCallPath result;
 
@@ -1054,6 +1115,7 @@ static inline ILLayout * layoutType (ILLayout_manager *manager, TypeDescriptor *
     assert(type != NULL);
     PDEBUG("LAYOUT_MANAGER: layoutType: Start\n");
     PDEBUG("LAYOUT_MANAGER: layoutType:     Request for type \"%s\"\n", type->getCompleteName(type));
+    layoutDepth++;
 
     /* Verify if the current type has already a ILLayout structure associated with */
     DescriptorMetadataTicket *ticket = type->createDescriptorMetadataTicket(type, INSTANCE_LAYOUT_METADATA);
@@ -1079,6 +1141,7 @@ static inline ILLayout * layoutType (ILLayout_manager *manager, TypeDescriptor *
 
             /* update the hashtable by inserting the new informations */
             xanList_syncAppend(manager->classesLayout, layout);
+            internal_deferNewImplementationsNotification(manager, layout);
         }
 
         type->broadcastDescriptorMetadataTicket(type, ticket, layout);
@@ -1101,6 +1164,12 @@ static inline ILLayout * layoutType (ILLayout_manager *manager, TypeDescriptor *
         PLATFORM_unlockMutex(&(layout->mutex));
     }
 
+    /* Notify the new implementations once no ticket is held anymore */
+    layoutDepth--;
+    if (layoutDepth == 0) {
+        internal_notifyDeferredImplementations(manager);
+    }
+
     /* Return the layout informations */
     PDEBUG("LAYOUT_MANAGER: layoutType: Exit\n");
     return (ILLayout *) ticket->data;
@@ -1113,6 +1182,7 @@ static inline IRVM_type * layoutJITType (ILLayout_manager *manager, TypeDescript
     assert(type != NULL);
     PDEBUG("LAYOUT_MANAGER: layoutJITType: Start\n");
     PDEBUG("LAYOUT_MANAGER: layoutJITType:     Request for type \"%s\"\n", type->getCompleteName(type));
+    layoutDepth++;
 
     /* verify if the current type has already a ILLayout structure associated with */
     DescriptorMetadataTicket *ticket = type->createDescriptorMetadataTicket(type, INSTANCE_LAYOUT_METADATA);
@@ -1135,6 +1205,7 @@ static inline IRVM_type * layoutJITType (ILLayout_manager *manager, TypeDescript
 
             /* update the hashtable by inserting the new informations */
             xanList_syncAppend(manager->classesLayout, layout);
+            internal_deferNewImplementationsNotification(manager, layout);
         }
 
         type->broadcastDescriptorMetadataTicket(type, ticket, layout);
@@ -1150,6 +1221,12 @@ static inline IRVM_type * layoutJITType (ILLayout_manager *manager, TypeDescript
         PLATFORM_unlockMutex(&(layout->mutex));
     }
 
+    /* Notify the new implementations once no ticket is held anymore */
+    layoutDepth--;
+    if (layoutDepth == 0) {
+        internal_notifyDeferredImplementations(manager);
+    }
+
     /* Return the layout informations */
     PDEBUG("LAYOUT_MANAGER: layoutJITType: Exit\n");
     return *(((ILLayout *) ticket->data)->jit_type);
@@ -1247,6 +1324,9 @@ static inline ILLayoutStatic * retrieve_static_type_layout (ILLayout_manager *ma
         item = item->next;
     }
 
+    /* Number the static fields */
+    return_value->fieldsByIndex = internal_indexFieldsLayout(return_value->fieldsLayout, &(return_value->fieldsNumber));
+
     /* postconditions --> update the size value for the static type layout */
     PDEBUG("LAYOUT_MANAGER: retrieve_static_type_layout : Ready to perform static layout\n");
     return_value->typeSize = _perform_static_layout(return_value);
@@ -1406,6 +1486,7 @@ static inline ILLayout * retrieve_type_layout (ILLayout_manager *manager, TypeDe
     /* Layout fields.
      */
     internal_layoutFields(manager, type_layout);
+    type_layout->fieldsByIndex = internal_indexFieldsLayout(type_layout->fieldsLayout, &(type_layout->fieldsNumber));
 
     /* postconditions --> update the size value for the type layout */
     assert(type_layout->typeSize >= 0);
@@ -1446,6 +1527,8 @@ static inline ILLayoutStatic * _alloc_ILLayoutStatic (ILLayout_manager *manager)
     return_value->type = NULL;
     return_value->typeSize = 0;
     return_value->fieldsLayout = xanList_new(sharedAllocFunction, freeFunction, NULL);
+    return_value->fieldsByIndex = NULL;
+    return_value->fieldsNumber = 0;
     return_value->fetchStaticFieldLayout = fetchStaticFieldLayout;
 
     /* verify the postconditions */
@@ -1481,6 +1564,8 @@ static inline ILLayout * _alloc_ILLayout_infos (ILLayout_manager *manager) {
     return_value->methods = NULL;
     return_value->type_of_layout = -1;
     return_value->fieldsLayout = NULL;
+    return_value->fieldsByIndex = NULL;
+    return_value->fieldsNumber = 0;
     return_value->fetchFieldLayout = fetchFieldLayout;
 
     /* return the initialized structure */
@@ -1537,6 +1622,86 @@ static inline ILFieldLayout * _get_Field_Layout_Infos (FieldDescriptor *field) {
     return field_layout;
 }
 
+static inline void internal_deferNewImplementationsNotification (ILLayout_manager *manager, ILLayout *layout) {
+
+    /* Assertions.
+     */
+    assert(manager != NULL);
+    assert(layout != NULL);
+    assert(layoutDepth > 0);
+
+    /* Check whether someone is interested in the implementations of virtual methods.
+     */
+    if (manager->newImplementationNotifier == NULL) {
+        return ;
+    }
+
+    /* Remember the layout.
+     */
+    if (layoutsToNotify == NULL) {
+        layoutsToNotify	= xanList_new(allocFunction, freeFunction, NULL);
+    }
+    xanList_append(layoutsToNotify, layout);
+
+    return ;
+}
+
+static inline void internal_notifyDeferredImplementations (ILLayout_manager *manager) {
+
+    /* Assertions.
+     */
+    assert(manager != NULL);
+    assert(layoutDepth == 0);
+
+    /* Notify the layouts created by the current thread.
+     * The notifier can lay out new types, which are notified by the loop as well.
+     */
+    if (layoutsToNotify == NULL) {
+        return ;
+    }
+    while (xanList_length(layoutsToNotify) > 0) {
+        XanListItem	*item;
+        ILLayout	*layout;
+        item	= xanList_first(layoutsToNotify);
+        layout	= item->data;
+        xanList_deleteItem(layoutsToNotify, item);
+        internal_notifyNewImplementations(manager, layout);
+    }
+
+    return ;
+}
+
+static inline void internal_notifyNewImplementations (ILLayout_manager *manager, ILLayout *layout) {
+    XanHashTableItem	*item;
+
+    /* Assertions.
+     */
+    assert(manager != NULL);
+    assert(layout != NULL);
+
+    /* Check whether someone is interested in the implementations of virtual methods.
+     */
+    if (manager->newImplementationNotifier == NULL) {
+        return ;
+    }
+
+    /* Notify the bodies of the virtual methods of the new type.
+     */
+    item	= xanHashTable_first(layout->methods);
+    while (item != NULL) {
+        VTableSlot	*vmethod;
+        vmethod	= (VTableSlot *) item->element;
+        assert(vmethod != NULL);
+        if (	(vmethod->body != NULL)				&&
+                (!vmethod->body->attributes->is_abstract)	) {
+            manager->newImplementationNotifier(vmethod->declaration, vmethod->body);
+        }
+        item	= xanHashTable_next(layout->methods, item);
+    }
+
+    return ;
+}
+
 static inline MethodImplementations *getMethodImplementations (ILLayout_manager *manager, MethodDescriptor *methodID) {
     MethodDescriptor *methodToFind;
 
@@ -55,6 +55,8 @@ typedef struct ILLayout {
     TypeDescriptor		*type;          	/**< Metadata information about the type					*/
     IRVM_type		**jit_type;     	/**< IR virtual machine type, make use of PMP					*/
     XanList         	*fieldsLayout;  	/**< An ordered list of ILFieldLayout structures				*/
+    ILFieldLayout		**fieldsByIndex;	/**< The elements of fieldsLayout indexed by the layoutIndex of their fields	*/
+    JITUINT32		fieldsNumber;		/**< Length of fieldsByIndex							*/
     JITUINT32 		type_of_layout; 	/**< A constant that define the type of layout					*/
     JITUINT32 		typeSize; 		/**< Size of an instance of this type in memory					*/
     JITUINT32 		packing_size;           /**< Packing size used for explicit layout of fields				*/
@@ -72,6 +74,8 @@ typedef struct ILLayoutStatic {
     struct ILLayout_manager *manager;
     TypeDescriptor          *type;          //metadata informations about the type
     XanList         *fieldsLayout;          //an ordered list of ILFieldLayout structures
+    ILFieldLayout   **fieldsByIndex;        //the elements of fieldsLayout indexed by the layoutIndex of their fields
+    JITUINT32 fieldsNumber;                 //length of fieldsByIndex
     JITUINT32 typeSize;                     //size of an instance of this type in memory
     ILFieldLayout * (*fetchStaticFieldLayout)(struct ILLayoutStatic *layout, FieldDescriptor *field);
     void            *initialized_obj;       //fresh copy of the object initialized with RVA
@@ -84,6 +88,7 @@ typedef struct ILLayout_manager {
     XanList                 *classesLayout;
     XanList                 *staticTypeLayout;
     XanHashTable            *methodImplementationInfos;
+    void			(*newImplementationNotifier)(MethodDescriptor *declaration, MethodDescriptor *body);
     ILLayout *              _Runtime_Field_Handle;
     ILLayout *              _Runtime_Method_Handle;
     ILLayout *              _Runtime_Type_Handle;
@@ -104,6 +109,7 @@ typedef struct ILLayout_manager {
 void LAYOUT_initManager (ILLayout_manager *manager);
 void LAYOUT_setCachingRequestsForVirtualMethodTables (ILLayout_manager *manager, JITBOOLEAN cache);
 void LAYOUT_createCachedVirtualMethodTables (ILLayout_manager *manager);
+void LAYOUT_setNewImplementationNotifier (ILLayout_manager *manager, void (*notifier)(MethodDescriptor *declaration, MethodDescriptor *body));
 void LAYOUT_setMethodTables (TypeDescriptor *ilType, void *vTable, IMTElem *IMT);
 void LAYOUT_getMethodTables (ILLayout *layout, void **vTable, IMTElem **IMT);
 void LAYOUT_destroyManager (ILLayout_manager *manager);
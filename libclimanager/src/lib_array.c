@@ -35,6 +35,8 @@ extern CLIManager_t *cliManager;
 static inline void * internal_getArrayElement (void *array, JITUINT32 index);
 static inline void internal_setValueArrayElement (void *array, JITUINT32 index, void *element);
 static inline void * internal_getValueArrayElement (void *array, JITUINT32 index);
+static inline void internal_setBoxedArrayElement (void *array, JITUINT32 index, void *value);
+static inline JITINT32 internal_getBoxedValueOffset (TypeDescriptor *elementType);
 static inline JITINT32 internal_getArrayLowerBound (void *array, JITINT32 dimension);
 static inline JITINT32 internal_getArrayUpperBound (void *array, JITINT32 dimension);
 static inline JITUINT32 internal_getArrayLength (void *object, JITINT32 dimension);
@@ -52,12 +54,17 @@ static void* internal_newInstanceFromType (TypeDescriptor* elementType, JITUINT3
 
 pthread_once_t arrayMetadataLock = PTHREAD_ONCE_INIT;
 
+/* Offset of the value within boxed instances of the last element type boxed by the thread	*/
+static __thread TypeDescriptor *lastBoxedType = NULL;
+static __thread JITINT32 lastBoxedOffset = 0;
+
 void init_arrayManager (t_arrayManager *arrayManager) {
 
     /* Initialize the functions			*/
     arrayManager->getArrayElement = internal_getArrayElement;
     arrayManager->setValueArrayElement = internal_setValueArrayElement;
     arrayManager->getValueArrayElement = internal_getValueArrayElement;
+    arrayManager->setBoxedArrayElement = internal_setBoxedArrayElement;
     arrayManager->getRank = internal_getRank;
     arrayManager->getArrayLowerBound = internal_getArrayLowerBound;
     arrayManager->getArrayUpperBound = internal_getArrayUpperBound;
@@ -141,11 +148,12 @@ static inline void internal_setValueArrayElement (void *array, JITUINT32 index,
 static inline void * internal_getValueArrayElement (void *array, JITUINT32 index) {
     JITUINT32 arrayLength;
     void            *value;
+    void            *element;
     JITUINT32 arraySlotSize;
     JITINT32 offset;
+    JITUINT32 irType;
     TypeDescriptor          *arr;
     TypeDescriptor          *elType;
-    FieldDescriptor         *a;
 
     /* Assertions                   */
     assert(array != NULL);
@@ -160,23 +168,91 @@ static inline void * internal_getValueArrayElement (void *array, JITUINT32 index
     elType = GET_ARRAY(arr)->type;
     assert(elType != NULL);
 
+    arraySlotSize = internal_getArrayElementSize(array);
+    element = array + (arraySlotSize * index);
+
+    /* References are returned as they are: only values need a box	*/
+    irType = elType->getIRType(elType);
+    if (    (irType == IROBJECT)    ||
+            (irType == IRMPOINTER)  ) {
+        return *((void **) element);
+    }
+
     value = cliManager->gc->allocObject(elType, 0);
+    offset = 0;
+    if (irType != IRVALUETYPE) {
+        offset = internal_getBoxedValueOffset(elType);
+    }
+    memcpy(value + offset, element, arraySlotSize);
+
+    return value;
+}
+
+static inline void internal_setBoxedArrayElement (void *array, JITUINT32 index, void *value) {
+    JITUINT32 arrayLength;
+    void            *element;
+    JITUINT32 arraySlotSize;
+    JITINT32 offset;
+    JITUINT32 irType;
+    TypeDescriptor          *arr;
+    TypeDescriptor          *elType;
+
+    /* Assertions                   */
+    assert(array != NULL);
+
+    /* Fetch the length of the array                */
+    arrayLength = (cliManager->CLR).arrayManager.getArrayLength(array, 0);
+    if ((index < 0) || (index >= arrayLength)) {
+        cliManager->throwExceptionByName((JITINT8 *) "System", (JITINT8 *) "IndexOutOfRangeException");
+    }
+
+    arr = cliManager->gc->getType(array);
+    elType = GET_ARRAY(arr)->type;
+    assert(elType != NULL);
+
     arraySlotSize = internal_getArrayElementSize(array);
+    element = array + (arraySlotSize * index);
 
-    a = elType->getFieldFromName(elType, (JITINT8 *) "value_");
+    /* References are stored as they are: only values need to be unboxed	*/
+    irType = elType->getIRType(elType);
+    if (    (irType == IROBJECT)    ||
+            (irType == IRMPOINTER)  ) {
+        (*((void **) element)) = value;
+        return;
+    }
+
+    if (value == NULL) {
+        cliManager->throwExceptionByName((JITINT8 *) "System", (JITINT8 *) "NullReferenceException");
+    }
+    offset = 0;
+    if (irType != IRVALUETYPE) {
+        offset = internal_getBoxedValueOffset(elType);
+    }
+    memcpy(element, value + offset, arraySlotSize);
+
+    return;
+}
+
+static inline JITINT32 internal_getBoxedValueOffset (TypeDescriptor *elementType) {
+    FieldDescriptor         *a;
+
+    /* Arrays are usually accessed many times in a row: look the field up only when the element type changes	*/
+    if (lastBoxedType == elementType) {
+        return lastBoxedOffset;
+    }
+
+    a = elementType->getFieldFromName(elementType, (JITINT8 *) "value_");
 
     /* Mono BCL loaded */
     if (a == NULL) {
-        a = elType->getFieldFromName(elType, (JITINT8 *) "m_value");
+        a = elementType->getFieldFromName(elementType, (JITINT8 *) "m_value");
     }
-
     assert(a != NULL);
 
-    offset = cliManager->gc->fetchFieldOffset(a);
-
-    memcpy(value + offset, (cliManager->CLR).arrayManager.getArrayElement(array, index), arraySlotSize);
+    lastBoxedOffset = cliManager->gc->fetchFieldOffset(a);
+    lastBoxedType = elementType;
 
-    return value;
+    return lastBoxedOffset;
 }
 
 static inline JITINT32 internal_getArrayLowerBound (void *object, JITINT32 dimension) {
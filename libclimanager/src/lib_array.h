@@ -33,7 +33,8 @@ typedef struct {
     TypeDescriptor *                (*fillILArrayType)();                           /**< Store the information about the System.Array class		*/
     void *          (*getArrayElement)(void *array, JITUINT32 index);               /**< Return the pointer of the element index of the array; return NULL if index is grater or equal to the length of the array.  */
     void (*setValueArrayElement)(void *array, JITUINT32 index, void *element);      /**< Set a single element into array at specified index.	*/
-    void *          (*getValueArrayElement)(void *array, JITUINT32 index);          /**< Return a single element from array at specified index.	*/
+    void *          (*getValueArrayElement)(void *array, JITUINT32 index);          /**< Return a single element from array at specified index; values are boxed, references are returned as they are.	*/
+    void (*setBoxedArrayElement)(void *array, JITUINT32 index, void *value);        /**< Store a reference, or unbox a value, into array at specified index.	*/
     JITINT32 (*getArrayLowerBound)(void *object, JITINT32 dimension);               /**< Return the lower bound of the array at specified dimension	*/
     JITINT32 (*getArrayUpperBound)(void *object, JITINT32 dimension);               /**< Return the upper bound of the array at specified dimension     */
     JITUINT32 (*getArrayLength)(void *object, JITINT32 dimension);                  /**< Return the dimension of the array (only for monodimensional arrays)	*/
@@ -37,6 +37,8 @@ static Method dm_getARCtor (t_delegatesManager* self);
 static inline Method dm_getDynamicInvoke (t_delegatesManager* self);
 static Method dm_getEndInvoke (t_delegatesManager* self);
 static MethodDescriptor* dm_getCalleeMethodID (t_delegatesManager* self, void* delegate);
+static Method dm_getInvoke (t_delegatesManager* self, TypeDescriptor* delegateType);
+static JITBOOLEAN dm_invoke (t_delegatesManager* self, void* delegate, void* argument);
 
 /* Private methods prototypes */
 static inline void dm_buildCtor (t_delegatesManager* self, Method method);
@@ -66,12 +68,17 @@ void init_delegatesManager (t_delegatesManager *self, IR_ITEM_VALUE buildDelegat
     self->getDynamicInvoke = dm_getDynamicInvoke;
     self->getEndInvoke = dm_getEndInvoke;
     self->getCalleeMethod = dm_getCalleeMethodID;
+    self->getInvoke = dm_getInvoke;
+    self->invoke = dm_invoke;
     self->initialize = internal_lib_delegates_initialize;
     self->destroy = destroyDelegatesManager;
 
     /* Setup the function pointer */
     self->buildDelegateFunctionPointer = buildDelegateFunctionPointer;
 
+    /* Make the cache of the Invoke methods */
+    self->invokeMethods = xanHashTable_new(11, JITFALSE, allocFunction, dynamicReallocFunction, freeFunction, NULL, NULL);
+
     /* Return			*/
     return;
 }
@@ -80,7 +87,7 @@ extern CLIManager_t *cliManager;
 
 /* Destructor */
 void destroyDelegatesManager (t_delegatesManager* self) {
-
+    xanHashTable_destroyTable(self->invokeMethods);
 }
 
 /* Build given method body */
@@ -192,6 +199,62 @@ static MethodDescriptor* dm_getCalleeMethodID (t_delegatesManager* self, void* d
     return method->ID;
 }
 
+/* Get the Invoke method of a delegate type */
+static Method dm_getInvoke (t_delegatesManager* self, TypeDescriptor* delegateType) {
+    XanList* methods_list;
+    MethodDescriptor* invokeID;
+    Method invoke;
+    Method cached;
+    t_methods* methods;
+
+    /* Look in the cache first */
+    xanHashTable_lock(self->invokeMethods);
+    invoke = xanHashTable_lookup(self->invokeMethods, delegateType);
+    xanHashTable_unlock(self->invokeMethods);
+    if (invoke != NULL) {
+        return invoke;
+    }
+
+    /* Resolve the method */
+    methods = &(cliManager->methods);
+    methods_list = delegateType->getMethodFromName(delegateType, (JITINT8 *) "Invoke");
+    if (	(methods_list == NULL)			||
+            (xanList_length(methods_list) == 0)	) {
+        print_err("Unable to find the Invoke method of a delegate", 0);
+        abort();
+    }
+    invokeID = (MethodDescriptor *) xanList_first(methods_list)->data;
+    invoke = methods->fetchOrCreateMethod(methods, invokeID, JITTRUE);
+    IRMETHOD_setMethodAsCallableExternally(&(invoke->IRMethod), JITTRUE);
+
+    /* Make sure the method is compiled before publishing it.
+     * The compilation can lay out types and run other delegates, so the cache is not locked meanwhile */
+    IRMETHOD_translateMethodToMachineCode(invoke->getIRMethod(invoke));
+    xanHashTable_lock(self->invokeMethods);
+    cached = xanHashTable_lookup(self->invokeMethods, delegateType);
+    if (cached == NULL) {
+        xanHashTable_insert(self->invokeMethods, delegateType, invoke);
+    }
+    xanHashTable_unlock(self->invokeMethods);
+
+    return invoke;
+}
+
+/* Invoke a delegate with a single argument */
+static JITBOOLEAN dm_invoke (t_delegatesManager* self, void* delegate, void* argument) {
+    Method invoke;
+    void* args[2];
+
+    /* Assertions */
+    assert(delegate != NULL);
+
+    invoke = dm_getInvoke(self, cliManager->gc->getType(delegate));
+    args[0] = &delegate;
+    args[1] = &argument;
+
+    return IRVM_run(cliManager->IRVM, *(invoke->jit_function), args, NULL) != 0;
+}
+
 /* Build the delegate constructor */
 static inline void dm_buildCtor (t_delegatesManager* self, Method method) {
 
@@ -81,6 +81,12 @@ typedef struct _DelegatesManager {
      */
     JITINT32 methodFieldOffset;
 
+    /**
+     * Invoke methods of the delegate types, already compiled, indexed by
+     * delegate type
+     */
+    XanHashTable* invokeMethods;
+
     /**
      * Build given method body
      *
@@ -187,6 +193,33 @@ typedef struct _DelegatesManager {
      */
     MethodDescriptor *(*getCalleeMethod)(struct _DelegatesManager* self, void* delegate);
 
+    /**
+     * Get the Invoke method of a delegate type
+     *
+     * The method is resolved and compiled the first time the type is seen;
+     * later calls return it from a cache. This method is thread safe.
+     *
+     * @param self this object
+     * @param delegateType the type of the delegate
+     *
+     * @return the Invoke method, ready to be run
+     */
+    Method (*getInvoke)(struct _DelegatesManager* self, TypeDescriptor* delegateType);
+
+    /**
+     * Invoke a delegate with a single argument
+     *
+     * The Invoke method of the delegate comes from the cache of getInvoke.
+     *
+     * @param self this object
+     * @param delegate the delegate to call
+     * @param argument the argument of the call
+     *
+     * @return JITTRUE if the call returned normally, JITFALSE if it threw
+     *         an exception
+     */
+    JITBOOLEAN (*invoke)(struct _DelegatesManager* self, void* delegate, void* argument);
+
     void (*initialize)(void);
     /**
      * Destroy the given DelegatesManager and free any used resources
@@ -38,10 +38,24 @@ typedef struct _DynamicLibrarySymbol {
     void *pointer;
 } DynamicLibrarySymbol;
 
+/* Call to a machine code function.
+ * P/Invoke methods that import the same symbol from the same library with the same signature share it.
+ */
+typedef struct _PinvokeStub {
+    JITINT8 *libraryName;
+    JITINT8 *symbolName;
+    ir_signature_t *signature;
+    ir_symbol_t *symbol;
+    void *pointer;
+} PinvokeStub;
+
 JITUINT32 hashDynamicLibrary (DynamicLibrary *library);
 JITINT32 equalsDynamicLibrary (DynamicLibrary *key1, DynamicLibrary *key2);
 JITUINT32 hashDynamicLibrarySymbol (DynamicLibrarySymbol *symbol);
 JITINT32 equalsDynamicLibrarySymbol (DynamicLibrarySymbol *key1, DynamicLibrarySymbol *key2);
+JITUINT32 hashPinvokeStub (PinvokeStub *stub);
+JITINT32 equalsPinvokeStub (PinvokeStub *key1, PinvokeStub *key2);
+static inline PinvokeStub * internal_fetchStub (PinvokeManager* manager, Method callee);
 static inline DynamicLibrary *newDynamicLibrary (PinvokeManager* manager, JITINT8 *name);
 static inline void *newDynamicLibrarySymbol (DynamicLibrary *library, JITINT8 *name);
 static inline ir_symbol_t *pInvokeManagerDeserialize (void *mem, JITUINT32 memBytes);
@@ -89,6 +103,44 @@ JITINT32 equalsDynamicLibrarySymbol (DynamicLibrarySymbol *key1, DynamicLibraryS
     return !STRCMP(key1->name, key2->name);
 }
 
+JITUINT32 hashPinvokeStub (PinvokeStub *stub) {
+    if (stub == NULL) {
+        return 0;
+    }
+    JITUINT32 seed = hashString(stub->symbolName);
+    seed = combineHash(seed, hashString(stub->libraryName));
+    seed = combineHash(seed, IRMETHOD_hashIRSignature(stub->signature));
+    return seed;
+}
+
+JITINT32 equalsPinvokeStub (PinvokeStub *key1, PinvokeStub *key2) {
+    JITUINT32	count;
+
+    if (key1 == NULL || key2 == NULL) {
+        return 0;
+    }
+    if (    (STRCMP(key1->symbolName, key2->symbolName) != 0)	||
+            (STRCMP(key1->libraryName, key2->libraryName) != 0)	) {
+        return 0;
+    }
+    if (!IRMETHOD_equalsIRSignature(key1->signature, key2->signature)) {
+        return 0;
+    }
+
+    /* Value types are passed by copy: their layout has to match as well.
+     */
+    if (    ((key1->signature)->resultType == IRVALUETYPE)				&&
+            ((key1->signature)->ilResultType != (key2->signature)->ilResultType)	) {
+        return 0;
+    }
+    for (count = 0; count < (key1->signature)->parametersNumber; count++) {
+        if (    ((key1->signature)->parameterTypes[count] == IRVALUETYPE)					&&
+                ((key1->signature)->ilParamsTypes[count] != (key2->signature)->ilParamsTypes[count])	) {
+            return 0;
+        }
+    }
+    return 1;
+}
 
 DynamicLibrary *newDynamicLibrary (PinvokeManager* manager, JITINT8 *name) {
     DynamicLibrary library;
@@ -314,6 +366,7 @@ static inline ir_instruction_t * internal_addPinvokeInstruction (PinvokeManager*
     MethodDescriptor 	*calleeID;
     ir_item_t               *icall_item;
     ir_symbol_t 		*symbol;
+    PinvokeStub		*stub;
     XanList                 *icall_params;
     JITUINT32 		num_par;
     JITUINT32 		count;
@@ -345,14 +398,16 @@ static inline ir_instruction_t * internal_addPinvokeInstruction (PinvokeManager*
     num_par 	= IRMETHOD_getMethodParametersNumber(calleeIRMethod);
 
     /* Fetch the symbol of the machine code of the callee.
+     * The library and the symbol are looked up only the first time a method with the same import and signature is called.
      */
-    symbol 		= IRSYMBOL_createSymbol(PINVOKE_SYMBOL, (void *) calleeID);
+    stub		= internal_fetchStub(manager, callee);
+    symbol 		= stub->symbol;
     assert(symbol != NULL);
 
     /* Check the invoked method.
      * Methods that quit the execution must be wrapped.
      */
-    fp		= (void *)(JITNUINT)(pInvokeManagerResolve(symbol).v);
+    fp		= stub->pointer;
     if (fp == exit) {
         ir_item_t	*par1;
         inst 			= IRMETHOD_newInstructionOfTypeAfter(caller, afterInst, IREXIT);
@@ -430,6 +485,54 @@ static inline ir_instruction_t * internal_addPinvokeInstruction (PinvokeManager*
     return inst;
 }
 
+static inline PinvokeStub * internal_fetchStub (PinvokeManager* manager, Method callee) {
+    MethodDescriptor 	*calleeID;
+    PinvokeStub		*stub;
+    PinvokeStub		key;
+
+    /* Fetch the CIL ID of the callee.
+     */
+    calleeID 	= callee->getID(callee);
+    assert(calleeID != NULL);
+
+    /* Check whether the method has been called before.
+     */
+    stub		= xanHashTable_syncLookup(manager->methodStubs, calleeID);
+    if (stub != NULL) {
+        return stub;
+    }
+
+    /* Check whether a method with the same import and signature has been called before.
+     */
+    key.libraryName	= calleeID->getImportModule(calleeID);
+    key.symbolName	= calleeID->getImportName(calleeID);
+    key.signature	= &((callee->getIRMethod(callee))->signature);
+    xanHashTable_lock(manager->stubs);
+    stub		= xanHashTable_lookup(manager->stubs, &key);
+    if (stub == NULL) {
+
+        /* Resolve the machine code of the callee.
+         */
+        stub			= allocFunction(sizeof(PinvokeStub));
+        memcpy(stub, &key, sizeof(PinvokeStub));
+        stub->symbol		= IRSYMBOL_createSymbol(PINVOKE_SYMBOL, (void *) calleeID);
+        stub->pointer		= (void *)(JITNUINT)(pInvokeManagerResolve(stub->symbol).v);
+        assert(stub->pointer != NULL);
+        xanHashTable_insert(manager->stubs, stub, stub);
+    }
+    xanHashTable_unlock(manager->stubs);
+
+    /* Remember the stub of the method.
+     */
+    xanHashTable_lock(manager->methodStubs);
+    if (xanHashTable_lookup(manager->methodStubs, calleeID) == NULL) {
+        xanHashTable_insert(manager->methodStubs, calleeID, stub);
+    }
+    xanHashTable_unlock(manager->methodStubs);
+
+    return stub;
+}
+
 void init_pinvokeManager (PinvokeManager *manager, JITINT8 *libPath) {
 
     /* Assertions.
@@ -441,6 +544,8 @@ void init_pinvokeManager (PinvokeManager *manager, JITINT8 *libPath) {
     manager->buildMethod 		= pInvokeManagerBuildMethod;
     manager->addPinvokeInstruction	= internal_addPinvokeInstruction;
     manager->libraries 		= xanHashTable_new(11, JITFALSE, allocFunction, dynamicReallocFunction, freeFunction, (JITUINT32 (*)(void *))hashDynamicLibrary, (JITINT32 (*)(void *, void *))equalsDynamicLibrary);
+    manager->stubs 			= xanHashTable_new(11, JITFALSE, allocFunction, dynamicReallocFunction, freeFunction, (JITUINT32 (*)(void *))hashPinvokeStub, (JITINT32 (*)(void *, void *))equalsPinvokeStub);
+    manager->methodStubs 		= xanHashTable_new(11, JITFALSE, allocFunction, dynamicReallocFunction, freeFunction, NULL, NULL);
     manager->destroy 		= destroyPinvokeManager;
 
     IRSYMBOL_registerSymbolManager(PINVOKE_SYMBOL, pInvokeManagerResolve, pInvokeManagerSerialize, pInvokeManagerDump, pInvokeManagerDeserialize);
@@ -451,6 +556,11 @@ void init_pinvokeManager (PinvokeManager *manager, JITINT8 *libPath) {
 void destroyPinvokeManager (PinvokeManager* manager) {
     XanHashTableItem	*hashItem;
 
+    /* Destroy the stubs.
+     */
+    xanHashTable_destroyTable(manager->methodStubs);
+    xanHashTable_destroyTableAndData(manager->stubs);
+
     /* Destroy the libraries loaded in memory.
      */
     hashItem	= xanHashTable_first(manager->libraries);
@@ -25,6 +25,8 @@
 typedef struct _PinvokeManager {
     XanHashTable 	*libraries;
     JITINT8		*libPath;
+    XanHashTable	*stubs;			/**< Calls to machine code shared by the P/Invoke methods with the same library, symbol and signature	*/
+    XanHashTable	*methodStubs;		/**< Stub used by each P/Invoke method									*/
 
     void 			(*buildMethod)		(struct _PinvokeManager* self, Method method);
     ir_instruction_t * 	(*addPinvokeInstruction)(struct _PinvokeManager* self, ir_method_t *caller, Method callee, ir_instruction_t *afterInst);
@@ -1373,6 +1373,23 @@ static inline void internal_destroyReflectManager (t_reflectManager *self) {
         item	= xanHashTable_next(self->clrTypes, item);
     }
 
+    /* Destroy the invoke stubs.
+     */
+    item	= xanHashTable_first(self->clrMethods);
+    while (item != NULL) {
+        CLRMethod	*clrMethod;
+        clrMethod	= item->element;
+        freeFunction(clrMethod->invokeStub);
+        item	= xanHashTable_next(self->clrMethods, item);
+    }
+    item	= xanHashTable_first(self->clrConstructors);
+    while (item != NULL) {
+        CLRConstructor	*clrConstructor;
+        clrConstructor	= item->element;
+        freeFunction(clrConstructor->invokeStub);
+        item	= xanHashTable_next(self->clrConstructors, item);
+    }
+
     /* Destroy the hash tables.
      */
     xanHashTable_destroyTable(self->clrTypes);
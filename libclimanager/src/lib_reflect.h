@@ -71,12 +71,14 @@ typedef struct {
     JITINT8 type;
     MethodDescriptor        *ID;
     void                    *object;
+    void                    *invokeStub;	/**< Steps to call the method through reflection, made at the first call	*/
 } CLRMethod;
 
 typedef struct {
     JITINT8 type;
     MethodDescriptor                *ID;
     void                    *object;
+    void                    *invokeStub;	/**< Steps to call the method through reflection, made at the first call	*/
 } CLRConstructor;
 
 typedef struct {
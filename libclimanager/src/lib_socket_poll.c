@@ -0,0 +1,466 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <config.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <compiler_memory_manager.h>
+#include <platform_API.h>
+
+// My headers
+#include <lib_socket_poll.h>
+// End
+
+#ifdef HAVE_SYS_EPOLL_H
+#include <sys/epoll.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Handles above this limit have no generation: they are registered again by every select.
+ */
+#define MAX_TRACKED_HANDLES	(1024 * 1024)
+
+#define INITIAL_ENTRIES		64
+#define INITIAL_EVENTS		64
+
+/* Events that make a socket ready for the three sets of select	*/
+#define POLL_READ		EPOLLIN
+#define POLL_WRITE		EPOLLOUT
+#define POLL_ERROR		EPOLLPRI
+
+typedef struct {
+    JITUINT32	generation;	/**< Generation of the handle when it was registered	*/
+    JITUINT32	registered;	/**< Events registered in the epoll instance; 0 if the handle is not registered	*/
+    JITUINT32	wanted;		/**< Events asked by the select identified by serial	*/
+    JITUINT32	ready;		/**< Events reported to the select identified by serial	*/
+    JITUINT32	serial;
+} t_socket_poll_entry;
+
+typedef struct {
+    int			epollFD;
+    t_socket_poll_entry	*entries;	/**< Indexed by handle	*/
+    JITUINT32		entriesNumber;
+    struct epoll_event	*events;
+    JITUINT32		eventsNumber;
+    JITUINT32		serial;		/**< Identifier of the select in progress	*/
+} t_socket_poll_engine;
+
+static inline void internal_initGenerations (void);
+static inline JITUINT32 internal_getGeneration (JITNINT handle);
+static inline void internal_bumpGeneration (JITNINT handle);
+static inline t_socket_poll_engine * internal_getEngine (void);
+static void internal_destroyEngine (void *engine);
+static inline t_socket_poll_entry * internal_getEntry (t_socket_poll_engine *engine, JITNINT handle);
+static inline void internal_addInterest (t_socket_poll_engine *engine, JITNINT *handles, JITUINT32 handlesNumber, JITUINT32 events);
+static inline JITINT32 internal_register (t_socket_poll_engine *engine, JITNINT *handles, JITUINT32 handlesNumber);
+static inline JITINT32 internal_wait (t_socket_poll_engine *engine, JITINT64 timeout);
+static inline JITINT32 internal_countReady (t_socket_poll_engine *engine, JITNINT *handles, JITUINT32 handlesNumber, JITUINT32 events);
+static inline void internal_compact (t_socket_poll_engine *engine, JITNINT *handles, JITUINT32 handlesNumber, JITUINT32 events);
+static inline JITINT64 internal_now (void);
+
+static pthread_once_t	generationsLock = PTHREAD_ONCE_INIT;
+static pthread_key_t	engineKey;
+static JITUINT32	*generations = NULL;
+static JITUINT32	generationsNumber = 0;
+static __thread t_socket_poll_engine	*currentEngine = NULL;
+static __thread JITBOOLEAN		engineUnavailable = JITFALSE;
+
+void SOCKETPOLL_socketOpened (JITNINT handle) {
+    internal_bumpGeneration(handle);
+}
+
+void SOCKETPOLL_socketClosed (JITNINT handle) {
+    internal_bumpGeneration(handle);
+}
+
+JITBOOLEAN SOCKETPOLL_select (JITNINT *readHandles, JITUINT32 readHandlesNumber, JITNINT *writeHandles, JITUINT32 writeHandlesNumber, JITNINT *errorHandles, JITUINT32 errorHandlesNumber, JITINT64 timeout, JITINT32 *result) {
+    t_socket_poll_engine	*engine;
+    JITINT32		ready;
+
+    /* Assertions			*/
+    assert(result != NULL);
+
+    engine	= internal_getEngine();
+    if (engine == NULL) {
+        return JITFALSE;
+    }
+
+    /* Start a new select: entries written by previous calls become stale	*/
+    (engine->serial)++;
+    if (engine->serial == 0) {
+        JITUINT32	count;
+        for (count = 0; count < engine->entriesNumber; count++) {
+            engine->entries[count].serial	= 0;
+        }
+        engine->serial	= 1;
+    }
+
+    /* Merge the interest of the three sets, then update the registrations that changed only.
+     */
+    internal_addInterest(engine, readHandles, readHandlesNumber, POLL_READ);
+    internal_addInterest(engine, writeHandles, writeHandlesNumber, POLL_WRITE);
+    internal_addInterest(engine, errorHandles, errorHandlesNumber, POLL_ERROR);
+    ready	= internal_register(engine, readHandles, readHandlesNumber);
+    if (ready == 0) {
+        ready	= internal_register(engine, writeHandles, writeHandlesNumber);
+    }
+    if (ready == 0) {
+        ready	= internal_register(engine, errorHandles, errorHandlesNumber);
+    }
+    if (ready == -2) {
+
+        /* Some handle cannot be polled (e.g., it is a regular file)	*/
+        return JITFALSE;
+    }
+    if (ready < 0) {
+        (*result)	= -1;
+        return JITTRUE;
+    }
+
+    /* Wait for the events	*/
+    ready	= internal_wait(engine, timeout);
+    if (ready <= 0) {
+        (*result)	= ready;
+        return JITTRUE;
+    }
+
+    /* Count the ready handles as select does, one per set	*/
+    ready	= internal_countReady(engine, readHandles, readHandlesNumber, POLL_READ);
+    ready	+= internal_countReady(engine, writeHandles, writeHandlesNumber, POLL_WRITE);
+    ready	+= internal_countReady(engine, errorHandles, errorHandlesNumber, POLL_ERROR);
+
+    /* Remove the handles that are not ready from the managed arrays	*/
+    if (ready > 0) {
+        internal_compact(engine, readHandles, readHandlesNumber, POLL_READ);
+        internal_compact(engine, writeHandles, writeHandlesNumber, POLL_WRITE);
+        internal_compact(engine, errorHandles, errorHandlesNumber, POLL_ERROR);
+    }
+    (*result)	= ready;
+
+    return JITTRUE;
+}
+
+static inline void internal_initGenerations (void) {
+    long	maxHandles;
+
+    pthread_key_create(&engineKey, internal_destroyEngine);
+    maxHandles	= sysconf(_SC_OPEN_MAX);
+    if (	(maxHandles <= 0)			||
+            (maxHandles > MAX_TRACKED_HANDLES)	) {
+        maxHandles	= MAX_TRACKED_HANDLES;
+    }
+    generations		= allocFunction(sizeof(JITUINT32) * maxHandles);
+    memset(generations, 0, sizeof(JITUINT32) * maxHandles);
+    generationsNumber	= maxHandles;
+}
+
+static inline JITUINT32 internal_getGeneration (JITNINT handle) {
+    PLATFORM_pthread_once(&generationsLock, internal_initGenerations);
+    if (	(handle < 0)					||
+            (((JITNUINT) handle) >= generationsNumber)	) {
+        return 0;
+    }
+
+    return __atomic_load_n(&(generations[handle]), __ATOMIC_ACQUIRE);
+}
+
+static inline void internal_bumpGeneration (JITNINT handle) {
+    PLATFORM_pthread_once(&generationsLock, internal_initGenerations);
+    if (	(handle < 0)					||
+            (((JITNUINT) handle) >= generationsNumber)	) {
+        return ;
+    }
+    __atomic_add_fetch(&(generations[handle]), 1, __ATOMIC_RELEASE);
+}
+
+static inline t_socket_poll_engine * internal_getEngine (void) {
+    t_socket_poll_engine	*engine;
+    int			epollFD;
+
+    if (currentEngine != NULL) {
+        return currentEngine;
+    }
+    if (engineUnavailable) {
+        return NULL;
+    }
+
+    /* Make the epoll instance of the current thread	*/
+    PLATFORM_pthread_once(&generationsLock, internal_initGenerations);
+    epollFD	= epoll_create1(EPOLL_CLOEXEC);
+    if (epollFD < 0) {
+        engineUnavailable	= JITTRUE;
+        return NULL;
+    }
+    engine			= allocFunction(sizeof(t_socket_poll_engine));
+    engine->epollFD		= epollFD;
+    engine->entriesNumber	= INITIAL_ENTRIES;
+    engine->entries		= allocFunction(sizeof(t_socket_poll_entry) * INITIAL_ENTRIES);
+    memset(engine->entries, 0, sizeof(t_socket_poll_entry) * INITIAL_ENTRIES);
+    engine->eventsNumber	= INITIAL_EVENTS;
+    engine->events		= allocFunction(sizeof(struct epoll_event) * INITIAL_EVENTS);
+    engine->serial		= 0;
+    pthread_setspecific(engineKey, engine);
+    currentEngine		= engine;
+
+    return engine;
+}
+
+static void internal_destroyEngine (void *engine) {
+    t_socket_poll_engine	*e;
+
+    e	= (t_socket_poll_engine *) engine;
+    close(e->epollFD);
+    freeFunction(e->entries);
+    freeFunction(e->events);
+    freeFunction(e);
+}
+
+static inline t_socket_poll_entry * internal_getEntry (t_socket_poll_engine *engine, JITNINT handle) {
+
+    /* Assertions			*/
+    assert(handle >= 0);
+
+    if (((JITNUINT) handle) >= engine->entriesNumber) {
+        JITUINT32	entriesNumber;
+        entriesNumber	= engine->entriesNumber;
+        while (((JITNUINT) handle) >= entriesNumber) {
+            entriesNumber	*= 2;
+        }
+        engine->entries	= dynamicReallocFunction(engine->entries, sizeof(t_socket_poll_entry) * entriesNumber);
+        memset(&(engine->entries[engine->entriesNumber]), 0, sizeof(t_socket_poll_entry) * (entriesNumber - engine->entriesNumber));
+        engine->entriesNumber	= entriesNumber;
+    }
+
+    return &(engine->entries[handle]);
+}
+
+static inline void internal_addInterest (t_socket_poll_engine *engine, JITNINT *handles, JITUINT32 handlesNumber, JITUINT32 events) {
+    JITUINT32	count;
+
+    if (handles == NULL) {
+        return ;
+    }
+    for (count = 0; count < handlesNumber; count++) {
+        t_socket_poll_entry	*entry;
+        if (handles[count] < 0) {
+            continue ;
+        }
+        entry	= internal_getEntry(engine, handles[count]);
+        if (entry->serial != engine->serial) {
+            entry->serial	= engine->serial;
+            entry->wanted	= 0;
+            entry->ready	= 0;
+        }
+        entry->wanted	|= events;
+    }
+}
+
+static inline JITINT32 internal_register (t_socket_poll_engine *engine, JITNINT *handles, JITUINT32 handlesNumber) {
+    JITUINT32	count;
+
+    if (handles == NULL) {
+        return 0;
+    }
+    for (count = 0; count < handlesNumber; count++) {
+        t_socket_poll_entry	*entry;
+        struct epoll_event	event;
+        JITUINT32		generation;
+        JITNINT			handle;
+        int			error;
+
+        handle	= handles[count];
+        if (handle < 0) {
+            continue ;
+        }
+        entry		= internal_getEntry(engine, handle);
+        generation	= internal_getGeneration(handle);
+        if (	(entry->registered == entry->wanted)		&&
+                (entry->generation == generation)		&&
+                (((JITNUINT) handle) < generationsNumber)	) {
+            continue ;
+        }
+
+        /* The handle could have been closed and reused since its last registration: the kernel dropped the old one in that case.
+         */
+        memset(&event, 0, sizeof(struct epoll_event));
+        event.events	= entry->wanted;
+        event.data.fd	= (int) handle;
+        if (entry->registered != 0) {
+            error	= epoll_ctl(engine->epollFD, EPOLL_CTL_MOD, (int) handle, &event);
+            if (	(error != 0)		&&
+                    (errno == ENOENT)	) {
+                error	= epoll_ctl(engine->epollFD, EPOLL_CTL_ADD, (int) handle, &event);
+            }
+        } else {
+            error	= epoll_ctl(engine->epollFD, EPOLL_CTL_ADD, (int) handle, &event);
+            if (	(error != 0)		&&
+                    (errno == EEXIST)	) {
+                error	= epoll_ctl(engine->epollFD, EPOLL_CTL_MOD, (int) handle, &event);
+            }
+        }
+        if (error != 0) {
+            entry->registered	= 0;
+            if (errno == EPERM) {
+                return -2;
+            }
+            return -1;
+        }
+        entry->registered	= entry->wanted;
+        entry->generation	= generation;
+    }
+
+    return 0;
+}
+
+static inline JITINT32 internal_wait (t_socket_poll_engine *engine, JITINT64 timeout) {
+    JITINT64	end;
+    JITINT32	ready;
+
+    end	= 0;
+    if (timeout >= 0) {
+        end	= internal_now() + timeout;
+    }
+    ready	= 0;
+    while (ready == 0) {
+        JITINT32	eventsNumber;
+        JITINT32	count;
+        int		timeoutMS;
+
+        /* Compute the time left	*/
+        timeoutMS	= -1;
+        if (timeout >= 0) {
+            JITINT64	left;
+            left	= end - internal_now();
+            if (left < 0) {
+                left	= 0;
+            }
+            timeoutMS	= (int) ((left + 999) / 1000);
+        }
+
+        eventsNumber	= epoll_wait(engine->epollFD, engine->events, engine->eventsNumber, timeoutMS);
+        if (eventsNumber < 0) {
+            if (errno == EINTR) {
+                continue ;
+            }
+            return -1;
+        }
+        if (eventsNumber == 0) {
+            return 0;
+        }
+
+        /* Record the events of the handles asked by this select.
+         * Handles left registered by previous selects are removed, so they do not wake up the next ones.
+         */
+        for (count = 0; count < eventsNumber; count++) {
+            t_socket_poll_entry	*entry;
+            JITUINT32		events;
+            JITUINT32		readyEvents;
+            entry	= internal_getEntry(engine, engine->events[count].data.fd);
+            events	= engine->events[count].events;
+            if (entry->serial != engine->serial) {
+                epoll_ctl(engine->epollFD, EPOLL_CTL_DEL, engine->events[count].data.fd, NULL);
+                entry->registered	= 0;
+                continue ;
+            }
+            readyEvents	= 0;
+            if ((events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0) {
+                readyEvents	|= POLL_READ;
+            }
+            if ((events & (EPOLLOUT | EPOLLERR)) != 0) {
+                readyEvents	|= POLL_WRITE;
+            }
+            if ((events & EPOLLPRI) != 0) {
+                readyEvents	|= POLL_ERROR;
+            }
+            readyEvents	&= entry->wanted;
+            if (readyEvents != 0) {
+                entry->ready	|= readyEvents;
+                ready++;
+            }
+        }
+
+        /* Make room for more events next time	*/
+        if (((JITUINT32) eventsNumber) == engine->eventsNumber) {
+            engine->eventsNumber	*= 2;
+            engine->events		= dynamicReallocFunction(engine->events, sizeof(struct epoll_event) * engine->eventsNumber);
+        }
+    }
+
+    return ready;
+}
+
+static inline JITINT32 internal_countReady (t_socket_poll_engine *engine, JITNINT *handles, JITUINT32 handlesNumber, JITUINT32 events) {
+    JITUINT32	count;
+    JITINT32	ready;
+
+    if (handles == NULL) {
+        return 0;
+    }
+    ready	= 0;
+    for (count = 0; count < handlesNumber; count++) {
+        if (handles[count] < 0) {
+            continue ;
+        }
+        if ((engine->entries[handles[count]].ready & events) != 0) {
+            ready++;
+        }
+    }
+
+    return ready;
+}
+
+static inline void internal_compact (t_socket_poll_engine *engine, JITNINT *handles, JITUINT32 handlesNumber, JITUINT32 events) {
+    JITUINT32	count;
+
+    if (handles == NULL) {
+        return ;
+    }
+    for (count = 0; count < handlesNumber; count++) {
+        if (handles[count] < 0) {
+            continue ;
+        }
+        if ((engine->entries[handles[count]].ready & events) == 0) {
+            handles[count]	= -1;
+        }
+    }
+}
+
+static inline JITINT64 internal_now (void) {
+    struct timespec	now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (((JITINT64) now.tv_sec) * 1000000) + (now.tv_nsec / 1000);
+}
+
+#else
+
+void SOCKETPOLL_socketOpened (JITNINT handle) {
+    return ;
+}
+
+void SOCKETPOLL_socketClosed (JITNINT handle) {
+    return ;
+}
+
+JITBOOLEAN SOCKETPOLL_select (JITNINT *readHandles, JITUINT32 readHandlesNumber, JITNINT *writeHandles, JITUINT32 writeHandlesNumber, JITNINT *errorHandles, JITUINT32 errorHandlesNumber, JITINT64 timeout, JITINT32 *result) {
+    return JITFALSE;
+}
+
+#endif
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/**
+ * @file lib_socket_poll.h
+ */
+#ifndef LIB_SOCKET_POLL_H
+#define LIB_SOCKET_POLL_H
+
+#include <jitsystem.h>
+
+/**
+ * @defgroup SocketPoll Socket readiness engine
+ *
+ * Readiness of sockets for Platform.SocketMethods.Select.
+ *
+ * Every thread owns a persistent epoll instance.
+ * A socket stays registered between two selects, so a call only changes the registrations of the sockets whose interest changed.
+ * Handles are reused by the kernel: every socket creation and close bumps the generation of its handle, and a registration made with an older generation is redone.
+ */
+
+/**
+ * @ingroup SocketPoll
+ * @brief Record that a socket has been created
+ */
+void SOCKETPOLL_socketOpened (JITNINT handle);
+
+/**
+ * @ingroup SocketPoll
+ * @brief Record that a socket is going to be closed
+ */
+void SOCKETPOLL_socketClosed (JITNINT handle);
+
+/**
+ * @ingroup SocketPoll
+ * @brief Wait for sockets to be ready
+ *
+ * The semantics is the one of select(): the handles of the arrays that are not ready are replaced by -1 when at least one handle is ready.
+ * Handles equal to -1 are ignored.
+ *
+ * @param timeout Microseconds to wait; a negative value waits forever
+ * @param result Number of ready handles, 0 on timeout, or -1 with errno set on error
+ * @return JITFALSE if the handles cannot be waited for by the engine; the caller has to use select() instead
+ */
+JITBOOLEAN SOCKETPOLL_select (JITNINT *readHandles, JITUINT32 readHandlesNumber, JITNINT *writeHandles, JITUINT32 writeHandlesNumber, JITNINT *errorHandles, JITUINT32 errorHandlesNumber, JITINT64 timeout, JITINT32 *result);
+
+#endif
@@ -22,6 +22,7 @@
 #include <string.h>
 #include <compiler_memory_manager.h>
 #include <small_unicode.h>
+#include <utf16_primitives.h>
 #include <base_symbol.h>
 #include <platform_API.h>
 
@@ -65,6 +66,7 @@ static inline void * internal_fetchOrCreateUserStringObject (UserString *userStr
 static inline UserString * internal_getFetchOrCreateUserString (t_binary_information *binary, JITUINT32 row);
 static inline ir_symbol_t * internal_getUserStringSymbol (t_binary_information *binary, JITUINT32 row);
 static inline void * internal_getUserString (t_binary_information *binary, JITUINT32 row);
+static inline void internal_internUserStrings (t_binary_information *binary);
 static inline void internal_check_metadata (void);
 static inline void internal_lib_string_initialize (void);
 static inline void *internal_trim (void *string, void *whiteSpaces, JITINT32 trimFlag);
@@ -149,9 +151,10 @@ void init_stringManager (t_stringManager *stringManager) {
     stringManager->initialize = internal_lib_string_initialize;
     stringManager->getFirstCharOffset = internal_getFirstCharOffset;
 
-    //hash table usata dalle funzioni intern e isInterned
-    stringManager->internHashTable = xanHashTable_new(11, 0, allocFunction, dynamicReallocFunction, freeFunction, internal_hashFunction, internal_hashCompare);
+    //tabella usata dalle funzioni intern e isInterned
+    stringManager->internTable = STRINGINTERN_newTable(internal_toLiteral);
     stringManager->usObjects = xanHashTable_new(11, 0, sharedAllocFunction, dynamicReallocFunction, freeFunction, hashUserString, equalsUserString);
+    stringManager->binariesWithInternedUserStrings = xanHashTable_new(11, 0, allocFunction, dynamicReallocFunction, freeFunction, NULL, NULL);
 
     IRSYMBOL_registerSymbolManager(USER_STRING_SYMBOL, userStringResolve, userStringSerialize, userStringDump, userStringDeserialize);
 
@@ -631,6 +634,14 @@ static inline TypeDescriptor *internal_fillILStringType () {
 
 
 static inline void * internal_fetchOrCreateUserStringObject (UserString *userString) {
+    void            *object;
+
+    /* The object is written once: check it without taking the lock first	*/
+    object = __atomic_load_n(userString->object, __ATOMIC_ACQUIRE);
+    if (object != NULL) {
+        return object;
+    }
+
     PLATFORM_lockMutex(&(userString->mutex));
 
     /* Check if there exist the US  object	*/
@@ -638,6 +649,7 @@ static inline void * internal_fetchOrCreateUserStringObject (UserString *userStr
         t_row_us_stream usRow;
         JITINT16        *stringUTF16;
         JITUINT32 bytesString;
+        JITUINT32 hash;
 
         /* Load user string row from stream */
         get_us_row(&((userString->binary->metadata).streams_metadata.us_stream), userString->row, &usRow);
@@ -653,15 +665,23 @@ static inline void * internal_fetchOrCreateUserStringObject (UserString *userStr
         bytesString = usRow.bytesLength;
         assert(bytesString >= 0);
 
-        /* Allocate the string		*/
-        *(userString->object) = internal_newPermanentInstance( stringUTF16, (bytesString / 2));
-        assert(*(userString->object) != NULL);
+        /* Literals are interned: reuse the string with the same characters if there is one	*/
+        hash = ILUTF16Hash(stringUTF16, bytesString / 2);
+        object = STRINGINTERN_lookup((cliManager->CLR).stringManager.internTable, stringUTF16, bytesString / 2, hash);
+        if (object == NULL) {
+
+            /* Allocate the string		*/
+            object = internal_newPermanentInstance( stringUTF16, (bytesString / 2));
+            assert(object != NULL);
+
+            /* Mark object accessible by Intern e IsInterned functions */
+            object = STRINGINTERN_intern((cliManager->CLR).stringManager.internTable, object, internal_toLiteral(object), bytesString / 2, hash);
+        }
+        assert(object != NULL);
+        __atomic_store_n(userString->object, object, __ATOMIC_RELEASE);
 
         /* We don't need the terminated string anymore	*/
         freeMemory(stringUTF16);
-
-        /* Mark object accessible by Intern e IsInterned functions */
-        internal_intern(*(userString->object));
     }
 
     PLATFORM_unlockMutex(&(userString->mutex));
@@ -736,11 +756,54 @@ static inline void userStringDump (ir_symbol_t *symbol, FILE *fileToWrite) {
 }
 
 static inline ir_symbol_t * internal_getUserStringSymbol (t_binary_information *binary, JITUINT32 row) {
-    UserString *us = internal_getFetchOrCreateUserString(binary, row);
+    XanHashTable    *interned;
+    UserString      *us;
+
+    /* Intern every literal of the assembly the first time one of them is used.
+     * Later ldstr instructions of the assembly then resolve to the object without allocating or hashing.
+     */
+    interned = (cliManager->CLR).stringManager.binariesWithInternedUserStrings;
+    xanHashTable_lock(interned);
+    if (xanHashTable_lookup(interned, binary) == NULL) {
+        xanHashTable_insert(interned, binary, binary);
+        xanHashTable_unlock(interned);
+        internal_internUserStrings(binary);
+    } else {
+        xanHashTable_unlock(interned);
+    }
+
+    us = internal_getFetchOrCreateUserString(binary, row);
 
     return IRSYMBOL_createSymbol(USER_STRING_SYMBOL, (void *) us);
 }
 
+static inline void internal_internUserStrings (t_binary_information *binary) {
+    t_us_stream     *stream;
+    JITUINT32 offset;
+
+    /* Assertions					*/
+    assert(binary != NULL);
+
+    /* The first row of the #US stream is the empty blob	*/
+    stream = &((binary->metadata).streams_metadata.us_stream);
+    offset = 1;
+    while (offset < stream->size) {
+        t_row_us_stream usRow;
+
+        get_us_row(stream, offset, &usRow);
+        if (usRow.string == NULL) { /* Padding at the end of the stream	*/
+            offset++;
+            continue;
+        }
+        internal_fetchOrCreateUserStringObject(internal_getFetchOrCreateUserString(binary, offset));
+
+        /* Skip the characters and the final byte of the row	*/
+        offset = (usRow.string - stream->raw_stream) + usRow.bytesLength + 1;
+    }
+
+    return ;
+}
+
 static inline ir_symbol_t * userStringDeserialize (void *mem, JITUINT32 memBytes) {
     JITINT8 *binaryName;
     t_binary_information *binary;
@@ -924,21 +987,16 @@ static inline void *internal_trim (void *string, void *whiteSpaces, JITINT32 tri
 }
 
 static inline JITUINT32 internal_hashFunction (void *string) {
-    JITINT32 hash = 0;
     JITINT16        *buf;
     JITINT32 buf_len;
-    JITINT32 i;
 
     buf_len = internal_getLength(string);
     assert(buf_len >= 0);
     buf = internal_toLiteral(string);
     assert(buf != NULL);
 
-    for (i = 0; i < buf_len; i++) {
-        hash = (hash << 5) + hash + (JITINT32) (buf[i]);
-    }
-
-    return hash;
+    /* hash = hash * 33 + buf[i], computed with vector instructions when available	*/
+    return ILUTF16Hash(buf, buf_len);
 }
 
 static inline JITINT32 internal_hashCompare (void *key1, void *key2) {
@@ -963,37 +1021,30 @@ static inline JITINT32 internal_hashCompare (void *key1, void *key2) {
 }
 
 static inline void * internal_intern (void *string) {
-    XanHashTable    *table;
+    JITINT16        *literal;
+    JITINT32 length;
 
     /* Assertions					*/
     assert(string != NULL);
 
-    table = (cliManager->CLR).stringManager.internHashTable;
-    assert(table != NULL);
-
-    xanHashTable_lock(table);
-    if (!xanHashTable_lookup(table, string)) {
-        xanHashTable_insert(table, string, string);
-    }
-    assert(xanHashTable_lookup(table, string) != NULL);
-    xanHashTable_unlock(table);
+    literal = internal_toLiteral(string);
+    length = internal_getLength(string);
 
-    /* Return					*/
-    return string;
+    /* Return the string already interned with the same characters, if any	*/
+    return STRINGINTERN_intern((cliManager->CLR).stringManager.internTable, string, literal, length, ILUTF16Hash(literal, length));
 }
 
 static inline void *internal_isInterned (void *string) {
-    void            *ret;
-    XanHashTable    *table;
-
-    table = (cliManager->CLR).stringManager.internHashTable;
-    assert(table != NULL);
+    JITINT16        *literal;
+    JITINT32 length;
 
-    xanHashTable_lock(table);
-    ret = xanHashTable_lookup(table, string);
-    xanHashTable_unlock(table);
+    if (string == NULL) {
+        return NULL;
+    }
+    literal = internal_toLiteral(string);
+    length = internal_getLength(string);
 
-    return ret;
+    return STRINGINTERN_lookup((cliManager->CLR).stringManager.internTable, literal, length, ILUTF16Hash(literal, length));
 }
 
 /*AGGIUNTE PER IL DEBUG*/
@@ -1114,8 +1165,9 @@ static inline void internal_destroyStringManager (t_stringManager *self) {
 
     /* Destroy the used hash tables.
      */
-    xanHashTable_destroyTable((cliManager->CLR).stringManager.internHashTable);
+    STRINGINTERN_destroyTable((cliManager->CLR).stringManager.internTable);
     xanHashTable_destroyTable((cliManager->CLR).stringManager.usObjects);
+    xanHashTable_destroyTable((cliManager->CLR).stringManager.binariesWithInternedUserStrings);
 
     return ;
 }
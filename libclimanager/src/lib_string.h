@@ -29,6 +29,7 @@
 #include <metadata/metadata_types.h>
 #include <metadata/streams/metadata_streams_manager.h>
 #include <platform_API.h>
+#include <lib_string_intern.h>
 
 /**
  * @brief String manager
@@ -47,7 +48,8 @@ typedef struct t_stringManager {
     JITINT32 capacityFieldOffset;
     JITINT32 firstCharFieldOffset;
     XanHashTable    *usObjects;
-    XanHashTable    *internHashTable;
+    XanHashTable    *binariesWithInternedUserStrings;     /**< Assemblies whose user strings have been interned	*/
+    t_string_intern_table *internTable;                    /**< Strings interned by String.Intern and by ldstr	*/
 
     TypeDescriptor *                (*fillILStringType)();                          /**< Store the information about the System.String class		*/
     JITINT32 (*getLength)(void *string);                                            /**< Return the number of UTF16 characters stored inside the System.String object given as input	*/
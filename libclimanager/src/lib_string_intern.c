@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <compiler_memory_manager.h>
+#include <platform_API.h>
+
+// My headers
+#include <lib_string_intern.h>
+// End
+
+#define INITIAL_SHARD_SLOTS	16
+
+static inline JITUINT32 internal_mixHash (JITUINT32 hash);
+static inline t_string_intern_shard * internal_getShard (t_string_intern_table *table, JITUINT32 mixedHash);
+static inline t_string_intern_slots * internal_newSlots (JITUINT32 slotsNumber);
+static inline void * internal_lookupInSlots (t_string_intern_table *table, t_string_intern_slots *slots, JITUINT32 mixedHash, JITINT16 *literal, JITINT32 length, JITUINT32 hash);
+static inline void internal_growShard (t_string_intern_shard *shard);
+
+t_string_intern_table * STRINGINTERN_newTable (JITINT16 * (*toLiteral)(void *string)) {
+    t_string_intern_table	*table;
+    JITUINT32		count;
+
+    /* Assertions			*/
+    assert(toLiteral != NULL);
+
+    table			= allocFunction(sizeof(t_string_intern_table));
+    table->toLiteral	= toLiteral;
+    for (count = 0; count < STRINGINTERN_SHARDS; count++) {
+        t_string_intern_shard	*shard;
+        shard			= &(table->shards[count]);
+        shard->slots		= internal_newSlots(INITIAL_SHARD_SLOTS);
+        shard->used		= 0;
+        shard->retiredSlots	= xanList_new(allocFunction, freeFunction, NULL);
+        PLATFORM_initMutex(&(shard->mutex), NULL);
+    }
+
+    return table;
+}
+
+void * STRINGINTERN_lookup (t_string_intern_table *table, JITINT16 *literal, JITINT32 length, JITUINT32 hash) {
+    t_string_intern_shard	*shard;
+    t_string_intern_slots	*slots;
+    JITUINT32		mixedHash;
+
+    /* Assertions			*/
+    assert(table != NULL);
+    assert((literal != NULL) || (length == 0));
+
+    mixedHash	= internal_mixHash(hash);
+    shard		= internal_getShard(table, mixedHash);
+    slots		= __atomic_load_n(&(shard->slots), __ATOMIC_ACQUIRE);
+
+    return internal_lookupInSlots(table, slots, mixedHash, literal, length, hash);
+}
+
+void * STRINGINTERN_intern (t_string_intern_table *table, void *string, JITINT16 *literal, JITINT32 length, JITUINT32 hash) {
+    t_string_intern_shard	*shard;
+    t_string_intern_slots	*slots;
+    t_string_intern_entry	*entry;
+    void			*interned;
+    JITUINT32		mixedHash;
+    JITUINT32		index;
+
+    /* Assertions			*/
+    assert(table != NULL);
+    assert(string != NULL);
+
+    /* Strings are usually interned many times: look for them without taking the lock first.
+     */
+    mixedHash	= internal_mixHash(hash);
+    shard		= internal_getShard(table, mixedHash);
+    slots		= __atomic_load_n(&(shard->slots), __ATOMIC_ACQUIRE);
+    interned	= internal_lookupInSlots(table, slots, mixedHash, literal, length, hash);
+    if (interned != NULL) {
+        return interned;
+    }
+
+    /* Check again while holding the lock: another thread could have interned the same characters.
+     */
+    PLATFORM_lockMutex(&(shard->mutex));
+    interned	= internal_lookupInSlots(table, shard->slots, mixedHash, literal, length, hash);
+    if (interned != NULL) {
+        PLATFORM_unlockMutex(&(shard->mutex));
+        return interned;
+    }
+
+    /* Keep the load factor below one half	*/
+    if (((shard->used + 1) * 2) > (shard->slots->mask + 1)) {
+        internal_growShard(shard);
+    }
+    slots	= shard->slots;
+
+    /* Publish the entry: the object is written last, so lookups that see it see its hash and its length as well.
+     */
+    index	= mixedHash & slots->mask;
+    while (slots->entries[index].object != NULL) {
+        index	= (index + 1) & slots->mask;
+    }
+    entry		= &(slots->entries[index]);
+    entry->hash	= hash;
+    entry->length	= length;
+    __atomic_store_n(&(entry->object), string, __ATOMIC_RELEASE);
+    (shard->used)++;
+    PLATFORM_unlockMutex(&(shard->mutex));
+
+    return string;
+}
+
+XanList * STRINGINTERN_toSlotList (t_string_intern_table *table) {
+    XanList		*list;
+    JITUINT32	count;
+
+    /* Assertions			*/
+    assert(table != NULL);
+
+    list	= xanList_new(allocFunction, freeFunction, NULL);
+    for (count = 0; count < STRINGINTERN_SHARDS; count++) {
+        t_string_intern_shard	*shard;
+        t_string_intern_slots	*slots;
+        JITUINT32		index;
+        shard	= &(table->shards[count]);
+        PLATFORM_lockMutex(&(shard->mutex));
+        slots	= shard->slots;
+        for (index = 0; index <= slots->mask; index++) {
+            if (slots->entries[index].object != NULL) {
+                xanList_append(list, &(slots->entries[index].object));
+            }
+        }
+        PLATFORM_unlockMutex(&(shard->mutex));
+    }
+
+    return list;
+}
+
+void STRINGINTERN_destroyTable (t_string_intern_table *table) {
+    JITUINT32	count;
+
+    /* Assertions			*/
+    assert(table != NULL);
+
+    for (count = 0; count < STRINGINTERN_SHARDS; count++) {
+        t_string_intern_shard	*shard;
+        XanListItem		*item;
+        shard	= &(table->shards[count]);
+        item	= xanList_first(shard->retiredSlots);
+        while (item != NULL) {
+            t_string_intern_slots	*slots;
+            slots	= item->data;
+            freeFunction(slots->entries);
+            freeFunction(slots);
+            item	= item->next;
+        }
+        xanList_destroyList(shard->retiredSlots);
+        freeFunction(shard->slots->entries);
+        freeFunction(shard->slots);
+        PLATFORM_destroyMutex(&(shard->mutex));
+    }
+    freeFunction(table);
+
+    return ;
+}
+
+static inline JITUINT32 internal_mixHash (JITUINT32 hash) {
+
+    /* The string hash keeps short strings in its lower bits: spread them before selecting shards and slots.
+     */
+    hash	^= hash >> 16;
+    hash	*= 0x85EBCA6BU;
+    hash	^= hash >> 13;
+    hash	*= 0xC2B2AE35U;
+    hash	^= hash >> 16;
+
+    return hash;
+}
+
+static inline t_string_intern_shard * internal_getShard (t_string_intern_table *table, JITUINT32 mixedHash) {
+    return &(table->shards[mixedHash >> (32 - STRINGINTERN_SHARDS_BITS)]);
+}
+
+static inline t_string_intern_slots * internal_newSlots (JITUINT32 slotsNumber) {
+    t_string_intern_slots	*slots;
+
+    /* Assertions			*/
+    assert((slotsNumber & (slotsNumber - 1)) == 0);
+
+    slots		= allocFunction(sizeof(t_string_intern_slots));
+    slots->entries	= allocFunction(sizeof(t_string_intern_entry) * slotsNumber);
+    memset(slots->entries, 0, sizeof(t_string_intern_entry) * slotsNumber);
+    slots->mask	= slotsNumber - 1;
+
+    return slots;
+}
+
+static inline void * internal_lookupInSlots (t_string_intern_table *table, t_string_intern_slots *slots, JITUINT32 mixedHash, JITINT16 *literal, JITINT32 length, JITUINT32 hash) {
+    JITUINT32	index;
+
+    index	= mixedHash & slots->mask;
+    while (JITTRUE) {
+        t_string_intern_entry	*entry;
+        void			*object;
+        entry	= &(slots->entries[index]);
+        object	= __atomic_load_n(&(entry->object), __ATOMIC_ACQUIRE);
+        if (object == NULL) {
+            return NULL;
+        }
+        if (	(entry->hash == hash)									&&
+                (entry->length == length)								&&
+                (memcmp(table->toLiteral(object), literal, sizeof(JITINT16) * length) == 0)	) {
+            return object;
+        }
+        index	= (index + 1) & slots->mask;
+    }
+}
+
+static inline void internal_growShard (t_string_intern_shard *shard) {
+    t_string_intern_slots	*oldSlots;
+    t_string_intern_slots	*newSlots;
+    JITUINT32		count;
+
+    /* Copy the entries to a table twice as large.
+     * Lookups in progress keep reading the old entries, so they are freed with the table only.
+     */
+    oldSlots	= shard->slots;
+    newSlots	= internal_newSlots((oldSlots->mask + 1) * 2);
+    for (count = 0; count <= oldSlots->mask; count++) {
+        t_string_intern_entry	*entry;
+        JITUINT32		index;
+        entry	= &(oldSlots->entries[count]);
+        if (entry->object == NULL) {
+            continue ;
+        }
+        index	= internal_mixHash(entry->hash) & newSlots->mask;
+        while (newSlots->entries[index].object != NULL) {
+            index	= (index + 1) & newSlots->mask;
+        }
+        newSlots->entries[index]	= *entry;
+    }
+    __atomic_store_n(&(shard->slots), newSlots, __ATOMIC_RELEASE);
+    xanList_append(shard->retiredSlots, oldSlots);
+
+    return ;
+}
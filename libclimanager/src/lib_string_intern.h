@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/**
+ * @file lib_string_intern.h
+ */
+#ifndef LIB_STRING_INTERN_H
+#define LIB_STRING_INTERN_H
+
+#include <pthread.h>
+#include <xanlib.h>
+#include <jitsystem.h>
+
+#define STRINGINTERN_SHARDS_BITS	6
+#define STRINGINTERN_SHARDS		(1 << STRINGINTERN_SHARDS_BITS)
+
+typedef struct {
+    void		*object;		/**< Interned System.String; NULL if the slot is free	*/
+    JITUINT32	hash;			/**< Hash of the characters of the string		*/
+    JITINT32	length;			/**< Number of characters of the string			*/
+} t_string_intern_entry;
+
+typedef struct {
+    t_string_intern_entry	*entries;
+    JITUINT32		mask;		/**< Number of entries minus one			*/
+} t_string_intern_slots;
+
+typedef struct {
+    t_string_intern_slots	*slots;		/**< Slots in use: they are read without taking the lock	*/
+    JITUINT32		used;
+    pthread_mutex_t		mutex;		/**< Serializes insertions within the shard			*/
+    XanList			*retiredSlots;	/**< Slots replaced by a resize that lookups in progress can still read	*/
+} t_string_intern_shard;
+
+/**
+ * @brief Table of interned strings
+ *
+ * The table is split in shards selected by the hash of the string.
+ * Every shard is an open addressing table with linear probing.
+ *
+ * Lookups do not take locks: an entry becomes visible only after its hash and its length are written, and it is never removed.
+ * Insertions take the lock of their shard only.
+ */
+typedef struct {
+    t_string_intern_shard	shards[STRINGINTERN_SHARDS];
+    JITINT16 *		(*toLiteral)(void *string);
+} t_string_intern_table;
+
+/**
+ * @brief Make a new table of interned strings
+ *
+ * @param toLiteral Return the characters of a System.String object
+ */
+t_string_intern_table * STRINGINTERN_newTable (JITINT16 * (*toLiteral)(void *string));
+
+/**
+ * @brief Find the interned string that has the characters given as input
+ *
+ * @param hash Hash of the characters as computed by ILUTF16Hash
+ * @return the interned System.String object, or NULL
+ */
+void * STRINGINTERN_lookup (t_string_intern_table *table, JITINT16 *literal, JITINT32 length, JITUINT32 hash);
+
+/**
+ * @brief Intern a string
+ *
+ * If a string with the same characters has been already interned, it is returned.
+ * Otherwise <code> string </code> is interned and returned.
+ *
+ * @param literal Characters of <code> string </code>
+ * @param hash Hash of the characters as computed by ILUTF16Hash
+ * @return the interned System.String object
+ */
+void * STRINGINTERN_intern (t_string_intern_table *table, void *string, JITINT16 *literal, JITINT32 length, JITUINT32 hash);
+
+/**
+ * @brief Return the addresses of the references to the interned strings
+ *
+ * The list is used by the garbage collector as part of the root set.
+ */
+XanList * STRINGINTERN_toSlotList (t_string_intern_table *table);
+
+/**
+ * @brief Destroy the table
+ *
+ * The strings are not freed.
+ */
+void STRINGINTERN_destroyTable (t_string_intern_table *table);
+
+#endif
@@ -19,6 +19,7 @@
  */
 #include <lib_thread.h>
 #include <errno.h>
+#include <string.h>
 #include <compiler_memory_manager.h>
 #include <platform_API.h>
 #include <ir_optimization_interface.h>
@@ -69,6 +70,7 @@
 
 extern CLIManager_t *cliManager;
 static pthread_once_t tm_metadataLock = PTHREAD_ONCE_INIT;
+static pthread_once_t tm_threadPoolLock = PTHREAD_ONCE_INIT;
 
 static void tm_initialize (void);
 static void tm_shutdownThreadManager (t_threadsManager *self);
@@ -103,6 +105,9 @@ static void tm_unlockLocalMutex (CLRLocalMutex* mutex);
 static void tm_constrain (CLRThread* threadInfo_src, CLRThread* threadInfo_dest);
 static void tm_movethread (CLRThread* threadInfo_src, JITUINT32 core);
 static XanList* tm_getFreeCPUs (void);
+static JITBOOLEAN tm_queueWorkItem (void* delegate, void* argument);
+static JITBOOLEAN tm_isProvidedByThePool (MethodDescriptor* method);
+static void tm_buildMethod (Method method);
 /* Private functions prototypes */
 static CLRThread* tm_buildCurrentThreadDescription (void);
 static JITBOOLEAN tm_initialize_mono_thread (void* thread, CLRThread* threadinfo);
@@ -136,6 +141,9 @@ static JITBOOLEAN tm_waitForLaunch (CLRThread* threadInfos);
 static void tm_changeThreadState (CLRThread* threadInfos, JITINT32 state);
 static inline void tm_writeThreadState (CLRThread* threadInfo, JITINT32 state);
 static inline JITINT32 tm_readThreadState (CLRThread* threadInfo);
+static void tm_startThreadPool (void);
+static void tm_initThreadPoolWorker (void);
+static void tm_runThreadPoolItem (void* delegate, void* argument);
 
 /* Current thread description */
 static __thread CLRThread* currentThreadDescription = NULL;
@@ -176,12 +184,16 @@ void init_threadsManager (t_threadsManager *self) {
     self->constrain = tm_constrain;
     self->movethread = tm_movethread;
     self->getFreeCPUs = tm_getFreeCPUs;
+    self->queueWorkItem = tm_queueWorkItem;
+    self->isProvidedByThePool = tm_isProvidedByThePool;
+    self->buildMethod = tm_buildMethod;
     /* Initialize internal state */
     tm_initRecursiveMutexDescription();
     tm_initThreadDefaultAttributes();
     self->locationLocks = xanHashTable_new(DEFAULT_LOCATION_LOCKS_SIZE, JITFALSE, allocFunction, dynamicReallocFunction, freeFunction, NULL, NULL);
     self->unstartedThreads = xanList_new(allocFunction, freeFunction, NULL);
     self->foregroundThreads = xanList_new(allocFunction, freeFunction, NULL);
+    self->threadPool = NULL;
 
 }
 
@@ -193,6 +205,81 @@ static void tm_shutdownThreadManager (t_threadsManager *self) {
     return ;
 }
 
+/* Queue a delegate call to the thread pool */
+static JITBOOLEAN tm_queueWorkItem (void* delegate, void* argument) {
+    t_thread_pool* pool;
+
+    if (delegate == NULL) {
+        return JITFALSE;
+    }
+    PLATFORM_pthread_once(&tm_threadPoolLock, tm_startThreadPool);
+    pool = (cliManager->CLR).threadsManager.threadPool;
+    if (pool == NULL) {
+        return JITFALSE;
+    }
+    THREADPOOL_push(pool, delegate, argument);
+
+    return JITTRUE;
+}
+
+/* Check whether the method is the managed entry point of the thread pool */
+static JITBOOLEAN tm_isProvidedByThePool (MethodDescriptor* method) {
+
+    /* Check the short name first: it does not need to build any string */
+    if (STRCMP(method->getName(method), (JITINT8 *) "QueueCompletionItem") != 0) {
+        return JITFALSE;
+    }
+    if (STRCMP(method->getCompleteName(method), (JITINT8 *) "System.Threading.ThreadPool.QueueCompletionItem") != 0) {
+        return JITFALSE;
+    }
+
+    /* The body forwards the callback and its state only */
+    if (    (!method->attributes->is_static)                           ||
+            (xanList_length(method->getParams(method)) != 2)   ) {
+        return JITFALSE;
+    }
+
+    return JITTRUE;
+}
+
+/* Build a body that queues the callback to the native thread pool */
+static void tm_buildMethod (Method method) {
+    ir_method_t* body;
+    ir_instruction_t* instruction;
+    ir_item_t queued;
+    ir_item_t callback;
+    ir_item_t state;
+    XanList* parameters;
+
+    /* Assertions */
+    assert(method != NULL);
+    body = method->getIRMethod(method);
+
+    /* Forward the parameters to tm_queueWorkItem */
+    memset(&callback, 0, sizeof(ir_item_t));
+    callback.value.v = 0;
+    callback.type = IROFFSET;
+    callback.internal_type = IROBJECT;
+    memset(&state, 0, sizeof(ir_item_t));
+    state.value.v = 1;
+    state.type = IROFFSET;
+    state.internal_type = IROBJECT;
+    parameters = xanList_new(allocFunction, freeFunction, NULL);
+    xanList_append(parameters, &callback);
+    xanList_append(parameters, &state);
+    IRMETHOD_newVariable(body, &queued, IRMETHOD_getResultType(body), NULL);
+    IRMETHOD_newNativeCallInstruction(body, "tm_queueWorkItem", tm_queueWorkItem, &queued, parameters);
+    xanList_destroyList(parameters);
+
+    /* Return whether the callback has been queued */
+    instruction = IRMETHOD_newInstructionOfType(body, IRRET);
+    IRMETHOD_cpInstructionParameter1(instruction, &queued);
+
+    method->lock(method);
+    method->setState(method, IR_STATE);
+    method->unlock(method);
+}
+
 /* Force metadata loading */
 static void tm_initialize (void) {
     PLATFORM_pthread_once(&tm_metadataLock, tm_loadMetadata);
@@ -334,7 +421,9 @@ static void tm_sleep (JITINT32 milliseconds) {
                                 THREAD_STATE_WAITSLEEPJOIN);
 
             /* Sleep */
+            IRVM_enterBlockingRegion(cliManager->IRVM);
             PLATFORM_nanosleep(&sleepTime, NULL);
+            IRVM_leaveBlockingRegion(cliManager->IRVM);
 
             /* Now I'm running */
             tm_writeThreadState(selfThreadInfos, THREAD_STATE_RUNNING);
@@ -1233,7 +1322,9 @@ static void tm_broadcastSignalThreadState (CLRThread* threadInfos) {
 
 /* Wait for thread state changes */
 static void tm_waitThreadState (CLRThread* threadInfos) {
+    IRVM_enterBlockingRegion(cliManager->IRVM);
     PLATFORM_waitCondVar(&threadInfos->stateCondition, &threadInfos->stateLock);
+    IRVM_leaveBlockingRegion(cliManager->IRVM);
 }
 
 /* Initialize an event monitor */
@@ -1287,7 +1378,9 @@ static void tm_broadcastSignalEvent (CLRWaitEvent* event) {
 /* Wait for event change */
 static void tm_waitEventSignal (CLRWaitEvent* event) {
 
+    IRVM_enterBlockingRegion(cliManager->IRVM);
     PLATFORM_waitCondVar(&event->signalCondition, &event->lock);
+    IRVM_leaveBlockingRegion(cliManager->IRVM);
 
 }
 
@@ -1723,3 +1816,32 @@ static inline JITINT32 tm_readThreadState (CLRThread* threadInfo) {
 
     return state;
 }
+
+/* Start the workers of the thread pool */
+static void tm_startThreadPool (void) {
+    t_threadsManager* self;
+
+    self = &(cliManager->CLR).threadsManager;
+    self->threadPool = THREADPOOL_newPool(0, cliManager->gc->threadCreate, &(self->threadDefaultAttributes), tm_initThreadPoolWorker, tm_runThreadPoolItem);
+}
+
+/* Turn the current native thread into a background CIL thread */
+static void tm_initThreadPoolWorker (void) {
+    CLRThread* threadInfos;
+
+    /* Build the System.Threading.Thread object now: it allocates, and
+     * work items are not in the root set once they leave the pool */
+    tm_getCurrentThread();
+    threadInfos = GET_CURRENT_THREAD_DESCRIPTION();
+    tm_writeThreadState(threadInfos, THREAD_STATE_RUNNING | THREAD_STATE_BACKGROUND);
+}
+
+/* Run a work item of the thread pool */
+static void tm_runThreadPoolItem (void* delegate, void* argument) {
+    t_delegatesManager* delegatesManager;
+
+    delegatesManager = &((cliManager->CLR).delegatesManager);
+    if (!delegatesManager->invoke(delegatesManager, delegate, argument)) {
+        printf("LIBCLIMANAGER: lib_thread.c: An exception has been thrown by a work item of the thread pool\n");
+    }
+}
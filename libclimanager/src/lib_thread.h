@@ -24,6 +24,7 @@
 #include <jitsystem.h>
 #include <ilmethod.h>
 #include <platform_API.h>
+#include <lib_threadpool.h>
 
 /**
  * Name of the privataData field inside a System.Threading.Thread object
@@ -279,6 +280,12 @@ typedef struct t_threadsManager {
      */
     XanList* foregroundThreads;
 
+    /**
+     * Native pool that runs completion callbacks and queued delegates; NULL
+     * until the first item is queued
+     */
+    t_thread_pool* threadPool;
+
     /**
      * Offset of the privateData field inside a System.Threading.Thread
      * object
@@ -585,6 +592,41 @@ typedef struct t_threadsManager {
      * @endcode
      */
     XanList *(*getFreeCPUs)(void);
+
+    /**
+     * Queue the call of a delegate to the native thread pool
+     *
+     * The delegate is called with argument as its only parameter by a
+     * background thread of the pool. The pool is started by the first call.
+     *
+     * @param delegate the delegate to call
+     * @param argument the argument of the call
+     *
+     * @return JITTRUE if the call has been queued, JITFALSE if the pool
+     *         could not be started
+     */
+    JITBOOLEAN (*queueWorkItem)(void* delegate, void* argument);
+
+    /**
+     * Check whether the body of a method is provided by the native thread
+     * pool
+     *
+     * System.Threading.ThreadPool.QueueCompletionItem, which the BCL uses to
+     * run the asynchronous calls started by BeginInvoke, is redirected to
+     * queueWorkItem.
+     *
+     * @param method the method to check
+     *
+     * @return JITTRUE if the body has to be built by buildMethod
+     */
+    JITBOOLEAN (*isProvidedByThePool)(MethodDescriptor* method);
+
+    /**
+     * Build the body of a method provided by the native thread pool
+     *
+     * @param method a method for which isProvidedByThePool returns JITTRUE
+     */
+    void (*buildMethod)(Method method);
 } t_threadsManager;
 
 /**
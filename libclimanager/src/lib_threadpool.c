@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <compiler_memory_manager.h>
+#include <platform_API.h>
+#include <iljit-utils.h>
+
+// My headers
+#include <lib_threadpool.h>
+// End
+
+#define INITIAL_DEQUE_SLOTS	64
+
+static inline void internal_initDeque (t_thread_pool_deque *deque);
+static inline void internal_pushBottom (t_thread_pool_deque *deque, void *delegate, void *argument);
+static inline JITBOOLEAN internal_popBottom (t_thread_pool_deque *deque, t_thread_pool_item *item);
+static inline JITBOOLEAN internal_stealTop (t_thread_pool_deque *deque, t_thread_pool_item *item);
+static inline void internal_growDeque (t_thread_pool_deque *deque);
+static inline void internal_takeItem (t_thread_pool_worker *worker, t_thread_pool_item *item);
+static void * internal_workerRun (t_thread_pool_worker *worker);
+
+/* Worker that runs on the current thread; NULL outside the pool */
+static __thread t_thread_pool_worker *currentWorker = NULL;
+
+t_thread_pool * THREADPOOL_newPool (JITUINT32 workersNumber, JITINT32 (*createThread)(pthread_t *thread, pthread_attr_t *attr, void *(*startRoutine)(void *), void *arg), pthread_attr_t *attributes, void (*initWorker)(void), void (*runItem)(void *delegate, void *argument)) {
+    t_thread_pool	*pool;
+    JITUINT32	count;
+    JITUINT32	startedWorkers;
+    JITINT32	error;
+
+    /* Assertions			*/
+    assert(createThread != NULL);
+    assert(runItem != NULL);
+
+    if (workersNumber == 0) {
+        workersNumber	= PLATFORM_getProcessorsNumber();
+        if (workersNumber == 0) {
+            workersNumber	= 1;
+        }
+    }
+
+    pool			= allocFunction(sizeof(t_thread_pool));
+    pool->workers		= allocFunction(sizeof(t_thread_pool_worker) * workersNumber);
+    pool->workersNumber	= workersNumber;
+    pool->nextWorker	= 0;
+    pool->pendingItems	= 0;
+    pool->runItem		= runItem;
+    pool->initWorker	= initWorker;
+    PLATFORM_initMutex(&(pool->sleepMutex), NULL);
+    PLATFORM_initCondVar(&(pool->sleepCondition), NULL);
+
+    /* Every deque must exist before any worker starts stealing	*/
+    for (count = 0; count < workersNumber; count++) {
+        t_thread_pool_worker	*worker;
+        worker		= &(pool->workers[count]);
+        worker->index	= count;
+        worker->pool	= pool;
+        internal_initDeque(&(worker->deque));
+    }
+
+    /* Items pushed to the deque of a worker that did not start are stolen by the others	*/
+    startedWorkers	= 0;
+    for (count = 0; count < workersNumber; count++) {
+        error	= createThread(&(pool->workers[count].id), attributes, (void * (*)(void *)) internal_workerRun, &(pool->workers[count]));
+        if (error != 0) {
+            print_err("THREADPOOL: Unable to create a worker of the thread pool", error);
+            continue ;
+        }
+        startedWorkers++;
+    }
+    if (startedWorkers == 0) {
+        for (count = 0; count < workersNumber; count++) {
+            freeFunction(pool->workers[count].deque.items);
+            PLATFORM_destroyMutex(&(pool->workers[count].deque.mutex));
+        }
+        PLATFORM_destroyMutex(&(pool->sleepMutex));
+        PLATFORM_destroyCondVar(&(pool->sleepCondition));
+        freeFunction(pool->workers);
+        freeFunction(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+void THREADPOOL_push (t_thread_pool *pool, void *delegate, void *argument) {
+    t_thread_pool_worker	*worker;
+
+    /* Assertions			*/
+    assert(pool != NULL);
+    assert(delegate != NULL);
+
+    /* Workers keep the items they generate: they are likely to touch the same data.
+     */
+    worker	= currentWorker;
+    if (	(worker == NULL)		||
+            (worker->pool != pool)		) {
+        JITUINT32	index;
+        index	= __atomic_fetch_add(&(pool->nextWorker), 1, __ATOMIC_RELAXED);
+        worker	= &(pool->workers[index % pool->workersNumber]);
+    }
+    internal_pushBottom(&(worker->deque), delegate, argument);
+
+    /* The counter is changed while holding the lock the sleeping workers check it with, so no wake up is lost.
+     */
+    PLATFORM_lockMutex(&(pool->sleepMutex));
+    __atomic_add_fetch(&(pool->pendingItems), 1, __ATOMIC_RELEASE);
+    PLATFORM_signalCondVar(&(pool->sleepCondition));
+    PLATFORM_unlockMutex(&(pool->sleepMutex));
+
+    return ;
+}
+
+XanList * THREADPOOL_toSlotList (t_thread_pool *pool) {
+    XanList		*list;
+    JITUINT32	count;
+
+    /* Assertions			*/
+    assert(pool != NULL);
+
+    list	= xanList_new(allocFunction, freeFunction, NULL);
+    for (count = 0; count < pool->workersNumber; count++) {
+        t_thread_pool_deque	*deque;
+        JITUINT32		index;
+        deque	= &(pool->workers[count].deque);
+        PLATFORM_lockMutex(&(deque->mutex));
+        for (index = deque->top; index != deque->bottom; index++) {
+            t_thread_pool_item	*item;
+            item	= &(deque->items[index & deque->mask]);
+            xanList_append(list, &(item->delegate));
+            if (item->argument != NULL) {
+                xanList_append(list, &(item->argument));
+            }
+        }
+        PLATFORM_unlockMutex(&(deque->mutex));
+    }
+
+    return list;
+}
+
+static void * internal_workerRun (t_thread_pool_worker *worker) {
+    t_thread_pool		*pool;
+    t_thread_pool_item	item;
+
+    /* Assertions			*/
+    assert(worker != NULL);
+
+    pool		= worker->pool;
+    currentWorker	= worker;
+
+    /* Prepare the thread before taking any item: the items are not roots of the collector once they leave the deques.
+     */
+    if (pool->initWorker != NULL) {
+        (pool->initWorker)();
+    }
+
+    while (JITTRUE) {
+        internal_takeItem(worker, &item);
+        (pool->runItem)(item.delegate, item.argument);
+    }
+
+    return NULL;
+}
+
+static inline void internal_takeItem (t_thread_pool_worker *worker, t_thread_pool_item *item) {
+    t_thread_pool	*pool;
+
+    pool	= worker->pool;
+    while (JITTRUE) {
+        JITUINT32	count;
+
+        /* Look at the own deque first, then steal from the others	*/
+        if (internal_popBottom(&(worker->deque), item)) {
+            __atomic_sub_fetch(&(pool->pendingItems), 1, __ATOMIC_RELAXED);
+            return ;
+        }
+        for (count = 1; count < pool->workersNumber; count++) {
+            t_thread_pool_worker	*victim;
+            victim	= &(pool->workers[(worker->index + count) % pool->workersNumber]);
+            if (internal_stealTop(&(victim->deque), item)) {
+                __atomic_sub_fetch(&(pool->pendingItems), 1, __ATOMIC_RELAXED);
+                return ;
+            }
+        }
+
+        /* Sleep until new items are pushed	*/
+        PLATFORM_lockMutex(&(pool->sleepMutex));
+        while (__atomic_load_n(&(pool->pendingItems), __ATOMIC_ACQUIRE) == 0) {
+            PLATFORM_waitCondVar(&(pool->sleepCondition), &(pool->sleepMutex));
+        }
+        PLATFORM_unlockMutex(&(pool->sleepMutex));
+    }
+}
+
+static inline void internal_initDeque (t_thread_pool_deque *deque) {
+    deque->items	= allocFunction(sizeof(t_thread_pool_item) * INITIAL_DEQUE_SLOTS);
+    memset(deque->items, 0, sizeof(t_thread_pool_item) * INITIAL_DEQUE_SLOTS);
+    deque->mask	= INITIAL_DEQUE_SLOTS - 1;
+    deque->top	= 0;
+    deque->bottom	= 0;
+    PLATFORM_initMutex(&(deque->mutex), NULL);
+}
+
+static inline void internal_pushBottom (t_thread_pool_deque *deque, void *delegate, void *argument) {
+    t_thread_pool_item	*item;
+
+    PLATFORM_lockMutex(&(deque->mutex));
+    if ((deque->bottom - deque->top) > deque->mask) {
+        internal_growDeque(deque);
+    }
+    item		= &(deque->items[deque->bottom & deque->mask]);
+    item->delegate	= delegate;
+    item->argument	= argument;
+    __atomic_store_n(&(deque->bottom), deque->bottom + 1, __ATOMIC_RELAXED);
+    PLATFORM_unlockMutex(&(deque->mutex));
+
+    return ;
+}
+
+static inline JITBOOLEAN internal_popBottom (t_thread_pool_deque *deque, t_thread_pool_item *item) {
+    t_thread_pool_item	*slot;
+
+    /* Skip the lock when the deque looks empty: the check is repeated while holding it	*/
+    if (__atomic_load_n(&(deque->bottom), __ATOMIC_RELAXED) == __atomic_load_n(&(deque->top), __ATOMIC_RELAXED)) {
+        return JITFALSE;
+    }
+
+    PLATFORM_lockMutex(&(deque->mutex));
+    if (deque->bottom == deque->top) {
+        PLATFORM_unlockMutex(&(deque->mutex));
+        return JITFALSE;
+    }
+    __atomic_store_n(&(deque->bottom), deque->bottom - 1, __ATOMIC_RELAXED);
+    slot		= &(deque->items[deque->bottom & deque->mask]);
+    *item		= *slot;
+    slot->delegate	= NULL;
+    slot->argument	= NULL;
+    PLATFORM_unlockMutex(&(deque->mutex));
+
+    return JITTRUE;
+}
+
+static inline JITBOOLEAN internal_stealTop (t_thread_pool_deque *deque, t_thread_pool_item *item) {
+    t_thread_pool_item	*slot;
+
+    /* Skip the lock when the deque looks empty: the check is repeated while holding it	*/
+    if (__atomic_load_n(&(deque->bottom), __ATOMIC_RELAXED) == __atomic_load_n(&(deque->top), __ATOMIC_RELAXED)) {
+        return JITFALSE;
+    }
+
+    PLATFORM_lockMutex(&(deque->mutex));
+    if (deque->bottom == deque->top) {
+        PLATFORM_unlockMutex(&(deque->mutex));
+        return JITFALSE;
+    }
+    slot		= &(deque->items[deque->top & deque->mask]);
+    *item		= *slot;
+    slot->delegate	= NULL;
+    slot->argument	= NULL;
+    __atomic_store_n(&(deque->top), deque->top + 1, __ATOMIC_RELAXED);
+    PLATFORM_unlockMutex(&(deque->mutex));
+
+    return JITTRUE;
+}
+
+static inline void internal_growDeque (t_thread_pool_deque *deque) {
+    t_thread_pool_item	*items;
+    JITUINT32		slotsNumber;
+    JITUINT32		count;
+    JITUINT32		index;
+
+    /* Copy the items to the beginning of a buffer twice as large	*/
+    slotsNumber	= (deque->mask + 1) * 2;
+    items		= allocFunction(sizeof(t_thread_pool_item) * slotsNumber);
+    memset(items, 0, sizeof(t_thread_pool_item) * slotsNumber);
+    count		= 0;
+    for (index = deque->top; index != deque->bottom; index++) {
+        items[count]	= deque->items[index & deque->mask];
+        count++;
+    }
+    freeFunction(deque->items);
+    deque->items	= items;
+    deque->mask	= slotsNumber - 1;
+    __atomic_store_n(&(deque->top), 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&(deque->bottom), count, __ATOMIC_RELAXED);
+
+    return ;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+/**
+ * @file lib_threadpool.h
+ */
+#ifndef LIB_THREADPOOL_H
+#define LIB_THREADPOOL_H
+
+#include <pthread.h>
+#include <xanlib.h>
+#include <jitsystem.h>
+
+/**
+ * @brief Work item: a delegate and the argument to invoke it with
+ */
+typedef struct {
+    void		*delegate;
+    void		*argument;
+} t_thread_pool_item;
+
+/**
+ * @brief Deque of work items owned by a worker
+ *
+ * Items are in the slots between top (included) and bottom (excluded).
+ * The owner pushes and pops at the bottom; the other workers steal from the top.
+ */
+typedef struct {
+    t_thread_pool_item	*items;
+    JITUINT32		mask;		/**< Number of slots minus one				*/
+    JITUINT32		top;
+    JITUINT32		bottom;
+    pthread_mutex_t		mutex;
+} t_thread_pool_deque;
+
+struct t_thread_pool;
+
+typedef struct {
+    pthread_t		id;
+    JITUINT32		index;
+    t_thread_pool_deque	deque;
+    struct t_thread_pool	*pool;
+} t_thread_pool_worker;
+
+/**
+ * @brief Pool of native threads that run delegates
+ *
+ * Every worker owns a deque of work items.
+ * Items pushed by a worker go to its own deque; items pushed by other threads are spread among the workers.
+ * A worker with an empty deque steals from the others before going to sleep.
+ *
+ * Workers are background threads: they live until the process exits.
+ */
+typedef struct t_thread_pool {
+    t_thread_pool_worker	*workers;
+    JITUINT32		workersNumber;
+    JITUINT32		nextWorker;		/**< Deque that receives the next item pushed by a thread outside the pool	*/
+    JITUINT32		pendingItems;
+    pthread_mutex_t		sleepMutex;
+    pthread_cond_t		sleepCondition;
+    void			(*runItem)(void *delegate, void *argument);
+    void			(*initWorker)(void);
+} t_thread_pool;
+
+/**
+ * @brief Make a new pool and start its workers
+ *
+ * @param workersNumber Number of workers; 0 starts one worker per processor
+ * @param createThread Function used to start the workers
+ * @param attributes Attributes of the workers
+ * @param initWorker Called by every worker before it runs any item; it can be NULL
+ * @param runItem Run a work item
+ * @return the new pool, or NULL if none of its workers could be started
+ */
+t_thread_pool * THREADPOOL_newPool (JITUINT32 workersNumber, JITINT32 (*createThread)(pthread_t *thread, pthread_attr_t *attr, void *(*startRoutine)(void *), void *arg), pthread_attr_t *attributes, void (*initWorker)(void), void (*runItem)(void *delegate, void *argument));
+
+/**
+ * @brief Queue a work item
+ */
+void THREADPOOL_push (t_thread_pool *pool, void *delegate, void *argument);
+
+/**
+ * @brief Return the addresses of the references stored in the queued work items
+ *
+ * The list is used by the garbage collector as part of the root set.
+ */
+XanList * THREADPOOL_toSlotList (t_thread_pool *pool);
+
+#endif
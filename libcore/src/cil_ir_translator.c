@@ -5302,7 +5302,12 @@ static inline JITINT16 translate_cil_throw (CLIManager_t *cliManager, Method met
     xanList_append(icall_params, current_stack_item);
     assert(icall_params != NULL);
     translate_ncall(method, (JITINT8 *) "setCurrentThreadException", IRVOID, icall_params, bytes_read, 0, NULL);
-    translate_ncall(method, (JITINT8 *) "updateTheStackTrace", IRVOID, NULL, bytes_read, 0, NULL);
+    icall_params = xanList_new(sharedAllocFunction, freeFunction, NULL);
+    assert(icall_params != NULL);
+    current_stack_item = make_new_IR_param();
+    memcpy(current_stack_item, &(stack->stack[(stack->top) - 1]), sizeof(ir_item_t));
+    xanList_append(icall_params, current_stack_item);
+    translate_ncall(method, (JITINT8 *) "updateTheStackTrace", IRVOID, icall_params, bytes_read, 0, NULL);
 
     /* THROW THE EXCEPTION OBJECT */
     instruction = method->newIRInstr(method);
@@ -10726,6 +10731,8 @@ static inline JITINT16 translate_cil_ldvirtftn (t_system *system, Method method,
 static inline JITUINT32 translate_Test_OutOfMemory (CLIManager_t *cliManager, Method method, CILStack cilStack, JITUINT32 *current_label_ID, XanList *labels, JITUINT32 bytes_read, t_stack *stack, ir_instruction_t *before) {
     ir_instruction_t        *instruction;
     t_label                 *label_l1;
+    XanList                 *icall_params;
+    ir_item_t               *current_stack_item;
 
 #ifdef DEBUG
     JITUINT32 stackTop;
@@ -10840,7 +10847,12 @@ static inline JITUINT32 translate_Test_OutOfMemory (CLIManager_t *cliManager, Me
 
     /* AT THIS POINT ON THE TOP OF THE STACK THERE IS ONLY THE CONSTRUCTED EXCEPTION OBJECT */
     PDEBUG("CILIR: test_OutOfMemory :       save the current stack trace \n");
-    translate_ncall(method, (JITINT8 *) "updateTheStackTrace", IRVOID, NULL, bytes_read, 0, NULL);
+    icall_params = xanList_new(sharedAllocFunction, freeFunction, NULL);
+    assert(icall_params != NULL);
+    current_stack_item = make_new_IR_param();
+    memcpy(current_stack_item, &(stack->stack[(stack->top) - 1]), sizeof(ir_item_t));
+    xanList_append(icall_params, current_stack_item);
+    translate_ncall(method, (JITINT8 *) "updateTheStackTrace", IRVOID, icall_params, bytes_read, 0, NULL);
 
     /* THROW THE EXCEPTION OBJECT */
     /* Insert the new instruction before the specified one (if any) */
@@ -27,6 +27,7 @@
 #include <system_manager.h>
 #include <code_generator.h>
 #include <runtime.h>
+#include <ildjit_profiler.h>
 // End
 
 typedef struct {
@@ -46,6 +47,7 @@ static inline void internal_layout_types (t_system *system);
 static inline void internal_addDependentCCTORS (ir_method_t *m, XanList *deps, XanHashTable *alreadyChecked);
 static inline XanList * internal_sortCctors (XanList *cctors);
 static inline void internal_addCallsToBootstrap (ir_method_t *m);
+static inline void internal_mapMachineCode (Method method);
 static inline t_plugins * internal_fetchDecoder (XanList *plugins, t_binary_information *b);
 static inline ir_instruction_t * internal_storeValueToGlobal (ir_method_t *m, ir_instruction_t *afterInst, ir_global_t *glo, ir_item_t *irValueToStore);
 static inline void internal_substituteSymbolsWithGlobals (ir_method_t *method, ir_instruction_t *i, ir_item_t *par, XanHashTable *symbolGlobalMap, XanHashTable *globalILTypeMap, XanHashTable *st);
@@ -301,7 +303,10 @@ void CODE_generateMachineCode (CodeGenerator *self, Method method) {
 
             /* Translate the method into the backend-specific intermediate representation.
              */
+            ILTelemetryTimer	telemetryTimer;
+            ILTELEMETRY_startTimer(&telemetryTimer);
             IRVM_lowerMethod(&(ildjitSystem->IRVM), irMethod, jitFunction);
+            profilerRecordStage(&telemetryTimer, ILTELEMETRY_LOWERING, method);
         }
     }
 
@@ -325,13 +330,43 @@ void CODE_linkMethodToProgram (CodeGenerator *self, Method method) {
         /* Link the method to the program.
          */
         if ((ildjitSystem->program).enableMachineCodeGeneration) {
+            ILTelemetryTimer	telemetryTimer;
+            ILTELEMETRY_startTimer(&telemetryTimer);
             IRVM_generateMachineCode(&(ildjitSystem->IRVM), *(method->jit_function), method->getIRMethod(method));
+            profilerRecordStage(&telemetryTimer, ILTELEMETRY_MACHINE_CODE, method);
+            internal_mapMachineCode(method);
         }
     }
 
     return ;
 }
 
+static inline void internal_mapMachineCode (Method method) {
+    void		*entryPoint;
+    JITUINT32	codeSize;
+
+    /* Map the whole machine code of the method, so that the addresses within it can be resolved to the method.
+     */
+    codeSize	= IRVM_getCodeSize(&(ildjitSystem->IRVM), *(method->jit_function));
+    if (codeSize == 0) {
+        return ;
+    }
+    entryPoint	= IRVM_getEntryPoint(&(ildjitSystem->IRVM), *(method->jit_function));
+    assert(entryPoint != NULL);
+    ILCODEMAP_insert((ildjitSystem->cliManager).methods.codeMap, entryPoint, entryPoint + codeSize, (void *) method);
+
+    return ;
+}
+
+void CODE_unmapMachineCode (void *entryPoint) {
+
+    /* The machine code starting at entryPoint is going to be freed, so new methods can be placed there.
+     */
+    ILCODEMAP_remove((ildjitSystem->cliManager).methods.codeMap, entryPoint);
+
+    return ;
+}
+
 void CODE_init (CodeGenerator *self) {
     self->cacheCodeGeneration	= JITFALSE;
     self->cachedMethods		= xanList_new(allocFunction, freeFunction, NULL);
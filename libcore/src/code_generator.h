@@ -28,6 +28,7 @@ void CODE_init (CodeGenerator *self);
 void CODE_shutdown (CodeGenerator *self);
 Method CODE_generateWrapperOfEntryPoint (CodeGenerator *self);
 void CODE_generateMachineCode (CodeGenerator *self, Method method);
+void CODE_unmapMachineCode (void *entryPoint);
 void CODE_linkMethodToProgram (CodeGenerator *self, Method method);
 void CODE_cacheCodeGeneration (CodeGenerator *self);
 void CODE_generateAndLinkCodeForCachedMethods (CodeGenerator *self);
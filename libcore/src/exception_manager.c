@@ -163,13 +163,11 @@ static inline void * _createCILExceptionObject (t_system *system, TypeDescriptor
             object_created = _get_Permanent_OutOfMemoryException(system);
             setConstructed(1);
         }
-
-        /* take a snapshot of the current stack trace element */
-        updateTheStackTrace();
     }
 
     /* Note that the every object returned by this function is not constructed. There must be a way in the
      * libjit exception catcher to manage the correct call to the specific constructor.
+     * The stack trace is not taken here: every caller takes it once, right before throwing the object.
      */
 
     /* check the postconditions */
@@ -178,10 +176,14 @@ static inline void * _createCILExceptionObject (t_system *system, TypeDescriptor
     return object_created;
 }
 
-void updateTheStackTrace () {
-    /*	SET THE NEW STACK TRACE */
+void updateTheStackTrace (void *exception) {
+
+    /*	SET THE NEW STACK TRACE.
+     *	The trace belongs to the throwing thread and is tagged with the exception: only the return addresses are taken, and the frames above the innermost catcher are taken only if the exception leaves it.
+     *	The methods the return addresses belong to are looked up when the trace is printed.
+     */
     PDEBUG("EXCEPTION_MANAGER : updateTheStackTrace : Updating the stack_trace \n");
-    ((ildjitSystem->program).thread_exception_infos)->stackTrace = IRVM_getStackTrace();
+    IRVM_captureStackTrace(exception);
 }
 
 /*   A CUSTOM EXCEPTION HANDLER. */
@@ -248,7 +250,7 @@ void * exception_handler (int exception_type) {
     setCurrentThreadException(exceptionObject);
 
     /* Update the stack trace	*/
-    updateTheStackTrace();
+    updateTheStackTrace(exceptionObject);
 
     /* Return		*/
     PDEBUG("EXCEPTION_MANAGER: exception_handler: Exit\n");
@@ -333,7 +335,7 @@ void print_stack_trace (t_system *system) {
     void                    *exception_uncaught;
     TypeDescriptor                  *type_of_the_object;
     JITINT8                 *message;
-    IRVM_stackTrace *stack_trace;
+    IRVM_stackTrace stack_trace;
     JITUINT32 stack_size;
     JITUINT32 count;
 
@@ -347,9 +349,7 @@ void print_stack_trace (t_system *system) {
 
     /* retrieve the uncaught exception object */
     exception_uncaught = ((system->program).thread_exception_infos)->exception_thrown;
-    stack_trace = ((system->program).thread_exception_infos)->stackTrace;
     assert(exception_uncaught != NULL);
-    assert(stack_trace != NULL);
 
     /* Retrieve the exception type & binary of the exception object */
 
@@ -437,16 +437,28 @@ void print_stack_trace (t_system *system) {
 
     fprintf(stdout, "Uncaught exception: %s : %s\n", type_of_the_object->getCompleteName(type_of_the_object), message);
 
-    /* RETRIEVE THE STACK_TRACE SIZE*/
-    stack_size = IRVM_getStackTraceSize(stack_trace);
+    /* RETRIEVE THE STACK_TRACE SIZE.
+     * The stack trace is available only if the exception has been thrown by the calling thread.
+     */
+    stack_size = 0;
+    if (IRVM_getExceptionStackTrace(exception_uncaught, &stack_trace)) {
+        stack_size = IRVM_getStackTraceSize(&stack_trace);
+    }
 
     /* For each known method of the stack trace, we must print on
      * the standard output the associated informations */
     for (count = 0; count < stack_size; count++) {
         Method current_method;
-
-        /* Fetch the method from the stack-trace                        */
-        current_method = (Method) IRVM_getStackTraceFunctionAt(&(ildjitSystem->IRVM), stack_trace, count);
+        void *return_address;
+
+        /* Fetch the method from the stack-trace.
+         * The return address follows the call, which can be the last instruction of the method: look up the byte before it.
+         */
+        return_address = IRVM_getStackTraceAddressAt(&stack_trace, count);
+        current_method = NULL;
+        if (return_address != NULL) {
+            current_method = (Method) ILCODEMAP_find((ildjitSystem->cliManager).methods.codeMap, return_address - 1, NULL);
+        }
         if (current_method != NULL) {
             JITUINT32 CIL_Offset;
             MethodDescriptor      *CIL_method;
@@ -456,7 +468,7 @@ void print_stack_trace (t_system *system) {
             assert(CIL_method != NULL);
 
             /* retrieve the CIL-offset associated with the stack-trace element */
-            CIL_Offset = IRVM_getStackTraceOffset(&(ildjitSystem->IRVM), stack_trace, count);
+            CIL_Offset = IRVM_getStackTraceOffset(&(ildjitSystem->IRVM), &stack_trace, count);
 
             /* print the information to the standard output */
             assert(CIL_method != NULL);
@@ -464,8 +476,7 @@ void print_stack_trace (t_system *system) {
         }
     }
 
-    /* release the memory allocated for the stack_trace element */
-    IRVM_destroyStackTrace(stack_trace);
+    /* The memory of the stack_trace element is owned by the thread that took it */
 
     /* Return					*/
     return;
@@ -606,15 +617,13 @@ void throw_thread_exception (void *exception_object) {
         setConstructed(0);
     } else {
         assert(isConstructed() == 1);
-        PDEBUG("EXCEPTION_MANAGER : throw_thread_exception : UPDATING THE STACK_TRACE!");
-        updateTheStackTrace();
     }
 
     /* Set the exception		*/
     setCurrentThreadException(exception_object);
 
     /* Update the stack trace	*/
-    updateTheStackTrace();
+    updateTheStackTrace(exception_object);
 
     /* Throw the exception */
     PDEBUG("EXCEPTION_MANAGER : throw_thread_exception : throwing a runtime exception \n");
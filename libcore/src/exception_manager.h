@@ -28,7 +28,7 @@ JITBOOLEAN isConstructed ();
 void setConstructed (JITBOOLEAN constructed);
 void * getCurrentThreadException ();
 void setCurrentThreadException (void * new_exception_object);
-void updateTheStackTrace ();
+void updateTheStackTrace (void *exception);
 void print_stack_trace ();
 void throw_thread_exception_ByName (JITINT8 *typeNameSpace, JITINT8 *typeName);
 void throw_thread_exception (void *exception_object);
@@ -239,6 +239,12 @@ typedef struct {
     JITUINT32 dimSize;
 } t_arrayHeader;
 
+/* Start routine of a thread created by ILDJIT */
+typedef struct {
+    void*                   (*startRoutine)(void*); /**< Routine to run                     */
+    void*                   arg;                    /**< Argument of the routine            */
+} t_threadStart;
+
 extern t_system *ildjitSystem;
 static CLIManager_t *cliManager;
 static IRVM_t *IRVM;
@@ -271,6 +277,9 @@ static JITINT32         gci_threadCreate (pthread_t* thread,
         void* (*startRoutine)(void*),
         void* arg);
 
+/* Run the start routine of a thread created by gci_threadCreate */
+static void*            gci_startThread (void* arg);
+
 static void             gci_collect (void);
 
 /* Check if object class is subtype of given type */
@@ -788,6 +797,12 @@ XanList*                getRootSet (void) {
     /* Object reference in the root set */
     void**                          objectReference;
 
+    /* References to the interned strings */
+    XanList*                        internedStrings;
+
+    /* References stored in the work items of the thread pool */
+    XanList*                        workItems;
+
     /* Assertions  */
     assert(rootSetList == NULL);
 
@@ -876,7 +891,16 @@ XanList*                getRootSet (void) {
 
     /* Add strings                                  */
     xanList_appendList(rootSetList, xanHashTable_toSlotList((cliManager->CLR).stringManager.usObjects));
-    xanList_appendList(rootSetList, xanHashTable_toSlotList((cliManager->CLR).stringManager.internHashTable));
+    internedStrings = STRINGINTERN_toSlotList((cliManager->CLR).stringManager.internTable);
+    xanList_appendList(rootSetList, internedStrings);
+    xanList_destroyList(internedStrings);
+
+    /* Add the work items queued to the thread pool	*/
+    if ((cliManager->CLR).threadsManager.threadPool != NULL) {
+        workItems = THREADPOOL_toSlotList((cliManager->CLR).threadsManager.threadPool);
+        xanList_appendList(rootSetList, workItems);
+        xanList_destroyList(workItems);
+    }
 
     /* Add the OutOfMemory exception */
     xanList_insert(rootSetList, &(ildjitSystem->exception_system._OutOfMemoryException));
@@ -1219,6 +1243,9 @@ static void*            gci_allocArray (TypeDescriptor *type, JITINT32 rank, JIT
     PDEBUG("GC: allocArray:         Rank	= %d \n", rank);
     PDEBUG("GC: allocArray:         Size    = %d \n", size);
 
+    /* Let the machine code of the recompiled methods be reclaimed */
+    IRVM_checkpoint(IRVM);
+
     /* Create a new array */
     TypeDescriptor *resolvedType = type->makeArrayDescriptor(type, rank);
     ArrayDescriptor *arrayType = GET_ARRAY(resolvedType);
@@ -1259,6 +1286,9 @@ static void*            gci_allocObject (TypeDescriptor *type, JITUINT32 overSiz
     /* Make a new object type */
     PDEBUG("GC: allocObject:        Make a new type information\n");
 
+    /* Let the machine code of the recompiled methods be reclaimed */
+    IRVM_checkpoint(IRVM);
+
     /* Create a new instance */
     PDEBUG("GC: allocObject:        Create the new instance\n");
     newObject = gci_createInstance(type, overSize, JITTRUE, JITFALSE);
@@ -1773,7 +1803,30 @@ static JITINT32         gci_threadCreate (pthread_t* thread,
         pthread_attr_t* attr,
         void* (*startRoutine)(void*),
         void* arg) {
-    return PLATFORM_createThread(thread, attr, startRoutine, arg);
+    t_threadStart   *start;
+    JITINT32        error;
+
+    start = allocFunction(sizeof(t_threadStart));
+    start->startRoutine = startRoutine;
+    start->arg = arg;
+    error = PLATFORM_createThread(thread, attr, gci_startThread, start);
+    if (error != 0) {
+        freeFunction(start);
+    }
+
+    return error;
+}
+
+static void*            gci_startThread (void* arg) {
+    t_threadStart   start;
+
+    start = *((t_threadStart *) arg);
+    freeFunction(arg);
+
+    /* Threads created by ILDJIT run the code only through IRVM_run */
+    IRVM_registerThread(&(ildjitSystem->IRVM));
+
+    return start.startRoutine(start.arg);
 }
 
 /* Add given root set to global one */
@@ -2007,8 +2060,10 @@ static JITBOOLEAN gci_waitForPulse (void* object, JITINT32 timeout) {
     header = GET_OBJECT_HEADER(object);
 
     /* Wait for signals */
+    IRVM_enterBlockingRegion(IRVM);
     pulseOccursBeforeTimeout = ILJITMonitorWaitForPulse(&header->monitor,
                                timeout);
+    IRVM_leaveBlockingRegion(IRVM);
 
     return pulseOccursBeforeTimeout;
 
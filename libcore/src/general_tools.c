@@ -84,7 +84,6 @@ void BuildDelegate (void* self, void* target, void* function_entry_point) {
      * exception
      */
     JITBOOLEAN noException;
-    XanHashTable *functionsEntryPoint;
 
     /* Assertions */
     assert(function_entry_point != NULL);
@@ -93,10 +92,9 @@ void BuildDelegate (void* self, void* target, void* function_entry_point) {
     garbageCollector = &(ildjitSystem->garbage_collectors.gc);
     delegatesManager = &((ildjitSystem->cliManager).CLR.delegatesManager);
     mdType = delegatesManager->getMulticastDelegate(delegatesManager);
-    functionsEntryPoint = (ildjitSystem->cliManager).methods.functionsEntryPoint;
 
     /* Obtain the Method relative to the given entry point */
-    method = (Method) xanHashTable_lookup(functionsEntryPoint, function_entry_point);
+    method = (Method) ILCODEMAP_lookup((ildjitSystem->cliManager).methods.codeMap, function_entry_point);
     assert(method != NULL);
     METHOD_BEGIN(ildjitSystem, "BuildDelegate");
 
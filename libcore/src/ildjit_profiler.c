@@ -28,6 +28,7 @@
 #include <ir_optimization_interface.h>
 #include <compiler_memory_manager.h>
 #include <platform_API.h>
+#include <compilation_telemetry.h>
 
 // My headers
 #include <ildjit_profiler.h>
@@ -359,6 +360,75 @@ void printProfilerInformation (void) {
     return;
 }
 
+void profilerRecordStage (ILTelemetryTimer *timer, ILTelemetryStage stage, Method method) {
+    ir_method_t	*irMethod;
+
+    /* Assertions			*/
+    assert(timer != NULL);
+    assert(method != NULL);
+
+    /* Check whether the telemetry is recording	*/
+    if (!ILTELEMETRY_isEnabled()) {
+        return ;
+    }
+
+    /* Record the stage; the IR method is the key the codetools are recorded with	*/
+    irMethod	= method->getIRMethod(method);
+    ILTELEMETRY_stopTimer(timer, stage, irMethod, method->getFullName(method), NULL, IRMETHOD_getInstructionsNumber(irMethod));
+
+    return;
+}
+
+void profilerRecordQueueWait (JITUINT64 enqueueTime, Method method, const char *queueName) {
+
+    /* Assertions			*/
+    assert(method != NULL);
+
+    /* Check whether the telemetry is recording	*/
+    if (!ILTELEMETRY_isEnabled()) {
+        return ;
+    }
+
+    ILTELEMETRY_recordQueueWait(enqueueTime, method->getIRMethod(method), method->getFullName(method), queueName);
+
+    return;
+}
+
+void printCompilationTelemetry (void) {
+    t_system                *system;
+
+    /* Check whether the telemetry has been recorded	*/
+    if (!ILTELEMETRY_isEnabled()) {
+        return ;
+    }
+
+    /* Fetch the system                     */
+    system = getSystem(NULL);
+    assert(system != NULL);
+
+    /* Print the summary			*/
+    if ((system->profiler).telemetrySummarySize > 0) {
+        ILTELEMETRY_printSummary(stderr, (system->profiler).telemetrySummarySize);
+    }
+
+    /* Dump the records			*/
+    if ((system->profiler).telemetryFileName != NULL) {
+        if (!ILTELEMETRY_dump((system->profiler).telemetryFileName)) {
+            char buf[DIM_BUF];
+            snprintf(buf, DIM_BUF, "ILDJIT: ERROR = Cannot write the compilation telemetry to %s. ", (system->profiler).telemetryFileName);
+            print_err(buf, errno);
+        }
+        free((system->profiler).telemetryFileName);
+        (system->profiler).telemetryFileName = NULL;
+    }
+
+    /* Free the records			*/
+    ILTELEMETRY_shutdown();
+
+    /* Return				*/
+    return;
+}
+
 static inline void internal_print_cpu_time_and_wall_time (JITFLOAT32 CPUTime, JITFLOAT32 totalCPUTime, JITFLOAT32 wallTime, JITFLOAT32 totalWallTime) {
     fprintf(stderr, "		CPU Time	= %.6f seconds\n", CPUTime);
     fprintf(stderr, "		CPU Time percent: %.6f\n", (CPUTime * 100) / totalCPUTime);
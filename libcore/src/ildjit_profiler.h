@@ -24,6 +24,7 @@
 #define PROFILER_H
 
 #include <jitsystem.h>
+#include <compilation_telemetry.h>
 
 // My headers
 #include <ildjit_system.h>
@@ -32,6 +33,9 @@
 void profilerStartTime (ProfileTime *startTime);
 JITFLOAT32 profilerGetTimeElapsed (ProfileTime *startTime, JITFLOAT32 *wallTime);
 void printProfilerInformation (void);
+void printCompilationTelemetry (void);
+void profilerRecordStage (ILTelemetryTimer *timer, ILTelemetryStage stage, Method method);
+void profilerRecordQueueWait (JITUINT64 enqueueTime, Method method, const char *queueName);
 JITFLOAT64 profilerGetSeconds (ProfileTime *time);
 
 #endif
@@ -135,6 +135,8 @@ typedef struct {
     JITUINT32 trampolinesTakenBeforeEntryPoint;             /**< Number of trampolines taken before starting the execution of the entry point*/
     ProfileTime startTime;                                  /**< Start time of iljit program						*/
     ProfileTime startExecutionTime;                         /**< When iljit starts executing the code dynamically generated.		*/
+    char *telemetryFileName;                                /**< File where the compilation telemetry is dumped; NULL if it is not dumped	*/
+    JITUINT32 telemetrySummarySize;                         /**< Methods and codetools listed by the summary of the compilation telemetry; 0 if the summary is not printed	*/
 } t_profiler;
 
 /**
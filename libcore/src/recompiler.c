@@ -28,9 +28,17 @@
 #include <translation_pipeline.h>
 // End
 
+typedef struct {
+    Method			method;
+    MethodDescriptor	*body;
+} implementation_dependence_t;
+
 extern t_system *ildjitSystem;
 
+static XanHashTable *implementationsDependences = NULL;
+
 static inline JITINT32 internal_recompiler (Method method, Method caller, ir_instruction_t *inst);
+static inline void internal_recompileSpecializedMethod (Method method);
 
 JITINT32 recompiler_with_profile (Method method, Method caller, ir_instruction_t *inst) {
     ProfileTime startTime;
@@ -112,3 +120,143 @@ static inline JITINT32 internal_recompiler (Method method, Method caller, ir_ins
     PDEBUG("RECOMPILER: recompiler: Exit\n");
     return JITTRUE;
 }
+
+void recompiler_init (void) {
+    if (implementationsDependences == NULL) {
+        implementationsDependences = xanHashTable_new(11, JITFALSE, sharedAllocFunction, dynamicReallocFunction, freeFunction, NULL, NULL);
+    }
+}
+
+void recompiler_addImplementationsDependence (Method method, MethodDescriptor *declaration, MethodDescriptor *body) {
+    XanList				*dependences;
+    XanListItem			*item;
+    implementation_dependence_t	*dependence;
+
+    /* Assertions				*/
+    assert(method != NULL);
+    assert(declaration != NULL);
+    assert(body != NULL);
+    assert(implementationsDependences != NULL);
+
+    /* Fetch the methods that depend on the	*
+     * implementations of the declaration	*/
+    xanHashTable_lock(implementationsDependences);
+    dependences = xanHashTable_lookup(implementationsDependences, declaration);
+    if (dependences == NULL) {
+        dependences = xanList_new(sharedAllocFunction, freeFunction, NULL);
+        xanHashTable_insert(implementationsDependences, declaration, dependences);
+    }
+
+    /* Check whether the dependence has been*
+     * already registered			*/
+    item = xanList_first(dependences);
+    while (item != NULL) {
+        dependence = item->data;
+        if (	(dependence->method == method)	&&
+                (dependence->body == body)	) {
+            break;
+        }
+        item = item->next;
+    }
+
+    /* Register the dependence		*/
+    if (item == NULL) {
+        dependence = sharedAllocFunction(sizeof(implementation_dependence_t));
+        dependence->method = method;
+        dependence->body = body;
+        xanList_append(dependences, dependence);
+    }
+    xanHashTable_unlock(implementationsDependences);
+
+    return;
+}
+
+void recompiler_newImplementationOfMethod (MethodDescriptor *declaration, MethodDescriptor *body) {
+    XanList		*dependences;
+    XanList		*toRecompile;
+    XanListItem	*item;
+
+    /* Assertions				*/
+    assert(declaration != NULL);
+    assert(body != NULL);
+
+    /* Check whether there are dependences	*/
+    if (implementationsDependences == NULL) {
+        return;
+    }
+
+    /* Collect the methods specialized for	*
+     * another implementation		*/
+    toRecompile = NULL;
+    xanHashTable_lock(implementationsDependences);
+    dependences = xanHashTable_lookup(implementationsDependences, declaration);
+    if (dependences != NULL) {
+        item = xanList_first(dependences);
+        while (item != NULL) {
+            implementation_dependence_t	*dependence;
+            XanListItem			*nextItem;
+
+            dependence = item->data;
+            nextItem = item->next;
+            if (dependence->body != body) {
+                if (toRecompile == NULL) {
+                    toRecompile = xanList_new(allocFunction, freeFunction, NULL);
+                }
+                if (xanList_find(toRecompile, dependence->method) == NULL) {
+                    xanList_append(toRecompile, dependence->method);
+                }
+                xanList_deleteItem(dependences, item);
+                freeFunction(dependence);
+            }
+            item = nextItem;
+        }
+    }
+    xanHashTable_unlock(implementationsDependences);
+    if (toRecompile == NULL) {
+        return;
+    }
+
+    /* Recompile them			*
+     * The guards inserted within their code*
+     * keep them correct until then		*/
+    item = xanList_first(toRecompile);
+    while (item != NULL) {
+        internal_recompileSpecializedMethod((Method) item->data);
+        item = item->next;
+    }
+
+    /* Free the memory			*/
+    xanList_destroyList(toRecompile);
+
+    return;
+}
+
+static inline void internal_recompileSpecializedMethod (Method method) {
+    JITBOOLEAN	toRecompile;
+
+    /* Assertions				*/
+    assert(method != NULL);
+    PDEBUG("RECOMPILER: recompileSpecializedMethod: Recompile the method %s\n", method->getFullName(method));
+
+    /* Only methods already compiled need	*
+     * to be recompiled; the others will	*
+     * see the new type when they will be	*
+     * optimized				*/
+    toRecompile = JITFALSE;
+    method->lock(method);
+    if (method->getState(method) == EXECUTABLE_STATE) {
+        method->setState(method, NEEDS_RECOMPILE_STATE);
+        toRecompile = JITTRUE;
+    }
+    method->unlock(method);
+
+    /* Insert the method into the pipeline.	*
+     * The notification can come from a	*
+     * compilation thread, so we cannot	*
+     * wait for the new code		*/
+    if (toRecompile) {
+        (ildjitSystem->pipeliner).insertMethod(&(ildjitSystem->pipeliner), method, MIN_METHOD_PRIORITY);
+    }
+
+    return;
+}
@@ -26,4 +26,21 @@
 JITINT32 recompiler (Method method, Method caller, ir_instruction_t *inst);
 JITINT32 recompiler_with_profile (Method method, Method caller, ir_instruction_t *inst);
 
+/**
+ * Initialize the table of dependences between methods and the implementations of virtual methods.
+ */
+void recompiler_init (void);
+
+/**
+ * Declare that the code of @c method has been specialized for @c body, which is the only known implementation of the virtual method @c declaration.
+ */
+void recompiler_addImplementationsDependence (Method method, MethodDescriptor *declaration, MethodDescriptor *body);
+
+/**
+ * A new type provides @c body as implementation of the virtual method @c declaration.
+ *
+ * Every method specialized for a different implementation of @c declaration is recompiled.
+ */
+void recompiler_newImplementationOfMethod (MethodDescriptor *declaration, MethodDescriptor *body);
+
 #endif
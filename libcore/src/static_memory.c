@@ -35,7 +35,7 @@ typedef struct {
     Method 		method;
     void            *obj;
     pthread_t 	owner;
-    JITBOOLEAN 	executionDone;
+    JITBOOLEAN 	executionDone;		/**< Set once, with release semantics, so it can be read without taking lock	*/
     JITBOOLEAN 	inExecution;
     pthread_mutex_t lock;
     pthread_cond_t 	condition;
@@ -60,6 +60,7 @@ static inline void static_object_serialize (ir_symbol_t * symbol, void **mem, JI
 static inline void static_object_dump (ir_symbol_t *symbol, FILE *fileToWrite);
 static inline ir_symbol_t *  static_object_deserialize (void *mem, JITUINT32 memBytes);
 static inline void internal_callCctorMethod (StaticMemoryManager* self, Method cctor);
+static inline JITBOOLEAN internal_isStaticConstructorCheckNeeded (StaticMemoryManager* self, Method cctor);
 
 void STATICMEMORY_callCctorMethod (StaticMemoryManager* self, Method cctor) {
     TranslationPipeline* pipeline;
@@ -98,6 +99,12 @@ ir_symbol_t * STATICMEMORY_fetchStaticObjectSymbol (StaticMemoryManager *manager
     MethodDescriptor *cctorMethodID = type->getCctor(type);
     if (cctorMethodID != NULL) {
         Method cctor = internal_fetchStaticConstructor(manager, cctorMethodID);
+
+        /* Static constructors that already run do not need to be checked before the execution of the method.
+         */
+        if (!internal_isStaticConstructorCheckNeeded(manager, cctor)) {
+            return symbol;
+        }
         if (cctor != method) {
             method->lock(method);
             cctor->lock(cctor);
@@ -658,7 +665,7 @@ static inline void internal_callStaticConstructor (StaticMemoryManager* self, t_
 
         /* Declare initialization done          */
         PLATFORM_lockMutex(&cctorDescription->lock);
-        cctorDescription->executionDone = JITTRUE;
+        __atomic_store_n(&(cctorDescription->executionDone), JITTRUE, __ATOMIC_RELEASE);
         cctorDescription->inExecution	= JITFALSE;
         PLATFORM_broadcastCondVar(&cctorDescription->condition);
     }
@@ -833,19 +840,35 @@ static inline JITBOOLEAN internal_tryDeclaringWaiting (StaticMemoryManager* self
 /* Check whether cctorDescription reference an executed cctor */
 static inline JITBOOLEAN internal_executionIsDone (StaticMemoryManager* self, t_methodToCall* cctorDescription) {
 
-    /* Whether cctor execution has done */
-    JITBOOLEAN executionDone;
-
     if (cctorDescription == NULL) {
         return JITTRUE;
     }
 
-    /* Do the check in a thread safe way */
-    PLATFORM_lockMutex(&cctorDescription->lock);
-    executionDone	= cctorDescription->executionDone;
-    PLATFORM_unlockMutex(&cctorDescription->lock);
+    /* The flag never goes back to false once set, so a single load is enough */
+    return __atomic_load_n(&(cctorDescription->executionDone), __ATOMIC_ACQUIRE);
+}
+
+/* Check whether the methods that access the static memory of the type of cctor have to call cctor before they run */
+static inline JITBOOLEAN internal_isStaticConstructorCheckNeeded (StaticMemoryManager* self, Method cctor) {
+    t_methodToCall	*cctorDescription;
+
+    /* The list of cctors of the methods is used to call cctors later (cached constructors and static compilation)	*
+     * or it is saved within the profile of the program								*/
+    if (	(self->cacheConstructors)				||
+            ((ildjitSystem->IRVM).behavior.aot)			||
+            ((ildjitSystem->IRVM).behavior.pgc == 1)		||
+            ((ildjitSystem->IRVM).behavior.staticCompilation)	) {
+        return JITTRUE;
+    }
+
+    /* Check whether the cctor has run already; if the cctor has never been considered, the	*
+     * description does not exist and the cctor has not run					*/
+    cctorDescription = xanHashTable_syncLookup(self->cctorMethodsExecuted, cctor);
+    if (cctorDescription == NULL) {
+        return JITTRUE;
+    }
 
-    return executionDone;
+    return !internal_executionIsDone(self, cctorDescription);
 }
 
 void STATICMEMORY_flushCachedConstructors (StaticMemoryManager *manager) {
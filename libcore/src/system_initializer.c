@@ -33,6 +33,7 @@
 #include <ir_optimization_interface.h>
 #include <ir_optimization_levels_interface.h>
 #include <plugin_manager.h>
+#include <compilation_telemetry.h>
 
 // My header
 #include <clr_interface.h>
@@ -90,7 +91,7 @@ static inline JITINT16 decode_arguments (t_system *system, JITNINT argc, char **
     char	*tmpPointer;
     char	*baseName;
     char buf[DIM_BUF];
-    char short_options[] = "htf:p:vVNO:e:b:XH:L:P:jdAaxwcDCG:z:F:RIMmsTil";
+    char short_options[] = "htf:p:vVNO:e:b:XH:L:P:jdAaxwcDCG:z:F:RIMmsTilk:K:r";
     struct utsname platformInfo;
     const struct option long_options[] = {
         { "help",					  0,		NULL,	  'h' },
@@ -127,6 +128,9 @@ static inline JITINT16 decode_arguments (t_system *system, JITNINT argc, char **
         { "do-not-overlap-compiler-and-executor-threads", 0,		NULL,	  'T' },
         { "disable-static-constructors", 		  0,		NULL,	  'i' },
         { "optimizations", 				  0,		NULL,	  'l' },
+        { "compilation-telemetry",			  1,		NULL,	  'k' },
+        { "compilation-telemetry-summary",		  1,		NULL,	  'K' },
+        { "reclaim-code",				  0,		NULL,	  'r' },
         { NULL,						  0,		NULL,	  0   }
     };
 
@@ -172,6 +176,17 @@ static inline JITINT16 decode_arguments (t_system *system, JITNINT argc, char **
             case 'p':
                 (system->IRVM).behavior.profiler = atoi(optarg);
                 break;
+            case 'k':
+                (system->profiler).telemetryFileName = strdup(optarg);
+                ILTELEMETRY_enable();
+                break;
+            case 'K':
+                (system->profiler).telemetrySummarySize = atoi(optarg);
+                ILTELEMETRY_enable();
+                break;
+            case 'r':
+                (system->IRVM).behavior.reclaimCode = JITTRUE;
+                break;
             case 'X':
                 (system->IRVM).behavior.debugExecution = 1;
                 break;
@@ -484,6 +499,9 @@ static inline void print_usage (FILE * stream) {
     fprintf(stream, "   -T    --do-not-overlap-compiler-and-executor-threads   Do not use compiler threads to execute code and vice versa\n");
     fprintf(stream, "   -i    --disable-static-constructors                    Disable both code generation and execution of static constructors\n");
     fprintf(stream, "   -l    --optimizations                                  Dump the optimizations (codetools) available inside the paths specified by ILDJIT_PLGUINS\n");
+    fprintf(stream, "   -k    --compilation-telemetry=file                     Record the time spent by each compilation stage and codetool for each method and dump it to file in the CSV format at exit\n");
+    fprintf(stream, "   -K    --compilation-telemetry-summary=num              Record the time spent by each compilation stage and codetool for each method and print to stderr the num methods and codetools that took the most time at exit\n");
+    fprintf(stream, "   -r    --reclaim-code                                   Free the machine code of the methods that have been recompiled once no thread can be running it\n");
     if (stream == stderr) {
         exit(1);
     }
@@ -315,6 +315,103 @@ static inline XanList * iljit_getImplementationsOfMethod (IR_ITEM_VALUE irMethod
     return list;
 }
 
+static inline IR_ITEM_VALUE iljit_getTheOnlyImplementationOfMethod (IR_ITEM_VALUE irMethodID) {
+    t_system		*system;
+    Method 			method;
+    Method 			implementation;
+    MethodDescriptor 	*methodID;
+    MethodDescriptor 	*body;
+    ILLayout_manager	*layoutManager;
+    XanListItem     	*item;
+
+    /* Fetch the system             */
+    system = getSystem(NULL);
+    assert(system != NULL);
+
+    /* Fetch the method descriptor	*/
+    method = (Method) (JITNUINT) irMethodID;
+    assert(method != NULL);
+    methodID = method->getID(method);
+    assert(methodID != NULL);
+
+    /* Generic virtual methods are	*
+     * dispatched through the IMT	*
+     * by instance, so we do not	*
+     * consider them		*/
+    if (methodID->isGeneric(methodID)) {
+        return 0;
+    }
+
+    /* Look at the virtual tables of*
+     * every type laid out so far	*/
+    body = NULL;
+    layoutManager = &((system->cliManager).layoutManager);
+    xanList_lock(layoutManager->classesLayout);
+    item = xanList_first(layoutManager->classesLayout);
+    while (item != NULL) {
+        ILLayout 	*layout;
+        VTableSlot 	*slot;
+
+        layout = (ILLayout *) item->data;
+        assert(layout != NULL);
+        slot = (VTableSlot *) xanHashTable_lookup(layout->methods, methodID);
+        if (	(slot != NULL)					&&
+                (slot->body != NULL)				&&
+                (!slot->body->attributes->is_abstract)		) {
+            if (body == NULL) {
+                body = slot->body;
+            } else if (body != slot->body) {
+                body = NULL;
+                break;
+            }
+        }
+        item = item->next;
+    }
+    xanList_unlock(layoutManager->classesLayout);
+    if (body == NULL) {
+        return 0;
+    }
+
+    /* Methods of value types expect*
+     * the unboxed value as this	*/
+    if (body->owner->isValueType(body->owner)) {
+        return 0;
+    }
+
+    /* Check that the only		*
+     * implementation has an IR body*/
+    implementation = fetchOrCreateMethod(&((system->cliManager).methods), body, JITFALSE);
+    assert(implementation != NULL);
+    if (!implementation->isIrImplemented(implementation)) {
+        return 0;
+    }
+
+    /* Return			*/
+    return (IR_ITEM_VALUE) (JITNUINT) implementation;
+}
+
+static inline void iljit_addImplementationsDependence (ir_method_t *irMethod, IR_ITEM_VALUE irMethodID) {
+    Method caller;
+    Method declaration;
+    Method implementation;
+
+    /* Fetch the methods		*/
+    caller = (Method) (JITNUINT) iljit_getIRMethodID(irMethod);
+    assert(caller != NULL);
+    declaration = (Method) (JITNUINT) irMethodID;
+    assert(declaration != NULL);
+    implementation = (Method) (JITNUINT) iljit_getTheOnlyImplementationOfMethod(irMethodID);
+    if (implementation == NULL) {
+        return;
+    }
+
+    /* Register the dependence	*/
+    recompiler_addImplementationsDependence(caller, declaration->getID(declaration), implementation->getID(implementation));
+
+    /* Return			*/
+    return;
+}
+
 static inline XanList * iljit_getIRMethods (void) {
     XanList         	*l;
     Method 			method;
@@ -364,18 +461,13 @@ static inline XanList * iljit_getIRMethods (void) {
 static inline ir_method_t * iljit_getIRMethodFromEntryPoint (void *entryPointAddress) {
     t_system        *system;
     Method method;
-    XanHashTable *functionsEntryPoint;
 
     /* Fetch the system             */
     system = getSystem(NULL);
     assert(system != NULL);
 
-    /* Cache some pointers		*/
-    functionsEntryPoint = (system->cliManager).methods.functionsEntryPoint;
-    assert(functionsEntryPoint != NULL);
-
     /* Fetch the JIT method		*/
-    method = (Method) xanHashTable_lookup(functionsEntryPoint, entryPointAddress);
+    method = (Method) ILCODEMAP_lookup((system->cliManager).methods.codeMap, entryPointAddress);
     if (method == NULL) {
         return NULL;
     }
@@ -449,6 +541,8 @@ static inline void iljit_ensureCorrectJITFunction(Method method) {
             method->setState(method, IR_STATE);
         } else if ((method->IRMethod).ID->attributes->is_pinvoke) {
             method->setState(method, IR_STATE);
+        } else if ((system->cliManager).CLR.threadsManager.isProvidedByThePool((method->IRMethod).ID)) {
+            method->setState(method, IR_STATE);
         } else if ((method->IRMethod).ID->attributes->is_internal_call) {
             CLR_buildMethod(method);
             method->setState(method, EXECUTABLE_STATE);
@@ -816,7 +910,6 @@ t_system * allocateAndInitializeSystem (JITBOOLEAN loadPlugins, JITBOOLEAN initM
     /* INITIALIZE THE system->program STRUCTURE.
      */
     (system->program).thread_exception_infos			= (t_thread_exception_infos *) allocFunction(sizeof(t_thread_exception_infos));
-    ((system->program).thread_exception_infos)->stackTrace		= NULL;
     ((system->program).thread_exception_infos)->exception_thrown	= NULL;
     ((system->program).thread_exception_infos)->isConstructed	= 1;
 
@@ -847,6 +940,8 @@ t_system * allocateAndInitializeSystem (JITBOOLEAN loadPlugins, JITBOOLEAN initM
                     iljit_getIRMethodID,
                     iljit_getIRMethods,
                     iljit_getImplementationsOfMethod,
+                    iljit_getTheOnlyImplementationOfMethod,
+                    iljit_addImplementationsDependence,
                     iljit_getCompatibleMethods,
                     iljit_getFunctionPointer,
                     iljit_loadSymbol,
@@ -881,6 +976,14 @@ t_system * allocateAndInitializeSystem (JITBOOLEAN loadPlugins, JITBOOLEAN initM
                         buildDelegateFunctionPointer,
                         system->machineCodeLibraryPath);
 
+    /* Recompile methods specialized for the implementations of virtual methods	*
+     * known so far when a new type overrides them.					*/
+    recompiler_init();
+    if (	(compilationScheme == jitScheme)	||
+            (compilationScheme == dlaScheme)	) {
+        LAYOUT_setNewImplementationNotifier(&((system->cliManager).layoutManager), recompiler_newImplementationOfMethod);
+    }
+
     /* Initialize the IR virtual machine		*/
     if ((ildjitSystem->IRVM).behavior.profiler) {
         IRVM_init(	&(system->IRVM),
@@ -904,6 +1007,12 @@ t_system * allocateAndInitializeSystem (JITBOOLEAN loadPlugins, JITBOOLEAN initM
                  );
     }
 
+    /* Forget the machine code reclaimed by the IR virtual machine before its memory is reused.
+     * The main thread runs the code only through IRVM_run.
+     */
+    (system->IRVM).codeReclaimed	= CODE_unmapMachineCode;
+    IRVM_registerThread(&(system->IRVM));
+
     /* Create the methods hash table.
      */
     PDEBUG("BOOTSTRAPPER: Create the <token, binary_info> <-> IR method Hash table\n");
@@ -1221,6 +1330,7 @@ static inline void internal_system_shutdown (t_system *system) {
     if ((system->IRVM).behavior.profiler >= 1) {
         printProfilerInformation();
     }
+    printCompilationTelemetry();
 
     /* Destroy manfred.
      */
@@ -1412,6 +1522,10 @@ static inline Method fetchOrCreateMethod (t_methods *methods, MethodDescriptor *
             } else if (methodID->attributes->is_pinvoke) {
                 IRMETHOD_addMethodDummyInstructions(body);
                 (ildjitSystem->cliManager).CLR.pinvokeManager.buildMethod(&((ildjitSystem->cliManager).CLR.pinvokeManager), method);
+
+            } else if ((ildjitSystem->cliManager).CLR.threadsManager.isProvidedByThePool(methodID)) {
+                IRMETHOD_addMethodDummyInstructions(body);
+                (ildjitSystem->cliManager).CLR.threadsManager.buildMethod(method);
             }
         }
 
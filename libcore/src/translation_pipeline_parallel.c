@@ -76,6 +76,7 @@ typedef struct {
     JITBOOLEAN insertedByCctorThread;
     JITBOOLEAN 	runCCTORS;
     XanList         *dlaMethods;
+    JITUINT64	enqueueTime;		/**< When the ticket has been inserted in its current pipe; it is set only if the compilation telemetry is recording	*/
 } t_ticket;
 
 typedef struct {
@@ -151,6 +152,7 @@ static inline void internal_synchTillIRMethod_dummy (TranslationPipeline *pipe,
 static inline JITINT32 insert_method_into_pipeline_async_dummy (TranslationPipeline *pipe, Method method, JITFLOAT32 priority);
 static inline void internal_notifyCompilationEnd (t_ticket *ticket);
 static inline void internal_destroyTicket (t_ticket *ticket);
+static inline const char * internal_pipeName (ildjitPipe_t *pipe);
 
 static JITBOOLEAN exitPipeCondition = JITFALSE;
 static pthread_mutex_t startPipeMutex;
@@ -743,6 +745,11 @@ static inline void internal_worker_execution (ildjitPipe_t *fromPipe, ildjitPipe
         }
         assert(ticket->method != NULL);
 
+        /* Record the time spent by the ticket in the pipe	*/
+        if (ILTELEMETRY_isEnabled()) {
+            profilerRecordQueueWait(ticket->enqueueTime, ticket->method, internal_pipeName(fromPipe));
+        }
+
         /* Make the JOB			*/
         jobState = (*compilationJob)(ticket, checkPoint.variable);
 
@@ -862,6 +869,7 @@ static inline void internal_pipe_end_job (ildjitPipe_t *sourcePipe, JITBOOLEAN u
 
 static inline JITUINT32 DLA (t_ticket *ticket, XanVar *checkPoint) {
     ProfileTime startTime;
+    ILTelemetryTimer	telemetryTimer;
     XanList                 *methods;
     XanListItem             *item;
 
@@ -886,6 +894,9 @@ static inline JITUINT32 DLA (t_ticket *ticket, XanVar *checkPoint) {
         return JOB_END;
     }
 
+    /* Compilation telemetry			*/
+    ILTELEMETRY_startTimer(&telemetryTimer);
+
     /* Check if we are executing the DLA compiler	*
      * or the AOT compiler.				*/
     if (    ((ildjitSystem->IRVM).behavior.aot)             &&
@@ -1016,6 +1027,7 @@ static inline JITUINT32 DLA (t_ticket *ticket, XanVar *checkPoint) {
         (ildjitSystem->profiler).wallTime.dla_time += wallTime;
         PLATFORM_unlockMutex(&((ildjitSystem->pipeliner).dlaPipe.profileMutex));
     }
+    profilerRecordStage(&telemetryTimer, ILTELEMETRY_DLA, ticket->method);
 
     /* Return					*/
     return JOB_END;
@@ -1023,11 +1035,15 @@ static inline JITUINT32 DLA (t_ticket *ticket, XanVar *checkPoint) {
 
 static inline JITUINT32 cilIRTranslator (t_ticket *ticket, XanVar *checkPoint) {
     ProfileTime startTime;
+    ILTelemetryTimer	telemetryTimer;
     XanListItem             *item;
 
     /* Assertions					*/
     assert(ticket != NULL);
 
+    /* Compilation telemetry			*/
+    ILTELEMETRY_startTimer(&telemetryTimer);
+
     /* Profiling					*/
     if ((ildjitSystem->IRVM).behavior.profiler >= 2) {
 
@@ -1076,6 +1092,7 @@ static inline JITUINT32 cilIRTranslator (t_ticket *ticket, XanVar *checkPoint) {
     ticket->method->unlock(ticket->method);
     PDEBUG("TRANSLATION PIPELINE (%d): CIL->IR:	Translation done of %s (%p)\n", getpid(), ticket->method->getFullName(ticket->method), ticket->method);
 #endif
+    profilerRecordStage(&telemetryTimer, ILTELEMETRY_CIL_IR, ticket->method);
 
     /* Wakeup every threads that are waiting for	*
      * this method in IR language			*/
@@ -1112,6 +1129,7 @@ static inline JITUINT32 cilIRTranslator (t_ticket *ticket, XanVar *checkPoint) {
 
 static inline JITUINT32 iROptimizer (t_ticket *ticket, XanVar *checkPoint) {
     ProfileTime startTime;
+    ILTelemetryTimer	telemetryTimer;
     ir_method_t     *ir_method;
     JITUINT32 state;
 
@@ -1136,6 +1154,7 @@ static inline JITUINT32 iROptimizer (t_ticket *ticket, XanVar *checkPoint) {
     ir_method = ticket->method->getIRMethod(ticket->method);
 
     /* Optimize the method			*/
+    ILTELEMETRY_startTimer(&telemetryTimer);
 #ifndef MULTIAPP
     PDEBUG("TRANSLATION PIPELINE: IR optimization:	Start IR optimization of %s\n", ticket->method->getName(ticket->method));
     state = IROPTIMIZER_optimizeMethod_checkpointable(&((ildjitSystem->IRVM).optimizer), ir_method, ticket->jobState, checkPoint);
@@ -1176,6 +1195,7 @@ static inline JITUINT32 iROptimizer (t_ticket *ticket, XanVar *checkPoint) {
     PDEBUG("TRANSLATION PIPELINE (%d): IR optimization:	IR optimization done of %s (%p, MethodDescriptor %p)\n", getpid(), ticket->method->getFullName(ticket->method), ticket->method, (ticket->method->IRMethod).ID);
     ticket->method->unlock(ticket->method);
 #endif
+    profilerRecordStage(&telemetryTimer, ILTELEMETRY_IR_OPTIMIZATION, ticket->method);
 
     /* Profiling				*/
     if ((ildjitSystem->IRVM).behavior.profiler >= 2) {
@@ -2072,6 +2092,9 @@ static inline void internal_putToPipe (ildjitPipe_t *destinationPipe, JITBOOLEAN
     PLATFORM_lockMutex(&(ticket->mutex));
 
     /* Insert ticket in pipe and refresh its state	*/
+    if (ILTELEMETRY_isEnabled()) {
+        ticket->enqueueTime = ILTELEMETRY_now();
+    }
     ticket->pipeItem = xanQueue_put(destinationWorkers->pipe, ticket, ticket->priority);
     assert(ticket->pipeItem != NULL);
     ticket->inHighPriorityPipe = destinateToHighPriority;
@@ -2313,7 +2336,7 @@ static inline void internal_add_functions (XanList *list, ir_item_t *item) {
             entryPoint = (void *) (JITNUINT) (item->value).v;
         }
         if (entryPoint != NULL) {
-            methodToCompile = (Method) xanHashTable_lookup((ildjitSystem->cliManager).methods.functionsEntryPoint, entryPoint);
+            methodToCompile = (Method) ILCODEMAP_lookup((ildjitSystem->cliManager).methods.codeMap, entryPoint);
             if (methodToCompile != NULL) {
                 xanList_append(list, methodToCompile);
             }
@@ -2430,3 +2453,23 @@ static inline void internal_synchTillIRMethod_dummy (TranslationPipeline *pipe,
 static inline JITINT32 insert_method_into_pipeline_async_dummy (TranslationPipeline *pipe, Method method, JITFLOAT32 priority) {
     return 0;
 }
+
+static inline const char * internal_pipeName (ildjitPipe_t *pipe) {
+    if (pipe == &((ildjitSystem->pipeliner).cilPipe)) {
+        return "cil-ir";
+    }
+    if (pipe == &((ildjitSystem->pipeliner).dlaPipe)) {
+        return "dla";
+    }
+    if (pipe == &((ildjitSystem->pipeliner).irOptimizerPipe)) {
+        return "optimization";
+    }
+    if (pipe == &((ildjitSystem->pipeliner).irPipe)) {
+        return "machinecode";
+    }
+    if (pipe == &((ildjitSystem->pipeliner).cctorPipe)) {
+        return "cctor";
+    }
+
+    return "unknown";
+}
@@ -65,6 +65,7 @@ typedef struct {
     JITBOOLEAN insertedByCctorThread;
     JITBOOLEAN 	runCCTORS;
     XanList         *dlaMethods;
+    JITUINT64	enqueueTime;		/**< When the ticket has been inserted in its current pipe; it is set only if the compilation telemetry is recording	*/
 } t_ticket;
 
 typedef struct {
@@ -139,6 +140,7 @@ static inline void internal_synchTillIRMethod_dummy (TranslationPipeline *pipe,
 static inline JITINT32 insert_method_into_pipeline_async_dummy (TranslationPipeline *pipe, Method method, JITFLOAT32 priority);
 static inline void internal_notifyCompilationEnd (t_ticket *ticket);
 static inline void internal_destroyTicket (t_ticket *ticket);
+static inline const char * internal_pipeName (ildjitPipe_t *pipe);
 static inline void internal_sequentialCompilationPipeline (TranslationPipeline *pipe, Method method);
 
 static JITBOOLEAN exitPipeCondition = JITFALSE;
@@ -687,6 +689,11 @@ static inline void internal_worker_execution (ildjitPipe_t *fromPipe, ildjitPipe
         }
         assert(ticket->method != NULL);
 
+        /* Record the time spent by the ticket in the pipe	*/
+        if (ILTELEMETRY_isEnabled()) {
+            profilerRecordQueueWait(ticket->enqueueTime, ticket->method, internal_pipeName(fromPipe));
+        }
+
         /* Make the JOB			*/
         jobState = (*compilationJob)(ticket, checkPoint.variable);
 
@@ -806,6 +813,7 @@ static inline void internal_pipe_end_job (ildjitPipe_t *sourcePipe, JITBOOLEAN u
 
 static inline JITUINT32 DLA (t_ticket *ticket, XanVar *checkPoint) {
     ProfileTime startTime;
+    ILTelemetryTimer	telemetryTimer;
     XanList                 *methods;
     XanListItem             *item;
 
@@ -830,6 +838,9 @@ static inline JITUINT32 DLA (t_ticket *ticket, XanVar *checkPoint) {
         return JOB_END;
     }
 
+    /* Compilation telemetry			*/
+    ILTELEMETRY_startTimer(&telemetryTimer);
+
     /* Check if we are executing the DLA compiler	*
      * or the AOT compiler.				*/
     if (    ((ildjitSystem->IRVM).behavior.aot)             &&
@@ -934,6 +945,7 @@ static inline JITUINT32 DLA (t_ticket *ticket, XanVar *checkPoint) {
         (ildjitSystem->profiler).wallTime.dla_time += wallTime;
         PLATFORM_unlockMutex(&((ildjitSystem->pipeliner).dlaPipe.profileMutex));
     }
+    profilerRecordStage(&telemetryTimer, ILTELEMETRY_DLA, ticket->method);
 
     /* Return					*/
     return JOB_END;
@@ -941,6 +953,7 @@ static inline JITUINT32 DLA (t_ticket *ticket, XanVar *checkPoint) {
 
 static inline JITUINT32 cilIRTranslator (t_ticket *ticket, XanVar *checkPoint) {
     ProfileTime startTime;
+    ILTelemetryTimer	telemetryTimer;
     XanListItem             *item;
 
     /* Assertions					*/
@@ -961,7 +974,9 @@ static inline JITUINT32 cilIRTranslator (t_ticket *ticket, XanVar *checkPoint) {
 #endif
 
     /* Translate the method from CIL to IR		*/
+    ILTELEMETRY_startTimer(&telemetryTimer);
     translate_method_from_cil_to_ir(ildjitSystem, ticket->method);
+    profilerRecordStage(&telemetryTimer, ILTELEMETRY_CIL_IR, ticket->method);
 
     /* Set the state of the method			*/
     ticket->method->lock(ticket->method);
@@ -1003,6 +1018,7 @@ static inline JITUINT32 cilIRTranslator (t_ticket *ticket, XanVar *checkPoint) {
 
 static inline JITUINT32 iROptimizer (t_ticket *ticket, XanVar *checkPoint) {
     ProfileTime 	startTime;
+    ILTelemetryTimer	telemetryTimer;
     JITUINT32	state;
 
     /* Assertions					*/
@@ -1023,7 +1039,9 @@ static inline JITUINT32 iROptimizer (t_ticket *ticket, XanVar *checkPoint) {
 #endif
 
     /* Optimize the method			*/
+    ILTELEMETRY_startTimer(&telemetryTimer);
     state	= CODE_optimizeIR(&(ildjitSystem->codeGenerator), ticket->method, ticket->jobState, checkPoint);
+    profilerRecordStage(&telemetryTimer, ILTELEMETRY_IR_OPTIMIZATION, ticket->method);
 
     /* Profiling				*/
     if ((ildjitSystem->IRVM).behavior.profiler >= 2) {
@@ -1915,6 +1933,9 @@ static inline void internal_putToPipe (ildjitPipe_t *destinationPipe, JITBOOLEAN
     PLATFORM_lockMutex(&(ticket->mutex));
 
     /* Insert ticket in pipe and refresh its state	*/
+    if (ILTELEMETRY_isEnabled()) {
+        ticket->enqueueTime = ILTELEMETRY_now();
+    }
     ticket->pipeItem = xanQueue_put(destinationWorkers->pipe, ticket, ticket->priority);
     assert(ticket->pipeItem != NULL);
     ticket->inHighPriorityPipe = destinateToHighPriority;
@@ -2127,7 +2148,7 @@ static inline void internal_add_functions (XanList *list, ir_item_t *item) {
             entryPoint = (void *) (JITNUINT) (item->value).v;
         }
         if (entryPoint != NULL) {
-            methodToCompile = (Method) xanHashTable_lookup((ildjitSystem->cliManager).methods.functionsEntryPoint, entryPoint);
+            methodToCompile = (Method) ILCODEMAP_lookup((ildjitSystem->cliManager).methods.codeMap, entryPoint);
             if (methodToCompile != NULL) {
                 xanList_append(list, methodToCompile);
             }
@@ -2233,3 +2254,23 @@ static inline void internal_synchTillIRMethod_dummy (TranslationPipeline *pipe,
 static inline JITINT32 insert_method_into_pipeline_async_dummy (TranslationPipeline *pipe, Method method, JITFLOAT32 priority) {
     return 0;
 }
+
+static inline const char * internal_pipeName (ildjitPipe_t *pipe) {
+    if (pipe == &((ildjitSystem->pipeliner).cilPipe)) {
+        return "cil-ir";
+    }
+    if (pipe == &((ildjitSystem->pipeliner).dlaPipe)) {
+        return "dla";
+    }
+    if (pipe == &((ildjitSystem->pipeliner).irOptimizerPipe)) {
+        return "optimization";
+    }
+    if (pipe == &((ildjitSystem->pipeliner).irPipe)) {
+        return "machinecode";
+    }
+    if (pipe == &((ildjitSystem->pipeliner).cctorPipe)) {
+        return "cctor";
+    }
+
+    return "unknown";
+}
@@ -1,66 +1,216 @@
 #include <stdio.h>
 #include <assert.h>
-#include <cmath>
 
 // My headers
 #include <cache.h>
 #include <cache_array.h>
+#include <coherence.h>
 #include <hwmodel_system.h>
 // End
 
 extern "C" {
 
-static CacheArray* l1cache;
-static CacheArray* l2cache;
+static CacheArray* levels[CACHE_MAX_LEVELS];
+static unsigned int latencies[CACHE_MAX_LEVELS];
+static unsigned int numLevels;
+static unsigned int memoryLatency;
 static unsigned long long int * clockCycles;
+static MulticoreCache* multicore;
 
 void CACHE_initCache (unsigned long long int * programClockCycles){
+	cache_level_config_t	defaults[2];
+
+	/* L1 hits are free, an L1 miss costs 9 cycles and an L2 miss 80 more.
+	 */
+	defaults[0].size	= 32 * 1024;
+	defaults[0].lineSize	= 64;
+	defaults[0].assoc	= 8;
+	defaults[0].latency	= 0;
+	defaults[1].size	= 512 * 1024;
+	defaults[1].lineSize	= 64;
+	defaults[1].assoc	= 8;
+	defaults[1].latency	= 9;
+
+	CACHE_initCacheHierarchy(programClockCycles, defaults, 2, 9 + 80);
+
+	return ;
+}
+
+void CACHE_initCacheHierarchy (unsigned long long int * programClockCycles, const cache_level_config_t *config, unsigned int count, unsigned int memLatency){
 
 	/* Assertions.
 	 */
 	assert(programClockCycles != NULL);
-        clockCycles = programClockCycles;        
-        
-        l1cache = new CacheArray(8192, 8);
-        l2cache = new CacheArray(8192*16, 8);
+	assert(config != NULL);
+	assert(count > 0 && count <= CACHE_MAX_LEVELS);
+        clockCycles = programClockCycles;
+
+        for(unsigned int i = 0; i < count; i++) {
+          levels[i] = new CacheArray(config[i].size, config[i].lineSize, config[i].assoc);
+          latencies[i] = config[i].latency;
+        }
+        numLevels = count;
+        memoryLatency = memLatency;
 
 	return ;
 }
 
-extern "C" void CACHE_processLoad (void * addr, unsigned int inputSize) {
-        /* Assertions.
-         */
-        assert(addr != NULL);
-        
-        int numRequests = ceil(inputSize / 4.0); // one word = 4 bytes
-        for(int i = 0; i < numRequests; i++) {
-          bool l1hit = l1cache->doMemoryRequest((unsigned int)addr + (i*4), 0);
-          bool l2hit = l2cache->doMemoryRequest((unsigned int)addr + (i*4), 0);
-          if(!l1hit) {
-            (*clockCycles) += 9; // L1 miss penalty is 9 cycles
-            if(!l2hit) {
-              (*clockCycles) += 80; // L2 miss penalty is 80 cycles
+void CACHE_initMulticore (unsigned int numCores, const cache_level_config_t *l1, const cache_level_config_t *l2, const cache_level_config_t *llc, unsigned int memLatency, unsigned int coherenceLatency){
+
+	/* Assertions.
+	 */
+	assert(l1 != NULL);
+	assert(l2 != NULL);
+	assert(llc != NULL);
+	assert(multicore == NULL);
+
+        multicore = new MulticoreCache(numCores, *l1, *l2, *llc, memLatency, coherenceLatency);
+
+	return ;
+}
+
+/* A dirty line evicted from level goes to the first lower level holding it, or to memory */
+static void writeBack (unsigned int level, uint64_t lineAddr) {
+        for(level++; level < numLevels; level++) {
+          int64_t way = levels[level]->probe(lineAddr >> levels[level]->getLineBits());
+          if(way != CACHE_MISS) {
+            levels[level]->setState(way, CACHE_LINE_MODIFIED);
+            return;
+          }
+        }
+}
+
+/* Look up every L1 line touched by the access down the hierarchy, up to the first level that holds it, and fill the levels above it */
+static inline void processAccess (uint64_t addr, unsigned int inputSize, bool isStore) {
+        unsigned int l1Bits = levels[0]->getLineBits();
+        uint64_t lastAddr = addr + (inputSize > 0 ? inputSize - 1 : 0);
+        unsigned long long int cycles = 0;
+
+        for(uint64_t line = addr >> l1Bits; line <= (lastAddr >> l1Bits); line++) {
+          uint64_t lineAddr = line << l1Bits;
+          unsigned int level;
+          int64_t way = CACHE_MISS;
+          for(level = 0; level < numLevels; level++) {
+            way = levels[level]->lookup(lineAddr >> levels[level]->getLineBits());
+            if(way != CACHE_MISS) {
+              cycles += latencies[level];
+              break;
+            }
+          }
+          if(level == numLevels) {
+            cycles += memoryLatency;
+          }
+
+          /* Write-allocate: the line goes to the levels that missed, a store dirties the L1 copy */
+          if(level == 0) {
+            if(isStore) {
+              levels[0]->setState(way, CACHE_LINE_MODIFIED);
+            }
+            continue;
+          }
+          while(level-- > 0) {
+            uint64_t victim;
+            uint8_t victimState;
+            uint8_t state = (level == 0 && isStore) ? CACHE_LINE_MODIFIED : CACHE_LINE_EXCLUSIVE;
+            levels[level]->allocate(lineAddr >> levels[level]->getLineBits(), state, &victim, &victimState);
+            if(victimState == CACHE_LINE_MODIFIED) {
+              writeBack(level, victim << levels[level]->getLineBits());
             }
           }
         }
+        (*clockCycles) += cycles;
+}
+
+void CACHE_processLoad (void * addr, unsigned int inputSize) {
+        /* Assertions.
+         */
+        assert(addr != NULL);
+
+        processAccess((uintptr_t)addr, inputSize, false);
 
         return;
 }
 
-extern "C" void CACHE_processStore (void * addr, unsigned int inputSize) {
+void CACHE_processStore (void * addr, unsigned int inputSize) {
         /* Assertions.
          */
         assert(addr != NULL);
-        
-        // For now, stores are the same as loads
-        CACHE_processLoad(addr, inputSize);
-        
+
+        processAccess((uintptr_t)addr, inputSize, true);
+
+        return;
+}
+
+void CACHE_processTrace (const cache_access_t *accesses, size_t numAccesses) {
+        /* Assertions.
+         */
+        assert(accesses != NULL || numAccesses == 0);
+
+        if(multicore != NULL) {
+          for(size_t i = 0; i < numAccesses; i++) {
+            multicore->access(accesses[i].core, accesses[i].inst, accesses[i].addr, accesses[i].size, accesses[i].isStore);
+          }
+          return;
+        }
+        for(size_t i = 0; i < numAccesses; i++) {
+          processAccess(accesses[i].addr, accesses[i].size, accesses[i].isStore);
+        }
+
         return;
 }
 
-extern "C" void CACHE_shutdownCache() {
-        delete l1cache;
-        delete l2cache;
+unsigned int CACHE_processCoreAccess (unsigned int core, uint64_t inst, uint64_t addr, unsigned int size, int isStore) {
+        assert(multicore != NULL);
+
+        return multicore->access(core, inst, addr, size, isStore);
+}
+
+unsigned long long CACHE_getNumRequests (unsigned int level) {
+        assert(level < numLevels);
+
+        return levels[level]->getNumRequests();
+}
+
+unsigned long long CACHE_getNumHits (unsigned int level) {
+        assert(level < numLevels);
+
+        return levels[level]->getNumHits();
+}
+
+unsigned long long CACHE_getNumWritebacks (unsigned int level) {
+        assert(level < numLevels);
+
+        return levels[level]->getNumWritebacks();
+}
+
+unsigned long long CACHE_getCoreCycles (unsigned int core) {
+        assert(multicore != NULL);
+
+        return multicore->getCycles(core);
+}
+
+int CACHE_getInstructionStats (uint64_t inst, cache_inst_stats_t *stats) {
+        assert(multicore != NULL);
+        assert(stats != NULL);
+
+        return multicore->getInstructionStats(inst, stats);
+}
+
+void CACHE_dumpInstructionStats (FILE *out) {
+        assert(multicore != NULL);
+        assert(out != NULL);
+
+        multicore->dumpInstructionStats(out);
+}
+
+void CACHE_shutdownCache() {
+        for(unsigned int i = 0; i < numLevels; i++) {
+          delete levels[i];
+          levels[i] = NULL;
+        }
+        numLevels = 0;
+        delete multicore;
+        multicore = NULL;
 
         return;
 }
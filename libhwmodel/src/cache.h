@@ -1,13 +1,79 @@
 #ifndef CACHE_H
 #define CACHE_H
 
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Maximum number of levels of the cache hierarchy */
+#define CACHE_MAX_LEVELS	4
+
+/* Maximum number of cores of the multicore model */
+#define CACHE_MAX_CORES		64
+
+/* One level of the cache hierarchy */
+typedef struct {
+	uint64_t size;			/* Capacity in bytes */
+	unsigned int lineSize;		/* Bytes per line, power of two */
+	unsigned int assoc;		/* Ways per set */
+	unsigned int latency;		/* Cycles charged when an access hits this level */
+} cache_level_config_t;
+
+/* One memory access of a trace */
+typedef struct {
+	uint64_t addr;
+	uint64_t inst;			/* Static instruction issuing the access (multicore model only) */
+	uint32_t size;
+	uint16_t core;			/* Core issuing the access (multicore model only) */
+	uint16_t isStore;
+} cache_access_t;
+
+/* Behaviour of the accesses of a static instruction in the multicore model */
+typedef struct {
+	unsigned long long accesses;
+	unsigned long long misses;		/* Misses of the private caches */
+	unsigned long long coherenceMisses;	/* Misses on lines lost to stores of other cores */
+	unsigned long long falseSharingMisses;	/* Coherence misses on bytes that no other core stored to */
+	unsigned long long invalidations;	/* Copies of other cores invalidated by stores */
+} cache_inst_stats_t;
+
+/* Default hierarchy: 32 KB L1 and 512 KB L2, 8-way, 64-byte lines */
 void CACHE_initCache (unsigned long long int * programClockCycles);
+
+/* Hierarchy of numLevels levels, levels[0] being the closest to the core. Accesses missing all of them cost memoryLatency cycles */
+void CACHE_initCacheHierarchy (unsigned long long int * programClockCycles, const cache_level_config_t *levels, unsigned int numLevels, unsigned int memoryLatency);
+
+/* Multicore hierarchy: numCores cores with private l1 and l2 caches, kept coherent by a MESI directory, and a shared llc. All levels must have the same line size.
+ * A private miss on a line held by another core costs coherenceLatency cycles, instead of the llc or memory latency */
+void CACHE_initMulticore (unsigned int numCores, const cache_level_config_t *l1, const cache_level_config_t *l2, const cache_level_config_t *llc, unsigned int memoryLatency, unsigned int coherenceLatency);
+
 void CACHE_processLoad (void * addr, unsigned int inputSize);
 void CACHE_processStore (void * addr, unsigned int inputSize);
+
+/* Access of a core of the multicore model, return the cycles it took */
+unsigned int CACHE_processCoreAccess (unsigned int core, uint64_t inst, uint64_t addr, unsigned int size, int isStore);
+
+/* Replay numAccesses accesses in order, on the multicore model if it has been initialized */
+void CACHE_processTrace (const cache_access_t *accesses, size_t numAccesses);
+
+/* Requests, hits and write-backs of dirty lines of a level so far (single core model) */
+unsigned long long CACHE_getNumRequests (unsigned int level);
+unsigned long long CACHE_getNumHits (unsigned int level);
+unsigned long long CACHE_getNumWritebacks (unsigned int level);
+
+/* Cycles spent in memory accesses by a core of the multicore model: the modeled speedup of a parallel schedule is the sequential cycles over the maximum of these */
+unsigned long long CACHE_getCoreCycles (unsigned int core);
+
+/* Statistics of a static instruction in the multicore model, return 0 if it never accessed memory */
+int CACHE_getInstructionStats (uint64_t inst, cache_inst_stats_t *stats);
+
+/* Print the statistics of all static instructions of the multicore model */
+void CACHE_dumpInstructionStats (FILE *out);
+
 void CACHE_shutdownCache();
 
 #ifdef __cplusplus
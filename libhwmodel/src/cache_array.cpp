@@ -1,25 +1,41 @@
 #include <cache_array.h>
 #include <assert.h>
-#include <cmath>
-#include <algorithm>
 #include <iostream>
 
-CacheArray::CacheArray(int numEntries, int assoc)
+static unsigned int log2Of(uint64_t x)
+{
+  unsigned int bits = 0;
+  while ((x >> bits) > 1) {
+    bits++;
+  }
+  return bits;
+}
+
+CacheArray::CacheArray(uint64_t size, unsigned int lineSize, unsigned int assoc)
 {
   numRequests_ = 0;
   numHits_ = 0;
-  numEntries_ = numEntries;
+  numWritebacks_ = 0;
   assoc_ = assoc;
 
-  assert(numEntries_ % assoc == 0);
-  assert(numEntries_ >= assoc);
-
-  numSets_ = numEntries / assoc;
-  log2Sets_ = (int)floor(log2(numSets_) + 0.5);
-
-  for(int i = 0; i < numSets_; i++) {
-    sets_.push_back(Set());
+  assert(assoc_ > 0 && assoc_ <= 256);
+  assert(size % ((uint64_t)lineSize * assoc_) == 0);
+
+  /* Line size and number of sets must be powers of two */
+  uint64_t numSets = size / lineSize / assoc_;
+  lineBits_ = log2Of(lineSize);
+  setMask_ = numSets - 1;
+  assert(((uint64_t)1 << lineBits_) == lineSize);
+  assert(numSets > 0 && (numSets & setMask_) == 0);
+
+  tags_.assign(numSets * assoc_, CACHE_INVALID_LINE);
+  states_.assign(numSets * assoc_, CACHE_LINE_INVALID);
+  ages_.resize(numSets * assoc_);
+  for(uint64_t i = 0; i < ages_.size(); i++) {
+    ages_[i] = i % assoc_;
   }
+  lastLine_ = CACHE_INVALID_LINE;
+  lastWay_ = CACHE_MISS;
 }
 
 CacheArray::~CacheArray()
@@ -28,80 +44,114 @@ CacheArray::~CacheArray()
   cerr << "HITRATE:" << double(numHits_) / double(numRequests_) << endl;
 }
 
-bool CacheArray::doMemoryRequest(unsigned int addr, int coreId)
+int64_t CacheArray::lookup(uint64_t line)
 {
   numRequests_++;
-  map<unsigned int, Entry>::iterator it;
-  int setNum = getSet(addr);
-  bool foundAddress = false;
 
-  it = sets_[setNum].entries.find(addr);
-  foundAddress = (it != sets_[setNum].entries.end());
-
-  if(foundAddress) {  // hit
-    it->second.lastTouched = numRequests_;
+  /* The last line looked up is still the most recently used one */
+  if(line == lastLine_) {
     numHits_++;
+    return lastWay_;
   }
-  else { //  miss - allocate new entry
-    Entry entry;
-    entry.address = addr;
-    entry.lastTouched = numRequests_;
-    
-    if((int)sets_[setNum].entries.size() >= assoc_) { // need to evict
-      unsigned int replacedAddress = getReplacementAddress(setNum);
-      int replaced = sets_[setNum].entries.erase(replacedAddress);
-      assert(replaced == 1);
+
+  uint64_t first = firstWay(line);
+  const uint64_t *tags = &tags_[first];
+  for(unsigned int way = 0; way < assoc_; way++) {
+    if(tags[way] == line) {  // hit
+      touch(first, way);
+      numHits_++;
+      lastLine_ = line;
+      lastWay_ = first + way;
+      return lastWay_;
     }
-    sets_[setNum].entries[addr] = entry;
   }
 
-  return foundAddress;
+  return CACHE_MISS;
 }
 
-unsigned int CacheArray::getReplacementAddress(int setNum)
+int64_t CacheArray::probe(uint64_t line) const
 {
-  unsigned int replaced = lru(setNum);
-  return replaced;
+  uint64_t first = firstWay(line);
+  const uint64_t *tags = &tags_[first];
+  for(unsigned int way = 0; way < assoc_; way++) {
+    if(tags[way] == line) {
+      return first + way;
+    }
+  }
+
+  return CACHE_MISS;
 }
 
-unsigned int CacheArray::lru(int setNum)
+int64_t CacheArray::allocate(uint64_t line, uint8_t state, uint64_t *victim, uint8_t *victimState)
 {
-  Set* set = &(sets_[setNum]);
-  assert((int)set->entries.size() == assoc_);
-
-  int leastRecent = numRequests_ + 1;
-  int count = 0;
-  map<unsigned int, Entry>::iterator it = set->entries.begin();
-  unsigned int choice = it->first;
-
-  for(count = 0, it = set->entries.begin(); it != set->entries.end(); it++, count++) {
-    int mostRecentAccess = it->second.lastTouched;
-    if(mostRecentAccess < leastRecent) {
-      leastRecent = mostRecentAccess;
-      choice = it->first;
+  //  replace the least recently used way, empty ways are the oldest ones
+  uint64_t first = firstWay(line);
+  uint8_t *ages = &ages_[first];
+  unsigned int way = 0;
+  for(unsigned int i = 0; i < assoc_; i++) {
+    if(ages[i] == assoc_ - 1) {
+      way = i;
+    }
+    else {
+      ages[i]++;
     }
   }
+  ages[way] = 0;
 
-  return choice;
+  *victim = tags_[first + way];
+  *victimState = states_[first + way];
+  if(*victimState == CACHE_LINE_MODIFIED) {
+    numWritebacks_++;
+  }
+  tags_[first + way] = line;
+  states_[first + way] = state;
+  lastLine_ = line;
+  lastWay_ = first + way;
+  return lastWay_;
 }
 
-int CacheArray::getSet(unsigned int address)
+uint8_t CacheArray::invalidate(uint64_t line)
 {
-  if(numSets_ == 1) {
-    return 0;
+  int64_t way = probe(line);
+  if(way == CACHE_MISS) {
+    return CACHE_LINE_INVALID;
   }
 
-  int byteOffset = 2;
+  uint8_t state = states_[way];
+  tags_[way] = CACHE_INVALID_LINE;
+  states_[way] = CACHE_LINE_INVALID;
+  uint64_t first = firstWay(line);
+  age(first, way - first);
+  if(line == lastLine_) {
+    lastLine_ = CACHE_INVALID_LINE;
+  }
+  return state;
+}
 
-  unsigned int index = address >> byteOffset;
-  index = index << (32 - log2Sets_);
-  index = index >> (32 - log2Sets_);
+/* Make way the most recently used one of the set starting at first */
+void CacheArray::touch(uint64_t first, unsigned int way)
+{
+  uint8_t *ages = &ages_[first];
+  uint8_t age = ages[way];
 
-  if(index >= sets_.size()) {
-    unsigned int key = address >> byteOffset;
-    key = key >> log2Sets_;
-    index = key % numSets_;
+  for(unsigned int i = 0; i < assoc_; i++) {
+    if(ages[i] < age) {
+      ages[i]++;
+    }
   }
+  ages[way] = 0;
+}
+
+/* Make way the least recently used one of the set starting at first */
+void CacheArray::age(uint64_t first, unsigned int way)
+{
+  uint8_t *ages = &ages_[first];
+  uint8_t age = ages[way];
 
-  return index;
+  for(unsigned int i = 0; i < assoc_; i++) {
+    if(ages[i] > age) {
+      ages[i]--;
+    }
+  }
+  ages[way] = assoc_ - 1;
 }
@@ -1,47 +1,78 @@
 #ifndef CACHE_ARRAY_H
 #define CACHE_ARRAY_H
 
-#include <map>
+#include <stdint.h>
 #include <vector>
 
 using namespace std;
 
-struct Entry
-{
-  unsigned int address;
-  unsigned long long lastTouched;
-};
+/* Tag of an empty way */
+#define CACHE_INVALID_LINE	(~(uint64_t)0)
 
-struct Set
-{
-  map<unsigned int, Entry> entries;
-};
+/* Result of a lookup that misses */
+#define CACHE_MISS		((int64_t)-1)
+
+/* MESI state of a line: modified lines are the dirty ones */
+#define CACHE_LINE_INVALID	0
+#define CACHE_LINE_SHARED	1
+#define CACHE_LINE_EXCLUSIVE	2
+#define CACHE_LINE_MODIFIED	3
 
+/**
+ * Set-associative array of cache lines with LRU replacement.
+ *
+ * The tags of all ways are stored in one flat array, set after set, next to
+ * the LRU age and the MESI state of every way: ages of a set are a permutation
+ * of 0..assoc-1, 0 being the most recently used way.  Ways are identified by
+ * their index in the flat arrays.
+ **/
 class CacheArray{
  public:
-  CacheArray(int numEntries, int assoc);
+  CacheArray(uint64_t size, unsigned int lineSize, unsigned int assoc);
   ~CacheArray();
-  bool doMemoryRequest(unsigned int addr, int coreId);
-  
+
+  /* Look up a line (an address shifted right by getLineBits()), counting the
+   * request and making the line the most recently used one. Return its way or
+   * CACHE_MISS */
+  int64_t lookup(uint64_t line);
+
+  /* Like lookup, without touching counters and LRU ages */
+  int64_t probe(uint64_t line) const;
+
+  /* Allocate line in the least recently used way of its set, returning the
+   * way. The line evicted, if any, is stored in victim and victimState */
+  int64_t allocate(uint64_t line, uint8_t state, uint64_t *victim, uint8_t *victimState);
+
+  /* Drop line, if present, and return the state it had */
+  uint8_t invalidate(uint64_t line);
+
+  uint8_t getState(int64_t way) const { return states_[way]; }
+  void setState(int64_t way, uint8_t state) { states_[way] = state; }
+
+  unsigned int getLineBits() const { return lineBits_; }
+  unsigned long long getNumRequests() const { return numRequests_; }
+  unsigned long long getNumHits() const { return numHits_; }
+  unsigned long long getNumWritebacks() const { return numWritebacks_; }
+
  private:
-  int numEntries_;
-  int assoc_;
-  
-  int numSets_;
-  int log2Sets_;
+  unsigned int assoc_;
+  unsigned int lineBits_;
+  uint64_t setMask_;
+
+  vector<uint64_t> tags_;
+  vector<uint8_t> ages_;
+  vector<uint8_t> states_;
+  uint64_t lastLine_;
+  int64_t lastWay_;
 
-  vector<Set> sets_;
   unsigned long long numRequests_;
   unsigned long long numHits_;
-  int coreId_;
+  unsigned long long numWritebacks_;
 
   // Helper functions
-  int getSet(unsigned int address);
-  unsigned int getReplacementAddress(int setNum);
-
-  // Replacement policies
-  unsigned int random(int setNum);
-  unsigned int lru(int setNum);
+  uint64_t firstWay(uint64_t line) const { return (line & setMask_) * assoc_; }
+  void touch(uint64_t first, unsigned int way);
+  void age(uint64_t first, unsigned int way);
 };
 
 #endif
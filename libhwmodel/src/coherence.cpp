@@ -0,0 +1,312 @@
+#include <coherence.h>
+#include <assert.h>
+#include <string.h>
+#include <algorithm>
+
+/* Coherence misses are classified at the granularity of 1/64 of a line */
+#define CHUNKS_PER_LINE_BITS	6
+
+static inline uint64_t coreBit(unsigned int core)
+{
+  return (uint64_t)1 << core;
+}
+
+/* Mask of the chunks first..last */
+static inline uint64_t chunkMask(unsigned int first, unsigned int last)
+{
+  uint64_t upTo = (last == 63) ? ~(uint64_t)0 : (((uint64_t)1 << (last + 1)) - 1);
+  return upTo & ~(((uint64_t)1 << first) - 1);
+}
+
+MulticoreCache::MulticoreCache(unsigned int numCores, const cache_level_config_t &l1, const cache_level_config_t &l2, const cache_level_config_t &llc, unsigned int memoryLatency, unsigned int coherenceLatency)
+{
+  assert(numCores > 0 && numCores <= CACHE_MAX_CORES);
+  assert(l1.lineSize == l2.lineSize && l2.lineSize == llc.lineSize);
+
+  numCores_ = numCores;
+  for(unsigned int i = 0; i < numCores_; i++) {
+    l1_.push_back(new CacheArray(l1.size, l1.lineSize, l1.assoc));
+    l2_.push_back(new CacheArray(l2.size, l2.lineSize, l2.assoc));
+  }
+  llc_ = new CacheArray(llc.size, llc.lineSize, llc.assoc);
+  latencies_[0] = l1.latency;
+  latencies_[1] = l2.latency;
+  latencies_[2] = llc.latency;
+  memoryLatency_ = memoryLatency;
+  coherenceLatency_ = coherenceLatency;
+
+  lineBits_ = llc_->getLineBits();
+  chunkBits_ = lineBits_ > CHUNKS_PER_LINE_BITS ? lineBits_ - CHUNKS_PER_LINE_BITS : 0;
+  cycles_.assign(numCores_, 0);
+}
+
+MulticoreCache::~MulticoreCache()
+{
+  for(unsigned int i = 0; i < numCores_; i++) {
+    delete l1_[i];
+    delete l2_[i];
+  }
+  delete llc_;
+}
+
+unsigned int MulticoreCache::access(unsigned int core, uint64_t inst, uint64_t addr, unsigned int size, bool isStore)
+{
+  assert(core < numCores_);
+  cache_inst_stats_t &stats = stats_[inst];
+  uint64_t lastAddr = addr + (size > 0 ? size - 1 : 0);
+  uint64_t lineMask = ((uint64_t)1 << lineBits_) - 1;
+  unsigned int cycles = 0;
+
+  for(uint64_t line = addr >> lineBits_; line <= (lastAddr >> lineBits_); line++) {
+    uint64_t lineAddr = line << lineBits_;
+    uint64_t first = (addr > lineAddr) ? (addr & lineMask) : 0;
+    uint64_t last = (lastAddr < lineAddr + lineMask) ? (lastAddr & lineMask) : lineMask;
+    cycles += accessLine(core, stats, line, chunkMask(first >> chunkBits_, last >> chunkBits_), isStore);
+  }
+  cycles_[core] += cycles;
+
+  return cycles;
+}
+
+unsigned int MulticoreCache::accessLine(unsigned int core, cache_inst_stats_t &stats, uint64_t line, uint64_t chunks, bool isStore)
+{
+  stats.accesses++;
+
+  int64_t way = l1_[core]->lookup(line);
+  if(way != CACHE_MISS) {
+    uint8_t state = l1_[core]->getState(way);
+    return latencies_[0] + (isStore ? storeHit(core, stats, line, chunks, state) : 0);
+  }
+
+  way = l2_[core]->lookup(line);
+  if(way != CACHE_MISS) {
+    uint8_t state = l2_[core]->getState(way);
+    unsigned int cycles = latencies_[1];
+    if(isStore) {
+      cycles += storeHit(core, stats, line, chunks, state);
+      state = CACHE_LINE_MODIFIED;
+    }
+    fillPrivate(core, line, state, false);
+    return cycles;
+  }
+
+  stats.misses++;
+  uint8_t state;
+  unsigned int cycles = fetchLine(core, stats, line, chunks, isStore, &state);
+  fillPrivate(core, line, state, true);
+  return cycles;
+}
+
+/* Store to a line of the private caches of core: shared copies of other cores are invalidated first */
+unsigned int MulticoreCache::storeHit(unsigned int core, cache_inst_stats_t &stats, uint64_t line, uint64_t chunks, uint8_t state)
+{
+  DirectoryEntry &entry = directory_[line];
+  uint64_t others = entry.sharers & ~coreBit(core);
+
+  switch(state) {
+    case CACHE_LINE_MODIFIED:
+      recordStore(entry, chunks);
+      return 0;
+    case CACHE_LINE_EXCLUSIVE:
+      assert(others == 0);
+      recordStore(entry, chunks);
+      setPrivateState(core, line, CACHE_LINE_MODIFIED);
+      return 0;
+    default:
+      invalidateOthers(stats, entry, line, others, chunks);
+      setPrivateState(core, line, CACHE_LINE_MODIFIED);
+      return others != 0 ? coherenceLatency_ : 0;
+  }
+}
+
+/* Bring line in the private caches of core, return the cycles it took and the state the line must have */
+unsigned int MulticoreCache::fetchLine(unsigned int core, cache_inst_stats_t &stats, uint64_t line, uint64_t chunks, bool isStore, uint8_t *state)
+{
+  DirectoryEntry &entry = directory_[line];
+  uint64_t bit = coreBit(core);
+  uint64_t others = entry.sharers & ~bit;
+  unsigned int cycles;
+
+  /* Classify the miss */
+  if(entry.invalidated & bit) {
+    stats.coherenceMisses++;
+    if((entry.written[core] & chunks) == 0) {
+      stats.falseSharingMisses++;
+    }
+    entry.invalidated &= ~bit;
+    entry.written[core] = 0;
+  }
+
+  if(others != 0) {
+    /* Another core provides the line */
+    cycles = coherenceLatency_;
+    if(isStore) {
+      invalidateOthers(stats, entry, line, others, chunks);
+      *state = CACHE_LINE_MODIFIED;
+    }
+    else {
+      /* An exclusive or modified copy becomes shared, modified data is written back */
+      for(unsigned int other = 0; other < numCores_; other++) {
+        int64_t way;
+        if((others & coreBit(other)) == 0 || (way = l2_[other]->probe(line)) == CACHE_MISS) {
+          continue;
+        }
+        if(l2_[other]->getState(way) == CACHE_LINE_MODIFIED) {
+          writeBack(line);
+        }
+        setPrivateState(other, line, CACHE_LINE_SHARED);
+      }
+      *state = CACHE_LINE_SHARED;
+    }
+  }
+  else {
+    cycles = accessLLC(line);
+    if(isStore) {
+      recordStore(entry, chunks);
+      *state = CACHE_LINE_MODIFIED;
+    }
+    else {
+      *state = CACHE_LINE_EXCLUSIVE;
+    }
+  }
+  entry.sharers |= bit;
+
+  return cycles;
+}
+
+unsigned int MulticoreCache::accessLLC(uint64_t line)
+{
+  if(llc_->lookup(line) != CACHE_MISS) {
+    return latencies_[2];
+  }
+
+  uint64_t victim;
+  uint8_t victimState;
+  llc_->allocate(line, CACHE_LINE_EXCLUSIVE, &victim, &victimState);
+  return memoryLatency_;
+}
+
+/* Invalidate the copies of line held by others, on behalf of a store to chunks */
+void MulticoreCache::invalidateOthers(cache_inst_stats_t &stats, DirectoryEntry &entry, uint64_t line, uint64_t others, uint64_t chunks)
+{
+  for(unsigned int other = 0; other < numCores_; other++) {
+    if((others & coreBit(other)) == 0) {
+      continue;
+    }
+    uint8_t l1State = l1_[other]->invalidate(line);
+    uint8_t l2State = l2_[other]->invalidate(line);
+    if(l1State == CACHE_LINE_MODIFIED || l2State == CACHE_LINE_MODIFIED) {
+      writeBack(line);
+    }
+    stats.invalidations++;
+  }
+
+  /* Every core that lost the line tracks the chunks stored to from now on, until it misses on the line */
+  recordStore(entry, chunks);
+  if(others != 0 && entry.written.empty()) {
+    entry.written.assign(numCores_, 0);
+  }
+  for(unsigned int other = 0; other < numCores_; other++) {
+    if(others & coreBit(other)) {
+      entry.written[other] = chunks;
+    }
+  }
+  entry.invalidated |= others;
+  entry.sharers &= ~others;
+}
+
+/* A core stored to chunks of the line: record it for every core that lost the line */
+void MulticoreCache::recordStore(DirectoryEntry &entry, uint64_t chunks)
+{
+  for(uint64_t lost = entry.invalidated; lost != 0; lost &= lost - 1) {
+    entry.written[__builtin_ctzll(lost)] |= chunks;
+  }
+}
+
+/* Allocate line in L1 and, if fillL2, in L2. The state of the two copies is kept the same */
+void MulticoreCache::fillPrivate(unsigned int core, uint64_t line, uint8_t state, bool fillL2)
+{
+  uint64_t victim;
+  uint8_t victimState;
+
+  if(fillL2) {
+    l2_[core]->allocate(line, state, &victim, &victimState);
+    if(victimState != CACHE_LINE_INVALID) {
+      evictPrivate(core, victim, victimState);
+    }
+  }
+
+  /* L2 holds a copy of the victim, if any, in the same state */
+  l1_[core]->allocate(line, state, &victim, &victimState);
+}
+
+/* A line left the L2 of core: the L1 copy goes too */
+void MulticoreCache::evictPrivate(unsigned int core, uint64_t line, uint8_t state)
+{
+  l1_[core]->invalidate(line);
+  if(state == CACHE_LINE_MODIFIED) {
+    writeBack(line);
+  }
+
+  unordered_map<uint64_t, DirectoryEntry>::iterator it = directory_.find(line);
+  assert(it != directory_.end());
+  it->second.sharers &= ~coreBit(core);
+  if(it->second.sharers == 0 && it->second.invalidated == 0) {
+    directory_.erase(it);
+  }
+}
+
+/* Write a dirty line back to the shared cache */
+void MulticoreCache::writeBack(uint64_t line)
+{
+  int64_t way = llc_->probe(line);
+
+  if(way != CACHE_MISS) {
+    llc_->setState(way, CACHE_LINE_MODIFIED);
+  }
+  else {
+    uint64_t victim;
+    uint8_t victimState;
+    llc_->allocate(line, CACHE_LINE_MODIFIED, &victim, &victimState);
+  }
+}
+
+void MulticoreCache::setPrivateState(unsigned int core, uint64_t line, uint8_t state)
+{
+  int64_t way = l1_[core]->probe(line);
+  if(way != CACHE_MISS) {
+    l1_[core]->setState(way, state);
+  }
+  way = l2_[core]->probe(line);
+  if(way != CACHE_MISS) {
+    l2_[core]->setState(way, state);
+  }
+}
+
+bool MulticoreCache::getInstructionStats(uint64_t inst, cache_inst_stats_t *stats) const
+{
+  unordered_map<uint64_t, cache_inst_stats_t>::const_iterator it = stats_.find(inst);
+
+  if(it == stats_.end()) {
+    memset(stats, 0, sizeof(cache_inst_stats_t));
+    return false;
+  }
+  *stats = it->second;
+  return true;
+}
+
+void MulticoreCache::dumpInstructionStats(FILE *out) const
+{
+  vector<uint64_t> insts;
+
+  for(unordered_map<uint64_t, cache_inst_stats_t>::const_iterator it = stats_.begin(); it != stats_.end(); it++) {
+    insts.push_back(it->first);
+  }
+  sort(insts.begin(), insts.end());
+
+  fprintf(out, "# Instruction Accesses Misses CoherenceMisses FalseSharingMisses Invalidations\n");
+  for(vector<uint64_t>::const_iterator i = insts.begin(); i != insts.end(); i++) {
+    const cache_inst_stats_t &stats = stats_.find(*i)->second;
+    fprintf(out, "%llu %llu %llu %llu %llu %llu\n", (unsigned long long)*i, stats.accesses, stats.misses, stats.coherenceMisses, stats.falseSharingMisses, stats.invalidations);
+  }
+}
@@ -0,0 +1,73 @@
+#ifndef COHERENCE_H
+#define COHERENCE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+#include <cache.h>
+#include <cache_array.h>
+
+using namespace std;
+
+/**
+ * Directory entry of a line: which private caches hold it and, for the
+ * classification of coherence misses, which ones lost it to a store of
+ * another core.  written[core] holds the chunks of the line stored to by
+ * other cores since core lost it; it is allocated at the first invalidation.
+ **/
+struct DirectoryEntry
+{
+  uint64_t sharers;
+  uint64_t invalidated;
+  vector<uint64_t> written;
+};
+
+/**
+ * Cores with private L1 and L2 caches (L2 inclusive of L1) in front of a
+ * shared last level cache.  Private caches are kept coherent by a MESI
+ * directory; every level is write-allocate and write-back, modified lines
+ * being the dirty ones.
+ **/
+class MulticoreCache{
+ public:
+  MulticoreCache(unsigned int numCores, const cache_level_config_t &l1, const cache_level_config_t &l2, const cache_level_config_t &llc, unsigned int memoryLatency, unsigned int coherenceLatency);
+  ~MulticoreCache();
+
+  /* Access of core on behalf of the static instruction inst, return the cycles it took */
+  unsigned int access(unsigned int core, uint64_t inst, uint64_t addr, unsigned int size, bool isStore);
+
+  unsigned long long getCycles(unsigned int core) const { return cycles_[core]; }
+  bool getInstructionStats(uint64_t inst, cache_inst_stats_t *stats) const;
+  void dumpInstructionStats(FILE *out) const;
+
+ private:
+  unsigned int numCores_;
+  unsigned int lineBits_;
+  unsigned int chunkBits_;
+  vector<CacheArray *> l1_;
+  vector<CacheArray *> l2_;
+  CacheArray *llc_;
+  unsigned int latencies_[3];
+  unsigned int memoryLatency_;
+  unsigned int coherenceLatency_;
+
+  unordered_map<uint64_t, DirectoryEntry> directory_;
+  unordered_map<uint64_t, cache_inst_stats_t> stats_;
+  vector<unsigned long long> cycles_;
+
+  // Helper functions
+  unsigned int accessLine(unsigned int core, cache_inst_stats_t &stats, uint64_t line, uint64_t chunks, bool isStore);
+  unsigned int storeHit(unsigned int core, cache_inst_stats_t &stats, uint64_t line, uint64_t chunks, uint8_t state);
+  unsigned int fetchLine(unsigned int core, cache_inst_stats_t &stats, uint64_t line, uint64_t chunks, bool isStore, uint8_t *state);
+  unsigned int accessLLC(uint64_t line);
+  void invalidateOthers(cache_inst_stats_t &stats, DirectoryEntry &entry, uint64_t line, uint64_t others, uint64_t chunks);
+  void recordStore(DirectoryEntry &entry, uint64_t chunks);
+  void fillPrivate(unsigned int core, uint64_t line, uint8_t state, bool fillL2);
+  void evictPrivate(unsigned int core, uint64_t line, uint8_t state);
+  void writeBack(uint64_t line);
+  void setPrivateState(unsigned int core, uint64_t line, uint8_t state);
+};
+
+#endif
@@ -612,6 +612,8 @@ static inline char *jobToString (JITUINT64 job) {
             return "SSA form to normal form code conversion   ";
         case CUSTOM:
             return "Custom                                    ";
+        case METHOD_DEVIRTUALIZATION:
+            return "Method devirtualization                   ";
     }
 
     return NULL;
@@ -1068,6 +1070,8 @@ char * IROPTIMIZER_jobToShortName (JITUINT64 job) {
             return "fromssa";
         case CUSTOM:
             return "custom";
+        case METHOD_DEVIRTUALIZATION:
+            return "devirtualization";
     }
 
     return NULL;
@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include <ir_method.h>
 #include <jitsystem.h>
+#include <compilation_telemetry.h>
 
 // My headers
 #include <optimizations_utilities.h>
@@ -26,6 +27,8 @@
 
 #define DIM_BUF 1024
 
+static inline void internal_runCodetool (ir_optimization_t *plugin, ir_method_t *method, JITUINT64 optimizationKind);
+
 JITBOOLEAN internal_isOptimizationInstalled (ir_optimizer_t *lib, JITUINT64 optimizationKind) {
     XanListItem	*item;
 
@@ -167,8 +170,40 @@ void internal_callMethodOptimization (ir_optimizer_t *lib, ir_method_t *method,
         }
     }
     method->valid_optimization &= ~(plugin->plugin->get_invalidations());
-    plugin->plugin->do_job(method);
+    internal_runCodetool(plugin, method, optimizationKind);
     method->valid_optimization |= optimizationKind;
 
     return;
 }
+
+static inline void internal_runCodetool (ir_optimization_t *plugin, ir_method_t *method, JITUINT64 optimizationKind) {
+    ILTelemetryTimer	timer;
+    JITINT8			*methodName;
+    char			*codetoolName;
+
+    /* Check whether the invocation has to be recorded.
+     */
+    if (!ILTELEMETRY_isEnabled()) {
+        plugin->plugin->do_job(method);
+        return ;
+    }
+
+    /* Run the codetool.
+     */
+    ILTELEMETRY_startTimer(&timer);
+    plugin->plugin->do_job(method);
+
+    /* Record the invocation.
+     */
+    methodName	= IRMETHOD_getCompleteMethodName(method);
+    if (methodName == NULL) {
+        methodName	= IRMETHOD_getMethodName(method);
+    }
+    codetoolName	= IROPTIMIZER_jobToShortName(optimizationKind);
+    if (codetoolName == NULL) {
+        codetoolName	= "unknown";
+    }
+    ILTELEMETRY_stopTimer(&timer, ILTELEMETRY_CODETOOL, method, methodName, codetoolName, IRMETHOD_getInstructionsNumber(method));
+
+    return ;
+}
@@ -85,6 +85,7 @@ inline FieldDescriptor *newFieldDescriptor (metadataManager_t *manager, BasicFie
         found->getCompleteName = getCompleteNameFromFieldDescriptor;
         found->getType = getTypeDescriptorFromField;
         found->isAccessible = isFieldAccessible;
+        found->layoutIndex = -1;
         /* end init Default value */
         found->attributes = getBasicFieldAttributes(manager, row);
         xanHashTable_insert(manager->fieldDescriptors, (void *) found, (void *) found);
@@ -623,6 +623,8 @@ typedef struct _FieldDescriptor {
     struct _TypeDescriptor *type;
     struct _TypeDescriptor * (*getType)(struct _FieldDescriptor *field);
 
+    JITINT32 layoutIndex;	/**< Position of the field in the layout of its type, -1 before the type is laid out	*/
+
     JITINT8 *name;
     JITINT8 *completeName;
     JITINT8 *(*getName)(struct _FieldDescriptor *type);
@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <compiler_memory_manager.h>
+#include <platform_API.h>
+#include <jitsystem.h>
+
+// My headers
+#include <code_map.h>
+// End
+
+static inline ILCodeMapEntry * internal_newEntry (void *start, void *end, void *data, JITUINT32 level);
+static inline ILCodeMapEntry * internal_findLastNotAfter (ILCodeMap *map, void *address);
+static inline JITUINT32 internal_randomLevel (ILCodeMap *map);
+
+ILCodeMap * ILCODEMAP_new (void) {
+    ILCodeMap	*map;
+
+    map			= allocFunction(sizeof(ILCodeMap));
+    map->head		= internal_newEntry(NULL, NULL, NULL, ILCODEMAP_MAX_LEVEL);
+    map->level		= 1;
+    map->entriesNumber	= 0;
+    map->seed		= 0x9E3779B9;
+    PLATFORM_initMutex(&(map->mutex), NULL);
+
+    return map;
+}
+
+void * ILCODEMAP_insert (ILCodeMap *map, void *start, void *end, void *data) {
+    ILCodeMapEntry	*predecessors[ILCODEMAP_MAX_LEVEL];
+    ILCodeMapEntry	*current;
+    ILCodeMapEntry	*entry;
+    JITINT32	count;
+    JITUINT32	level;
+    JITUINT32	mapLevel;
+
+    /* Assertions			*/
+    assert(map != NULL);
+    assert(((JITNUINT) start) < ((JITNUINT) end));
+
+    PLATFORM_lockMutex(&(map->mutex));
+
+    /* Find the last entry of each level that starts before start	*/
+    mapLevel	= map->level;
+    current		= map->head;
+    for (count = ILCODEMAP_MAX_LEVEL - 1; count >= 0; count--) {
+        if (count < (JITINT32) mapLevel) {
+            ILCodeMapEntry	*next;
+            while (	((next = current->next[count]) != NULL)		&&
+                    (((JITNUINT) next->start) < ((JITNUINT) start))	) {
+                current	= next;
+            }
+        }
+        predecessors[count]	= current;
+    }
+
+    /* Check whether the range is already mapped	*/
+    entry	= current->next[0];
+    if (	(entry != NULL)			&&
+            (entry->start == start)		) {
+        if (entry->end == entry->start) {
+
+            /* Reuse the entry of a removed range; the data is published before the range becomes non-empty	*/
+            __atomic_store_n(&(entry->data), data, __ATOMIC_RELEASE);
+            __atomic_store_n(&(entry->end), end, __ATOMIC_RELEASE);
+            __atomic_store_n(&(map->entriesNumber), map->entriesNumber + 1, __ATOMIC_RELAXED);
+            PLATFORM_unlockMutex(&(map->mutex));
+            return data;
+        }
+        if (((JITNUINT) entry->end) < ((JITNUINT) end)) {
+            __atomic_store_n(&(entry->end), end, __ATOMIC_RELEASE);
+        }
+        data	= entry->data;
+        PLATFORM_unlockMutex(&(map->mutex));
+        return data;
+    }
+
+    /* Make the entry and link its own pointers before publishing it	*/
+    level	= internal_randomLevel(map);
+    entry	= internal_newEntry(start, end, data, level);
+    for (count = 0; count < (JITINT32) level; count++) {
+        entry->next[count]	= predecessors[count]->next[count];
+    }
+
+    /* Publish the entry from the lowest level upward, so a reader that	*
+     * finds it at some level also finds it at the levels below		*/
+    for (count = 0; count < (JITINT32) level; count++) {
+        __atomic_store_n(&(predecessors[count]->next[count]), entry, __ATOMIC_RELEASE);
+    }
+    if (level > mapLevel) {
+        __atomic_store_n(&(map->level), level, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&(map->entriesNumber), map->entriesNumber + 1, __ATOMIC_RELAXED);
+
+    PLATFORM_unlockMutex(&(map->mutex));
+
+    return data;
+}
+
+void * ILCODEMAP_remove (ILCodeMap *map, void *start) {
+    ILCodeMapEntry	*entry;
+    void		*data;
+
+    /* Assertions			*/
+    assert(map != NULL);
+
+    PLATFORM_lockMutex(&(map->mutex));
+
+    /* Fetch the range			*/
+    entry	= internal_findLastNotAfter(map, start);
+    if (	(entry == NULL)			||
+            (entry->start != start)		||
+            (entry->end == entry->start)	) {
+        PLATFORM_unlockMutex(&(map->mutex));
+        return NULL;
+    }
+
+    /* Empty the range; the entry stays linked because readers can be walking through it	*/
+    data	= entry->data;
+    __atomic_store_n(&(entry->end), entry->start, __ATOMIC_RELEASE);
+    __atomic_store_n(&(entry->data), NULL, __ATOMIC_RELEASE);
+    __atomic_store_n(&(map->entriesNumber), map->entriesNumber - 1, __ATOMIC_RELAXED);
+
+    PLATFORM_unlockMutex(&(map->mutex));
+
+    return data;
+}
+
+void * ILCODEMAP_lookup (ILCodeMap *map, void *start) {
+    ILCodeMapEntry	*entry;
+
+    /* Assertions			*/
+    assert(map != NULL);
+
+    entry	= internal_findLastNotAfter(map, start);
+    if (	(entry == NULL)			||
+            (entry->start != start)		) {
+        return NULL;
+    }
+
+    return __atomic_load_n(&(entry->data), __ATOMIC_ACQUIRE);
+}
+
+void * ILCODEMAP_find (ILCodeMap *map, void *address, void **rangeStart) {
+    ILCodeMapEntry	*entry;
+
+    /* Assertions			*/
+    assert(map != NULL);
+
+    entry	= internal_findLastNotAfter(map, address);
+    if (	(entry == NULL)										||
+            (((JITNUINT) address) >= ((JITNUINT) __atomic_load_n(&(entry->end), __ATOMIC_ACQUIRE)))	) {
+        return NULL;
+    }
+    if (rangeStart != NULL) {
+        (*rangeStart)	= entry->start;
+    }
+
+    return __atomic_load_n(&(entry->data), __ATOMIC_ACQUIRE);
+}
+
+JITUINT32 ILCODEMAP_size (ILCodeMap *map) {
+    return __atomic_load_n(&(map->entriesNumber), __ATOMIC_RELAXED);
+}
+
+void ILCODEMAP_destroy (ILCodeMap *map) {
+    ILCodeMapEntry	*entry;
+
+    /* Assertions			*/
+    assert(map != NULL);
+
+    entry	= map->head;
+    while (entry != NULL) {
+        ILCodeMapEntry	*next;
+        next	= entry->next[0];
+        freeFunction(entry);
+        entry	= next;
+    }
+    PLATFORM_destroyMutex(&(map->mutex));
+    freeFunction(map);
+
+    return ;
+}
+
+static inline ILCodeMapEntry * internal_findLastNotAfter (ILCodeMap *map, void *address) {
+    ILCodeMapEntry	*current;
+    JITINT32	count;
+
+    /* Walk down the levels keeping the last entry that does not start after address.
+     * Entries linked while walking are either seen at the current level or at the ones below.
+     */
+    current	= map->head;
+    for (count = ((JITINT32) __atomic_load_n(&(map->level), __ATOMIC_ACQUIRE)) - 1; count >= 0; count--) {
+        ILCodeMapEntry	*next;
+        while (	((next = __atomic_load_n(&(current->next[count]), __ATOMIC_ACQUIRE)) != NULL)	&&
+                (((JITNUINT) next->start) <= ((JITNUINT) address))				) {
+            current	= next;
+        }
+    }
+    if (current == map->head) {
+        return NULL;
+    }
+
+    return current;
+}
+
+static inline ILCodeMapEntry * internal_newEntry (void *start, void *end, void *data, JITUINT32 level) {
+    ILCodeMapEntry	*entry;
+
+    entry		= allocFunction(sizeof(ILCodeMapEntry) + (sizeof(ILCodeMapEntry *) * level));
+    entry->start	= start;
+    entry->end	= end;
+    entry->data	= data;
+    entry->level	= level;
+
+    return entry;
+}
+
+static inline JITUINT32 internal_randomLevel (ILCodeMap *map) {
+    JITUINT32	level;
+    JITUINT32	bits;
+
+    /* Xorshift generator; it is only used by writers, which hold the mutex.
+     * Every level is reached with probability 1/4 from the level below.
+     */
+    bits		= map->seed;
+    bits		^= bits << 13;
+    bits		^= bits >> 17;
+    bits		^= bits << 5;
+    map->seed	= bits;
+    level		= 1;
+    while (	((bits & 3) == 0)			&&
+            (level < ILCODEMAP_MAX_LEVEL)		) {
+        level++;
+        bits	>>= 2;
+    }
+
+    return level;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef CODE_MAP_H
+#define CODE_MAP_H
+
+#include <pthread.h>
+#include <jitsystem.h>
+
+/**
+ * @defgroup CodeMap Code map
+ *
+ * Map from ranges of code addresses [start, end) to the data of the code (e.g., the method it belongs to).
+ *
+ * The ranges are kept sorted by their start in a skip list.
+ * Lookups do not take locks and never wait for writers: a new range is linked from the lowest level of the list upward, so readers either see it completely or do not see it.
+ * Insertions and removals are serialized by a mutex.
+ * Ranges are never unlinked while the map is alive, so readers never access freed memory: a removed range is left empty and it is reused by the next range that starts at the same address.
+ */
+
+/**
+ * @ingroup CodeMap
+ * @brief Highest number of levels of the skip list
+ */
+#define ILCODEMAP_MAX_LEVEL		16
+
+typedef struct ILCodeMapEntry {
+    void			*start;			/**< First address of the range					*/
+    void			*end;			/**< Address after the last one of the range			*/
+    void			*data;
+    JITUINT32		level;			/**< Number of lists the entry is linked to			*/
+    struct ILCodeMapEntry	*next[];		/**< Next entry of each level					*/
+} ILCodeMapEntry;
+
+typedef struct {
+    ILCodeMapEntry		*head;			/**< Sentinel linked to every level				*/
+    JITUINT32		level;			/**< Levels in use						*/
+    JITUINT32		entriesNumber;
+    JITUINT32		seed;			/**< State of the generator of the levels of new entries	*/
+    pthread_mutex_t		mutex;			/**< Serializes the writers					*/
+} ILCodeMap;
+
+/**
+ * @ingroup CodeMap
+ * @brief Make an empty map
+ */
+ILCodeMap * ILCODEMAP_new (void);
+
+/**
+ * @ingroup CodeMap
+ * @brief Map the range [start, end) to data
+ *
+ * If a range starting at start is already mapped, its data is kept and its end is extended to end if it is further.
+ * A range that has been removed is replaced.
+ *
+ * @return the data mapped to the range starting at start
+ */
+void * ILCODEMAP_insert (ILCodeMap *map, void *start, void *end, void *data);
+
+/**
+ * @ingroup CodeMap
+ * @brief Unmap the range that starts exactly at start
+ *
+ * It has to be called before the memory of the range can be reused, so that new code placed at start is not resolved to the old data.
+ *
+ * @return the data mapped to the range, or NULL if no range starts at start
+ */
+void * ILCODEMAP_remove (ILCodeMap *map, void *start);
+
+/**
+ * @ingroup CodeMap
+ * @brief Fetch the data of the range that starts exactly at start
+ *
+ * @return NULL if no range starts at start
+ */
+void * ILCODEMAP_lookup (ILCodeMap *map, void *start);
+
+/**
+ * @ingroup CodeMap
+ * @brief Fetch the data of the range that includes address
+ *
+ * @param rangeStart If it is not NULL, it is set to the start of the range found
+ * @return NULL if address does not belong to any range
+ */
+void * ILCODEMAP_find (ILCodeMap *map, void *address, void **rangeStart);
+
+/**
+ * @ingroup CodeMap
+ * @brief Number of ranges mapped
+ */
+JITUINT32 ILCODEMAP_size (ILCodeMap *map);
+
+/**
+ * @ingroup CodeMap
+ * @brief Free the map
+ *
+ * No other thread can access the map while it is destroyed.
+ */
+void ILCODEMAP_destroy (ILCodeMap *map);
+
+#endif
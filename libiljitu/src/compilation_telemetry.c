@@ -0,0 +1,467 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <assert.h>
+#include <compiler_memory_manager.h>
+#include <platform_API.h>
+#include <jitsystem.h>
+
+// My headers
+#include <compilation_telemetry.h>
+// End
+
+typedef struct {
+    void			*key;			/**< Method or name of the codetool			*/
+    JITINT8			*name;
+    JITUINT64		time;
+    JITUINT64		queueTime;
+    JITUINT32		records;
+} ILTelemetryAggregate;
+
+static inline JITUINT64 internal_clock (void);
+static inline void internal_append (ILTelemetryStage stage, void *method, JITINT8 *methodName, const char *passName, JITUINT64 startTime, JITUINT64 time, JITUINT64 selfTime, JITUINT32 codeSize);
+static inline ILTelemetryBlock * internal_newBlock (void);
+static inline ILTelemetryRecord ** internal_collectRecords (JITUINT32 *recordsNumber);
+static inline JITUINT32 internal_aggregate (ILTelemetryRecord **records, JITUINT32 recordsNumber, JITBOOLEAN byCodetool, ILTelemetryAggregate *aggregates);
+static inline void internal_printQuoted (FILE *fileToWrite, JITINT8 *string);
+static int internal_compareMethods (const void *r1, const void *r2);
+static int internal_compareCodetools (const void *r1, const void *r2);
+static int internal_compareAggregates (const void *a1, const void *a2);
+
+static JITBOOLEAN	enabled		= JITFALSE;
+static JITUINT64	baseTime	= 0;
+static ILTelemetryBlock	*blocks		= NULL;
+static JITUINT32	threadsNumber	= 0;
+static __thread ILTelemetryBlock	*currentBlock	= NULL;
+static __thread JITUINT64		nestedTime	= 0;
+
+void ILTELEMETRY_enable (void) {
+    baseTime	= internal_clock();
+    enabled		= JITTRUE;
+
+    return ;
+}
+
+JITBOOLEAN ILTELEMETRY_isEnabled (void) {
+    return enabled;
+}
+
+JITUINT64 ILTELEMETRY_now (void) {
+    return internal_clock() - baseTime;
+}
+
+void ILTELEMETRY_startTimer (ILTelemetryTimer *timer) {
+
+    /* Assertions			*/
+    assert(timer != NULL);
+
+    if (!enabled) {
+        return ;
+    }
+
+    /* Start counting the records nested in the new one from zero	*/
+    timer->outerNestedTime	= nestedTime;
+    nestedTime		= 0;
+    timer->startTime	= ILTELEMETRY_now();
+
+    return ;
+}
+
+void ILTELEMETRY_stopTimer (ILTelemetryTimer *timer, ILTelemetryStage stage, void *method, JITINT8 *methodName, const char *passName, JITUINT32 codeSize) {
+    JITUINT64	time;
+    JITUINT64	selfTime;
+
+    /* Assertions			*/
+    assert(timer != NULL);
+    assert(stage < ILTELEMETRY_STAGES_NUMBER);
+
+    if (!enabled) {
+        return ;
+    }
+
+    /* Compute the time of the stage out of the records nested in it	*/
+    time		= ILTELEMETRY_now() - timer->startTime;
+    selfTime	= (time > nestedTime) ? (time - nestedTime) : 0;
+
+    /* The whole stage is nested in the enclosing timer			*/
+    nestedTime	= timer->outerNestedTime + time;
+
+    internal_append(stage, method, methodName, passName, timer->startTime, time, selfTime, codeSize);
+
+    return ;
+}
+
+void ILTELEMETRY_recordQueueWait (JITUINT64 enqueueTime, void *method, JITINT8 *methodName, const char *passName) {
+    JITUINT64	now;
+    JITUINT64	time;
+
+    if (!enabled) {
+        return ;
+    }
+    now	= ILTELEMETRY_now();
+    time	= (now > enqueueTime) ? (now - enqueueTime) : 0;
+    internal_append(ILTELEMETRY_QUEUE_WAIT, method, methodName, passName, enqueueTime, time, time, 0);
+
+    return ;
+}
+
+const char * ILTELEMETRY_stageName (ILTelemetryStage stage) {
+    switch (stage) {
+        case ILTELEMETRY_QUEUE_WAIT:
+            return "queue";
+        case ILTELEMETRY_CIL_IR:
+            return "cil-ir";
+        case ILTELEMETRY_DLA:
+            return "dla";
+        case ILTELEMETRY_IR_OPTIMIZATION:
+            return "optimization";
+        case ILTELEMETRY_CODETOOL:
+            return "codetool";
+        case ILTELEMETRY_LOWERING:
+            return "lowering";
+        case ILTELEMETRY_MACHINE_CODE:
+            return "machinecode";
+        default:
+            return "unknown";
+    }
+}
+
+JITBOOLEAN ILTELEMETRY_dump (char *fileName) {
+    ILTelemetryBlock	*block;
+    FILE			*fileToWrite;
+
+    /* Assertions			*/
+    assert(fileName != NULL);
+
+    /* Open the file		*/
+    fileToWrite	= fopen(fileName, "w");
+    if (fileToWrite == NULL) {
+        return JITFALSE;
+    }
+
+    /* Write the records		*/
+    fprintf(fileToWrite, "thread,stage,pass,method,start_us,time_us,self_time_us,code_size\n");
+    block	= __atomic_load_n(&blocks, __ATOMIC_ACQUIRE);
+    while (block != NULL) {
+        JITUINT32	recordsNumber;
+        JITUINT32	count;
+
+        recordsNumber	= __atomic_load_n(&(block->recordsNumber), __ATOMIC_ACQUIRE);
+        for (count = 0; count < recordsNumber; count++) {
+            ILTelemetryRecord	*record;
+            record	= &(block->records[count]);
+            fprintf(fileToWrite, "%u,%s,%s,", record->threadID, ILTELEMETRY_stageName(record->stage), (record->passName != NULL) ? record->passName : "");
+            internal_printQuoted(fileToWrite, record->methodName);
+            fprintf(fileToWrite, ",%.3f,%.3f,%.3f,%u\n", record->startTime / 1000.0, record->time / 1000.0, record->selfTime / 1000.0, record->codeSize);
+        }
+        block	= block->next;
+    }
+
+    /* Close the file		*/
+    if (fclose(fileToWrite) != 0) {
+        return JITFALSE;
+    }
+
+    return JITTRUE;
+}
+
+void ILTELEMETRY_printSummary (FILE *stream, JITUINT32 topN) {
+    ILTelemetryRecord	**records;
+    ILTelemetryAggregate	*aggregates;
+    JITUINT64		stageTimes[ILTELEMETRY_STAGES_NUMBER];
+    JITUINT64		stageSelfTimes[ILTELEMETRY_STAGES_NUMBER];
+    JITUINT32		stageRecords[ILTELEMETRY_STAGES_NUMBER];
+    JITUINT32		recordsNumber;
+    JITUINT32		aggregatesNumber;
+    JITUINT32		count;
+
+    /* Assertions			*/
+    assert(stream != NULL);
+
+    /* Fetch the records		*/
+    records	= internal_collectRecords(&recordsNumber);
+    fprintf(stream, "Compilation telemetry\n");
+    fprintf(stream, "	Records					= %u\n", recordsNumber);
+    if (recordsNumber == 0) {
+        fprintf(stream, "\n");
+        freeFunction(records);
+        return ;
+    }
+
+    /* Time of every stage		*/
+    memset(stageTimes, 0, sizeof(stageTimes));
+    memset(stageSelfTimes, 0, sizeof(stageSelfTimes));
+    memset(stageRecords, 0, sizeof(stageRecords));
+    for (count = 0; count < recordsNumber; count++) {
+        stageTimes[records[count]->stage]	+= records[count]->time;
+        stageSelfTimes[records[count]->stage]	+= records[count]->selfTime;
+        stageRecords[records[count]->stage]++;
+    }
+    fprintf(stream, "	Stages\n");
+    for (count = 0; count < ILTELEMETRY_STAGES_NUMBER; count++) {
+        fprintf(stream, "		%-12s	records = %-8u	time = %.6f seconds	self time = %.6f seconds\n", ILTELEMETRY_stageName(count), stageRecords[count], stageTimes[count] / 1000000000.0, stageSelfTimes[count] / 1000000000.0);
+    }
+
+    /* Methods that took the most time	*/
+    aggregates		= allocFunction(sizeof(ILTelemetryAggregate) * recordsNumber);
+    qsort(records, recordsNumber, sizeof(ILTelemetryRecord *), internal_compareMethods);
+    aggregatesNumber	= internal_aggregate(records, recordsNumber, JITFALSE, aggregates);
+    qsort(aggregates, aggregatesNumber, sizeof(ILTelemetryAggregate), internal_compareAggregates);
+    fprintf(stream, "	Methods that took the most compilation time (out of %u)\n", aggregatesNumber);
+    for (count = 0; (count < topN) && (count < aggregatesNumber); count++) {
+        fprintf(stream, "		%3u) %.6f seconds	queues = %.6f seconds	%s\n", count + 1, aggregates[count].time / 1000000000.0, aggregates[count].queueTime / 1000000000.0, (aggregates[count].name != NULL) ? (char *) aggregates[count].name : "?");
+    }
+
+    /* Codetools that took the most time	*/
+    qsort(records, recordsNumber, sizeof(ILTelemetryRecord *), internal_compareCodetools);
+    aggregatesNumber	= internal_aggregate(records, recordsNumber, JITTRUE, aggregates);
+    qsort(aggregates, aggregatesNumber, sizeof(ILTelemetryAggregate), internal_compareAggregates);
+    fprintf(stream, "	Codetools that took the most self time (out of %u)\n", aggregatesNumber);
+    for (count = 0; (count < topN) && (count < aggregatesNumber); count++) {
+        fprintf(stream, "		%3u) %.6f seconds	invocations = %-8u	%s\n", count + 1, aggregates[count].time / 1000000000.0, aggregates[count].records, (char *) aggregates[count].name);
+    }
+    fprintf(stream, "\n");
+
+    /* Free the memory		*/
+    freeFunction(aggregates);
+    freeFunction(records);
+
+    return ;
+}
+
+void ILTELEMETRY_shutdown (void) {
+    ILTelemetryBlock	*block;
+
+    enabled	= JITFALSE;
+    block	= __atomic_exchange_n(&blocks, NULL, __ATOMIC_ACQ_REL);
+    while (block != NULL) {
+        ILTelemetryBlock	*next;
+        next	= block->next;
+        freeFunction(block);
+        block	= next;
+    }
+    currentBlock	= NULL;
+
+    return ;
+}
+
+static inline void internal_append (ILTelemetryStage stage, void *method, JITINT8 *methodName, const char *passName, JITUINT64 startTime, JITUINT64 time, JITUINT64 selfTime, JITUINT32 codeSize) {
+    ILTelemetryRecord	*record;
+    JITUINT32		recordsNumber;
+
+    /* Fetch a block with room for the record	*/
+    if (	(currentBlock == NULL)							||
+            (currentBlock->recordsNumber == ILTELEMETRY_BLOCK_RECORDS)		) {
+        currentBlock	= internal_newBlock();
+    }
+
+    /* Fill the record and publish it		*/
+    recordsNumber		= currentBlock->recordsNumber;
+    record			= &(currentBlock->records[recordsNumber]);
+    record->method		= method;
+    record->methodName	= methodName;
+    record->passName	= passName;
+    record->startTime	= startTime;
+    record->time		= time;
+    record->selfTime	= selfTime;
+    record->codeSize	= codeSize;
+    record->stage		= stage;
+    record->threadID	= currentBlock->threadID;
+    __atomic_store_n(&(currentBlock->recordsNumber), recordsNumber + 1, __ATOMIC_RELEASE);
+
+    return ;
+}
+
+static inline ILTelemetryBlock * internal_newBlock (void) {
+    ILTelemetryBlock	*block;
+
+    /* Make the block		*/
+    block		= allocFunction(sizeof(ILTelemetryBlock));
+    if (currentBlock != NULL) {
+        block->threadID	= currentBlock->threadID;
+    } else {
+        block->threadID	= (JITUINT16) __atomic_fetch_add(&threadsNumber, 1, __ATOMIC_RELAXED);
+    }
+
+    /* Link the block to the list	*/
+    block->next	= __atomic_load_n(&blocks, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&blocks, &(block->next), block, JITTRUE, __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+        ;
+    }
+
+    return block;
+}
+
+static inline ILTelemetryRecord ** internal_collectRecords (JITUINT32 *recordsNumber) {
+    ILTelemetryRecord	**records;
+    ILTelemetryBlock	*block;
+    JITUINT32		number;
+    JITUINT32		blocksNumber;
+
+    /* Count the blocks		*/
+    blocksNumber	= 0;
+    block		= __atomic_load_n(&blocks, __ATOMIC_ACQUIRE);
+    while (block != NULL) {
+        blocksNumber++;
+        block	= block->next;
+    }
+
+    /* Collect the records		*/
+    records	= allocFunction(sizeof(ILTelemetryRecord *) * ((blocksNumber * ILTELEMETRY_BLOCK_RECORDS) + 1));
+    number	= 0;
+    block	= __atomic_load_n(&blocks, __ATOMIC_ACQUIRE);
+    while (block != NULL) {
+        JITUINT32	blockRecords;
+        JITUINT32	count;
+
+        blockRecords	= __atomic_load_n(&(block->recordsNumber), __ATOMIC_ACQUIRE);
+        for (count = 0; count < blockRecords; count++) {
+            records[number]	= &(block->records[count]);
+            number++;
+        }
+        block	= block->next;
+    }
+    (*recordsNumber)	= number;
+
+    return records;
+}
+
+static inline JITUINT32 internal_aggregate (ILTelemetryRecord **records, JITUINT32 recordsNumber, JITBOOLEAN byCodetool, ILTelemetryAggregate *aggregates) {
+    ILTelemetryAggregate	*current;
+    JITUINT32		aggregatesNumber;
+    JITUINT32		count;
+
+    /* Records are sorted, so the ones of the same method or codetool are contiguous.
+     * The time of a method is the self time of its records, so the time of the stages nested in others is not counted twice.
+     */
+    current			= NULL;
+    aggregatesNumber	= 0;
+    for (count = 0; count < recordsNumber; count++) {
+        ILTelemetryRecord	*record;
+        void			*key;
+
+        record	= records[count];
+        if (byCodetool) {
+            if (	(record->stage != ILTELEMETRY_CODETOOL)	||
+                    (record->passName == NULL)		) {
+                continue ;
+            }
+            key	= (void *) record->passName;
+        } else {
+            key	= record->method;
+        }
+        if (	(current == NULL)											||
+                (byCodetool && (strcmp((char *) current->key, (char *) key) != 0))					||
+                ((!byCodetool) && (current->key != key))								) {
+            current		= &(aggregates[aggregatesNumber]);
+            aggregatesNumber++;
+            memset(current, 0, sizeof(ILTelemetryAggregate));
+            current->key	= key;
+            current->name	= byCodetool ? (JITINT8 *) record->passName : record->methodName;
+        }
+        if (current->name == NULL) {
+            current->name	= record->methodName;
+        }
+        if (record->stage == ILTELEMETRY_QUEUE_WAIT) {
+            current->queueTime	+= record->time;
+        } else {
+            current->time		+= record->selfTime;
+        }
+        current->records++;
+    }
+
+    return aggregatesNumber;
+}
+
+static inline void internal_printQuoted (FILE *fileToWrite, JITINT8 *string) {
+    JITINT8	*c;
+
+    if (string == NULL) {
+        return ;
+    }
+    fputc('"', fileToWrite);
+    for (c = string; (*c) != '\0'; c++) {
+        if ((*c) == '"') {
+            fputc('"', fileToWrite);
+        }
+        fputc(*c, fileToWrite);
+    }
+    fputc('"', fileToWrite);
+
+    return ;
+}
+
+static int internal_compareMethods (const void *r1, const void *r2) {
+    JITNUINT	m1;
+    JITNUINT	m2;
+
+    m1	= (JITNUINT) (*((ILTelemetryRecord **) r1))->method;
+    m2	= (JITNUINT) (*((ILTelemetryRecord **) r2))->method;
+    if (m1 < m2) {
+        return -1;
+    }
+    if (m1 > m2) {
+        return 1;
+    }
+
+    return 0;
+}
+
+static int internal_compareCodetools (const void *r1, const void *r2) {
+    const char	*p1;
+    const char	*p2;
+
+    p1	= (*((ILTelemetryRecord **) r1))->passName;
+    p2	= (*((ILTelemetryRecord **) r2))->passName;
+    if (p1 == NULL) {
+        return (p2 == NULL) ? 0 : -1;
+    }
+    if (p2 == NULL) {
+        return 1;
+    }
+
+    return strcmp(p1, p2);
+}
+
+static int internal_compareAggregates (const void *a1, const void *a2) {
+    JITUINT64	t1;
+    JITUINT64	t2;
+
+    /* Descending order of time	*/
+    t1	= ((ILTelemetryAggregate *) a1)->time;
+    t2	= ((ILTelemetryAggregate *) a2)->time;
+    if (t1 > t2) {
+        return -1;
+    }
+    if (t1 < t2) {
+        return 1;
+    }
+
+    return 0;
+}
+
+static inline JITUINT64 internal_clock (void) {
+    struct timespec	now;
+
+    PLATFORM_clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (((JITUINT64) now.tv_sec) * 1000000000ULL) + ((JITUINT64) now.tv_nsec);
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef COMPILATION_TELEMETRY_H
+#define COMPILATION_TELEMETRY_H
+
+#include <stdio.h>
+#include <jitsystem.h>
+
+/**
+ * @defgroup CompilationTelemetry Compilation telemetry
+ *
+ * Per-method record of the time spent by every stage of the compilation (e.g., CIL->IR translation, every codetool invoked, lowering, machine code generation)
+ * and of the time spent by methods waiting in the queues between the stages of the translation pipeline.
+ *
+ * Every thread appends its records to blocks that only it writes; a block is linked to the list of every block with a compare-and-swap when it is made, so recording never takes locks.
+ * Records are read only once the compilation threads are gone (i.e., by \ref ILTELEMETRY_dump and \ref ILTELEMETRY_printSummary at the exit of the system).
+ *
+ * Nested stages (e.g., codetools that invoke other codetools) are charged to their own records: the self time of a record does not include the time of the records started and stopped within it.
+ */
+
+/**
+ * @ingroup CompilationTelemetry
+ * @brief Records of each block
+ */
+#define ILTELEMETRY_BLOCK_RECORDS	1024
+
+typedef enum {
+    ILTELEMETRY_QUEUE_WAIT = 0,		/**< Time spent waiting in the queue of a stage of the translation pipeline	*/
+    ILTELEMETRY_CIL_IR,			/**< CIL->IR translation							*/
+    ILTELEMETRY_DLA,			/**< Dynamic look ahead								*/
+    ILTELEMETRY_IR_OPTIMIZATION,		/**< Optimization stage, which includes the codetools it invokes		*/
+    ILTELEMETRY_CODETOOL,			/**< Single invocation of a codetool						*/
+    ILTELEMETRY_LOWERING,			/**< Translation to the representation of the backend				*/
+    ILTELEMETRY_MACHINE_CODE,		/**< Generation of the machine code by the backend				*/
+    ILTELEMETRY_STAGES_NUMBER
+} ILTelemetryStage;
+
+typedef struct {
+    void			*method;		/**< Key of the method (e.g., its IR method)				*/
+    JITINT8			*methodName;		/**< Name of the method; it has to be alive till the telemetry is dumped	*/
+    const char		*passName;		/**< Codetool or queue of the record; NULL for the other stages		*/
+    JITUINT64		startTime;		/**< Nanoseconds from the enabling of the telemetry			*/
+    JITUINT64		time;			/**< Nanoseconds spent by the stage					*/
+    JITUINT64		selfTime;		/**< Nanoseconds spent by the stage out of the records nested in it	*/
+    JITUINT32		codeSize;		/**< Instructions of the method after the stage; 0 if unknown		*/
+    JITUINT16		stage;
+    JITUINT16		threadID;
+} ILTelemetryRecord;
+
+typedef struct ILTelemetryBlock {
+    struct ILTelemetryBlock	*next;			/**< Block made before this one by any thread			*/
+    JITUINT32		recordsNumber;		/**< Records published by the owner of the block		*/
+    JITUINT16		threadID;
+    ILTelemetryRecord	records[ILTELEMETRY_BLOCK_RECORDS];
+} ILTelemetryBlock;
+
+typedef struct {
+    JITUINT64		startTime;
+    JITUINT64		outerNestedTime;	/**< Time of the records nested in the enclosing timer so far	*/
+} ILTelemetryTimer;
+
+/**
+ * @ingroup CompilationTelemetry
+ * @brief Start recording
+ *
+ * It has to be called before the compilation threads start.
+ */
+void ILTELEMETRY_enable (void);
+
+/**
+ * @ingroup CompilationTelemetry
+ * @brief Check whether the telemetry is recording
+ */
+JITBOOLEAN ILTELEMETRY_isEnabled (void);
+
+/**
+ * @ingroup CompilationTelemetry
+ * @brief Nanoseconds from the enabling of the telemetry
+ */
+JITUINT64 ILTELEMETRY_now (void);
+
+/**
+ * @ingroup CompilationTelemetry
+ * @brief Start timing a stage
+ *
+ * Timers of the same thread have to be stopped in the reverse order they have been started.
+ */
+void ILTELEMETRY_startTimer (ILTelemetryTimer *timer);
+
+/**
+ * @ingroup CompilationTelemetry
+ * @brief Stop timing a stage and record it
+ */
+void ILTELEMETRY_stopTimer (ILTelemetryTimer *timer, ILTelemetryStage stage, void *method, JITINT8 *methodName, const char *passName, JITUINT32 codeSize);
+
+/**
+ * @ingroup CompilationTelemetry
+ * @brief Record the time spent by a method in the queue passName since enqueueTime
+ *
+ * @param enqueueTime Value returned by \ref ILTELEMETRY_now when the method has been inserted in the queue
+ */
+void ILTELEMETRY_recordQueueWait (JITUINT64 enqueueTime, void *method, JITINT8 *methodName, const char *passName);
+
+/**
+ * @ingroup CompilationTelemetry
+ * @brief Name of a stage
+ */
+const char * ILTELEMETRY_stageName (ILTelemetryStage stage);
+
+/**
+ * @ingroup CompilationTelemetry
+ * @brief Write every record to fileName
+ *
+ * The file is in the CSV format with a header line; times are in microseconds.
+ *
+ * @return JITFALSE if the file cannot be written
+ */
+JITBOOLEAN ILTELEMETRY_dump (char *fileName);
+
+/**
+ * @ingroup CompilationTelemetry
+ * @brief Print the time of every stage, and the topN methods and codetools that took the most time
+ */
+void ILTELEMETRY_printSummary (FILE *stream, JITUINT32 topN);
+
+/**
+ * @ingroup CompilationTelemetry
+ * @brief Free the records
+ *
+ * No thread has to record anymore.
+ */
+void ILTELEMETRY_shutdown (void);
+
+#endif
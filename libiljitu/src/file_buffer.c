@@ -0,0 +1,473 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <assert.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <compiler_memory_manager.h>
+#include <platform_API.h>
+#include <jitsystem.h>
+
+// My headers
+#include <file_buffer.h>
+// End
+
+/* Reads in a row that have to start where the previous one ended before the buffer grows.
+ */
+#define SEQUENTIAL_ACCESSES_TO_GROW	2
+
+static inline JITINT32 internal_readDirect (ILFileBuffer *file, void *buf, JITINT32 size);
+static inline JITINT32 internal_writeDirect (ILFileBuffer *file, void *buf, JITINT32 size);
+static inline JITBOOLEAN internal_writeVector (ILFileBuffer *file, struct iovec *vector, JITINT32 vectorLength, JITINT64 position);
+static inline JITBOOLEAN internal_flushWrites (ILFileBuffer *file);
+static inline void internal_resizeBuffer (ILFileBuffer *file, JITBOOLEAN sequential);
+
+ILFileBuffer * ILFILENew (JITINT32 fileDescriptor, JITBOOLEAN sequentialHint) {
+    ILFileBuffer	*file;
+    struct stat	info;
+    JITINT32	flags;
+    off_t		position;
+
+    file			= allocFunction(sizeof(ILFileBuffer));
+    file->fileDescriptor	= fileDescriptor;
+    file->buffered		= JITFALSE;
+    file->position		= 0;
+    file->buffer		= NULL;
+    file->bufferSize	= 0;
+    file->bufferPosition	= 0;
+    file->readBytes		= 0;
+    file->dirtyBytes	= 0;
+    file->sequentialAccesses= 0;
+    file->syscalls		= 0;
+    PLATFORM_initMutex(&(file->mutex), NULL);
+
+    /* Only regular files can be read and written at a given position.
+     * Writes of files opened in append mode go to the end of the file whatever their position is.
+     */
+    flags		= fcntl(fileDescriptor, F_GETFL, 0);
+    position	= PLATFORM_lseek(fileDescriptor, 0, SEEK_CUR);
+    if (	(PLATFORM_fstat(fileDescriptor, &info) == 0)	&&
+            (S_ISREG(info.st_mode))				&&
+            (flags != -1)					&&
+            ((flags & O_APPEND) == 0)			&&
+            (position != (off_t) -1)			) {
+        file->buffered		= JITTRUE;
+        file->position		= (JITINT64) position;
+        file->bufferPosition	= file->position;
+        file->bufferSize	= ILFILE_MIN_BUFFER_SIZE;
+        file->buffer		= allocFunction(file->bufferSize);
+    }
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    if (sequentialHint) {
+        posix_fadvise(fileDescriptor, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+
+    return file;
+}
+
+JITINT32 ILFILERead (ILFileBuffer *file, void *buf, JITINT32 size) {
+    JITUINT8	*dst;
+    JITINT32	copied;
+    JITINT32	result;
+    JITBOOLEAN	sequential;
+
+    /* Assertions			*/
+    assert(file != NULL);
+    assert(buf != NULL);
+
+    if (size <= 0) {
+        return 0;
+    }
+
+    PLATFORM_lockMutex(&(file->mutex));
+    if (!file->buffered) {
+        result	= internal_readDirect(file, buf, size);
+        PLATFORM_unlockMutex(&(file->mutex));
+        return result;
+    }
+
+    /* The data waiting to be written has to be visible to the read	*/
+    if (!internal_flushWrites(file)) {
+        PLATFORM_unlockMutex(&(file->mutex));
+        return -1;
+    }
+
+    /* Take what has been read ahead	*/
+    dst	= buf;
+    copied	= 0;
+    if (	(file->position >= file->bufferPosition)				&&
+            (file->position < (file->bufferPosition + file->readBytes))	) {
+        JITUINT32	offset;
+        offset	= (JITUINT32) (file->position - file->bufferPosition);
+        copied	= file->readBytes - offset;
+        if (copied > size) {
+            copied	= size;
+        }
+        memcpy(dst, file->buffer + offset, copied);
+        file->position	+= copied;
+        if (copied == size) {
+            PLATFORM_unlockMutex(&(file->mutex));
+            return copied;
+        }
+        dst	+= copied;
+        size	-= copied;
+    }
+
+    /* Adapt the size of the read-ahead to the way the file is read.
+     * The buffer does not hold valid data from here on.
+     */
+    sequential		= (file->position == (file->bufferPosition + file->readBytes));
+    internal_resizeBuffer(file, sequential);
+    file->readBytes		= 0;
+    file->bufferPosition	= file->position;
+
+    if (	(!sequential)				||
+            (((JITUINT32) size) >= file->bufferSize)	) {
+
+        /* Read ahead only when reads follow each other and are smaller than the buffer	*/
+        do {
+            result	= pread(file->fileDescriptor, dst, size, (off_t) file->position);
+            (file->syscalls)++;
+        } while ((result < 0) && (errno == EINTR));
+        if (result > 0) {
+            file->position		+= result;
+            file->bufferPosition	= file->position;
+        }
+
+    } else {
+        struct iovec	vector[2];
+
+        /* Fill both the destination and the buffer with a single system call	*/
+        vector[0].iov_base	= dst;
+        vector[0].iov_len	= size;
+        vector[1].iov_base	= file->buffer;
+        vector[1].iov_len	= file->bufferSize;
+        do {
+            result	= preadv(file->fileDescriptor, vector, 2, (off_t) file->position);
+            (file->syscalls)++;
+        } while ((result < 0) && (errno == EINTR));
+        if (result > size) {
+            file->bufferPosition	= file->position + size;
+            file->readBytes		= result - size;
+            result			= size;
+        }
+        if (result > 0) {
+            file->position		+= result;
+            if (file->readBytes == 0) {
+                file->bufferPosition	= file->position;
+            }
+        }
+    }
+    PLATFORM_unlockMutex(&(file->mutex));
+
+    /* Data already copied hides the errors of the system call	*/
+    if (result < 0) {
+        return (copied > 0) ? copied : -1;
+    }
+
+    return copied + result;
+}
+
+JITINT32 ILFILEWrite (ILFileBuffer *file, void *buf, JITINT32 size) {
+    struct iovec	vector[2];
+    JITINT32	result;
+
+    /* Assertions			*/
+    assert(file != NULL);
+    assert(buf != NULL);
+
+    if (size <= 0) {
+        return 0;
+    }
+
+    PLATFORM_lockMutex(&(file->mutex));
+    if (!file->buffered) {
+        result	= internal_writeDirect(file, buf, size);
+        PLATFORM_unlockMutex(&(file->mutex));
+        return result;
+    }
+
+    /* Data read ahead may be overwritten	*/
+    if (file->readBytes > 0) {
+        file->readBytes		= 0;
+        file->bufferPosition	= file->position;
+    }
+
+    /* The buffer holds a single contiguous range of the file	*/
+    if (	(file->dirtyBytes > 0)							&&
+            (file->position != (file->bufferPosition + file->dirtyBytes))	) {
+        if (!internal_flushWrites(file)) {
+            PLATFORM_unlockMutex(&(file->mutex));
+            return -1;
+        }
+    }
+    if (file->dirtyBytes == 0) {
+        file->bufferPosition	= file->position;
+    }
+
+    /* Delay the write if it fits the buffer	*/
+    if ((file->dirtyBytes + (JITUINT32) size) <= file->bufferSize) {
+        memcpy(file->buffer + file->dirtyBytes, buf, size);
+        file->dirtyBytes	+= size;
+        file->position		+= size;
+        PLATFORM_unlockMutex(&(file->mutex));
+        return size;
+    }
+
+    /* Write both the buffer and the new data with a single system call	*/
+    vector[0].iov_base	= file->buffer;
+    vector[0].iov_len	= file->dirtyBytes;
+    vector[1].iov_base	= buf;
+    vector[1].iov_len	= size;
+    if (!internal_writeVector(file, vector, 2, file->bufferPosition)) {
+        PLATFORM_unlockMutex(&(file->mutex));
+        return -1;
+    }
+    file->dirtyBytes	= 0;
+    file->position		+= size;
+    file->bufferPosition	= file->position;
+
+    /* Writes that overflow the buffer are sequential by construction	*/
+    internal_resizeBuffer(file, JITTRUE);
+    PLATFORM_unlockMutex(&(file->mutex));
+
+    return size;
+}
+
+JITINT64 ILFILESeek (ILFileBuffer *file, JITINT64 offset, JITINT32 whence) {
+    JITINT64	result;
+    off_t		position;
+
+    /* Assertions			*/
+    assert(file != NULL);
+
+    PLATFORM_lockMutex(&(file->mutex));
+    if (!file->buffered) {
+        while ((position = PLATFORM_lseek(file->fileDescriptor, (off_t) offset, whence)) == (off_t) -1) {
+            if (errno != EINTR) {
+                break;
+            }
+        }
+        PLATFORM_unlockMutex(&(file->mutex));
+        return (JITINT64) position;
+    }
+
+    /* The end of the file includes the data waiting to be written	*/
+    if (	(whence == SEEK_END)		&&
+            (!internal_flushWrites(file))	) {
+        PLATFORM_unlockMutex(&(file->mutex));
+        return -1;
+    }
+
+    switch (whence) {
+        case SEEK_SET:
+            result	= offset;
+            break;
+        case SEEK_CUR:
+            result	= file->position + offset;
+            break;
+        case SEEK_END: {
+            struct stat	info;
+            if (PLATFORM_fstat(file->fileDescriptor, &info) != 0) {
+                PLATFORM_unlockMutex(&(file->mutex));
+                return -1;
+            }
+            (file->syscalls)++;
+            result	= ((JITINT64) info.st_size) + offset;
+            break;
+        }
+        default:
+            result	= -1;
+    }
+    if (result < 0) {
+        PLATFORM_unlockMutex(&(file->mutex));
+        errno	= EINVAL;
+        return -1;
+    }
+
+    /* Data read ahead stays valid: seeks within it are served from memory	*/
+    file->position	= result;
+    PLATFORM_unlockMutex(&(file->mutex));
+
+    return result;
+}
+
+JITBOOLEAN ILFILEFlush (ILFileBuffer *file) {
+    JITBOOLEAN	result;
+
+    /* Assertions			*/
+    assert(file != NULL);
+
+    PLATFORM_lockMutex(&(file->mutex));
+    result			= internal_flushWrites(file);
+    file->readBytes		= 0;
+    file->bufferPosition	= file->position;
+    PLATFORM_unlockMutex(&(file->mutex));
+
+    return result;
+}
+
+JITBOOLEAN ILFILEDestroy (ILFileBuffer *file) {
+    JITBOOLEAN	result;
+
+    /* Assertions			*/
+    assert(file != NULL);
+
+    result	= ILFILEFlush(file);
+
+    /* Leave the offset of the kernel where the handle is, for whoever uses the descriptor next	*/
+    if (file->buffered) {
+        PLATFORM_lseek(file->fileDescriptor, (off_t) file->position, SEEK_SET);
+    }
+    PLATFORM_destroyMutex(&(file->mutex));
+    if (file->buffer != NULL) {
+        freeFunction(file->buffer);
+    }
+    freeFunction(file);
+
+    return result;
+}
+
+static inline JITINT32 internal_readDirect (ILFileBuffer *file, void *buf, JITINT32 size) {
+    JITINT32	result;
+
+    do {
+        result	= PLATFORM_read(file->fileDescriptor, buf, size);
+        (file->syscalls)++;
+    } while ((result < 0) && (errno == EINTR));
+
+    return result;
+}
+
+static inline JITINT32 internal_writeDirect (ILFileBuffer *file, void *buf, JITINT32 size) {
+    JITINT32	written;
+    JITINT32	result;
+
+    written	= 0;
+    result	= 0;
+    while (size > 0) {
+        result	= PLATFORM_write(file->fileDescriptor, buf, size);
+        (file->syscalls)++;
+        if (result >= 0) {
+            written	+= result;
+            size	-= result;
+            buf	+= result;
+        } else if (errno != EINTR) {
+            break;
+        }
+    }
+    if (written > 0) {
+        return written;
+    }
+
+    return (result < 0) ? -1 : 0;
+}
+
+static inline JITBOOLEAN internal_writeVector (ILFileBuffer *file, struct iovec *vector, JITINT32 vectorLength, JITINT64 position) {
+
+    /* Skip empty vectors	*/
+    while (	(vectorLength > 0)		&&
+            (vector->iov_len == 0)		) {
+        vector++;
+        vectorLength--;
+    }
+
+    while (vectorLength > 0) {
+        ssize_t	result;
+
+        result	= pwritev(file->fileDescriptor, vector, vectorLength, (off_t) position);
+        (file->syscalls)++;
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return JITFALSE;
+        }
+        position	+= result;
+
+        /* Move over what the kernel took	*/
+        while (	(vectorLength > 0)				&&
+                (((size_t) result) >= vector->iov_len)		) {
+            result	-= vector->iov_len;
+            vector++;
+            vectorLength--;
+        }
+        if (vectorLength > 0) {
+            vector->iov_base	= ((JITUINT8 *) vector->iov_base) + result;
+            vector->iov_len		-= result;
+        }
+    }
+
+    return JITTRUE;
+}
+
+static inline JITBOOLEAN internal_flushWrites (ILFileBuffer *file) {
+    struct iovec	vector;
+
+    if (file->dirtyBytes == 0) {
+        return JITTRUE;
+    }
+    vector.iov_base	= file->buffer;
+    vector.iov_len	= file->dirtyBytes;
+    if (!internal_writeVector(file, &vector, 1, file->bufferPosition)) {
+        return JITFALSE;
+    }
+    file->bufferPosition	+= file->dirtyBytes;
+    file->dirtyBytes	= 0;
+
+    return JITTRUE;
+}
+
+static inline void internal_resizeBuffer (ILFileBuffer *file, JITBOOLEAN sequential) {
+    JITUINT32	newSize;
+
+    /* The buffer must not hold any data waiting to be written	*/
+    assert(file->dirtyBytes == 0);
+
+    /* Grow the buffer while the file is accessed sequentially and shrink it at the first random access	*/
+    newSize	= file->bufferSize;
+    if (sequential) {
+        (file->sequentialAccesses)++;
+        if (	(file->sequentialAccesses >= SEQUENTIAL_ACCESSES_TO_GROW)	&&
+                (newSize < ILFILE_MAX_BUFFER_SIZE)				) {
+            newSize				= newSize * 2;
+            file->sequentialAccesses	= 0;
+        }
+    } else {
+        file->sequentialAccesses	= 0;
+        newSize				= ILFILE_MIN_BUFFER_SIZE;
+    }
+    if (newSize == file->bufferSize) {
+        return ;
+    }
+
+    /* The content of the buffer is not needed	*/
+    freeFunction(file->buffer);
+    file->buffer		= allocFunction(newSize);
+    file->bufferSize	= newSize;
+
+    return ;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef FILE_BUFFER_H
+#define FILE_BUFFER_H
+
+#include <pthread.h>
+#include <jitsystem.h>
+
+/**
+ * @defgroup FileBuffer Buffered file handles
+ *
+ * Read-ahead and write-behind buffering of the file handles used by the Platform.FileMethods internal calls.
+ *
+ * Reads that miss the buffer are issued with a single preadv that fills both the destination of the caller and the read-ahead buffer.
+ * Writes that do not fit the buffer are issued with a single pwritev that drains the buffer and writes the data of the caller.
+ * The size of the read-ahead grows while the file is read sequentially and shrinks back on random accesses, which are not read ahead.
+ *
+ * Only regular files opened without O_APPEND are buffered; the other handles are accessed directly.
+ * The data is read and written at the position tracked by the buffer, so the offset of the kernel is not moved by reads and writes.
+ */
+
+/**
+ * @ingroup FileBuffer
+ * @brief Smallest size of the buffer of a handle
+ */
+#define ILFILE_MIN_BUFFER_SIZE		(4 * 1024)
+
+/**
+ * @ingroup FileBuffer
+ * @brief Largest size of the buffer of a handle
+ */
+#define ILFILE_MAX_BUFFER_SIZE		(256 * 1024)
+
+typedef struct {
+    JITINT32		fileDescriptor;
+    JITBOOLEAN		buffered;		/**< JITFALSE if the handle is accessed directly		*/
+    JITINT64		position;		/**< Position of the next read or write			*/
+    JITUINT8		*buffer;
+    JITUINT32		bufferSize;		/**< Bytes allocated for buffer					*/
+    JITINT64		bufferPosition;		/**< Position in the file of the first byte of buffer		*/
+    JITUINT32		readBytes;		/**< Bytes of buffer that have been read ahead			*/
+    JITUINT32		dirtyBytes;		/**< Bytes of buffer that wait to be written			*/
+    JITUINT32		sequentialAccesses;	/**< Reads in a row that started where the previous one ended	*/
+    JITUINT64		syscalls;		/**< System calls issued to access the data of the file	*/
+    pthread_mutex_t		mutex;
+} ILFileBuffer;
+
+/**
+ * @ingroup FileBuffer
+ * @brief Make the buffer of an open file handle
+ *
+ * @param sequentialHint Advise the kernel that the file is going to be read sequentially
+ */
+ILFileBuffer * ILFILENew (JITINT32 fileDescriptor, JITBOOLEAN sequentialHint);
+
+/**
+ * @ingroup FileBuffer
+ * @brief Read up to size bytes
+ *
+ * @return the number of bytes read, 0 at the end of the file, or -1 with errno set on error
+ */
+JITINT32 ILFILERead (ILFileBuffer *file, void *buf, JITINT32 size);
+
+/**
+ * @ingroup FileBuffer
+ * @brief Write size bytes
+ *
+ * @return the number of bytes written, or -1 with errno set on error
+ */
+JITINT32 ILFILEWrite (ILFileBuffer *file, void *buf, JITINT32 size);
+
+/**
+ * @ingroup FileBuffer
+ * @brief Move the position of the handle
+ *
+ * @param whence SEEK_SET, SEEK_CUR or SEEK_END
+ * @return the new position, or -1 with errno set on error
+ */
+JITINT64 ILFILESeek (ILFileBuffer *file, JITINT64 offset, JITINT32 whence);
+
+/**
+ * @ingroup FileBuffer
+ * @brief Write the pending data and drop the data read ahead
+ *
+ * It has to be called before the file is accessed without using the buffer (e.g., before changing its length).
+ *
+ * @return JITFALSE if the pending data cannot be written
+ */
+JITBOOLEAN ILFILEFlush (ILFileBuffer *file);
+
+/**
+ * @ingroup FileBuffer
+ * @brief Write the pending data and free the buffer
+ *
+ * The file handle is not closed.
+ *
+ * @return JITFALSE if the pending data cannot be written
+ */
+JITBOOLEAN ILFILEDestroy (ILFileBuffer *file);
+
+#endif
@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <string.h>
+#include <unistd.h>
+#include <assert.h>
+#include <jitsystem.h>
+
+// My headers
+#include <memory_primitives.h>
+// End
+
+#if defined(__SSE2__)
+#define ILMEM_SSE2
+#include <emmintrin.h>
+#endif
+
+/* Threshold used when the size of the caches cannot be read.
+ */
+#define DEFAULT_NON_TEMPORAL_THRESHOLD	(1024 * 1024)
+
+/* Bytes written by every iteration of the non-temporal loops.
+ */
+#define NON_TEMPORAL_STEP		64
+
+/* Smallest threshold: blocks have to cover the unaligned head of the destination and at least one step.
+ */
+#define MIN_NON_TEMPORAL_THRESHOLD	(16 + NON_TEMPORAL_STEP)
+
+static inline JITNUINT internal_defaultNonTemporalThreshold (void);
+static inline JITBOOLEAN internal_overlap (void *dst, const void *src, JITNUINT size);
+#ifdef ILMEM_SSE2
+static inline void internal_copyNonTemporal (void *dst, const void *src, JITNUINT size);
+static inline void internal_setNonTemporal (void *dst, JITUINT8 value, JITNUINT size);
+#endif
+
+static JITNUINT nonTemporalThreshold = DEFAULT_NON_TEMPORAL_THRESHOLD;
+
+void ILMEMCopy (void *dst, const void *src, JITNUINT size) {
+
+#ifdef ILMEM_SSE2
+    if (	(size >= nonTemporalThreshold)			&&
+            (!internal_overlap(dst, src, size))		) {
+        internal_copyNonTemporal(dst, src, size);
+        return ;
+    }
+#endif
+    memmove(dst, src, size);
+
+    return ;
+}
+
+void ILMEMSet (void *dst, JITUINT8 value, JITNUINT size) {
+
+#ifdef ILMEM_SSE2
+    if (size >= nonTemporalThreshold) {
+        internal_setNonTemporal(dst, value, size);
+        return ;
+    }
+#endif
+    memset(dst, value, size);
+
+    return ;
+}
+
+void ILMEMCopyReferences (void **dst, void **src, JITNUINT count) {
+    JITNUINT	index;
+
+    /* Assertions			*/
+    assert((((JITNUINT) dst) % sizeof(void *)) == 0);
+    assert((((JITNUINT) src) % sizeof(void *)) == 0);
+
+    if (dst == src) {
+        return ;
+    }
+
+    /* Move the references one word at a time, in the direction that keeps overlapping ranges correct.
+     */
+    if (dst < src) {
+        for (index = 0; index < count; index++) {
+            __atomic_store_n(&(dst[index]), src[index], __ATOMIC_RELAXED);
+        }
+    } else {
+        for (index = count; index > 0; index--) {
+            __atomic_store_n(&(dst[index - 1]), src[index - 1], __ATOMIC_RELAXED);
+        }
+    }
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    return ;
+}
+
+void ILMEMSetNonTemporalThreshold (JITNUINT threshold) {
+    if (threshold == 0) {
+        threshold	= internal_defaultNonTemporalThreshold();
+    }
+    if (threshold < MIN_NON_TEMPORAL_THRESHOLD) {
+        threshold	= MIN_NON_TEMPORAL_THRESHOLD;
+    }
+    nonTemporalThreshold	= threshold;
+}
+
+JITNUINT ILMEMGetNonTemporalThreshold (void) {
+    return nonTemporalThreshold;
+}
+
+static inline JITNUINT internal_defaultNonTemporalThreshold (void) {
+    long	cacheSize;
+
+    /* Blocks larger than half of the last level cache would evict most of it anyway.
+     */
+    cacheSize	= -1;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    cacheSize	= sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    if (cacheSize <= 0) {
+        cacheSize	= sysconf(_SC_LEVEL2_CACHE_SIZE);
+    }
+#endif
+    if (cacheSize <= 0) {
+        return DEFAULT_NON_TEMPORAL_THRESHOLD;
+    }
+
+    return ((JITNUINT) cacheSize) / 2;
+}
+
+static inline JITBOOLEAN internal_overlap (void *dst, const void *src, JITNUINT size) {
+    JITNUINT	d;
+    JITNUINT	s;
+
+    d	= (JITNUINT) dst;
+    s	= (JITNUINT) src;
+
+    return (d < (s + size)) && (s < (d + size));
+}
+
+#ifdef ILMEM_SSE2
+static inline void internal_copyNonTemporal (void *dst, const void *src, JITNUINT size) {
+    JITUINT8	*d;
+    const JITUINT8	*s;
+    JITNUINT	head;
+
+    d	= (JITUINT8 *) dst;
+    s	= (const JITUINT8 *) src;
+
+    /* Non-temporal stores need an aligned destination	*/
+    head	= (16 - (((JITNUINT) d) & 15)) & 15;
+    memcpy(d, s, head);
+    d	+= head;
+    s	+= head;
+    size	-= head;
+
+    while (size >= NON_TEMPORAL_STEP) {
+        __m128i	v0;
+        __m128i	v1;
+        __m128i	v2;
+        __m128i	v3;
+        v0	= _mm_loadu_si128((const __m128i *) (s));
+        v1	= _mm_loadu_si128((const __m128i *) (s + 16));
+        v2	= _mm_loadu_si128((const __m128i *) (s + 32));
+        v3	= _mm_loadu_si128((const __m128i *) (s + 48));
+        _mm_stream_si128((__m128i *) (d), v0);
+        _mm_stream_si128((__m128i *) (d + 16), v1);
+        _mm_stream_si128((__m128i *) (d + 32), v2);
+        _mm_stream_si128((__m128i *) (d + 48), v3);
+        d	+= NON_TEMPORAL_STEP;
+        s	+= NON_TEMPORAL_STEP;
+        size	-= NON_TEMPORAL_STEP;
+    }
+
+    /* Non-temporal stores are weakly ordered: make them visible before returning.
+     */
+    _mm_sfence();
+    memcpy(d, s, size);
+
+    return ;
+}
+
+static inline void internal_setNonTemporal (void *dst, JITUINT8 value, JITNUINT size) {
+    JITUINT8	*d;
+    JITNUINT	head;
+    __m128i		v;
+
+    d	= (JITUINT8 *) dst;
+
+    /* Non-temporal stores need an aligned destination	*/
+    head	= (16 - (((JITNUINT) d) & 15)) & 15;
+    memset(d, value, head);
+    d	+= head;
+    size	-= head;
+
+    v	= _mm_set1_epi8((char) value);
+    while (size >= NON_TEMPORAL_STEP) {
+        _mm_stream_si128((__m128i *) (d), v);
+        _mm_stream_si128((__m128i *) (d + 16), v);
+        _mm_stream_si128((__m128i *) (d + 32), v);
+        _mm_stream_si128((__m128i *) (d + 48), v);
+        d	+= NON_TEMPORAL_STEP;
+        size	-= NON_TEMPORAL_STEP;
+    }
+    _mm_sfence();
+    memset(d, value, size);
+
+    return ;
+}
+#endif
+
+static void __attribute__((constructor)) internal_initMemoryPrimitives (void) {
+    ILMEMSetNonTemporalThreshold(0);
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef MEMORY_PRIMITIVES_H
+#define MEMORY_PRIMITIVES_H
+
+#include <jitsystem.h>
+
+/**
+ * @defgroup MemoryPrimitives Bulk memory primitives
+ *
+ * Copies and clears of managed buffers used by the array internal calls.
+ *
+ * Blocks larger than a threshold are written with non-temporal stores, so they do not evict the working set of the program from the caches.
+ * The threshold is half of the last level cache of the running CPU.
+ */
+
+/**
+ * @ingroup MemoryPrimitives
+ * @brief Copy a block of memory
+ *
+ * Source and destination can overlap.
+ */
+void ILMEMCopy (void *dst, const void *src, JITNUINT size);
+
+/**
+ * @ingroup MemoryPrimitives
+ * @brief Fill a block of memory with a byte
+ */
+void ILMEMSet (void *dst, JITUINT8 value, JITNUINT size);
+
+/**
+ * @ingroup MemoryPrimitives
+ * @brief Copy an array of object references
+ *
+ * Source and destination can overlap.
+ * Every reference is moved with a single store, so a collector never observes a partially written reference.
+ * No barrier is issued per reference: a single release fence orders the whole copy before the stores that follow it.
+ */
+void ILMEMCopyReferences (void **dst, void **src, JITNUINT count);
+
+/**
+ * @ingroup MemoryPrimitives
+ * @brief Set the size in bytes above which non-temporal stores are used
+ *
+ * Thresholds smaller than 80 bytes are raised to 80 bytes.
+ *
+ * @param threshold Size in bytes; 0 restores the default one
+ */
+void ILMEMSetNonTemporalThreshold (JITNUINT threshold);
+
+/**
+ * @ingroup MemoryPrimitives
+ * @brief Return the size in bytes above which non-temporal stores are used
+ */
+JITNUINT ILMEMGetNonTemporalThreshold (void);
+
+#endif
@@ -0,0 +1,797 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <string.h>
+#include <assert.h>
+#include <jitsystem.h>
+
+// My headers
+#include <utf16_primitives.h>
+// End
+
+#if defined(__SSE2__)
+#define ILUTF16_SSE2
+#include <emmintrin.h>
+#if defined(__GNUC__) && ((__GNUC__ >= 5) || defined(__clang__))
+#define ILUTF16_AVX2
+#include <immintrin.h>
+#endif
+#endif
+
+/* Sets of code units up to this size are searched with vector compares; larger ones use a bloom filter.
+ */
+#define MAX_VECTOR_SET		8
+
+/* Powers of the multiplier of the hash function.
+ */
+#define HASH_MULTIPLIER		33U
+#define HASH_MULTIPLIER_2	(HASH_MULTIPLIER * HASH_MULTIPLIER)
+#define HASH_MULTIPLIER_3	(HASH_MULTIPLIER_2 * HASH_MULTIPLIER)
+#define HASH_MULTIPLIER_4	(HASH_MULTIPLIER_3 * HASH_MULTIPLIER)
+#define HASH_MULTIPLIER_8	(HASH_MULTIPLIER_4 * HASH_MULTIPLIER_4)
+#define HASH_MULTIPLIER_16	(HASH_MULTIPLIER_8 * HASH_MULTIPLIER_8)
+#define HASH_MULTIPLIER_32	(HASH_MULTIPLIER_16 * HASH_MULTIPLIER_16)
+
+typedef struct {
+    JITINT32	(*indexOf)(const JITINT16 *str, JITINT32 len, JITINT16 ch);
+    JITINT32	(*lastIndexOf)(const JITINT16 *str, JITINT32 len, JITINT16 ch);
+    JITINT32	(*indexOfAny)(const JITINT16 *str, JITINT32 len, const JITINT16 *set, JITINT32 setLen);
+    JITINT32	(*lastIndexOfAny)(const JITINT16 *str, JITINT32 len, const JITINT16 *set, JITINT32 setLen);
+    JITINT32	(*mismatch)(const JITINT16 *str1, const JITINT16 *str2, JITINT32 len);
+    JITINT32	(*find)(const JITINT16 *str, JITINT32 len, const JITINT16 *pattern, JITINT32 patternLen);
+    JITINT32	(*findLast)(const JITINT16 *str, JITINT32 len, const JITINT16 *pattern, JITINT32 patternLen);
+    JITUINT32	(*hash)(const JITINT16 *str, JITINT32 len);
+    JITINT32	implementation;
+    const char	*name;
+} utf16_primitives_t;
+
+static inline JITUINT64 internal_bloomOfSet (const JITINT16 *set, JITINT32 setLen);
+static inline JITBOOLEAN internal_belongsToSet (JITINT16 ch, JITUINT64 bloom, const JITINT16 *set, JITINT32 setLen);
+static JITINT32 internal_indexOf_scalar (const JITINT16 *str, JITINT32 len, JITINT16 ch);
+static JITINT32 internal_lastIndexOf_scalar (const JITINT16 *str, JITINT32 len, JITINT16 ch);
+static JITINT32 internal_indexOfAny_scalar (const JITINT16 *str, JITINT32 len, const JITINT16 *set, JITINT32 setLen);
+static JITINT32 internal_lastIndexOfAny_scalar (const JITINT16 *str, JITINT32 len, const JITINT16 *set, JITINT32 setLen);
+static JITINT32 internal_mismatch_scalar (const JITINT16 *str1, const JITINT16 *str2, JITINT32 len);
+static JITINT32 internal_find_scalar (const JITINT16 *str, JITINT32 len, const JITINT16 *pattern, JITINT32 patternLen);
+static JITINT32 internal_findLast_scalar (const JITINT16 *str, JITINT32 len, const JITINT16 *pattern, JITINT32 patternLen);
+static JITUINT32 internal_hash_scalar (const JITINT16 *str, JITINT32 len);
+
+static const utf16_primitives_t scalarPrimitives = {
+    internal_indexOf_scalar,
+    internal_lastIndexOf_scalar,
+    internal_indexOfAny_scalar,
+    internal_lastIndexOfAny_scalar,
+    internal_mismatch_scalar,
+    internal_find_scalar,
+    internal_findLast_scalar,
+    internal_hash_scalar,
+    ILUTF16_IMPLEMENTATION_SCALAR,
+    "scalar"
+};
+
+static const utf16_primitives_t *primitives = &scalarPrimitives;
+
+JITINT32 ILUTF16IndexOf (const JITINT16 *str, JITINT32 len, JITINT16 ch) {
+    return primitives->indexOf(str, len, ch);
+}
+
+JITINT32 ILUTF16LastIndexOf (const JITINT16 *str, JITINT32 len, JITINT16 ch) {
+    return primitives->lastIndexOf(str, len, ch);
+}
+
+JITINT32 ILUTF16IndexOfAny (const JITINT16 *str, JITINT32 len, const JITINT16 *set, JITINT32 setLen) {
+    if (setLen == 1) {
+        return primitives->indexOf(str, len, set[0]);
+    }
+    return primitives->indexOfAny(str, len, set, setLen);
+}
+
+JITINT32 ILUTF16LastIndexOfAny (const JITINT16 *str, JITINT32 len, const JITINT16 *set, JITINT32 setLen) {
+    if (setLen == 1) {
+        return primitives->lastIndexOf(str, len, set[0]);
+    }
+    return primitives->lastIndexOfAny(str, len, set, setLen);
+}
+
+JITINT32 ILUTF16Mismatch (const JITINT16 *str1, const JITINT16 *str2, JITINT32 len) {
+    return primitives->mismatch(str1, str2, len);
+}
+
+JITINT32 ILUTF16Find (const JITINT16 *str, JITINT32 len, const JITINT16 *pattern, JITINT32 patternLen) {
+    if (patternLen == 0) {
+        return 0;
+    }
+    if (patternLen > len) {
+        return -1;
+    }
+    if (patternLen == 1) {
+        return primitives->indexOf(str, len, pattern[0]);
+    }
+    return primitives->find(str, len, pattern, patternLen);
+}
+
+JITINT32 ILUTF16FindLast (const JITINT16 *str, JITINT32 len, const JITINT16 *pattern, JITINT32 patternLen) {
+    if (patternLen == 0) {
+        return len;
+    }
+    if (patternLen > len) {
+        return -1;
+    }
+    if (patternLen == 1) {
+        return primitives->lastIndexOf(str, len, pattern[0]);
+    }
+    return primitives->findLast(str, len, pattern, patternLen);
+}
+
+JITUINT32 ILUTF16Hash (const JITINT16 *str, JITINT32 len) {
+    return primitives->hash(str, len);
+}
+
+const char * ILUTF16GetImplementationName (void) {
+    return primitives->name;
+}
+
+/****************************************************************************************************************************
+*                                               SCALAR                                                                      *
+****************************************************************************************************************************/
+static inline JITUINT64 internal_bloomOfSet (const JITINT16 *set, JITINT32 setLen) {
+    JITUINT64	bloom;
+    JITINT32	count;
+
+    bloom	= 0;
+    for (count = 0; count < setLen; count++) {
+        bloom	|= ((JITUINT64) 1) << (((JITUINT16) set[count]) & 63);
+    }
+
+    return bloom;
+}
+
+static inline JITBOOLEAN internal_belongsToSet (JITINT16 ch, JITUINT64 bloom, const JITINT16 *set, JITINT32 setLen) {
+    JITINT32	count;
+
+    if ((bloom & (((JITUINT64) 1) << (((JITUINT16) ch) & 63))) == 0) {
+        return JITFALSE;
+    }
+    for (count = 0; count < setLen; count++) {
+        if (set[count] == ch) {
+            return JITTRUE;
+        }
+    }
+
+    return JITFALSE;
+}
+
+static JITINT32 internal_indexOf_scalar (const JITINT16 *str, JITINT32 len, JITINT16 ch) {
+    JITINT32	count;
+
+    for (count = 0; count < len; count++) {
+        if (str[count] == ch) {
+            return count;
+        }
+    }
+
+    return -1;
+}
+
+static JITINT32 internal_lastIndexOf_scalar (const JITINT16 *str, JITINT32 len, JITINT16 ch) {
+    JITINT32	count;
+
+    for (count = len - 1; count >= 0; count--) {
+        if (str[count] == ch) {
+            return count;
+        }
+    }
+
+    return -1;
+}
+
+static JITINT32 internal_indexOfAny_scalar (const JITINT16 *str, JITINT32 len, const JITINT16 *set, JITINT32 setLen) {
+    JITUINT64	bloom;
+    JITINT32	count;
+
+    bloom	= internal_bloomOfSet(set, setLen);
+    for (count = 0; count < len; count++) {
+        if (internal_belongsToSet(str[count], bloom, set, setLen)) {
+            return count;
+        }
+    }
+
+    return -1;
+}
+
+static JITINT32 internal_lastIndexOfAny_scalar (const JITINT16 *str, JITINT32 len, const JITINT16 *set, JITINT32 setLen) {
+    JITUINT64	bloom;
+    JITINT32	count;
+
+    bloom	= internal_bloomOfSet(set, setLen);
+    for (count = len - 1; count >= 0; count--) {
+        if (internal_belongsToSet(str[count], bloom, set, setLen)) {
+            return count;
+        }
+    }
+
+    return -1;
+}
+
+static JITINT32 internal_mismatch_scalar (const JITINT16 *str1, const JITINT16 *str2, JITINT32 len) {
+    JITINT32	count;
+
+    for (count = 0; count < len; count++) {
+        if (str1[count] != str2[count]) {
+            return count;
+        }
+    }
+
+    return len;
+}
+
+static JITINT32 internal_find_scalar (const JITINT16 *str, JITINT32 len, const JITINT16 *pattern, JITINT32 patternLen) {
+    JITINT32	lastPosition;
+    JITINT32	count;
+
+    lastPosition	= len - patternLen;
+    for (count = 0; count <= lastPosition; count++) {
+        if (	(str[count] == pattern[0])							&&
+                (memcmp(str + count, pattern, patternLen * sizeof(JITINT16)) == 0)	) {
+            return count;
+        }
+    }
+
+    return -1;
+}
+
+static JITINT32 internal_findLast_scalar (const JITINT16 *str, JITINT32 len, const JITINT16 *pattern, JITINT32 patternLen) {
+    JITINT32	count;
+
+    for (count = len - patternLen; count >= 0; count--) {
+        if (	(str[count] == pattern[0])							&&
+                (memcmp(str + count, pattern, patternLen * sizeof(JITINT16)) == 0)	) {
+            return count;
+        }
+    }
+
+    return -1;
+}
+
+static JITUINT32 internal_hash_scalar (const JITINT16 *str, JITINT32 len) {
+    JITUINT32	hash;
+    JITINT32	count;
+
+    /* Four code units per iteration shorten the chain of dependences between multiplications.
+     */
+    hash	= 0;
+    for (count = 0; (count + 4) <= len; count += 4) {
+        hash	= (hash * HASH_MULTIPLIER_4)
+                  + ((JITUINT32) (JITINT32) str[count] * HASH_MULTIPLIER_3)
+                  + ((JITUINT32) (JITINT32) str[count + 1] * HASH_MULTIPLIER_2)
+                  + ((JITUINT32) (JITINT32) str[count + 2] * HASH_MULTIPLIER)
+                  + (JITUINT32) (JITINT32) str[count + 3];
+    }
+    for (; count < len; count++) {
+        hash	= (hash * HASH_MULTIPLIER) + (JITUINT32) (JITINT32) str[count];
+    }
+
+    return hash;
+}
+
+#ifdef ILUTF16_SSE2
+/****************************************************************************************************************************
+*                                               SSE2                                                                        *
+****************************************************************************************************************************/
+#define SSE2_UNITS	8
+
+static inline JITINT32 internal_firstUnitOfMask (JITUINT32 mask) {
+    return __builtin_ctz(mask) >> 1;
+}
+
+static inline JITINT32 internal_lastUnitOfMask (JITUINT32 mask) {
+    return (31 - __builtin_clz(mask)) >> 1;
+}
+
+static JITINT32 internal_indexOf_sse2 (const JITINT16 *str, JITINT32 len, JITINT16 ch) {
+    __m128i		value;
+    JITINT32	count;
+
+    value	= _mm_set1_epi16(ch);
+    for (count = 0; (count + SSE2_UNITS) <= len; count += SSE2_UNITS) {
+        JITUINT32	mask;
+        mask	= _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *) (str + count)), value));
+        if (mask != 0) {
+            return count + internal_firstUnitOfMask(mask);
+        }
+    }
+    for (; count < len; count++) {
+        if (str[count] == ch) {
+            return count;
+        }
+    }
+
+    return -1;
+}
+
+static JITINT32 internal_lastIndexOf_sse2 (const JITINT16 *str, JITINT32 len, JITINT16 ch) {
+    __m128i		value;
+    JITINT32	count;
+
+    value	= _mm_set1_epi16(ch);
+    for (count = len; count >= SSE2_UNITS; count -= SSE2_UNITS) {
+        JITUINT32	mask;
+        mask	= _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *) (str + count - SSE2_UNITS)), value));
+        if (mask != 0) {
+            return count - SSE2_UNITS + internal_lastUnitOfMask(mask);
+        }
+    }
+    for (count--; count >= 0; count--) {
+        if (str[count] == ch) {
+            return count;
+        }
+    }
+
+    return -1;
+}
+
+static JITINT32 internal_indexOfAny_sse2 (const JITINT16 *str, JITINT32 len, const JITINT16 *set, JITINT32 setLen) {
+    __m128i		values[MAX_VECTOR_SET];
+    JITINT32	count;
+    JITINT32	setCount;
+
+    if (setLen > MAX_VECTOR_SET) {
+        return internal_indexOfAny_scalar(str, len, set, setLen);
+    }
+    for (setCount = 0; setCount < setLen; setCount++) {
+        values[setCount]	= _mm_set1_epi16(set[setCount]);
+    }
+    for (count = 0; (count + SSE2_UNITS) <= len; count += SSE2_UNITS) {
+        __m128i		units;
+        __m128i		matches;
+        JITUINT32	mask;
+        units	= _mm_loadu_si128((const __m128i *) (str + count));
+        matches	= _mm_setzero_si128();
+        for (setCount = 0; setCount < setLen; setCount++) {
+            matches	= _mm_or_si128(matches, _mm_cmpeq_epi16(units, values[setCount]));
+        }
+        mask	= _mm_movemask_epi8(matches);
+        if (mask != 0) {
+            return count + internal_firstUnitOfMask(mask);
+        }
+    }
+    if (count < len) {
+        JITINT32	position;
+        position	= internal_indexOfAny_scalar(str + count, len - count, set, setLen);
+        if (position >= 0) {
+            return count + position;
+        }
+    }
+
+    return -1;
+}
+
+static JITINT32 internal_lastIndexOfAny_sse2 (const JITINT16 *str, JITINT32 len, const JITINT16 *set, JITINT32 setLen) {
+    __m128i		values[MAX_VECTOR_SET];
+    JITINT32	count;
+    JITINT32	setCount;
+
+    if (setLen > MAX_VECTOR_SET) {
+        return internal_lastIndexOfAny_scalar(str, len, set, setLen);
+    }
+    for (setCount = 0; setCount < setLen; setCount++) {
+        values[setCount]	= _mm_set1_epi16(set[setCount]);
+    }
+    for (count = len; count >= SSE2_UNITS; count -= SSE2_UNITS) {
+        __m128i		units;
+        __m128i		matches;
+        JITUINT32	mask;
+        units	= _mm_loadu_si128((const __m128i *) (str + count - SSE2_UNITS));
+        matches	= _mm_setzero_si128();
+        for (setCount = 0; setCount < setLen; setCount++) {
+            matches	= _mm_or_si128(matches, _mm_cmpeq_epi16(units, values[setCount]));
+        }
+        mask	= _mm_movemask_epi8(matches);
+        if (mask != 0) {
+            return count - SSE2_UNITS + internal_lastUnitOfMask(mask);
+        }
+    }
+
+    return internal_lastIndexOfAny_scalar(str, count, set, setLen);
+}
+
+static JITINT32 internal_mismatch_sse2 (const JITINT16 *str1, const JITINT16 *str2, JITINT32 len) {
+    JITINT32	count;
+
+    for (count = 0; (count + SSE2_UNITS) <= len; count += SSE2_UNITS) {
+        JITUINT32	mask;
+        mask	= _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *) (str1 + count)), _mm_loadu_si128((const __m128i *) (str2 + count))));
+        if (mask != 0xFFFF) {
+            return count + internal_firstUnitOfMask((~mask) & 0xFFFF);
+        }
+    }
+    for (; count < len; count++) {
+        if (str1[count] != str2[count]) {
+            return count;
+        }
+    }
+
+    return len;
+}
+
+static JITINT32 internal_find_sse2 (const JITINT16 *str, JITINT32 len, const JITINT16 *pattern, JITINT32 patternLen) {
+    __m128i		first;
+    __m128i		last;
+    JITINT32	lastPosition;
+    JITINT32	count;
+
+    /* Candidates are the positions where both the first and the last code unit of the pattern match.
+     * Only those are compared with the whole pattern.
+     */
+    assert(patternLen >= 2);
+    first		= _mm_set1_epi16(pattern[0]);
+    last		= _mm_set1_epi16(pattern[patternLen - 1]);
+    lastPosition	= len - patternLen;
+    for (count = 0; (count + SSE2_UNITS) <= (lastPosition + 1); count += SSE2_UNITS) {
+        JITUINT32	mask;
+        mask	= _mm_movemask_epi8(_mm_and_si128(	_mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *) (str + count)), first),
+                                                _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *) (str + count + patternLen - 1)), last)));
+        while (mask != 0) {
+            JITINT32	position;
+            position	= count + internal_firstUnitOfMask(mask);
+            if (memcmp(str + position + 1, pattern + 1, (patternLen - 2) * sizeof(JITINT16)) == 0) {
+                return position;
+            }
+            mask	&= ~(3U << ((position - count) << 1));
+        }
+    }
+    for (; count <= lastPosition; count++) {
+        if (	(str[count] == pattern[0])							&&
+                (memcmp(str + count, pattern, patternLen * sizeof(JITINT16)) == 0)	) {
+            return count;
+        }
+    }
+
+    return -1;
+}
+
+static JITINT32 internal_findLast_sse2 (const JITINT16 *str, JITINT32 len, const JITINT16 *pattern, JITINT32 patternLen) {
+    __m128i		first;
+    __m128i		last;
+    JITINT32	count;
+
+    assert(patternLen >= 2);
+    first	= _mm_set1_epi16(pattern[0]);
+    last	= _mm_set1_epi16(pattern[patternLen - 1]);
+
+    /* count is the number of candidate positions not checked yet.
+     */
+    for (count = len - patternLen + 1; count >= SSE2_UNITS; count -= SSE2_UNITS) {
+        JITINT32	base;
+        JITUINT32	mask;
+        base	= count - SSE2_UNITS;
+        mask	= _mm_movemask_epi8(_mm_and_si128(	_mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *) (str + base)), first),
+                                                _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *) (str + base + patternLen - 1)), last)));
+        while (mask != 0) {
+            JITINT32	position;
+            position	= base + internal_lastUnitOfMask(mask);
+            if (memcmp(str + position + 1, pattern + 1, (patternLen - 2) * sizeof(JITINT16)) == 0) {
+                return position;
+            }
+            mask	&= ~(3U << ((position - base) << 1));
+        }
+    }
+    for (count--; count >= 0; count--) {
+        if (	(str[count] == pattern[0])							&&
+                (memcmp(str + count, pattern, patternLen * sizeof(JITINT16)) == 0)	) {
+            return count;
+        }
+    }
+
+    return -1;
+}
+
+static const utf16_primitives_t sse2Primitives = {
+    internal_indexOf_sse2,
+    internal_lastIndexOf_sse2,
+    internal_indexOfAny_sse2,
+    internal_lastIndexOfAny_sse2,
+    internal_mismatch_sse2,
+    internal_find_sse2,
+    internal_findLast_sse2,
+    internal_hash_scalar,
+    ILUTF16_IMPLEMENTATION_SSE2,
+    "sse2"
+};
+#endif
+
+#ifdef ILUTF16_AVX2
+/****************************************************************************************************************************
+*                                               AVX2                                                                        *
+****************************************************************************************************************************/
+#define AVX2_UNITS	16
+#define AVX2		__attribute__((target("avx2")))
+
+AVX2 static JITINT32 internal_indexOf_avx2 (const JITINT16 *str, JITINT32 len, JITINT16 ch) {
+    __m256i		value;
+    JITINT32	count;
+
+    value	= _mm256_set1_epi16(ch);
+    for (count = 0; (count + AVX2_UNITS) <= len; count += AVX2_UNITS) {
+        JITUINT32	mask;
+        mask	= _mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i *) (str + count)), value));
+        if (mask != 0) {
+            return count + internal_firstUnitOfMask(mask);
+        }
+    }
+    if (count < len) {
+        JITINT32	position;
+        position	= internal_indexOf_sse2(str + count, len - count, ch);
+        if (position >= 0) {
+            return count + position;
+        }
+    }
+
+    return -1;
+}
+
+AVX2 static JITINT32 internal_lastIndexOf_avx2 (const JITINT16 *str, JITINT32 len, JITINT16 ch) {
+    __m256i		value;
+    JITINT32	count;
+
+    value	= _mm256_set1_epi16(ch);
+    for (count = len; count >= AVX2_UNITS; count -= AVX2_UNITS) {
+        JITUINT32	mask;
+        mask	= _mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i *) (str + count - AVX2_UNITS)), value));
+        if (mask != 0) {
+            return count - AVX2_UNITS + internal_lastUnitOfMask(mask);
+        }
+    }
+
+    return internal_lastIndexOf_sse2(str, count, ch);
+}
+
+AVX2 static JITINT32 internal_indexOfAny_avx2 (const JITINT16 *str, JITINT32 len, const JITINT16 *set, JITINT32 setLen) {
+    __m256i		values[MAX_VECTOR_SET];
+    JITINT32	count;
+    JITINT32	setCount;
+
+    if (setLen > MAX_VECTOR_SET) {
+        return internal_indexOfAny_scalar(str, len, set, setLen);
+    }
+    for (setCount = 0; setCount < setLen; setCount++) {
+        values[setCount]	= _mm256_set1_epi16(set[setCount]);
+    }
+    for (count = 0; (count + AVX2_UNITS) <= len; count += AVX2_UNITS) {
+        __m256i		units;
+        __m256i		matches;
+        JITUINT32	mask;
+        units	= _mm256_loadu_si256((const __m256i *) (str + count));
+        matches	= _mm256_setzero_si256();
+        for (setCount = 0; setCount < setLen; setCount++) {
+            matches	= _mm256_or_si256(matches, _mm256_cmpeq_epi16(units, values[setCount]));
+        }
+        mask	= _mm256_movemask_epi8(matches);
+        if (mask != 0) {
+            return count + internal_firstUnitOfMask(mask);
+        }
+    }
+    if (count < len) {
+        JITINT32	position;
+        position	= internal_indexOfAny_sse2(str + count, len - count, set, setLen);
+        if (position >= 0) {
+            return count + position;
+        }
+    }
+
+    return -1;
+}
+
+AVX2 static JITINT32 internal_lastIndexOfAny_avx2 (const JITINT16 *str, JITINT32 len, const JITINT16 *set, JITINT32 setLen) {
+    __m256i		values[MAX_VECTOR_SET];
+    JITINT32	count;
+    JITINT32	setCount;
+
+    if (setLen > MAX_VECTOR_SET) {
+        return internal_lastIndexOfAny_scalar(str, len, set, setLen);
+    }
+    for (setCount = 0; setCount < setLen; setCount++) {
+        values[setCount]	= _mm256_set1_epi16(set[setCount]);
+    }
+    for (count = len; count >= AVX2_UNITS; count -= AVX2_UNITS) {
+        __m256i		units;
+        __m256i		matches;
+        JITUINT32	mask;
+        units	= _mm256_loadu_si256((const __m256i *) (str + count - AVX2_UNITS));
+        matches	= _mm256_setzero_si256();
+        for (setCount = 0; setCount < setLen; setCount++) {
+            matches	= _mm256_or_si256(matches, _mm256_cmpeq_epi16(units, values[setCount]));
+        }
+        mask	= _mm256_movemask_epi8(matches);
+        if (mask != 0) {
+            return count - AVX2_UNITS + internal_lastUnitOfMask(mask);
+        }
+    }
+
+    return internal_lastIndexOfAny_sse2(str, count, set, setLen);
+}
+
+AVX2 static JITINT32 internal_mismatch_avx2 (const JITINT16 *str1, const JITINT16 *str2, JITINT32 len) {
+    JITINT32	count;
+
+    for (count = 0; (count + AVX2_UNITS) <= len; count += AVX2_UNITS) {
+        JITUINT32	mask;
+        mask	= _mm256_movemask_epi8(_mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i *) (str1 + count)), _mm256_loadu_si256((const __m256i *) (str2 + count))));
+        if (mask != 0xFFFFFFFFU) {
+            return count + internal_firstUnitOfMask(~mask);
+        }
+    }
+
+    return count + internal_mismatch_sse2(str1 + count, str2 + count, len - count);
+}
+
+AVX2 static JITINT32 internal_find_avx2 (const JITINT16 *str, JITINT32 len, const JITINT16 *pattern, JITINT32 patternLen) {
+    __m256i		first;
+    __m256i		last;
+    JITINT32	lastPosition;
+    JITINT32	count;
+
+    assert(patternLen >= 2);
+    first		= _mm256_set1_epi16(pattern[0]);
+    last		= _mm256_set1_epi16(pattern[patternLen - 1]);
+    lastPosition	= len - patternLen;
+    for (count = 0; (count + AVX2_UNITS) <= (lastPosition + 1); count += AVX2_UNITS) {
+        JITUINT32	mask;
+        mask	= _mm256_movemask_epi8(_mm256_and_si256(	_mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i *) (str + count)), first),
+                                                    _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i *) (str + count + patternLen - 1)), last)));
+        while (mask != 0) {
+            JITINT32	position;
+            position	= count + internal_firstUnitOfMask(mask);
+            if (memcmp(str + position + 1, pattern + 1, (patternLen - 2) * sizeof(JITINT16)) == 0) {
+                return position;
+            }
+            mask	&= ~(3U << ((position - count) << 1));
+        }
+    }
+    if (count <= lastPosition) {
+        JITINT32	position;
+        position	= internal_find_sse2(str + count, len - count, pattern, patternLen);
+        if (position >= 0) {
+            return count + position;
+        }
+    }
+
+    return -1;
+}
+
+AVX2 static JITINT32 internal_findLast_avx2 (const JITINT16 *str, JITINT32 len, const JITINT16 *pattern, JITINT32 patternLen) {
+    __m256i		first;
+    __m256i		last;
+    JITINT32	count;
+
+    assert(patternLen >= 2);
+    first	= _mm256_set1_epi16(pattern[0]);
+    last	= _mm256_set1_epi16(pattern[patternLen - 1]);
+    for (count = len - patternLen + 1; count >= AVX2_UNITS; count -= AVX2_UNITS) {
+        JITINT32	base;
+        JITUINT32	mask;
+        base	= count - AVX2_UNITS;
+        mask	= _mm256_movemask_epi8(_mm256_and_si256(	_mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i *) (str + base)), first),
+                                                    _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i *) (str + base + patternLen - 1)), last)));
+        while (mask != 0) {
+            JITINT32	position;
+            position	= base + internal_lastUnitOfMask(mask);
+            if (memcmp(str + position + 1, pattern + 1, (patternLen - 2) * sizeof(JITINT16)) == 0) {
+                return position;
+            }
+            mask	&= ~(3U << ((position - base) << 1));
+        }
+    }
+    if (count <= 0) {
+        return -1;
+    }
+
+    /* The remaining candidates start before count: the text they span ends at count + patternLen - 1.
+     */
+    return internal_findLast_sse2(str, count + patternLen - 1, pattern, patternLen);
+}
+
+AVX2 static JITUINT32 internal_hash_avx2 (const JITINT16 *str, JITINT32 len) {
+    __m256i		accumulators[4];
+    __m256i		multiplier;
+    JITUINT32	lanes[4 * 8];
+    JITUINT32	weight;
+    JITUINT32	hash;
+    JITINT32	count;
+    JITINT32	lane;
+
+    if (len < (4 * AVX2_UNITS)) {
+        return internal_hash_scalar(str, len);
+    }
+
+    /* Lane j of the accumulator k sums the code units at positions 32i + 8k + j as if they were a string of their own, with multiplier 33^32.
+     * The four accumulators are independent, so their multiplications overlap.
+     * The 32 lanes are then combined as the last 32 code units of a string.
+     */
+    accumulators[0]	= _mm256_setzero_si256();
+    accumulators[1]	= _mm256_setzero_si256();
+    accumulators[2]	= _mm256_setzero_si256();
+    accumulators[3]	= _mm256_setzero_si256();
+    multiplier	= _mm256_set1_epi32(HASH_MULTIPLIER_32);
+    for (count = 0; (count + (2 * AVX2_UNITS)) <= len; count += (2 * AVX2_UNITS)) {
+        __m256i	units0;
+        __m256i	units1;
+        units0		= _mm256_loadu_si256((const __m256i *) (str + count));
+        units1		= _mm256_loadu_si256((const __m256i *) (str + count + AVX2_UNITS));
+        accumulators[0]	= _mm256_add_epi32(_mm256_mullo_epi32(accumulators[0], multiplier), _mm256_cvtepi16_epi32(_mm256_castsi256_si128(units0)));
+        accumulators[1]	= _mm256_add_epi32(_mm256_mullo_epi32(accumulators[1], multiplier), _mm256_cvtepi16_epi32(_mm256_extracti128_si256(units0, 1)));
+        accumulators[2]	= _mm256_add_epi32(_mm256_mullo_epi32(accumulators[2], multiplier), _mm256_cvtepi16_epi32(_mm256_castsi256_si128(units1)));
+        accumulators[3]	= _mm256_add_epi32(_mm256_mullo_epi32(accumulators[3], multiplier), _mm256_cvtepi16_epi32(_mm256_extracti128_si256(units1, 1)));
+    }
+    _mm256_storeu_si256((__m256i *) lanes, accumulators[0]);
+    _mm256_storeu_si256((__m256i *) (lanes + 8), accumulators[1]);
+    _mm256_storeu_si256((__m256i *) (lanes + 16), accumulators[2]);
+    _mm256_storeu_si256((__m256i *) (lanes + 24), accumulators[3]);
+    hash	= 0;
+    weight	= 1;
+    for (lane = (4 * 8) - 1; lane >= 0; lane--) {
+        hash	+= lanes[lane] * weight;
+        weight	*= HASH_MULTIPLIER;
+    }
+    for (; count < len; count++) {
+        hash	= (hash * HASH_MULTIPLIER) + (JITUINT32) (JITINT32) str[count];
+    }
+
+    return hash;
+}
+
+static const utf16_primitives_t avx2Primitives = {
+    internal_indexOf_avx2,
+    internal_lastIndexOf_avx2,
+    internal_indexOfAny_avx2,
+    internal_lastIndexOfAny_avx2,
+    internal_mismatch_avx2,
+    internal_find_avx2,
+    internal_findLast_avx2,
+    internal_hash_avx2,
+    ILUTF16_IMPLEMENTATION_AVX2,
+    "avx2"
+};
+#endif
+
+/****************************************************************************************************************************
+*                                               DISPATCH                                                                    *
+****************************************************************************************************************************/
+JITINT32 ILUTF16SelectImplementation (JITINT32 implementation) {
+    const utf16_primitives_t	*selected;
+
+    selected	= &scalarPrimitives;
+#ifdef ILUTF16_SSE2
+    if (implementation >= ILUTF16_IMPLEMENTATION_SSE2) {
+        selected	= &sse2Primitives;
+    }
+#endif
+#ifdef ILUTF16_AVX2
+    __builtin_cpu_init();
+    if (	(implementation >= ILUTF16_IMPLEMENTATION_AVX2)	&&
+            __builtin_cpu_supports("avx2")			) {
+        selected	= &avx2Primitives;
+    }
+#endif
+    primitives	= selected;
+
+    return selected->implementation;
+}
+
+static void __attribute__((constructor)) internal_initPrimitives (void) {
+    ILUTF16SelectImplementation(ILUTF16_IMPLEMENTATION_AVX2);
+}
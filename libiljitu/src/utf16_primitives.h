@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef UTF16_PRIMITIVES_H
+#define UTF16_PRIMITIVES_H
+
+#include <jitsystem.h>
+
+/**
+ * @defgroup UTF16Primitives UTF-16 string primitives
+ *
+ * Bulk operations on arrays of UTF-16 code units used by the string internal calls.
+ *
+ * Every primitive has a scalar, an SSE2 and an AVX2 implementation.
+ * The best one supported by the running CPU is selected when the library is loaded.
+ */
+
+#define ILUTF16_IMPLEMENTATION_SCALAR	0
+#define ILUTF16_IMPLEMENTATION_SSE2	1
+#define ILUTF16_IMPLEMENTATION_AVX2	2
+
+/**
+ * @ingroup UTF16Primitives
+ * @brief Find a code unit
+ *
+ * @return the position of the first occurrence of <code> ch </code> within <code> str[0 .. len - 1] </code>, or -1
+ */
+JITINT32 ILUTF16IndexOf (const JITINT16 *str, JITINT32 len, JITINT16 ch);
+
+/**
+ * @ingroup UTF16Primitives
+ * @brief Find the last occurrence of a code unit
+ *
+ * @return the position of the last occurrence of <code> ch </code> within <code> str[0 .. len - 1] </code>, or -1
+ */
+JITINT32 ILUTF16LastIndexOf (const JITINT16 *str, JITINT32 len, JITINT16 ch);
+
+/**
+ * @ingroup UTF16Primitives
+ * @brief Find any code unit of a set
+ *
+ * @return the position of the first element of <code> str </code> that belongs to <code> set[0 .. setLen - 1] </code>, or -1
+ */
+JITINT32 ILUTF16IndexOfAny (const JITINT16 *str, JITINT32 len, const JITINT16 *set, JITINT32 setLen);
+
+/**
+ * @ingroup UTF16Primitives
+ * @brief Find the last code unit that belongs to a set
+ *
+ * @return the position of the last element of <code> str </code> that belongs to <code> set[0 .. setLen - 1] </code>, or -1
+ */
+JITINT32 ILUTF16LastIndexOfAny (const JITINT16 *str, JITINT32 len, const JITINT16 *set, JITINT32 setLen);
+
+/**
+ * @ingroup UTF16Primitives
+ * @brief Compare two arrays of code units
+ *
+ * @return the position of the first code unit that differs, or <code> len </code> if the arrays are equal
+ */
+JITINT32 ILUTF16Mismatch (const JITINT16 *str1, const JITINT16 *str2, JITINT32 len);
+
+/**
+ * @ingroup UTF16Primitives
+ * @brief Find a substring
+ *
+ * @return the position of the first occurrence of <code> pattern </code> within <code> str </code>, or -1
+ */
+JITINT32 ILUTF16Find (const JITINT16 *str, JITINT32 len, const JITINT16 *pattern, JITINT32 patternLen);
+
+/**
+ * @ingroup UTF16Primitives
+ * @brief Find the last occurrence of a substring
+ *
+ * @return the position of the last occurrence of <code> pattern </code> within <code> str </code>, or -1
+ */
+JITINT32 ILUTF16FindLast (const JITINT16 *str, JITINT32 len, const JITINT16 *pattern, JITINT32 patternLen);
+
+/**
+ * @ingroup UTF16Primitives
+ * @brief Hash an array of code units
+ *
+ * The result is the one of <code> hash = hash * 33 + (JITINT32) str[i] </code> computed for every code unit, starting from 0.
+ */
+JITUINT32 ILUTF16Hash (const JITINT16 *str, JITINT32 len);
+
+/**
+ * @ingroup UTF16Primitives
+ * @brief Select the implementation of the primitives
+ *
+ * The request is lowered to the best implementation supported by the CPU.
+ *
+ * @param implementation ILUTF16_IMPLEMENTATION_SCALAR, ILUTF16_IMPLEMENTATION_SSE2 or ILUTF16_IMPLEMENTATION_AVX2
+ * @return the implementation in use
+ */
+JITINT32 ILUTF16SelectImplementation (JITINT32 implementation);
+
+/**
+ * @ingroup UTF16Primitives
+ * @brief Return the name of the implementation in use
+ */
+const char * ILUTF16GetImplementationName (void);
+
+#endif
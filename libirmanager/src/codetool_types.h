@@ -467,4 +467,13 @@
  */
 #define CUSTOM                                  0x1000000000000LLU
 
+/**
+ * @def METHOD_DEVIRTUALIZATION
+ * \ingroup Codetools
+ * @brief Devirtualization of virtual calls
+ *
+ * Transform virtual calls (IRVCALL) into direct calls (IRCALL) by using the class hierarchy of the program.
+ */
+#define METHOD_DEVIRTUALIZATION                 0x2000000000000LLU
+
 #endif
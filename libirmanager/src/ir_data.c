@@ -153,6 +153,23 @@ IR_ITEM_VALUE IRDATA_getMethodIDFromItem (ir_item_t *item) {
     return methodID.value.v;
 }
 
+void IRDATA_setFunctionPointerOfMethod (ir_item_t *item, IR_ITEM_VALUE irMethodID) {
+
+    /* Assertions.
+     */
+    assert(item != NULL);
+    assert(irMethodID != 0);
+
+    /* Store the symbol of the entry point.
+     */
+    memset(item, 0, sizeof(ir_item_t));
+    (item->value).v		= (IR_ITEM_VALUE) (JITNUINT) IRSYMBOL_createSymbol(FUNCTION_POINTER_SYMBOL, (void *) (JITNUINT) irMethodID);
+    item->type		= IRSYMBOL;
+    item->internal_type	= IRFPOINTER;
+
+    return ;
+}
+
 JITBOOLEAN IRDATA_isAMethodID (ir_item_t *item) {
     return internal_isATaggedSymbol(item, METHOD_SYMBOL);
 }
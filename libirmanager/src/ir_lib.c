@@ -96,6 +96,8 @@ void IRLibNew (
     IR_ITEM_VALUE (*getIRMethodID)(ir_method_t * method),
     XanList *       (*getIRMethods)(void),
     XanList *       (*getImplementationsOfMethod)(IR_ITEM_VALUE irMethodID),
+    IR_ITEM_VALUE   (*getTheOnlyImplementationOfMethod)(IR_ITEM_VALUE irMethodID),
+    void (*addImplementationsDependence)(ir_method_t *method, IR_ITEM_VALUE irMethodID),
     XanList *       (*getCompatibleMethods)(ir_signature_t * signature),
     void *          (*getFunctionPointer)(ir_method_t * method),
     ir_symbol_t *   (*loadSymbol)(JITUINT32 number),
@@ -124,6 +126,8 @@ void IRLibNew (
     ir_lib->getIRMethodID = getIRMethodID;
     ir_lib->getIRMethods = getIRMethods;
     ir_lib->getImplementationsOfMethod = getImplementationsOfMethod;
+    ir_lib->getTheOnlyImplementationOfMethod = getTheOnlyImplementationOfMethod;
+    ir_lib->addImplementationsDependence = addImplementationsDependence;
     ir_lib->getCompatibleMethods = getCompatibleMethods;
     ir_lib->getFunctionPointer = getFunctionPointer;
     ir_lib->loadSymbol = loadSymbol;
@@ -132,6 +132,160 @@ ir_instruction_t * IRMETHOD_getTheDestinationOfTheCircuitBackedge (circuit_t *lo
     return (loop->backEdge).dst;
 }
 
+JITBOOLEAN IRMETHOD_doesInstructionBelongToCircuit (ir_method_t *method, circuit_t *loop, ir_instruction_t *inst) {
+    JITUINT32 	trigger;
+    JITNUINT 	mask;
+
+    /* Assertions						*/
+    assert(method != NULL);
+    assert(loop != NULL);
+    assert(inst != NULL);
+    assert(loop->belong_inst != NULL);
+
+    /* Compute the bitmap to use				*/
+    mask 		= ((JITNUINT)1 << ((inst->ID) % (sizeof(JITNUINT) * 8)));
+    trigger 	= ((inst->ID) / (sizeof(JITNUINT) * 8));
+
+    return (loop->belong_inst[trigger] & mask) != 0;
+}
+
+ir_instruction_t * IRMETHOD_addCircuitPreHeader (ir_method_t *method, circuit_t *loop) {
+    ir_instruction_t	*header;
+    ir_instruction_t	*entry;
+    ir_instruction_t	*prev;
+    ir_instruction_t	*preHeader;
+    ir_instruction_t	*insertBefore;
+    XanList			*loopInsts;
+    XanList			*branchesToRedirect;
+    XanListItem		*item;
+    JITBOOLEAN		*isInLoop;
+    JITBOOLEAN		canBeAdded;
+
+    /* Assertions						*/
+    assert(method != NULL);
+    assert(loop != NULL);
+
+    /* Fetch the header of the circuit.
+     * The pre-header is inserted just before it; therefore we need a label to keep the code layout consistent.
+     */
+    header	= (loop->backEdge).dst;
+    if (	(header == NULL)		||
+            (header->type != IRLABEL)	) {
+        return NULL;
+    }
+
+    /* Fetch the instructions of every circuit that shares the same header.
+     * Branches coming from any of them are not entries of the loop.
+     */
+    loopInsts	= IRMETHOD_getInstructionsWithinAnyCircuitsOfSameHeader(method, header);
+    isInLoop	= allocFunction(sizeof(JITBOOLEAN) * (IRMETHOD_getInstructionsNumber(method) + 1));
+    item		= xanList_first(loopInsts);
+    while (item != NULL) {
+        ir_instruction_t	*i;
+        i		= item->data;
+        isInLoop[i->ID]	= JITTRUE;
+        item		= item->next;
+    }
+
+    /* Identify the entry point of the loop and the branches that reach it from outside.
+     */
+    entry			= NULL;
+    canBeAdded		= JITTRUE;
+    branchesToRedirect	= xanList_new(allocFunction, freeFunction, NULL);
+    item			= xanList_first(loopInsts);
+    while ((item != NULL) && canBeAdded) {
+        ir_instruction_t	*i;
+        XanList			*preds;
+        XanListItem		*item2;
+
+        /* Fetch the predecessors of the current instruction of the loop.
+         */
+        i	= item->data;
+        preds	= IRMETHOD_getInstructionPredecessors(method, i);
+        item2	= xanList_first(preds);
+        while (item2 != NULL) {
+            ir_instruction_t	*pred;
+            pred	= item2->data;
+            if (!isInLoop[pred->ID]) {
+
+                /* The loop can have only one entry point.
+                 */
+                if (	(entry != NULL)	&&
+                        (entry != i)	) {
+                    canBeAdded	= JITFALSE;
+                    break ;
+                }
+                entry	= i;
+
+                /* Remember the branches to redirect.
+                 */
+                if (	(entry->type == IRLABEL)									&&
+                        (IRMETHOD_doesInstructionUseLabel(method, pred, IRMETHOD_getInstructionParameter1Value(entry)))	) {
+                    xanList_append(branchesToRedirect, pred);
+
+                } else if (entry != header) {
+
+                    /* The entry point is reached by fall-through from outside the loop.
+                     * The pre-header could not be placed before it.
+                     */
+                    canBeAdded	= JITFALSE;
+                    break ;
+                }
+            }
+            item2	= item2->next;
+        }
+        xanList_destroyList(preds);
+        item	= item->next;
+    }
+    if (	(entry == NULL)				||
+            (entry->type != IRLABEL)	) {
+        canBeAdded	= JITFALSE;
+    }
+
+    /* The instruction just before the header must not fall through from the loop into the new pre-header.
+     */
+    prev	= IRMETHOD_getPrevInstruction(method, header);
+    if (	canBeAdded						&&
+            (prev != NULL)						&&
+            isInLoop[prev->ID]					&&
+            IRMETHOD_canTheNextInstructionBeASuccessor(method, prev)	) {
+        canBeAdded	= JITFALSE;
+    }
+
+    /* Free the memory.
+     */
+    freeFunction(isInLoop);
+    xanList_destroyList(loopInsts);
+    if (!canBeAdded) {
+        xanList_destroyList(branchesToRedirect);
+        return NULL;
+    }
+
+    /* Add the pre-header.
+     * If the loop is not entered from its header (e.g., rotated loops), the pre-header jumps to the entry point.
+     */
+    preHeader	= IRMETHOD_newLabelBefore(method, header);
+    if (entry != header) {
+        insertBefore	= IRMETHOD_newBranchToLabelBefore(method, entry, header);
+    } else {
+        insertBefore	= header;
+    }
+
+    /* Redirect the entries of the loop to the pre-header.
+     */
+    item	= xanList_first(branchesToRedirect);
+    while (item != NULL) {
+        IRMETHOD_substituteLabel(method, item->data, IRMETHOD_getInstructionParameter1Value(entry), IRMETHOD_getInstructionParameter1Value(preHeader));
+        item	= item->next;
+    }
+
+    /* Free the memory.
+     */
+    xanList_destroyList(branchesToRedirect);
+
+    return insertBefore;
+}
+
 JITBOOLEAN IRMETHOD_isCircuitInvariant (ir_method_t *method, circuit_t *loop, ir_instruction_t *inst) {
     JITUINT32 	trigger;
     JITNUINT 	mask;
@@ -1047,6 +1047,8 @@ typedef struct ir_lib_t {
     IR_ITEM_VALUE 	(*getIRMethodID)(ir_method_t * method);
     XanList *       (*getIRMethods)(void);
     XanList *       (*getImplementationsOfMethod)(IR_ITEM_VALUE irMethodID);
+    IR_ITEM_VALUE   (*getTheOnlyImplementationOfMethod)(IR_ITEM_VALUE irMethodID);
+    void 		(*addImplementationsDependence)(ir_method_t *method, IR_ITEM_VALUE irMethodID);
     XanList *       (*getCompatibleMethods)(ir_signature_t * signature);
     void *          (*getFunctionPointer)(ir_method_t * method);
     ir_symbol_t *   (*loadSymbol)(JITUINT32 number);
@@ -1477,6 +1479,8 @@ void IRLibNew(
     IR_ITEM_VALUE (*getIRMethodID)(ir_method_t * method),
     XanList *       (*getIRMethods)(void),
     XanList *       (*getImplementationsOfMethod)(IR_ITEM_VALUE irMethodID),
+    IR_ITEM_VALUE   (*getTheOnlyImplementationOfMethod)(IR_ITEM_VALUE irMethodID),
+    void (*addImplementationsDependence)(ir_method_t *method, IR_ITEM_VALUE irMethodID),
     XanList *       (*getCompatibleMethods)(ir_signature_t * signature),
     void *          (*getFunctionPointer)(ir_method_t * method),
     ir_symbol_t *   (*loadSymbol)(JITUINT32 number),
@@ -2824,6 +2828,18 @@ void * IRDATA_getGlobalVariableEffectiveAddress (ir_item_t *item);
  */
 JITBOOLEAN IRDATA_isAFunctionPointer (ir_item_t *item);
 
+/**
+ * \ingroup IRMETHOD_DataTypeMethod
+ * @brief Store the entry point of a method into an IR constant
+ *
+ * After the call, @c item is a constant of type IRFPOINTER that includes the entry point of the method @c irMethodID (i.e., @c IRDATA_isAFunctionPointer returns JITTRUE).
+ * The constant can be compared with function pointers loaded from virtual tables.
+ *
+ * @param item IR item to set
+ * @param irMethodID Method to consider
+ */
+void IRDATA_setFunctionPointerOfMethod (ir_item_t *item, IR_ITEM_VALUE irMethodID);
+
 /**
  * \ingroup IRMETHOD_DataTypeMethod
  * @brief Check if a IR variable or constant is an identificator of a method
@@ -3354,6 +3370,33 @@ ir_method_t * IRMETHOD_getIRMethodFromMethodID (ir_method_t *method, IR_ITEM_VAL
  */
 XanList * IRPROGRAM_getImplementationsOfMethod (IR_ITEM_VALUE irMethodID);
 
+/**
+ * \ingroup IRMETHOD_Program
+ * @brief Return the only implementation of a virtual method
+ *
+ * Class hierarchy analysis: every type laid out so far is considered.
+ * If all of them that inherit or override the virtual method given as input share the same body, and this body has an IR implementation, its IRMETHODID is returned.
+ *
+ * Notice that the answer holds only for the types loaded so far.
+ * Dynamic compilation schemes can load new types later; code that relies on the answer has to be guarded and it should be registered by calling \ref IRPROGRAM_addImplementationsDependence.
+ *
+ * @param irMethodID Method to consider (usually stored within the first parameter of IRVCALL)
+ * @return IRMETHODID of the only implementation or 0 if it does not exist
+ */
+IR_ITEM_VALUE IRPROGRAM_getTheOnlyImplementationOfMethod (IR_ITEM_VALUE irMethodID);
+
+/**
+ * \ingroup IRMETHOD_Program
+ * @brief Declare that a method relies on the current implementations of a virtual method
+ *
+ * The code of @c method has been specialized for the only implementation of @c irMethodID (see \ref IRPROGRAM_getTheOnlyImplementationOfMethod).
+ * When a new type overriding @c irMethodID is loaded, @c method is recompiled.
+ *
+ * @param method Method that relies on the implementations of @c irMethodID
+ * @param irMethodID Virtual method
+ */
+void IRPROGRAM_addImplementationsDependence (ir_method_t *method, IR_ITEM_VALUE irMethodID);
+
 /**
  * \ingroup IRMETHOD_Program
  * @brief Return the list of methods with the signature given as input
@@ -3870,6 +3913,40 @@ ir_instruction_t * IRMETHOD_getTheSourceOfTheCircuitBackedge (circuit_t *circuit
  */
 ir_instruction_t * IRMETHOD_getTheDestinationOfTheCircuitBackedge (circuit_t *circuit);
 
+/**
+ * \ingroup IRMETHOD_Circuit
+ * @brief Check if an instruction belongs to a circuit
+ *
+ * Check if the instruction <code> inst </code> belongs to the circuit <code> circuit </code>.
+ *
+ * The information LOOP_IDENTIFICATION needs to be valid before calling this function.
+ *
+ * @param method IR method that includes the circuit given as input
+ * @param circuit Circuit to consider
+ * @param inst Instruction to check
+ * @return JITTRUE or JITFALSE
+ */
+JITBOOLEAN IRMETHOD_doesInstructionBelongToCircuit (ir_method_t *method, circuit_t *circuit, ir_instruction_t *inst);
+
+/**
+ * \ingroup IRMETHOD_Circuit
+ * @brief Add a pre-header to a circuit
+ *
+ * Add a new basic block that is executed once every time the circuit given as input is entered from outside.
+ * Every branch that enters the circuit from outside is redirected to the new basic block.
+ *
+ * The returned instruction is the one that new instructions of the pre-header have to be inserted before (e.g., by calling \ref IRMETHOD_newInstructionBefore ).
+ *
+ * This function returns NULL and it does not modify the method if the circuit has more than one entry point (i.e., the circuit is not reducible) or if the code layout does not allow to insert a pre-header.
+ *
+ * The circuit information is not valid anymore after a pre-header has been inserted.
+ *
+ * @param method IR method that includes the circuit given as input
+ * @param circuit Circuit to consider
+ * @return The instruction to insert the pre-header code before or NULL
+ */
+ir_instruction_t * IRMETHOD_addCircuitPreHeader (ir_method_t *method, circuit_t *circuit);
+
 /**
  * \ingroup IRMETHOD_InstructionDominance
  * @brief Get the set of postdominators of an instruction
@@ -558,6 +558,22 @@ XanList * IRPROGRAM_getImplementationsOfMethod (IR_ITEM_VALUE irMethodID) {
     return result;
 }
 
+IR_ITEM_VALUE IRPROGRAM_getTheOnlyImplementationOfMethod (IR_ITEM_VALUE irMethodID) {
+    return ir_library->getTheOnlyImplementationOfMethod(irMethodID);
+}
+
+void IRPROGRAM_addImplementationsDependence (ir_method_t *method, IR_ITEM_VALUE irMethodID) {
+
+    /* Assertions			*/
+    assert(method != NULL);
+
+    /* Register the dependence	*/
+    ir_library->addImplementationsDependence(method, irMethodID);
+
+    /* Return			*/
+    return;
+}
+
 JITBOOLEAN IRPROGRAM_doesMethodBelongToProgram (ir_method_t *method) {
     BasicAssembly           *assembly;
     t_binary_information    *binary;
@@ -83,7 +83,6 @@ typedef struct {
 } IRVM_stackTrace;
 
 typedef struct {
-    IRVM_stackTrace         *stackTrace;
     void                    *exception_thrown;
     JITBOOLEAN isConstructed;
 } t_thread_exception_infos;
@@ -123,6 +122,7 @@ typedef struct {
     JITBOOLEAN aot;
     JITBOOLEAN staticCompilation;
     JITBOOLEAN onlyPrecompilation;
+    JITBOOLEAN reclaimCode;                                 /**< Free the machine code replaced by the recompilation of methods		*/
     JITINT8 pgc;
 } ir_system_behavior_t;
 
@@ -145,6 +145,7 @@ typedef struct IRVM_t {
     void 			(*leaveExecution)	(JITINT32 exitCode);
     t_jit_function *        (*getJITMethod)		(IR_ITEM_VALUE method);
     IRVM_type *             (*lookupValueType)	(TypeDescriptor *type);
+    void			(*codeReclaimed)	(void *entryPoint);                                                      /**< Function to invoke right before the machine code of a recompiled method starting at entryPoint is freed; it can be NULL	*/
 } IRVM_t;
 
 #ifdef __cplusplus
@@ -204,6 +205,50 @@ void IRVM_shutdown (IRVM_t *_this);
  */
 JITINT32 IRVM_run (IRVM_t *self, t_jit_function *jitFunction, void **args, void *returnArea);
 
+/**
+ * \ingroup IRBACKEND
+ * @brief Check in the current thread for the reclamation of the machine code of recompiled methods
+ *
+ * The machine code replaced by the recompilation of a method is freed only once every thread that runs code has checked in after the replacement.
+ * Threads that run code for a long time have to check in periodically (e.g., when they allocate memory); it is cheap when no code has been replaced since their last check-in.
+ *
+ * It does nothing if (self->behavior).reclaimCode is not set.
+ *
+ * @param self IR virtual machine
+ */
+void IRVM_checkpoint (IRVM_t *self);
+
+/**
+ * \ingroup IRBACKEND
+ * @brief Enter a region where the current thread waits without running code (e.g., for a monitor, or for another thread)
+ *
+ * The stack of the thread is scanned on its behalf while it is within the region, so waiting threads do not prevent the reclamation of the machine code of recompiled methods.
+ *
+ * @param self IR virtual machine
+ */
+void IRVM_enterBlockingRegion (IRVM_t *self);
+
+/**
+ * \ingroup IRBACKEND
+ * @brief Leave the region entered by \ref IRVM_enterBlockingRegion
+ *
+ * @param self IR virtual machine
+ */
+void IRVM_leaveBlockingRegion (IRVM_t *self);
+
+/**
+ * \ingroup IRBACKEND
+ * @brief Declare that the current thread runs code only through \ref IRVM_run
+ *
+ * Threads that check in without ever having run code through \ref IRVM_run are taken as native threads that called into the code directly, and their whole stack is scanned from then on for the reclamation of the machine code of recompiled methods.
+ * Threads created by ILDJIT have to be declared before they check in, so that they do not hold back the reclamation while they wait outside the code.
+ *
+ * It does nothing if (self->behavior).reclaimCode is not set.
+ *
+ * @param self IR virtual machine
+ */
+void IRVM_registerThread (IRVM_t *self);
+
 /**
  * \ingroup IRBACKEND_codegeneration
  * @brief Start the pre-compilation
@@ -276,6 +321,18 @@ JITINT32 IRVM_isANativeFunction (IRVM_t *self, t_jit_function *function);
  */
 void * IRVM_getEntryPoint (IRVM_t *self, t_jit_function *function);
 
+/**
+ * \ingroup IRBACKEND
+ *
+ * Return the size of the machine code of the function.
+ *
+ * The machine code of <code> function </code> spans from its entry point to the entry point plus the returned size.
+ *
+ * @param function Backend-dependent function
+ * @return Size in bytes of the machine code of <code> function </code>, or 0 if it is native or its machine code has not been generated yet
+ */
+JITUINT32 IRVM_getCodeSize (IRVM_t *self, t_jit_function *function);
+
 /**
  * \ingroup IRBACKEND
  *
@@ -462,11 +519,54 @@ JITINT32 IRVM_isCompilationAvailable (IRVM_t *self);
 
 /*********** Stack trace ******************/
 IRVM_stackTrace * IRVM_getStackTrace (void);
+
+/**
+ * Start the stack trace of an exception that the current thread is about to throw.
+ *
+ * Only the return addresses are captured: methods and offsets are looked up when they are read.
+ * The backend can take the frames lazily, while the exception unwinds them.
+ *
+ * @param exception Exception to throw
+ */
+void IRVM_captureStackTrace (void *exception);
+
+/**
+ * Fetch the stack trace that the current thread captured for an exception.
+ *
+ * The stack trace belongs to the thread, which reuses its memory for the next exception: it must not be destroyed.
+ *
+ * @param exception Exception thrown by the current thread
+ * @param stack Set to the stack trace of exception
+ * @return JITFALSE if the last stack trace captured by the current thread is not the one of exception
+ */
+JITBOOLEAN IRVM_getExceptionStackTrace (void *exception, IRVM_stackTrace *stack);
 void IRVM_destroyStackTrace (IRVM_stackTrace *stack);
+
+/**
+ * Return the CIL offset of the call that was running in a frame of a stack trace.
+ *
+ * @return (JITUINT32)-1 if the frame does not belong to a method or no offset has been recorded for the call
+ */
 JITUINT32 IRVM_getStackTraceOffset (IRVM_t *IRVM, IRVM_stackTrace *stack, JITUINT32 position);
+
+/**
+ * Return the method that a frame of a stack trace belongs to.
+ *
+ * @return NULL if the frame belongs to native code
+ */
 void * IRVM_getStackTraceFunctionAt (IRVM_t *IRVM, IRVM_stackTrace *stack, JITUINT32 position);
 JITUINT32 IRVM_getStackTraceSize (IRVM_stackTrace *stack);
 
+/**
+ * Return the address of the code that was running in a frame of a stack trace.
+ *
+ * Position 0 is the innermost frame.
+ * The address is a return address: it follows the call that was running in the frame.
+ *
+ * @return NULL if position is out of the stack trace
+ */
+void * IRVM_getStackTraceAddressAt (IRVM_stackTrace *stack, JITUINT32 position);
+
 void libirvirtualmachineCompilationFlags (char *buffer, int bufferLength);
 
 void libirvirtualmachineCompilationTime (char *buffer, int bufferLength);
@@ -42,6 +42,9 @@
 
 #define DIM_BUF 1024
 
+/* Copies and initializations of memory of known size up to this number of bytes are expanded into loads and stores	*/
+#define MAX_INLINED_MEMORY_BLOCK	64
+
 typedef struct {
 	jit_label_t label;
 	JITUINT32 ID;
@@ -121,6 +124,8 @@ static inline JITINT16 translate_ir_librarycall (IRVM_t *_this, ir_method_t *met
 static inline JITINT16 translate_ir_icall (IRVM_t *_this, ir_method_t *method, ir_instruction_t *inst, t_jit_function_internal *jitFunction);
 static inline JITINT16 translate_ir_initmemory (IRVM_t *_this, ir_method_t *method, ir_instruction_t *inst, t_jit_function_internal *jitFunction);
 static inline JITINT16 translate_ir_memory_copy (IRVM_t *_this, ir_method_t *method, ir_instruction_t *inst, t_jit_function_internal *jitFunction);
+static inline JITBOOLEAN internal_getConstantMemoryBlockSize (ir_instruction_t *inst, ir_item_t *item, jit_nint *size);
+static inline jit_type_t internal_getMemoryChunkType (jit_nint bytes, jit_nint *chunkBytes);
 static inline JITINT16 translate_ir_alloca (IRVM_t *_this, ir_method_t *method, ir_instruction_t *inst, t_jit_function_internal *jitFunction);
 static inline JITINT16 translate_ir_alloc (IRVM_t *_this, ir_method_t *method, ir_instruction_t *inst, t_jit_function_internal *jitFunction);
 static inline JITINT16 translate_ir_realloc (IRVM_t *_this, ir_method_t *method, ir_instruction_t *inst, t_jit_function_internal *jitFunction);
@@ -146,6 +151,7 @@ static inline JITINT32 internal_run (t_jit_function_internal *jitFunction, void
 static inline jit_type_t internal_fromIRTypeToJITType (IRVM_t *_this, JITUINT32 IRType, TypeDescriptor *class);
 static inline JITINT32 internal_recompilerFunctionWrapper (jit_function_t function);
 static inline JITINT32 internal_dummyRecompiler (jit_function_t function, void *pc);
+static void internal_codeReclaimed (void *start, void *data);
 
 void IRVM_destroyStackTrace (IRVM_stackTrace *stack){
 	jit_stack_trace_free(stack->stack_trace);
@@ -189,6 +195,10 @@ JITUINT32 IRVM_getStackTraceSize (IRVM_stackTrace *stack){
 	return jit_stack_trace_get_size(stack->stack_trace);
 }
 
+void * IRVM_getStackTraceAddressAt (IRVM_stackTrace *stack, JITUINT32 position){
+	return jit_stack_trace_get_pc(stack->stack_trace, position);
+}
+
 IRVM_stackTrace * IRVM_getStackTrace (void){
 	IRVM_stackTrace *s;
 
@@ -197,6 +207,15 @@ IRVM_stackTrace * IRVM_getStackTrace (void){
 	return s;
 }
 
+void IRVM_captureStackTrace (void *exception){
+	jit_exception_capture_stack_trace(exception);
+}
+
+JITBOOLEAN IRVM_getExceptionStackTrace (void *exception, IRVM_stackTrace *stack){
+	stack->stack_trace = jit_exception_get_thrown_stack_trace(exception);
+	return stack->stack_trace != NULL;
+}
+
 void IRVM_throwBuiltinException (IRVM_t *self, JITUINT32 exceptionType){
 	switch (exceptionType) {
 	    case OUT_OF_MEMORY_EXCEPTION:
@@ -251,6 +270,12 @@ void IRVM_init (IRVM_t *_this, t_running_garbage_collector *gc, IRVM_type * (*lo
 		(_this->behavior).libjitOptimizations = jit_function_get_max_optimization_level();
 	}
 
+	/* Let Libjit free the machine code	*
+	 * replaced by recompilations		*/
+	if ((_this->behavior).reclaimCode) {
+		jit_context_set_meta_numeric(data->context, JIT_OPTION_RECLAIM_CODE, 1);
+	}
+
 	/* Make the signature of the basic      *
 	 * constructor of the exceptions	*/
 	params_ctor[0] = jit_type_void_ptr;
@@ -321,6 +346,13 @@ void IRVM_makeTheMethodCallable (IRVM_t *_this, t_jit_function *jitFunction, ir_
 	jit_function_setup_entry(internalFunction->function, internalFunction->entryPoint);
 	internal_unlockLibjit(_this->data);
 
+	/* Free the machine code replaced by	*
+	 * the previous recompilations that	*
+	 * no thread can run anymore		*/
+	if ((_this->behavior).reclaimCode) {
+		jit_context_reclaim_code(((IRVM_t_internal *) _this->data)->context, internal_codeReclaimed, _this);
+	}
+
 	/* Dump the methods in the target       *
 	 * machine code				*/
 	if (    ((_this->behavior).dumpAssembly.dumpAssembly)   &&
@@ -4019,6 +4051,7 @@ static inline JITINT16 translate_ir_memory_copy (IRVM_t *_this, ir_method_t *met
 	jit_value_t param_1;
 	jit_value_t param_2;
 	jit_value_t param_3;
+	jit_nint size;
 
 	/* assertions */
 	assert(method != NULL);
@@ -4035,6 +4068,29 @@ static inline JITINT16 translate_ir_memory_copy (IRVM_t *_this, ir_method_t *met
 	PDEBUG(", ");
 	assert(param_2 != NULL);
 
+	/* Small blocks of known size are copied inline	*/
+	if (internal_getConstantMemoryBlockSize(inst, &(inst->param_3), &size)) {
+		PDEBUG("%ld)\n", (long) size);
+		if (size <= MAX_INLINED_MEMORY_BLOCK) {
+			jit_nint offset;
+			offset = 0;
+			while (offset < size) {
+				jit_type_t chunkType;
+				jit_nint chunkBytes;
+				jit_value_t temp;
+				chunkType = internal_getMemoryChunkType(size - offset, &chunkBytes);
+				temp = jit_insn_load_relative(jitFunction->function, param_2, offset, chunkType);
+				jit_insn_store_relative(jitFunction->function, param_1, offset, temp);
+				offset += chunkBytes;
+			}
+			return 0;
+		}
+
+		/* Give the size to the backend as a constant	*/
+		jit_insn_memcpy(jitFunction->function, param_1, param_2, jit_value_create_nint_constant(jitFunction->function, jit_type_nint, size));
+		return 0;
+	}
+
 	param_3 = make_variable(_this, method, &(inst->param_3), jitFunction);
 	PDEBUG(")\n");
 	assert(param_3 != NULL);
@@ -4050,6 +4106,7 @@ static inline JITINT16 translate_ir_initmemory (IRVM_t *_this, ir_method_t *meth
 	jit_value_t param_1;
 	jit_value_t param_2;
 	jit_value_t param_3;
+	jit_nint size;
 
 	/* assertions */
 	assert(method != NULL);
@@ -4061,6 +4118,32 @@ static inline JITINT16 translate_ir_initmemory (IRVM_t *_this, ir_method_t *meth
 	PDEBUG(", ");
 	assert(param_1 != NULL);
 
+	/* Small blocks of known size initialized with a	*
+	 * known value are written inline			*/
+	if (	IRDATA_isAConstant(&(inst->param_2))						&&
+		internal_getConstantMemoryBlockSize(inst, &(inst->param_3), &size)		&&
+		(size <= MAX_INLINED_MEMORY_BLOCK)						) {
+		jit_ulong pattern;
+		jit_nint offset;
+		PDEBUG("%ld)\n", (long) size);
+		pattern = ((jit_ulong) (IRDATA_getIntegerValueOfConstant(&(inst->param_2)) & 0xFF)) * 0x0101010101010101ULL;
+		offset = 0;
+		while (offset < size) {
+			jit_type_t chunkType;
+			jit_nint chunkBytes;
+			jit_value_t value;
+			chunkType = internal_getMemoryChunkType(size - offset, &chunkBytes);
+			if (chunkBytes == 8) {
+				value = jit_value_create_long_constant(jitFunction->function, chunkType, (jit_long) pattern);
+			} else {
+				value = jit_value_create_nint_constant(jitFunction->function, chunkType, (jit_nint) (pattern & ((((jit_ulong) 1) << (chunkBytes * 8)) - 1)));
+			}
+			jit_insn_store_relative(jitFunction->function, param_1, offset, value);
+			offset += chunkBytes;
+		}
+		return 0;
+	}
+
 	/* Create the second parameter	*/
 	param_2 = make_variable(_this, method, &(inst->param_2), jitFunction);
 	PDEBUG(", ");
@@ -4076,6 +4159,35 @@ static inline JITINT16 translate_ir_initmemory (IRVM_t *_this, ir_method_t *meth
 	return 0;
 }
 
+static inline JITBOOLEAN internal_getConstantMemoryBlockSize (ir_instruction_t *inst, ir_item_t *item, jit_nint *size){
+
+	/* Volatile accesses keep their single memory operation	*/
+	if (	IRMETHOD_isInstructionVolatile(inst)	||
+		(!IRDATA_isAConstant(item))		) {
+		return JITFALSE;
+	}
+	(*size) = (jit_nint) IRDATA_getIntegerValueOfConstant(item);
+
+	return ((*size) > 0);
+}
+
+static inline jit_type_t internal_getMemoryChunkType (jit_nint bytes, jit_nint *chunkBytes){
+	if (bytes >= 8) {
+		(*chunkBytes) = 8;
+		return jit_type_ulong;
+	}
+	if (bytes >= 4) {
+		(*chunkBytes) = 4;
+		return jit_type_uint;
+	}
+	if (bytes >= 2) {
+		(*chunkBytes) = 2;
+		return jit_type_ushort;
+	}
+	(*chunkBytes) = 1;
+	return jit_type_ubyte;
+}
+
 static inline void set_volatile_variables (IRVM_t *_this, ir_method_t *method, ir_instruction_t *inst, t_jit_function_internal *jitFunction){
 	jit_value_t	value;
 
@@ -4251,7 +4363,80 @@ char * libirvirtualmachineVersion (){
 }
 
 JITINT32 IRVM_run (IRVM_t *self, t_jit_function *jitFunction, void **args, void *returnArea){
-	return internal_run(jitFunction->data, args, returnArea);
+	jit_context_t context;
+	JITBOOLEAN attached;
+	JITBOOLEAN blocked;
+	JITINT32 error;
+
+	if (!(self->behavior).reclaimCode) {
+		return internal_run(jitFunction->data, args, returnArea);
+	}
+
+	/* Attach the thread to the context, or	*
+	 * leave the blocking region it is in	*
+	 * if it is running code already (e.g.,	*
+	 * a static constructor invoked while	*
+	 * compiling a method)			*/
+	context = ((IRVM_t_internal *) self->data)->context;
+	attached = jit_context_attach_thread(context, &context);
+	blocked = JITFALSE;
+	if (!attached) {
+		blocked = jit_context_leave_blocking(context);
+	}
+
+	/* Run					*/
+	error = internal_run(jitFunction->data, args, returnArea);
+
+	/* Restore the state of the thread	*/
+	if (attached) {
+		jit_context_detach_thread(context);
+	} else if (blocked) {
+		jit_context_enter_blocking(context);
+	}
+
+	return error;
+}
+
+void IRVM_checkpoint (IRVM_t *self){
+	if ((self->behavior).reclaimCode) {
+		jit_context_checkpoint(((IRVM_t_internal *) self->data)->context);
+	}
+}
+
+void IRVM_enterBlockingRegion (IRVM_t *self){
+	if ((self->behavior).reclaimCode) {
+		jit_context_enter_blocking(((IRVM_t_internal *) self->data)->context);
+	}
+}
+
+void IRVM_leaveBlockingRegion (IRVM_t *self){
+	if ((self->behavior).reclaimCode) {
+		jit_context_leave_blocking(((IRVM_t_internal *) self->data)->context);
+	}
+}
+
+void IRVM_registerThread (IRVM_t *self){
+	jit_context_t context;
+
+	if (!(self->behavior).reclaimCode) {
+		return;
+	}
+
+	/* A thread detached from the context is	*
+	 * attached again only by IRVM_run		*/
+	context = ((IRVM_t_internal *) self->data)->context;
+	if (jit_context_attach_thread(context, &context)) {
+		jit_context_detach_thread(context);
+	}
+}
+
+static void internal_codeReclaimed (void *start, void *data){
+	IRVM_t *_this;
+
+	_this = (IRVM_t *) data;
+	if (_this->codeReclaimed != NULL) {
+		_this->codeReclaimed(start);
+	}
 }
 
 static inline JITINT32 internal_run (t_jit_function_internal *jitFunction, void **args, void *returnArea){
@@ -4353,7 +4538,12 @@ static inline JITINT32 internal_recompilerFunctionWrapper (jit_function_t functi
 	/* Unlock the libjit				*/
 	internal_unlockLibjit(_this->data);
 
+	/* The thread waits for the compilation of the	*
+	 * method, so the machine code it was running	*
+	 * can be reclaimed meanwhile			*/
+	IRVM_enterBlockingRegion(_this);
 	result = _this->recompilerFunction(ilmethod, caller, inst);
+	IRVM_leaveBlockingRegion(_this);
 
 	/* Lock the Libjit library			*/
 	internal_lockLibjit(_this->data);
@@ -4935,6 +5125,23 @@ void * IRVM_getEntryPoint (IRVM_t *self, t_jit_function *function){
 	return internalFunction->entryPoint;
 }
 
+JITUINT32 IRVM_getCodeSize (IRVM_t *self, t_jit_function *function){
+	t_jit_function_internal *internalFunction;
+
+	/* Assertions				*/
+	assert(function != NULL);
+
+	/* Cache some pointers			*/
+	internalFunction = function->data;
+	if (	(internalFunction == NULL)		||
+		(internalFunction->nativeFunction != NULL)	) {
+		return 0;
+	}
+
+	/* Return				*/
+	return jit_function_get_code_size(internalFunction->function);
+}
+
 JITINT32 IRVM_hasTheSignatureBeenTranslated (IRVM_t *self, t_jit_function *backendFunction){
 	t_jit_function_internal *internalFunction;
 
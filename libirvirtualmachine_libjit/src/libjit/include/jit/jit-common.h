@@ -95,6 +95,12 @@ typedef int (*jit_on_demand_func)(jit_function_t func);
  */
 typedef void *(*jit_on_demand_driver_func)(jit_function_t func);
 
+/*
+ * Function that is told about the replaced code of a function right before
+ * its space is given back to the function cache.
+ */
+typedef void (*jit_reclaim_func)(void *start, void *data);
+
 #ifdef  __cplusplus
 };
 #endif
@@ -44,6 +44,14 @@ void *jit_context_get_meta (jit_context_t context, int type) JIT_NOTHROW;
 jit_nuint jit_context_get_meta_numeric
 	(jit_context_t context, int type) JIT_NOTHROW;
 void jit_context_free_meta (jit_context_t context, int type) JIT_NOTHROW;
+int jit_context_attach_thread
+	(jit_context_t context, void *stack_base) JIT_NOTHROW;
+void jit_context_detach_thread (jit_context_t context) JIT_NOTHROW;
+void jit_context_checkpoint (jit_context_t context) JIT_NOTHROW;
+void jit_context_enter_blocking (jit_context_t context) JIT_NOTHROW;
+int jit_context_leave_blocking (jit_context_t context) JIT_NOTHROW;
+unsigned long jit_context_reclaim_code
+	(jit_context_t context, jit_reclaim_func reclaimed, void *data) JIT_NOTHROW;
 
 /*
  * Standard meta values for builtin configurable options.
@@ -54,6 +62,8 @@ void jit_context_free_meta (jit_context_t context, int type) JIT_NOTHROW;
 #define JIT_OPTION_DONT_FOLD            10003
 #define JIT_OPTION_POSITION_INDEPENDENT 10004
 #define JIT_OPTION_CACHE_MAX_PAGE_FACTOR        10005
+#define JIT_OPTION_DONT_PEEPHOLE        10006
+#define JIT_OPTION_RECLAIM_CODE         10007
 
 #ifdef  __cplusplus
 };
@@ -60,6 +60,8 @@ void jit_exception_builtin (int exception_type);
 jit_exception_func jit_exception_set_handler (jit_exception_func handler);
 jit_exception_func jit_exception_get_handler (void);
 jit_stack_trace_t jit_exception_get_stack_trace (void);
+jit_stack_trace_t jit_exception_capture_stack_trace (void *object);
+jit_stack_trace_t jit_exception_get_thrown_stack_trace (void *object);
 unsigned int jit_stack_trace_get_size (jit_stack_trace_t trace);
 jit_function_t jit_stack_trace_get_function (jit_context_t context,
 					     jit_stack_trace_t trace,
@@ -31,12 +31,13 @@ _jit_bitset_init (_jit_bitset_t *bs){
 
 int
 _jit_bitset_allocate (_jit_bitset_t *bs, int size){
+	/* The size is kept in words */
+	size = (size + _JIT_BITSET_WORD_BITS - 1) / _JIT_BITSET_WORD_BITS;
 	bs->size = size;
 	if (size > 0) {
-		size = (size + _JIT_BITSET_WORD_BITS - 1) / _JIT_BITSET_WORD_BITS;
 		bs->bits = jit_calloc(size, sizeof(_jit_bitset_word_t));
 		if (!bs->bits) {
-			jit_free(bs);
+			bs->size = 0;
 			return 0;
 		}
 	}else {
@@ -65,7 +66,7 @@ _jit_bitset_set_bit (_jit_bitset_t *bs, int bit){
 
 	word = bit / _JIT_BITSET_WORD_BITS;
 	bit = bit % _JIT_BITSET_WORD_BITS;
-	bs->bits[word] |= bit;
+	bs->bits[word] |= ((_jit_bitset_word_t) 1) << bit;
 }
 
 void
@@ -74,7 +75,7 @@ _jit_bitset_clear_bit (_jit_bitset_t *bs, int bit){
 
 	word = bit / _JIT_BITSET_WORD_BITS;
 	bit = bit % _JIT_BITSET_WORD_BITS;
-	bs->bits[word] &= ~bit;
+	bs->bits[word] &= ~(((_jit_bitset_word_t) 1) << bit);
 }
 
 int
@@ -83,7 +84,7 @@ _jit_bitset_test_bit (_jit_bitset_t *bs, int bit){
 
 	word = bit / _JIT_BITSET_WORD_BITS;
 	bit = bit % _JIT_BITSET_WORD_BITS;
-	return (bs->bits[word] & bit) != 0;
+	return (bs->bits[word] & (((_jit_bitset_word_t) 1) << bit)) != 0;
 }
 
 void
@@ -60,6 +60,30 @@ struct jit_cache_debug {
 
 };
 
+/*
+ * Tune the minimum size of the space left by freed methods that is
+ * reused for new methods.  Smaller holes are only reused once they
+ * merge with the space of other freed methods.
+ */
+#ifndef JIT_CACHE_MIN_HOLE
+#define JIT_CACHE_MIN_HOLE              512
+#endif
+
+/*
+ * Space taken by a method within its page: the code is written at the
+ * bottom of the space and the auxillary data at its top.  The record
+ * is stored within the auxillary data of the method itself.
+ */
+typedef struct jit_cache_body *jit_cache_body_t;
+struct jit_cache_body {
+	unsigned char           *page;          /* Page that contains the method */
+	unsigned char           *codeStart;     /* Start of the code, alignment included */
+	unsigned char           *codeEnd;       /* End of the code */
+	unsigned char           *dataStart;     /* Start of the auxillary data */
+	unsigned char           *dataEnd;       /* End of the auxillary data */
+	int freed;                              /* Non-zero if the method is being freed */
+};
+
 /*
  * Method information block, organised as a red-black tree node.
  * There may be more than one such block associated with a method
@@ -72,6 +96,7 @@ struct jit_cache_method {
 	unsigned char           *start;         /* Start of the region */
 	unsigned char           *end;           /* End of the region */
 	jit_cache_debug_t debug;                /* Debug information for method */
+	jit_cache_body_t body;                  /* Space taken by the method */
 	jit_cache_method_t left;                /* Left sub-tree and red/black bit */
 	jit_cache_method_t right;               /* Right sub-tree */
 
@@ -85,6 +110,15 @@ struct jit_cache_page {
 	long factor;                            /* Page size factor */
 };
 
+/*
+ * Free space within a page left by freed methods.
+ */
+struct jit_cache_hole {
+	unsigned char           *page;          /* Page that contains the hole */
+	unsigned char           *start;         /* Start of the hole */
+	unsigned char           *end;           /* End of the hole */
+};
+
 /*
  * Structure of the method cache.
  */
@@ -97,7 +131,15 @@ struct jit_cache {
 	unsigned int maxPageFactor;             /* Maximum page size factor */
 	unsigned char           *freeStart;     /* Start of the current free region */
 	unsigned char           *freeEnd;       /* End of the current free region */
+	unsigned char           *freePage;      /* Page of the current free region */
 	long pagesLeft;                         /* Number of pages left to allocate */
+	struct jit_cache_hole   *holes;         /* Holes left by freed methods, sorted by address */
+	unsigned long numHoles;                 /* Number of holes in the list */
+	unsigned long maxNumHoles;              /* Maximum number of holes that could be in the list */
+	unsigned long holeBytes;                /* Bytes within the holes */
+	struct jit_cache_hole   hole;           /* Hole the current method is written to, if page is not NULL */
+	int holeOverflow;                       /* Non-zero if the method did not fit into its hole */
+	jit_cache_body_t body;                  /* Space taken by the current method */
 	jit_cache_method_t method;              /* Information for the current method */
 	struct jit_cache_method head;           /* Head of the lookup tree */
 	struct jit_cache_method nil;            /* Nil pointer for the lookup tree */
@@ -255,14 +297,32 @@ static long UncompressInt (UncompressReader *meta){
 	}
 }
 
+static void FreeCacheSpace (jit_cache_t cache, unsigned char *page,
+			    unsigned char *start, unsigned char *end);
+
 /*
  * Allocate a cache page and add it to the cache.
  */
 static void AllocCachePage (jit_cache_t cache, int factor){
 	long num;
 	unsigned char *ptr;
+	unsigned char *page;
+	unsigned char *start;
+	unsigned char *end;
 	struct jit_cache_page *list;
 
+	/* Turn the rest of the current free region into a hole, so that the
+	   page it belongs to can be given back once its methods are freed */
+	if (cache->freeStart) {
+		page = cache->freePage;
+		start = cache->freeStart;
+		end = cache->freeEnd;
+		cache->freeStart = 0;
+		cache->freeEnd = 0;
+		cache->freePage = 0;
+		FreeCacheSpace(cache, page, start, end);
+	}
+
 	/* The minimum page factor is 1 */
 	if (factor <= 0) {
 		factor = 1;
@@ -306,6 +366,7 @@ static void AllocCachePage (jit_cache_t cache, int factor){
  failAlloc:
 			cache->freeStart = 0;
 			cache->freeEnd = 0;
+			cache->freePage = 0;
 			return;
 		}
 
@@ -324,6 +385,162 @@ static void AllocCachePage (jit_cache_t cache, int factor){
 	/* Set up the working region within the new page */
 	cache->freeStart = ptr;
 	cache->freeEnd = ptr + (int) cache->pageSize * factor;
+	cache->freePage = ptr;
+}
+
+/*
+ * Find the position of a page within the page list.
+ * Returns -1 if the page is not in the list.
+ */
+static long FindCachePage (jit_cache_t cache, unsigned char *page){
+	unsigned long index;
+
+	for (index = 0; index < cache->numPages; ++index) {
+		if (cache->pages[index].page == (void *) page) {
+			return (long) index;
+		}
+	}
+	return -1;
+}
+
+/*
+ * Remove a hole from the hole list.
+ */
+static void RemoveCacheHole (jit_cache_t cache, unsigned long index){
+	cache->holeBytes -= (unsigned long) (cache->holes[index].end - cache->holes[index].start);
+	--(cache->numHoles);
+	jit_memmove(cache->holes + index, cache->holes + index + 1,
+		    (cache->numHoles - index) * sizeof(struct jit_cache_hole));
+}
+
+/*
+ * Give back to the cache the space between "start" and "end" within
+ * "page".  The space is merged with the adjacent holes, then with the
+ * current free region if it borders on it.  Pages that become empty
+ * are given back to the system.
+ */
+static void FreeCacheSpace (jit_cache_t cache, unsigned char *page,
+			    unsigned char *start, unsigned char *end){
+	struct jit_cache_hole *list;
+	struct jit_cache_hole *hole;
+	unsigned long low, high, middle;
+	unsigned long num;
+	long index;
+	long factor;
+
+	if (start >= end) {
+		return;
+	}
+
+	/* Find the position of the space within the sorted hole list */
+	low = 0;
+	high = cache->numHoles;
+	while (low < high) {
+		middle = (low + high) / 2;
+		if (cache->holes[middle].start < start) {
+			low = middle + 1;
+		}else {
+			high = middle;
+		}
+	}
+
+	/* Merge the space with the holes that border on it */
+	if (low > 0 && cache->holes[low - 1].page == page
+	    && cache->holes[low - 1].end == start) {
+		--low;
+		hole = &(cache->holes[low]);
+		hole->end = end;
+		cache->holeBytes += (unsigned long) (end - start);
+		if (low + 1 < cache->numHoles && cache->holes[low + 1].page == page
+		    && cache->holes[low + 1].start == end) {
+			start = end;
+			end = cache->holes[low + 1].end;
+			RemoveCacheHole(cache, low + 1);
+			hole = &(cache->holes[low]);
+			hole->end = end;
+			cache->holeBytes += (unsigned long) (end - start);
+		}
+	}else if (low < cache->numHoles && cache->holes[low].page == page
+		  && cache->holes[low].start == end) {
+		hole = &(cache->holes[low]);
+		hole->start = start;
+		cache->holeBytes += (unsigned long) (end - start);
+	}else {
+		/* Insert a new hole, growing the list if needed.  If we are out
+		   of memory, then the space is lost, as it was before it was
+		   freed */
+		if (cache->numHoles == cache->maxNumHoles) {
+			num = (cache->maxNumHoles == 0) ? 16 : cache->maxNumHoles * 2;
+			list = (struct jit_cache_hole *) jit_realloc(cache->holes,
+								     sizeof(struct jit_cache_hole) * num);
+			if (!list) {
+				return;
+			}
+			cache->holes = list;
+			cache->maxNumHoles = num;
+		}
+		jit_memmove(cache->holes + low + 1, cache->holes + low,
+			    (cache->numHoles - low) * sizeof(struct jit_cache_hole));
+		++(cache->numHoles);
+		hole = &(cache->holes[low]);
+		hole->page = page;
+		hole->start = start;
+		hole->end = end;
+		cache->holeBytes += (unsigned long) (end - start);
+	}
+
+	/* Give the hole to the current free region if it borders on it */
+	if (cache->freeStart && hole->page == cache->freePage) {
+		if (hole->end == cache->freeStart) {
+			cache->freeStart = hole->start;
+			RemoveCacheHole(cache, low);
+			return;
+		}else if (hole->start == cache->freeEnd) {
+			cache->freeEnd = hole->end;
+			RemoveCacheHole(cache, low);
+			return;
+		}
+	}
+
+	/* Give the page back to the system if nothing is left within it */
+	if (hole->page == cache->freePage || hole->start != hole->page) {
+		return;
+	}
+	index = FindCachePage(cache, hole->page);
+	if (index < 0) {
+		return;
+	}
+	factor = cache->pages[index].factor;
+	if (hole->end != hole->page + cache->pageSize * factor) {
+		return;
+	}
+	RemoveCacheHole(cache, low);
+	jit_free_exec(cache->pages[index].page, cache->pageSize * factor);
+	--(cache->numPages);
+	jit_memmove(cache->pages + index, cache->pages + index + 1,
+		    (cache->numPages - (unsigned long) index) * sizeof(struct jit_cache_page));
+	if (cache->pagesLeft >= 0) {
+		cache->pagesLeft += factor;
+	}
+}
+
+/*
+ * Take the hole that the next method is written to.  The first hole
+ * that is big enough is taken, so that the methods are packed into the
+ * lowest pages and the other ones have a chance to be given back to the
+ * system.  Returns zero if there is no such hole.
+ */
+static int TakeCacheHole (jit_cache_t cache){
+	unsigned long index;
+
+	for (index = 0; index < cache->numHoles; ++index) {
+		if ((unsigned long) (cache->holes[index].end - cache->holes[index].start) >= JIT_CACHE_MIN_HOLE) {
+			cache->hole = cache->holes[index];
+			RemoveCacheHole(cache, index);
+			return 1;
+		}
+	}
+	return 0;
 }
 
 /*
@@ -477,6 +694,83 @@ static void AddToLookupTree (jit_cache_t cache, jit_cache_method_t method){
 	SetBlack(cache->head.right);
 }
 
+/*
+ * Collect the method region blocks of a sub-tree in address order,
+ * skipping the blocks of the methods that are being freed.  Only
+ * counts them if "list" is NULL.
+ */
+static unsigned long CollectRegions (jit_cache_method_t node,
+				     jit_cache_method_t nil,
+				     jit_cache_method_t *list){
+	unsigned long num;
+
+	if (node == nil) {
+		return 0;
+	}
+	num = CollectRegions(GetLeft(node), nil, list);
+	if (!node->body || !node->body->freed) {
+		if (list) {
+			list[num] = node;
+		}
+		++num;
+	}
+	return num + CollectRegions(GetRight(node), nil, (list ? list + num : 0));
+}
+
+/*
+ * Build a balanced red-black tree from a list of method region blocks
+ * sorted by address.  Splitting the list at its middle fills every level
+ * but the deepest one, so the tree is valid if the blocks at depth
+ * "redDepth" (i.e., the deepest level) are red and the others black.
+ */
+static jit_cache_method_t BuildLookupTree (jit_cache_method_t *list, long low, long high,
+					   int depth, int redDepth, jit_cache_method_t nil){
+	jit_cache_method_t node;
+	long middle;
+
+	if (low > high) {
+		return nil;
+	}
+	middle = low + (high - low) / 2;
+	node = list[middle];
+	node->left = BuildLookupTree(list, low, middle - 1, depth + 1, redDepth, nil);
+	node->right = BuildLookupTree(list, middle + 1, high, depth + 1, redDepth, nil);
+	if (depth == redDepth) {
+		SetRed(node);
+	}
+	return node;
+}
+
+/*
+ * Rebuild the lookup tree without the region blocks of the methods that
+ * are being freed.  Returns zero if out of memory, in which case the
+ * tree is left untouched.
+ */
+static int RebuildLookupTree (jit_cache_t cache){
+	jit_cache_method_t *list;
+	unsigned long num;
+	int redDepth;
+
+	num = CollectRegions(cache->head.right, &(cache->nil), 0);
+	if (num == 0) {
+		cache->head.right = &(cache->nil);
+		return 1;
+	}
+	list = (jit_cache_method_t *) jit_malloc(num * sizeof(jit_cache_method_t));
+	if (!list) {
+		return 0;
+	}
+	CollectRegions(cache->head.right, &(cache->nil), list);
+	redDepth = 0;
+	while ((num >> (redDepth + 1)) != 0) {
+		++redDepth;
+	}
+	cache->head.right = BuildLookupTree(list, 0, (long) num - 1, 0, redDepth, &(cache->nil));
+	SetBlack(cache->head.right);
+	jit_free(list);
+	return 1;
+}
+
 /*
  * Flush the current debug buffer.
  */
@@ -563,6 +857,16 @@ jit_cache_t _jit_cache_create (long limit, long cache_page_size, int max_page_fa
 	cache->maxPageFactor = max_page_factor;
 	cache->freeStart = 0;
 	cache->freeEnd = 0;
+	cache->freePage = 0;
+	cache->holes = 0;
+	cache->numHoles = 0;
+	cache->maxNumHoles = 0;
+	cache->holeBytes = 0;
+	cache->hole.page = 0;
+	cache->hole.start = 0;
+	cache->hole.end = 0;
+	cache->holeOverflow = 0;
+	cache->body = 0;
 	if (limit > 0) {
 		cache->pagesLeft = limit / cache_page_size;
 		if (cache->pagesLeft < 1) {
@@ -577,6 +881,7 @@ jit_cache_t _jit_cache_create (long limit, long cache_page_size, int max_page_fa
 	cache->nil.start = 0;
 	cache->nil.end = 0;
 	cache->nil.debug = 0;
+	cache->nil.body = 0;
 	cache->nil.left = &(cache->nil);
 	cache->nil.right = &(cache->nil);
 	cache->head.method = 0;
@@ -584,6 +889,7 @@ jit_cache_t _jit_cache_create (long limit, long cache_page_size, int max_page_fa
 	cache->head.start = 0;
 	cache->head.end = 0;
 	cache->head.debug = 0;
+	cache->head.body = 0;
 	cache->head.left = 0;
 	cache->head.right = &(cache->nil);
 	cache->start = 0;
@@ -613,6 +919,9 @@ void _jit_cache_destroy (jit_cache_t cache){
 	if (cache->pages) {
 		jit_free(cache->pages);
 	}
+	if (cache->holes) {
+		jit_free(cache->holes);
+	}
 
         /* Free the cache object itself */
 	jit_free(cache);
@@ -637,31 +946,58 @@ int _jit_cache_start_method (jit_cache_t cache,
 			     int align,
 			     void *method){
 	unsigned char *ptr;
-
-        /* Do we need to allocate a new cache page? */
-	if (page_factor > 0) {
+	unsigned char *page;
+	unsigned char *limit;
+
+        /* Do we need to allocate a new cache page?  A method that did
+           not fit into a hole tries the current free region first */
+	if (cache->holeOverflow && cache->freeStart) {
+		page_factor = -1;
+	}else if (page_factor > 0) {
 		AllocCachePage(cache, page_factor);
 	}
+	cache->holeOverflow = 0;
 
-        /* Bail out if the cache is already full */
-	if (!cache->freeStart) {
-		return JIT_CACHE_TOO_BIG;
+        /* Set up the initial cache position.  The first attempt prefers
+           the space left by freed methods to the free region */
+	posn->cache = cache;
+	if (page_factor == 0 && TakeCacheHole(cache)) {
+		page = cache->hole.page;
+		posn->ptr = cache->hole.start;
+		posn->limit = cache->hole.end;
+	}else {
+                /* Bail out if the cache is already full */
+		if (!cache->freeStart) {
+			return JIT_CACHE_TOO_BIG;
+		}
+		page = cache->freePage;
+		posn->ptr = cache->freeStart;
+		posn->limit = cache->freeEnd;
 	}
 
-        /* Set up the initial cache position */
-	posn->cache = cache;
-	posn->ptr = cache->freeStart;
-	posn->limit = cache->freeEnd;
+        /* Allocate memory for the record of the space taken by the method */
+	ptr = posn->ptr;
+	limit = posn->limit;
+	cache->body = (jit_cache_body_t) _jit_cache_alloc(posn, sizeof(struct jit_cache_body));
+	if (!cache->body) {
+                /* There is insufficient space in this page */
+		goto restart;
+	}
+	cache->body->page = page;
+	cache->body->codeStart = ptr;
+	cache->body->codeEnd = 0;
+	cache->body->dataStart = 0;
+	cache->body->dataEnd = limit;
+	cache->body->freed = 0;
 
         /* Align the method start */
-	ptr = posn->ptr;
 	if (align > 1) {
 		ptr = (unsigned char *) (((jit_nuint) (ptr + align - 1)) & ~((jit_nuint) (align - 1)));
 	}
 	if (ptr >= posn->limit) {
                 /* There is insufficient space in this page */
 		posn->ptr = posn->limit;
-		return JIT_CACHE_RESTART;
+		goto restart;
 	}
 #ifdef jit_should_pad
 	if (ptr > posn->ptr) {
@@ -674,13 +1010,14 @@ int _jit_cache_start_method (jit_cache_t cache,
 	cache->method = (jit_cache_method_t) _jit_cache_alloc(posn, sizeof(struct jit_cache_method));
 	if (!cache->method) {
                 /* There is insufficient space in this page */
-		return JIT_CACHE_RESTART;
+		goto restart;
 	}
 	cache->method->method = method;
 	cache->method->cookie = 0;
 	cache->method->start = posn->ptr;
 	cache->method->end = posn->ptr;
 	cache->method->debug = 0;
+	cache->method->body = cache->body;
 	cache->method->left = 0;
 	cache->method->right = 0;
 
@@ -693,6 +1030,15 @@ int _jit_cache_start_method (jit_cache_t cache,
 	cache->lastDebug = 0;
 
 	return JIT_CACHE_OK;
+
+ restart:
+        /* Give the hole back, if we took one */
+	if (cache->hole.page) {
+		FreeCacheSpace(cache, cache->hole.page, cache->hole.start, cache->hole.end);
+		cache->hole.page = 0;
+	}
+	cache->body = 0;
+	return JIT_CACHE_RESTART;
 }
 
 int _jit_cache_end_method (jit_cache_posn *posn){
@@ -702,6 +1048,17 @@ int _jit_cache_end_method (jit_cache_posn *posn){
 
         /* Determine if we ran out of space while writing the method */
 	if (posn->ptr >= posn->limit) {
+		cache->body = 0;
+		cache->method = 0;
+
+                /* If we were writing to a hole, then give it back */
+		if (cache->hole.page) {
+			FreeCacheSpace(cache, cache->hole.page, cache->hole.start, cache->hole.end);
+			cache->hole.page = 0;
+			cache->holeOverflow = 1;
+			return JIT_CACHE_RESTART;
+		}
+
                 /* If we had a newly allocated page then it has to be freed
                    to let allocate another new page of appropriate size. */
 		if ((cache->freeStart == ((unsigned char *) (cache->pages[cache->numPages - 1].page)))
@@ -715,6 +1072,7 @@ int _jit_cache_end_method (jit_cache_posn *posn){
 			}
 			cache->freeStart = 0;
 			cache->freeEnd = 0;
+			cache->freePage = 0;
 		}
 		return JIT_CACHE_RESTART;
 	}
@@ -727,9 +1085,20 @@ int _jit_cache_end_method (jit_cache_posn *posn){
 		}
 	}
 
-        /* Flush the position information back to the cache */
-	cache->freeStart = posn->ptr;
-	cache->freeEnd = posn->limit;
+        /* Record the space taken by the method */
+	cache->body->codeEnd = posn->ptr;
+	cache->body->dataStart = posn->limit;
+	cache->body = 0;
+
+        /* Flush the position information back to the cache, or give
+           the rest of the hole back if the method was written to one */
+	if (cache->hole.page) {
+		FreeCacheSpace(cache, cache->hole.page, posn->ptr, posn->limit);
+		cache->hole.page = 0;
+	}else {
+		cache->freeStart = posn->ptr;
+		cache->freeEnd = posn->limit;
+	}
 
         /* Update the last method region block and then
            add all method regions to the lookup tree */
@@ -868,6 +1237,8 @@ void _jit_cache_new_region (jit_cache_posn *posn, void *cookie){
 	newMethod->cookie = cookie;
 	newMethod->start = posn->ptr;
 	newMethod->end = posn->ptr;
+	newMethod->debug = 0;
+	newMethod->body = method->body;
 
         /* Attach the new region to the cache */
 	newMethod->left = 0;
@@ -899,6 +1270,64 @@ void *_jit_cache_get_method (jit_cache_t cache, void *pc, void **cookie){
 	return 0;
 }
 
+unsigned long _jit_cache_free_methods (jit_cache_t cache, void **starts, unsigned long num){
+	jit_cache_body_t *bodies;
+	jit_cache_method_t node;
+	struct jit_cache_body body;
+	unsigned long numBodies;
+	unsigned long index;
+	unsigned long bytes;
+
+	bodies = (jit_cache_body_t *) jit_malloc((num + 1) * sizeof(jit_cache_body_t));
+	if (!bodies) {
+		return 0;
+	}
+
+        /* Mark the methods that start at the given addresses */
+	numBodies = 0;
+	for (index = 0; index < num; ++index) {
+		node = cache->head.right;
+		while (node != &(cache->nil)) {
+			if (((unsigned char *) (starts[index])) < node->start) {
+				node = GetLeft(node);
+			}else if (((unsigned char *) (starts[index])) >= node->end) {
+				node = GetRight(node);
+			}else {
+				break;
+			}
+		}
+		if (node != &(cache->nil) && node->start == (unsigned char *) (starts[index])
+		    && node->body && !node->body->freed) {
+			node->body->freed = 1;
+			bodies[numBodies++] = node->body;
+		}
+	}
+
+        /* Remove their region blocks from the lookup tree before their
+           space, which holds the blocks, can be reused */
+	if (numBodies == 0 || !RebuildLookupTree(cache)) {
+		for (index = 0; index < numBodies; ++index) {
+			bodies[index]->freed = 0;
+		}
+		jit_free(bodies);
+		return 0;
+	}
+
+        /* Give their space back.  The record of the space is copied out,
+           because it lives within the space it describes */
+	bytes = 0;
+	for (index = 0; index < numBodies; ++index) {
+		body = *(bodies[index]);
+		bytes += (unsigned long) (body.codeEnd - body.codeStart);
+		bytes += (unsigned long) (body.dataEnd - body.dataStart);
+		FreeCacheSpace(cache, body.page, body.codeStart, body.codeEnd);
+		FreeCacheSpace(cache, body.page, body.dataStart, body.dataEnd);
+	}
+	jit_free(bodies);
+
+	return bytes;
+}
+
 /*
  * Add a parent pointer to a list.  Returns null if out of memory.
  */
@@ -1211,8 +1640,14 @@ unsigned long _jit_cache_get_bytecode (jit_cache_t cache, void *start,
 }
 
 unsigned long _jit_cache_get_size (jit_cache_t cache){
-	return (cache->numPages * cache->pageSize) -
-	       (cache->freeEnd - cache->freeStart);
+	unsigned long size;
+	unsigned long page;
+
+	size = 0;
+	for (page = 0; page < cache->numPages; ++page) {
+		size += cache->pageSize * cache->pages[page].factor;
+	}
+	return size - (cache->freeEnd - cache->freeStart) - cache->holeBytes;
 }
 
 /*
@@ -1319,6 +1754,18 @@ unsigned long _jit_cache_get_size (jit_cache_t cache){
    lookups are used when walking the stack during exceptions or security
    processing.
 
+   The space taken by a method (i.e., its code and its auxillary data) is
+   recorded in a jit_cache_body block, so that it can be given back to the
+   cache by _jit_cache_free_methods.  The space given back becomes a hole
+   within its page; holes that border on each other are merged, holes that
+   border on the current free region are merged into it, and pages that
+   become empty are given back to the system, as is the rest of the free
+   region when a new page is allocated.  The first attempt to output a
+   method is made into the lowest hole of at least JIT_CACHE_MIN_HOLE bytes,
+   if any; a method that does not fit into it is output to the free region,
+   then to new pages.  Methods are not moved once they have been output, so
+   this is the only compaction the cache performs.
+
    Each method can also have offset information associated with it, to map
    between native code addresses and offsets within the original bytecode.
    This is typically used to support debugging.  Offset information is stored
@@ -1385,6 +1832,13 @@ unsigned long _jit_cache_get_size (jit_cache_t cache){
    to set a limit on how far it will grow.  Once the limit is reached, out
    of memory will be reported and there is no way to recover.
 
+   The exception is the code of recompilable functions that has been
+   replaced by a newer version: callers reach these functions through
+   their indirector, so the old code can only be running if a thread
+   was already within it when it was replaced.  jit-reclaim.c waits until
+   every thread has proved, by scanning its own stack, that it is not
+   within such code before freeing it with _jit_cache_free_methods.
+
  */
 
 #ifdef  __cplusplus
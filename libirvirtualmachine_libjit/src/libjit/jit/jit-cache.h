@@ -165,6 +165,15 @@ void *_jit_cache_get_start_method (jit_cache_t cache, void *pc);
  */
 void *_jit_cache_get_end_method (jit_cache_t cache, void *pc);
 
+/*
+ * Free the methods whose first region starts at one of the "num"
+ * addresses in "starts", and give their space back to the cache.
+ * The caller has to make sure that no thread is running, or is going
+ * to run, their code.  Addresses that are not the start of a method
+ * are ignored.  Returns the number of bytes given back.
+ */
+unsigned long _jit_cache_free_methods (jit_cache_t cache, void **starts, unsigned long num);
+
 /*
  * Get a list of all method that are presently in the cache.
  * The list is terminated by a NULL, and must be free'd with
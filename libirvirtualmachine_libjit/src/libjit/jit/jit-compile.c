@@ -683,6 +683,7 @@ compile (_jit_compile_t *state, jit_function_t func){
 int
 jit_compile (jit_function_t func){
 	_jit_compile_t state;
+	void *old_entry;
 	int result;
 
 	/* Bail out on invalid parameter */
@@ -702,10 +703,12 @@ jit_compile (jit_function_t func){
 	}
 
 	/* Compile and record the entry point */
+	old_entry = func->is_compiled ? func->entry_point : 0;
 	result = compile(&state, func);
 	if (result == JIT_RESULT_OK) {
 		func->entry_point = state.code_start;
 		func->is_compiled = 1;
+		_jit_function_retire_code(func, old_entry, func->entry_point);
 
 		/* Free the builder structure, which we no longer require */
 		_jit_function_free_builder(func);
@@ -769,14 +772,18 @@ jit_compile_entry (jit_function_t func, void **entry_point){
    @*/
 void
 jit_function_setup_entry (jit_function_t func, void *entry_point){
+	void *old_entry;
+
 	/* Bail out if we have nothing to do */
 	if (!func) {
 		return;
 	}
-	/* Record the entry point */
+	/* Record the entry point, and retire the code it replaces */
 	if (entry_point) {
+		old_entry = func->is_compiled ? func->entry_point : 0;
 		func->entry_point = entry_point;
 		func->is_compiled = 1;
+		_jit_function_retire_code(func, old_entry, entry_point);
 	}
 	_jit_function_free_builder(func);
 }
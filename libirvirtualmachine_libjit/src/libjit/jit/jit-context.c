@@ -86,6 +86,7 @@ jit_context_t jit_context_create (void){
 	/* Initialize the context and return it */
 	jit_mutex_create(&(context->builder_lock));
 	jit_mutex_create(&(context->cache_lock));
+	jit_mutex_create(&(context->reclaim_lock));
 	context->functions = 0;
 	context->last_function = 0;
 	context->on_demand_driver = _jit_function_compile_on_demand;
@@ -100,6 +101,7 @@ jit_context_t jit_context_create (void){
  * @end deftypefun
    @*/
 void jit_context_destroy (jit_context_t context){
+	jit_reclaim_thread_t thread;
 	int sym;
 
 	if (context) {
@@ -113,6 +115,15 @@ void jit_context_destroy (jit_context_t context){
 			jit_free(context->registered_symbols[sym]);
 		}
 		jit_free(context->registered_symbols);
+
+		/* The attached threads free their records when they exit */
+		jit_mutex_lock(&(context->reclaim_lock));
+		for (thread = context->reclaim_threads; thread; thread = thread->next) {
+			thread->context = 0;
+		}
+		jit_mutex_unlock(&(context->reclaim_lock));
+		jit_free(context->retired);
+		jit_mutex_destroy(&(context->reclaim_lock));
 		jit_mutex_destroy(&(context->cache_lock));
 		jit_mutex_destroy(&(context->builder_lock));
 		jit_free(context);
@@ -263,6 +274,20 @@ int jit_context_set_meta
  * A numeric option that forces generation of position-independent code (PIC)
  * if it is set to a non-zero value. This may be mainly useful for pre-compiled
  * contexts.
+ *
+ * @vindex JIT_OPTION_DONT_PEEPHOLE
+ * @item JIT_OPTION_DONT_PEEPHOLE
+ * A numeric option that disables the peephole optimization of the generated
+ * code when it is set to a non-zero value.  This is useful for debugging, and
+ * for measuring what the peephole optimizer saves.
+ *
+ * @vindex JIT_OPTION_RECLAIM_CODE
+ * @item JIT_OPTION_RECLAIM_CODE
+ * A numeric option that makes the code replaced by the recompilation of a
+ * recompilable function reclaimable by @code{jit_context_reclaim_code}, when
+ * it is set to a non-zero value.  Every thread that runs the compiled code of
+ * the context has to be attached to it with @code{jit_context_attach_thread}
+ * (@pxref{Reclaiming the code of recompiled functions}).
  * @end table
  *
  * Metadata type values of 10000 or greater are reserved for internal use.
@@ -38,6 +38,29 @@
 
    @*/
 
+/*
+ * Number of frames a new stack trace has room for.
+ */
+#define JIT_STACK_TRACE_INITIAL_SIZE    64
+
+/*
+ * Structure of a stack trace.  The stack trace of a thrown exception
+ * stops at the frame of its innermost catcher: "object" is the exception,
+ * "catcher" is the setjmp buffer the walk stopped at and "frame" is the
+ * frame to resume from if the exception leaves that catcher.  "frame" is
+ * NULL once the whole call stack has been taken.
+ */
+struct jit_stack_trace {
+	unsigned int size;
+	unsigned int capacity;
+	void                       *object;
+	struct jit_jmp_buf         *catcher;
+	void                       *frame;
+	void                       *items[1];
+};
+
+static int stack_trace_walk (jit_stack_trace_t *trace, void *resume, struct jit_jmp_buf *catcher);
+
 /*@
  * @deftypefun {void *} jit_exception_get_last (void)
  * Get the last exception object that occurred on this thread, or NULL
@@ -121,6 +144,15 @@ void jit_exception_throw (void *object){
 
 	if (control) {
 		control->last_exception = object;
+
+		/* Extend the stack trace of an exception that leaves the catcher its trace stops at */
+		if (control->stack_trace
+		    && control->stack_trace->object == object
+		    && control->stack_trace->frame
+		    && control->stack_trace->catcher != control->setjmp_head) {
+			control->stack_trace->catcher = control->setjmp_head;
+			stack_trace_walk(&(control->stack_trace), control->stack_trace->frame, control->setjmp_head);
+		}
 		if (control->setjmp_head) {
 			control->backtrace_head = control->setjmp_head->trace;
 			longjmp(control->setjmp_head->buf, 1);
@@ -276,12 +308,75 @@ jit_exception_func jit_exception_get_handler (void){
 }
 
 /*
- * Structure of a stack trace.
+ * Allocate an empty stack trace.
  */
-struct jit_stack_trace {
-	unsigned int size;
-	void                       *items[1];
-};
+static jit_stack_trace_t stack_trace_new (void *object){
+	jit_stack_trace_t trace;
+
+	trace = (jit_stack_trace_t) jit_malloc(sizeof(struct jit_stack_trace)
+					       + JIT_STACK_TRACE_INITIAL_SIZE * sizeof(void *)
+					       - sizeof(void *));
+	if (trace) {
+		trace->size = 0;
+		trace->capacity = JIT_STACK_TRACE_INITIAL_SIZE;
+		trace->object = object;
+		trace->catcher = 0;
+		trace->frame = 0;
+	}
+	return trace;
+}
+
+/*
+ * Append the current call stack to "*trace", growing it if needed.
+ * The frames below "resume" are skipped, because they are already in
+ * the trace.  If "catcher" is not NULL, the walk stops at the frame that
+ * holds it.  Returns zero and frees the trace if there is insufficient
+ * memory.
+ */
+static int stack_trace_walk (jit_stack_trace_t *trace, void *resume, struct jit_jmp_buf *catcher){
+	jit_stack_trace_t t;
+	jit_unwind_context_t unwind;
+	int more;
+
+	t = *trace;
+	t->frame = 0;
+	if (!jit_unwind_init(&unwind, NULL)) {
+		return 1;
+	}
+	more = 1;
+	while (more) {
+		if (!resume || (char *) (unwind.frame) >= (char *) resume) {
+			if (t->size == t->capacity) {
+				jit_stack_trace_t larger;
+				larger = (jit_stack_trace_t) jit_realloc(t, sizeof(struct jit_stack_trace)
+									 + 2 * t->capacity * sizeof(void *)
+									 - sizeof(void *));
+				if (!larger) {
+					jit_unwind_free(&unwind);
+					jit_free(t);
+					*trace = 0;
+					return 0;
+				}
+				t = larger;
+				*trace = t;
+				t->capacity *= 2;
+			}
+			t->items[t->size] = jit_unwind_get_pc(&unwind);
+			t->size++;
+			resume = 0;
+		}
+		more = jit_unwind_next_pc(&unwind);
+		if (more && !resume && catcher && (char *) (unwind.frame) > (char *) catcher) {
+
+			/* The caller holds the catcher: stop here until the exception leaves it */
+			t->frame = unwind.frame;
+			more = 0;
+		}
+	}
+	jit_unwind_free(&unwind);
+
+	return 1;
+}
 
 /*@
  * @deftypefun jit_stack_trace_t jit_exception_get_stack_trace (void)
@@ -293,41 +388,15 @@ struct jit_stack_trace {
    @*/
 jit_stack_trace_t jit_exception_get_stack_trace (void){
 	jit_stack_trace_t trace;
-	unsigned int size;
-	jit_unwind_context_t unwind;
 
-	/* Count the number of items in the current thread's call stack */
-	size = 0;
-	if (jit_unwind_init(&unwind, NULL)) {
-		do {
-			size++;
-		} while (jit_unwind_next_pc(&unwind));
-		jit_unwind_free(&unwind);
-	}
-
-	/* Bail out if the stack is not available */
-	if (size == 0) {
+	trace = stack_trace_new(0);
+	if (!trace) {
 		return 0;
 	}
-
-	/* Allocate memory for the stack trace */
-	trace = (jit_stack_trace_t) jit_malloc(sizeof(struct jit_stack_trace)
-					       + size * sizeof(void *)
-					       - sizeof(void *));
-	if (!trace) {
+	if (!stack_trace_walk(&trace, 0, 0)) {
 		return 0;
 	}
-	trace->size = size;
-
-	/* Populate the stack trace with the items we counted earlier */
-	size = 0;
-	if (jit_unwind_init(&unwind, NULL)) {
-		do {
-			trace->items[size] = jit_unwind_get_pc(&unwind);
-			size++;
-		} while (jit_unwind_next_pc(&unwind));
-		jit_unwind_free(&unwind);
-	}else {
+	if (trace->size == 0) {
 		jit_free(trace);
 		return 0;
 	}
@@ -335,6 +404,57 @@ jit_stack_trace_t jit_exception_get_stack_trace (void){
 	return trace;
 }
 
+/*@
+ * @deftypefun jit_stack_trace_t jit_exception_capture_stack_trace (void *@var{object})
+ * Start the stack trace of @var{object}, which the current thread is
+ * about to throw.  Only the frames up to the innermost catcher are
+ * taken: @code{jit_exception_throw} adds the following ones when
+ * @var{object} is rethrown out of that catcher.  An exception that is
+ * caught close to where it is thrown does not walk the rest of the
+ * call stack.
+ *
+ * The stack trace belongs to the current thread, which reuses its
+ * memory for the next capture.  It must not be freed.  Returns NULL if
+ * there is insufficient memory.
+ * @end deftypefun
+   @*/
+jit_stack_trace_t jit_exception_capture_stack_trace (void *object){
+	jit_thread_control_t control = _jit_thread_get_control();
+
+	if (!control) {
+		return 0;
+	}
+	if (!(control->stack_trace)) {
+		control->stack_trace = stack_trace_new(object);
+		if (!(control->stack_trace)) {
+			return 0;
+		}
+	}
+	control->stack_trace->size = 0;
+	control->stack_trace->object = object;
+	control->stack_trace->catcher = control->setjmp_head;
+	stack_trace_walk(&(control->stack_trace), 0, control->setjmp_head);
+
+	return control->stack_trace;
+}
+
+/*@
+ * @deftypefun jit_stack_trace_t jit_exception_get_thrown_stack_trace (void *@var{object})
+ * Get the stack trace of @var{object}, if it is the last exception
+ * whose stack trace has been captured by the current thread.  The
+ * stack trace covers the frames @var{object} has unwound so far.
+ * Returns NULL otherwise.  The stack trace must not be freed.
+ * @end deftypefun
+   @*/
+jit_stack_trace_t jit_exception_get_thrown_stack_trace (void *object){
+	jit_thread_control_t control = _jit_thread_get_control();
+
+	if (control && control->stack_trace && control->stack_trace->object == object) {
+		return control->stack_trace;
+	}
+	return 0;
+}
+
 /*@
  * @deftypefun {unsigned int} jit_stack_trace_get_size (jit_stack_trace_t @var{trace})
  * Get the size of a stack trace.
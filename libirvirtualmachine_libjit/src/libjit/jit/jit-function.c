@@ -652,6 +652,37 @@ jit_function_t jit_function_from_vtable_pointer (jit_context_t context, void *vt
 #endif
 }
 
+/*@
+ * @deftypefun {unsigned int} jit_function_get_code_size (jit_function_t @var{func})
+ * Get the size in bytes of the native code of @var{func}.  Returns zero
+ * if the function has not been compiled yet, or if its code is
+ * not in the cache of its context.
+ * @end deftypefun
+   @*/
+unsigned int jit_function_get_code_size (jit_function_t func){
+#ifdef JIT_BACKEND_INTERP
+	return 0;
+#else
+	jit_context_t context;
+	void *end;
+
+	if (!func || !(func->is_compiled) || !(func->entry_point)) {
+		return 0;
+	}
+	context = func->context;
+	if (!(context->cache)) {
+		return 0;
+	}
+	jit_mutex_lock(&(context->cache_lock));
+	end = _jit_cache_get_end_method(context->cache, func->entry_point);
+	jit_mutex_unlock(&(context->cache_lock));
+	if (!end) {
+		return 0;
+	}
+	return (unsigned int) (((unsigned char *) end) - ((unsigned char *) (func->entry_point)));
+#endif
+}
+
 /*@
  * @deftypefun void jit_function_set_on_demand_compiler (jit_function_t @var{func}, jit_on_demand_func @var{on_demand})
  * Specify the C function to be called when @var{func} needs to be
@@ -225,6 +225,9 @@ struct _jit_block {
 	/* Metadata */
 	jit_meta_t meta;
 
+	/* Position in the linear block list, set by the global register allocator */
+	int index;
+
 	/* Code generation data */
 	void                    *address;
 	void                    *fixup_list;
@@ -504,6 +507,45 @@ struct jit_regsym {
 	char name[1];
 };
 
+/*
+ * Code of a replaced version of a recompilable function, which is
+ * waiting for every thread to leave it before it is freed.
+ */
+typedef struct jit_retired_code *jit_retired_code_t;
+struct jit_retired_code {
+	unsigned char           *start;         /* Entry point of the code */
+	unsigned char           *end;           /* End of the code */
+	unsigned long epoch;                    /* Epoch at which it was last seen */
+};
+
+/*
+ * Thread attached to a context for the reclamation of replaced code.
+ * The record is owned by the thread, and linked both to the list of
+ * the context and to the list of the thread.
+ */
+typedef struct jit_reclaim_thread *jit_reclaim_thread_t;
+struct jit_reclaim_thread {
+	jit_context_t context;                  /* Context, or NULL once it is destroyed */
+	unsigned long epoch;                    /* Epoch of the last check-in */
+	int attached;                           /* Non-zero if it may be running code */
+	int blocked;                            /* Non-zero within a blocking region */
+	void                    **stack_top;    /* Lowest stack address of a blocking region */
+	void                    **stack_base;   /* Stack address above every frame of compiled code */
+	jit_reclaim_thread_t next;              /* Next thread attached to the context */
+	jit_reclaim_thread_t next_context;      /* Next context of the thread */
+};
+
+/*
+ * Detach the current thread from every context, because it is exiting.
+ */
+void _jit_reclaim_thread_exit (jit_reclaim_thread_t threads);
+
+/*
+ * Retire the code of a recompilable function that has been replaced
+ * by "new_entry", if JIT_OPTION_RECLAIM_CODE is set for its context.
+ */
+void _jit_function_retire_code (jit_function_t func, void *old_entry, void *new_entry);
+
 /*
  * Internal structure of a context.
  */
@@ -537,6 +579,16 @@ struct _jit_context {
 
 	/* On-demand compilation driver */
 	jit_on_demand_driver_func on_demand_driver;
+
+	/* Replaced code of recompilable functions, sorted by address,
+	   and the threads that may be running it (see jit-reclaim.c) */
+	jit_mutex_t reclaim_lock;
+	unsigned long reclaim_epoch;
+	int reclaim_disabled;
+	jit_retired_code_t retired;
+	unsigned int num_retired;
+	unsigned int max_retired;
+	jit_reclaim_thread_t reclaim_threads;
 };
 
 /*
@@ -575,6 +627,8 @@ struct jit_thread_control {
 	jit_exception_func exception_handler;
 	jit_backtrace_t backtrace_head;
 	struct jit_jmp_buf      *setjmp_head;
+	jit_reclaim_thread_t reclaim_threads;
+	jit_stack_trace_t stack_trace;
 };
 
 /*
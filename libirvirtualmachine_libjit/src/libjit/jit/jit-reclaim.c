@@ -0,0 +1,526 @@
+/*
+ * jit-reclaim.c - Reclamation of the replaced code of recompiled functions.
+ *
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This file is part of the libjit library.
+ *
+ * The libjit library is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation, either version 2.1 of
+ * the License, or (at your option) any later version.
+ *
+ * The libjit library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with the libjit library.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include "jit-internal.h"
+#include "jit-cache.h"
+
+/*@
+
+   @section Reclaiming the code of recompiled functions
+   @cindex jit-context.h
+
+   Every time a recompilable function is compiled again, its new code
+   replaces the old one, which stays in the function cache.  Programs that
+   recompile their functions for as long as they run (e.g., to apply more
+   optimizations to the hottest ones) can ask @code{libjit} to give the
+   space of the replaced code back to the cache, by setting the
+   @code{JIT_OPTION_RECLAIM_CODE} option of the context.
+
+   The callers of recompilable functions always go through their
+   indirector, so the replaced code is only run by the threads that were
+   already within it when it was replaced.  Reclamation uses epochs to find
+   out when no thread can be within it anymore:
+
+   @itemize @bullet
+   @item
+   Every thread that runs compiled code of the context is attached to it
+   with @code{jit_context_attach_thread}.  Threads that enter compiled
+   code without being attached first (e.g., native threads calling back
+   into the program) are attached with their whole stack the first time
+   they check in.
+   @item
+   Replaced code is tagged with the current epoch of the context, which
+   is then advanced.
+   @item
+   Attached threads check in from time to time with
+   @code{jit_context_checkpoint}.  A check-in scans the stack of the
+   thread for return addresses within replaced code: the code found is
+   tagged with the current epoch again, and the other code is known to be
+   left by the thread.
+   @item
+   @code{jit_context_reclaim_code} frees the replaced code whose epoch is
+   older than the last check-in of every attached thread.
+   @end itemize
+
+   Threads that wait for something (e.g., a lock, or the compilation of a
+   function) for a long time would prevent the reclamation; they enter a
+   blocking region instead, during which their stack is scanned on their
+   behalf by @code{jit_context_reclaim_code}.
+
+   Stack traces that are kept after the code they refer to has been freed
+   may be resolved to the wrong function.  Programs that map code
+   addresses to their own data are told about the code that is going to
+   be freed through the callback given to
+   @code{jit_context_reclaim_code}.
+
+   @*/
+
+/*
+ * Find the record of the current thread for a context.
+ */
+static jit_reclaim_thread_t
+current_thread (jit_context_t context){
+	jit_thread_control_t control;
+	jit_reclaim_thread_t thread;
+
+	control = _jit_thread_get_control();
+	if (!control) {
+		return 0;
+	}
+	for (thread = control->reclaim_threads; thread; thread = thread->next_context) {
+		if (thread->context == context) {
+			return thread;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Find the base of the stack of the current thread, for threads that are
+ * attached while they may already be running compiled code.  Returns
+ * NULL if it cannot be found.
+ */
+static void **
+current_stack_base (void){
+#if defined(JIT_THREADS_PTHREAD) && defined(HAVE_PTHREAD_GETATTR_NP)
+	pthread_attr_t attr;
+	void *stack;
+	size_t size;
+
+	if (pthread_getattr_np(pthread_self(), &attr) != 0) {
+		return 0;
+	}
+	if (pthread_attr_getstack(&attr, &stack, &size) != 0) {
+		stack = 0;
+	}
+	pthread_attr_destroy(&attr);
+	if (!stack) {
+		return 0;
+	}
+	return (void **) ((unsigned char *) stack + size);
+#else
+	return 0;
+#endif
+}
+
+/*
+ * Find the last replaced code that starts at or before "pc".
+ * Returns -1 if there is no such code.
+ */
+static long
+find_retired_code (jit_context_t context, unsigned char *pc){
+	long low, high, middle;
+
+	low = 0;
+	high = (long) (context->num_retired) - 1;
+	while (low <= high) {
+		middle = (low + high) / 2;
+		if (context->retired[middle].start <= pc) {
+			low = middle + 1;
+		}else {
+			high = middle - 1;
+		}
+	}
+	return high;
+}
+
+/*
+ * Check in a thread whose stack, from "stack_top" to its base, does not
+ * change while the reclamation lock is held.  Every word of the stack is
+ * taken as a possible return address, so frames are found even within
+ * code that has been compiled without frame pointers.
+ */
+static void
+check_in (jit_context_t context, jit_reclaim_thread_t thread, void **stack_top){
+	unsigned long epoch;
+	unsigned char *low;
+	unsigned char *high;
+	unsigned char *pc;
+	void **word;
+	long index;
+	int pinned;
+
+	epoch = context->reclaim_epoch;
+	if (context->num_retired > 0) {
+		/* We cannot vouch for a thread whose stack bounds are wrong */
+		if (stack_top > thread->stack_base) {
+			return;
+		}
+
+		/* Tag the replaced code that the thread may return to */
+		low = context->retired[0].start;
+		high = context->retired[context->num_retired - 1].end;
+		pinned = 0;
+		for (word = stack_top; word < thread->stack_base; ++word) {
+			pc = (unsigned char *) (*word);
+			if (pc < low || pc > high) {
+				continue;
+			}
+			index = find_retired_code(context, pc);
+			if (index >= 0 && pc <= context->retired[index].end) {
+				context->retired[index].epoch = epoch;
+				pinned = 1;
+			}
+		}
+
+		/* The tagged code has to survive until the thread checks in
+		   again, which happens at a newer epoch */
+		if (pinned) {
+			context->reclaim_epoch = epoch + 1;
+		}
+	}
+	thread->epoch = epoch;
+}
+
+/*@
+ * @deftypefun int jit_context_attach_thread (jit_context_t @var{context}, void *@var{stack_base})
+ * Attach the current thread to @var{context}, before it runs its compiled
+ * code.  Every frame of compiled code that the thread runs until it is
+ * detached has to be below @var{stack_base}: the address of a local
+ * variable of the function that calls the compiled code is fine.  Returns
+ * zero if the thread was already attached, in which case nothing is done.
+ *
+ * If @var{stack_base} is NULL, the thread may be running compiled code
+ * already: the whole stack of the thread is scanned, now and at every
+ * check-in.  Reclamation is turned off if the stack of the thread cannot
+ * be found.
+ *
+ * Threads have to be attached only when @code{JIT_OPTION_RECLAIM_CODE} is
+ * set for @var{context}.
+ * @end deftypefun
+   @*/
+int
+jit_context_attach_thread (jit_context_t context, void *stack_base){
+	jit_thread_control_t control;
+	jit_reclaim_thread_t thread;
+	void *stack_top;
+	int running;
+
+	thread = current_thread(context);
+	if (thread && thread->attached) {
+		return 0;
+	}
+	running = !stack_base;
+	if (running) {
+		stack_base = current_stack_base();
+	}
+
+	jit_mutex_lock(&(context->reclaim_lock));
+	if (!stack_base) {
+		/* We cannot know which code this thread runs */
+		context->reclaim_disabled = 1;
+	}
+	if (!thread) {
+		control = _jit_thread_get_control();
+		thread = jit_cnew(struct jit_reclaim_thread);
+		if (!control || !thread) {
+			/* We cannot know which code this thread runs anymore */
+			jit_free(thread);
+			context->reclaim_disabled = 1;
+			jit_mutex_unlock(&(context->reclaim_lock));
+			return 1;
+		}
+		thread->context = context;
+		thread->next = context->reclaim_threads;
+		context->reclaim_threads = thread;
+		thread->next_context = control->reclaim_threads;
+		control->reclaim_threads = thread;
+	}
+	thread->attached = 1;
+	thread->blocked = 0;
+	thread->stack_base = (void **) stack_base;
+	thread->epoch = context->reclaim_epoch;
+	if (running && stack_base) {
+		check_in(context, thread, &stack_top);
+	}
+	jit_mutex_unlock(&(context->reclaim_lock));
+
+	return 1;
+}
+
+/*@
+ * @deftypefun void jit_context_detach_thread (jit_context_t @var{context})
+ * Detach the current thread from @var{context}, once it does not run its
+ * compiled code anymore.  Threads are detached from every context when
+ * they exit.
+ * @end deftypefun
+   @*/
+void
+jit_context_detach_thread (jit_context_t context){
+	jit_reclaim_thread_t thread;
+
+	thread = current_thread(context);
+	if (!thread || !thread->attached) {
+		return;
+	}
+	jit_mutex_lock(&(context->reclaim_lock));
+	thread->attached = 0;
+	thread->blocked = 0;
+	jit_mutex_unlock(&(context->reclaim_lock));
+}
+
+/*@
+ * @deftypefun void jit_context_checkpoint (jit_context_t @var{context})
+ * Check in the current thread, so that the replaced code it is not
+ * within anymore can be reclaimed.  It only costs a comparison if no code
+ * has been replaced since the last check-in of the thread.
+ *
+ * A thread that has never been attached to @var{context} is attached
+ * with its whole stack, as it may have entered compiled code without
+ * going through the program's own entry points.
+ * @end deftypefun
+   @*/
+void
+jit_context_checkpoint (jit_context_t context){
+	jit_reclaim_thread_t thread;
+	void *stack_top;
+
+	thread = current_thread(context);
+	if (!thread) {
+		jit_context_attach_thread(context, 0);
+		return;
+	}
+	if (!thread->attached || thread->blocked) {
+		return;
+	}
+	if (thread->epoch == context->reclaim_epoch) {
+		return;
+	}
+	jit_mutex_lock(&(context->reclaim_lock));
+	check_in(context, thread, &stack_top);
+	jit_mutex_unlock(&(context->reclaim_lock));
+}
+
+/*@
+ * @deftypefun void jit_context_enter_blocking (jit_context_t @var{context})
+ * Enter a blocking region, before the current thread waits for something.
+ * The thread must not run compiled code of @var{context} until it leaves
+ * the region with @code{jit_context_leave_blocking}, so that its stack can
+ * be scanned on its behalf.
+ * @end deftypefun
+   @*/
+void
+jit_context_enter_blocking (jit_context_t context){
+	jit_reclaim_thread_t thread;
+	void *stack_top;
+
+	thread = current_thread(context);
+	if (!thread || !thread->attached || thread->blocked) {
+		return;
+	}
+	jit_mutex_lock(&(context->reclaim_lock));
+	thread->stack_top = &stack_top;
+	thread->blocked = 1;
+	check_in(context, thread, thread->stack_top);
+	jit_mutex_unlock(&(context->reclaim_lock));
+}
+
+/*@
+ * @deftypefun int jit_context_leave_blocking (jit_context_t @var{context})
+ * Leave the blocking region of the current thread.  Returns zero if the
+ * thread was not within a blocking region.
+ * @end deftypefun
+   @*/
+int
+jit_context_leave_blocking (jit_context_t context){
+	jit_reclaim_thread_t thread;
+
+	thread = current_thread(context);
+	if (!thread || !thread->blocked) {
+		return 0;
+	}
+	jit_mutex_lock(&(context->reclaim_lock));
+	thread->blocked = 0;
+	jit_mutex_unlock(&(context->reclaim_lock));
+	return 1;
+}
+
+/*@
+ * @deftypefun {unsigned long} jit_context_reclaim_code (jit_context_t @var{context}, jit_reclaim_func @var{reclaimed}, void *@var{data})
+ * Free the replaced code of the recompilable functions of @var{context}
+ * that no attached thread can be running, and give its space back to the
+ * function cache.  Returns the number of bytes given back.
+ *
+ * If @var{reclaimed} is not NULL, it is called with the start of every
+ * piece of code and @var{data} before the space of the code can be used
+ * by new functions.  It must not call the functions of this section.
+ * @end deftypefun
+   @*/
+unsigned long
+jit_context_reclaim_code (jit_context_t context, jit_reclaim_func reclaimed, void *data){
+	jit_reclaim_thread_t thread;
+	unsigned long epoch;
+	unsigned long bytes;
+	unsigned int num;
+	unsigned int kept;
+	unsigned int index;
+	void **starts;
+
+	jit_mutex_lock(&(context->reclaim_lock));
+	if (context->num_retired == 0 || context->reclaim_disabled) {
+		jit_mutex_unlock(&(context->reclaim_lock));
+		return 0;
+	}
+
+	/* Check in the threads within blocking regions on their behalf,
+	   then find the oldest check-in */
+	for (thread = context->reclaim_threads; thread; thread = thread->next) {
+		if (thread->attached && thread->blocked) {
+			check_in(context, thread, thread->stack_top);
+		}
+	}
+	epoch = context->reclaim_epoch;
+	for (thread = context->reclaim_threads; thread; thread = thread->next) {
+		if (thread->attached && thread->epoch < epoch) {
+			epoch = thread->epoch;
+		}
+	}
+
+	/* Take the code that every thread has left out of the list */
+	num = 0;
+	for (index = 0; index < context->num_retired; ++index) {
+		if (context->retired[index].epoch < epoch) {
+			++num;
+		}
+	}
+	if (num == 0) {
+		jit_mutex_unlock(&(context->reclaim_lock));
+		return 0;
+	}
+	starts = (void **) jit_malloc(num * sizeof(void *));
+	if (!starts) {
+		jit_mutex_unlock(&(context->reclaim_lock));
+		return 0;
+	}
+	num = 0;
+	kept = 0;
+	for (index = 0; index < context->num_retired; ++index) {
+		if (context->retired[index].epoch < epoch) {
+			starts[num++] = context->retired[index].start;
+		}else {
+			context->retired[kept++] = context->retired[index];
+		}
+	}
+	context->num_retired = kept;
+
+	/* Let the program forget the code before its space can be reused */
+	if (reclaimed) {
+		for (index = 0; index < num; ++index) {
+			(*reclaimed)(starts[index], data);
+		}
+	}
+
+	/* Give its space back to the cache */
+	jit_mutex_lock(&(context->cache_lock));
+	bytes = _jit_cache_free_methods(context->cache, starts, num);
+	jit_mutex_unlock(&(context->cache_lock));
+	jit_mutex_unlock(&(context->reclaim_lock));
+	jit_free(starts);
+
+	return bytes;
+}
+
+void
+_jit_function_retire_code (jit_function_t func, void *old_entry, void *new_entry){
+#ifndef JIT_BACKEND_INTERP
+	jit_context_t context = func->context;
+	jit_retired_code_t list;
+	unsigned char *end;
+	unsigned int num;
+	long index;
+
+	if (!old_entry || old_entry == new_entry || !func->is_recompilable) {
+		return;
+	}
+	if (!jit_context_get_meta_numeric(context, JIT_OPTION_RECLAIM_CODE)) {
+		return;
+	}
+
+	jit_mutex_lock(&(context->reclaim_lock));
+	if (context->reclaim_disabled) {
+		jit_mutex_unlock(&(context->reclaim_lock));
+		return;
+	}
+
+	/* Find the end of the replaced code */
+	end = 0;
+	jit_mutex_lock(&(context->cache_lock));
+	if (context->cache && _jit_cache_get_start_method(context->cache, old_entry) == old_entry) {
+		end = (unsigned char *) _jit_cache_get_end_method(context->cache, old_entry);
+	}
+	jit_mutex_unlock(&(context->cache_lock));
+
+	/* Insert it into the sorted list, unless it is already there.  If we
+	   are out of memory, then the code is simply never freed */
+	index = find_retired_code(context, (unsigned char *) old_entry);
+	if (!end || (index >= 0 && context->retired[index].start == (unsigned char *) old_entry)) {
+		jit_mutex_unlock(&(context->reclaim_lock));
+		return;
+	}
+	if (context->num_retired == context->max_retired) {
+		num = (context->max_retired == 0) ? 16 : context->max_retired * 2;
+		list = (jit_retired_code_t) jit_realloc(context->retired, num * sizeof(struct jit_retired_code));
+		if (!list) {
+			jit_mutex_unlock(&(context->reclaim_lock));
+			return;
+		}
+		context->retired = list;
+		context->max_retired = num;
+	}
+	++index;
+	jit_memmove(context->retired + index + 1, context->retired + index,
+		    (context->num_retired - (unsigned int) index) * sizeof(struct jit_retired_code));
+	context->retired[index].start = (unsigned char *) old_entry;
+	context->retired[index].end = end;
+	context->retired[index].epoch = context->reclaim_epoch;
+	++(context->num_retired);
+	++(context->reclaim_epoch);
+	jit_mutex_unlock(&(context->reclaim_lock));
+#endif
+}
+
+void
+_jit_reclaim_thread_exit (jit_reclaim_thread_t threads){
+	jit_reclaim_thread_t next;
+	jit_reclaim_thread_t *link;
+	jit_context_t context;
+
+	while (threads) {
+		next = threads->next_context;
+		context = threads->context;
+		if (context) {
+			jit_mutex_lock(&(context->reclaim_lock));
+			for (link = &(context->reclaim_threads); *link; link = &((*link)->next)) {
+				if (*link == threads) {
+					*link = threads->next;
+					break;
+				}
+			}
+			jit_mutex_unlock(&(context->reclaim_lock));
+		}
+		jit_free(threads);
+		threads = next;
+	}
+}
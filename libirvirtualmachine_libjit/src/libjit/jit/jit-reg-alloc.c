@@ -22,8 +22,10 @@
 
 #include "jit-internal.h"
 #include "jit-reg-alloc.h"
+#include "jit-bitset.h"
 #include <jit/jit-dump.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 /*@
@@ -45,6 +47,19 @@
  */
 #define JIT_MIN_USED            3
 
+/*
+ * Weight of a use within a loop is multiplied by this factor for
+ * every level of loop nesting, up to JIT_MAX_LOOP_DEPTH levels.
+ */
+#define JIT_LOOP_WEIGHT         8
+#define JIT_MAX_LOOP_DEPTH      5
+
+/*
+ * Maximum number of bits of the liveness sets (blocks times candidates)
+ * the linear scan allocator builds; larger functions use the fast tier.
+ */
+#define JIT_MAX_LIVENESS_BITS   (1 << 24)
+
 /*
  * Use is_register_occupied() function.
  */
@@ -90,7 +105,6 @@
 #define CLOBBER_OTHER_REG       4
 
 #ifdef JIT_REG_DEBUG
-#include <stdlib.h>
 
 static void dump_regs (jit_gencode_t gen, const char *name){
 	int reg, index;
@@ -2169,42 +2183,55 @@ _jit_regs_lookup (char *name){
 	return -1;
 }
 
-/*@
- * @deftypefun void _jit_regs_alloc_global (jit_gencode_t gen, jit_function_t func)
- * Perform global register allocation on the values in @code{func}.
- * This is called during function compilation just after variable
- * liveness has been computed.
- * @end deftypefun
-   @*/
-void _jit_regs_alloc_global (jit_gencode_t gen, jit_function_t func){
 #if JIT_NUM_GLOBAL_REGS != 0
+/*
+ * Live interval of a global register candidate.  Intervals are made of
+ * whole blocks of the linear block list: the local allocator writes
+ * values back to their global registers up to the end of a block, so
+ * two candidates may share a global register only if no block holds both.
+ */
+typedef struct {
+	jit_value_t value;
+	int start;
+	int end;
+	unsigned long weight;
+	int reg;
+} _jit_live_interval_t;
+
+/*
+ * Check if a value is worth a global register.
+ */
+static int
+is_global_candidate (jit_value_t value){
+	return value->global_candidate && value->usage_count >= JIT_MIN_USED
+	       && !(value->is_addressable) && !(value->is_volatile);
+}
+
+/*
+ * Assign a global register to a value for the whole function.
+ */
+static void
+set_global_register (jit_gencode_t gen, jit_value_t value, int reg){
+	value->has_global_register = 1;
+	value->in_global_register = 1;
+	value->global_reg = (short) reg;
+	jit_reg_set_used(gen->touched, reg);
+	jit_reg_set_used(gen->permanent, reg);
+}
+
+/*
+ * Allocate the global registers to the most used candidates.  This is
+ * the fast tier, used when the control flow graph is not available.
+ */
+static void
+alloc_global_by_usage (jit_gencode_t gen, jit_function_t func){
 	jit_value_t candidates[JIT_NUM_GLOBAL_REGS];
 	int num_candidates = 0;
 	int index, reg, posn, num;
 	jit_pool_block_t block;
 	jit_value_t value, temp;
 
-	/* If the function has a "try" block, then don't do global allocation
-	   as the "longjmp" for exception throws will wipe out global registers */
-	if (func->has_try) {
-		return;
-	}
-
-	/* If the current function involves a tail call, then we don't do
-	   global register allocation and we also prevent the code generator
-	   from using any of the callee-saved registers.  This simplifies
-	   tail calls, which don't have to worry about restoring such registers */
-	if (func->builder->has_tail_call) {
-		for (reg = 0; reg < JIT_NUM_REGS; ++reg) {
-			if ((jit_reg_flags(reg) & (JIT_REG_FIXED|JIT_REG_CALL_USED)) == 0) {
-				jit_reg_set_used(gen->permanent, reg);
-			}
-		}
-		return;
-	}
-
-	/* Scan all values within the function, looking for the most used.
-	   We will replace this with a better allocation strategy later */
+	/* Scan all values within the function, looking for the most used */
 	block = func->builder->value_pool.blocks;
 	num = (int) (func->builder->value_pool.elems_per_block);
 	while (block != 0) {
@@ -2213,8 +2240,7 @@ void _jit_regs_alloc_global (jit_gencode_t gen, jit_function_t func){
 		}
 		for (posn = 0; posn < num; ++posn) {
 			value = (jit_value_t) (block->data + posn * sizeof(struct _jit_value));
-			if (value->global_candidate && value->usage_count >= JIT_MIN_USED &&
-			    !(value->is_addressable) && !(value->is_volatile)) {
+			if (is_global_candidate(value)) {
 				/* Insert this candidate into the list, ordered on count */
 				index = 0;
 				while (index < num_candidates &&
@@ -2243,14 +2269,420 @@ void _jit_regs_alloc_global (jit_gencode_t gen, jit_function_t func){
 		while (reg >= 0 && (jit_reg_flags(reg) & JIT_REG_GLOBAL) == 0) {
 			--reg;
 		}
-		candidates[index]->has_global_register = 1;
-		candidates[index]->in_global_register = 1;
-		candidates[index]->global_reg = (short) reg;
-		jit_reg_set_used(gen->touched, reg);
-		jit_reg_set_used(gen->permanent, reg);
+		set_global_register(gen, candidates[index], reg);
 		--reg;
 	}
+}
+
+/*
+ * Get the live interval of an instruction operand, or NULL if the
+ * operand is not a global register candidate.
+ */
+static _jit_live_interval_t *
+get_live_interval (_jit_live_interval_t *intervals, int num_intervals, jit_value_t value){
+	if (!value || value->is_constant || value->index < 0 || value->index >= num_intervals) {
+		return 0;
+	}
+	if (intervals[value->index].value != value) {
+		return 0;
+	}
+	return &(intervals[value->index]);
+}
+
+/*
+ * Compute the loop nesting depth of every block.  An edge is a back edge
+ * if its destination is not before its source in the postorder.  The loop
+ * of a header holds the blocks that reach the source of one of its back
+ * edges without going through the header.
+ */
+static int
+compute_loop_depths (jit_function_t func, int num_blocks, int *depths){
+	jit_block_t *order = func->builder->block_order;
+	jit_block_t header, block, pred;
+	int *post, *marks;
+	jit_block_t *stack;
+	int index, edge, top, is_header;
+
+	post = (int *) jit_malloc(2 * num_blocks * sizeof(int));
+	stack = (jit_block_t *) jit_malloc(num_blocks * sizeof(jit_block_t));
+	if (!post || !stack) {
+		jit_free(post);
+		jit_free(stack);
+		return 0;
+	}
+	marks = post + num_blocks;
+	for (index = 0; index < num_blocks; ++index) {
+		post[order[index]->index] = index;
+		marks[index] = -1;
+		depths[index] = 0;
+	}
+
+	for (index = 0; index < num_blocks; ++index) {
+		header = order[index];
+		is_header = 0;
+		for (edge = 0; edge < header->num_preds; ++edge) {
+			if (post[header->preds[edge]->src->index] <= index) {
+				is_header = 1;
+			}
+		}
+		if (!is_header) {
+			continue;
+		}
+
+		/* Walk backwards from the sources of the back edges */
+		marks[header->index] = index;
+		++(depths[header->index]);
+		top = 0;
+		for (edge = 0; edge < header->num_preds; ++edge) {
+			pred = header->preds[edge]->src;
+			if (post[pred->index] <= index && marks[pred->index] != index) {
+				marks[pred->index] = index;
+				stack[top++] = pred;
+			}
+		}
+		while (top > 0) {
+			block = stack[--top];
+			++(depths[block->index]);
+			for (edge = 0; edge < block->num_preds; ++edge) {
+				pred = block->preds[edge]->src;
+				if (marks[pred->index] != index) {
+					marks[pred->index] = index;
+					stack[top++] = pred;
+				}
+			}
+		}
+	}
+
+	jit_free(post);
+	jit_free(stack);
+	return 1;
+}
+
+/*
+ * Order live intervals by their first block.
+ */
+static int
+compare_live_intervals (const void *first, const void *second){
+	const _jit_live_interval_t *interval1 = *((const _jit_live_interval_t **) first);
+	const _jit_live_interval_t *interval2 = *((const _jit_live_interval_t **) second);
+
+	if (interval1->start != interval2->start) {
+		return interval1->start - interval2->start;
+	}
+	if (interval1->weight != interval2->weight) {
+		return (interval1->weight > interval2->weight) ? -1 : 1;
+	}
+	return 0;
+}
+
+/*
+ * Allocate the global registers with a linear scan over the live
+ * intervals of the candidates.  Every use and definition of a candidate
+ * weighs JIT_LOOP_WEIGHT times more for every loop around it, and when
+ * the registers run out the interval with the least weight stays in the
+ * frame; so induction variables and array bases of inner loops win over
+ * values that are used often outside them.  Returns zero if the function
+ * should be handled by the fast tier instead.
+ */
+static int
+alloc_global_linear_scan (jit_gencode_t gen, jit_function_t func){
+	_jit_live_interval_t *intervals, *interval;
+	_jit_live_interval_t **sorted;
+	_jit_live_interval_t *active[JIT_NUM_GLOBAL_REGS];
+	int regs[JIT_NUM_GLOBAL_REGS];
+	char free_regs[JIT_NUM_GLOBAL_REGS];
+	_jit_bitset_t *sets, *use, *def, *live_in, *live_out, *temp;
+	int *depths;
+	int num_blocks, num_intervals, num_sorted, num_regs, num_active;
+	int index, posn, num, reg, edge, changed, result, victim;
+	unsigned long weight;
+	jit_pool_block_t pool_block;
+	jit_block_t block;
+	jit_insn_iter_t iter;
+	jit_insn_t insn;
+	jit_value_t value;
+	int flags;
+
+	/* Number the blocks in the order the code is generated.  Every block
+	   has to be in the control flow graph built by the optimizer */
+	num_blocks = 0;
+	block = 0;
+	while ((block = jit_block_next(func, block)) != 0) {
+		block->index = num_blocks++;
+	}
+	if (num_blocks != func->builder->num_block_order) {
+		return 0;
+	}
+
+	/* Count the candidates */
+	num_intervals = 0;
+	pool_block = func->builder->value_pool.blocks;
+	num = (int) (func->builder->value_pool.elems_per_block);
+	while (pool_block != 0) {
+		if (!(pool_block->next)) {
+			num = (int) (func->builder->value_pool.elems_in_last);
+		}
+		for (posn = 0; posn < num; ++posn) {
+			value = (jit_value_t) (pool_block->data + posn * sizeof(struct _jit_value));
+			if (is_global_candidate(value)) {
+				++num_intervals;
+			}
+		}
+		pool_block = pool_block->next;
+	}
+	if (num_intervals == 0) {
+		return 1;
+	}
+	if (num_intervals > JIT_MAX_LIVENESS_BITS / num_blocks) {
+		return 0;
+	}
+
+	/* Make an interval for every candidate */
+	result = 0;
+	intervals = (_jit_live_interval_t *) jit_calloc(num_intervals, sizeof(_jit_live_interval_t));
+	sorted = (_jit_live_interval_t **) jit_malloc(num_intervals * sizeof(_jit_live_interval_t *));
+	depths = (int *) jit_malloc(num_blocks * sizeof(int));
+	sets = (_jit_bitset_t *) jit_calloc(4 * num_blocks + 1, sizeof(_jit_bitset_t));
+	if (!intervals || !sorted || !depths || !sets) {
+		jit_free(intervals);
+		jit_free(sorted);
+		jit_free(depths);
+		jit_free(sets);
+		return 0;
+	}
+	index = 0;
+	pool_block = func->builder->value_pool.blocks;
+	num = (int) (func->builder->value_pool.elems_per_block);
+	while (pool_block != 0) {
+		if (!(pool_block->next)) {
+			num = (int) (func->builder->value_pool.elems_in_last);
+		}
+		for (posn = 0; posn < num; ++posn) {
+			value = (jit_value_t) (pool_block->data + posn * sizeof(struct _jit_value));
+			if (is_global_candidate(value)) {
+				intervals[index].value = value;
+				intervals[index].start = num_blocks;
+				intervals[index].end = -1;
+				intervals[index].reg = -1;
+				value->index = index++;
+			}
+		}
+		pool_block = pool_block->next;
+	}
+
+	/* Allocate the liveness sets of the blocks */
+	use = sets;
+	def = sets + num_blocks;
+	live_in = sets + 2 * num_blocks;
+	live_out = sets + 3 * num_blocks;
+	temp = sets + 4 * num_blocks;
+	for (index = 0; index <= 4 * num_blocks; ++index) {
+		if (!_jit_bitset_allocate(&(sets[index]), num_intervals)) {
+			goto cleanup;
+		}
+	}
+
+	if (!compute_loop_depths(func, num_blocks, depths)) {
+		goto cleanup;
+	}
 
+	/* Collect the upward exposed uses and the definitions of every block,
+	   and weigh every reference by the loop nesting depth of its block */
+	block = 0;
+	while ((block = jit_block_next(func, block)) != 0) {
+		weight = 1;
+		for (index = 0; index < depths[block->index] && index < JIT_MAX_LOOP_DEPTH; ++index) {
+			weight *= JIT_LOOP_WEIGHT;
+		}
+		jit_insn_iter_init(&iter, block);
+		while ((insn = jit_insn_iter_next(&iter)) != 0) {
+			if (insn->opcode == JIT_OP_NOP) {
+				continue;
+			}
+			flags = insn->flags;
+			if ((flags & JIT_INSN_VALUE1_OTHER_FLAGS) == 0) {
+				interval = get_live_interval(intervals, num_intervals, insn->value1);
+				if (interval) {
+					if (!_jit_bitset_test_bit(&(def[block->index]), interval->value->index)) {
+						_jit_bitset_set_bit(&(use[block->index]), interval->value->index);
+					}
+					interval->weight += weight;
+				}
+			}
+			if ((flags & JIT_INSN_VALUE2_OTHER_FLAGS) == 0) {
+				interval = get_live_interval(intervals, num_intervals, insn->value2);
+				if (interval) {
+					if (!_jit_bitset_test_bit(&(def[block->index]), interval->value->index)) {
+						_jit_bitset_set_bit(&(use[block->index]), interval->value->index);
+					}
+					interval->weight += weight;
+				}
+			}
+			if ((flags & JIT_INSN_DEST_OTHER_FLAGS) == 0) {
+				interval = get_live_interval(intervals, num_intervals, insn->dest);
+				if (interval) {
+					if ((flags & JIT_INSN_DEST_IS_VALUE) != 0) {
+						if (!_jit_bitset_test_bit(&(def[block->index]), interval->value->index)) {
+							_jit_bitset_set_bit(&(use[block->index]), interval->value->index);
+						}
+					}else {
+						_jit_bitset_set_bit(&(def[block->index]), interval->value->index);
+					}
+					interval->weight += weight;
+				}
+			}
+		}
+	}
+
+	/* Propagate the liveness across the blocks till the fixed point;
+	   the postorder visits successors before their predecessors */
+	do {
+		changed = 0;
+		for (index = 0; index < num_blocks; ++index) {
+			block = func->builder->block_order[index];
+			_jit_bitset_clear(&(live_out[block->index]));
+			for (edge = 0; edge < block->num_succs; ++edge) {
+				_jit_bitset_add(&(live_out[block->index]), &(live_in[block->succs[edge]->dst->index]));
+			}
+			_jit_bitset_copy(temp, &(live_out[block->index]));
+			_jit_bitset_sub(temp, &(def[block->index]));
+			_jit_bitset_add(temp, &(use[block->index]));
+			changed |= _jit_bitset_copy(&(live_in[block->index]), temp);
+		}
+	} while (changed);
+
+	/* Extend every interval over the blocks that reference it or
+	   where it is live on entry or on exit */
+	for (index = 0; index < num_blocks; ++index) {
+		_jit_bitset_copy(temp, &(use[index]));
+		_jit_bitset_add(temp, &(def[index]));
+		_jit_bitset_add(temp, &(live_in[index]));
+		_jit_bitset_add(temp, &(live_out[index]));
+		for (posn = 0; posn < num_intervals; ++posn) {
+			if (_jit_bitset_test_bit(temp, posn)) {
+				if (intervals[posn].start > index) {
+					intervals[posn].start = index;
+				}
+				intervals[posn].end = index;
+			}
+		}
+	}
+	num_sorted = 0;
+	for (index = 0; index < num_intervals; ++index) {
+		if (intervals[index].end >= 0) {
+			sorted[num_sorted++] = &(intervals[index]);
+		}
+	}
+	qsort(sorted, num_sorted, sizeof(_jit_live_interval_t *), compare_live_intervals);
+
+	/* Collect the global registers from the top-most one in the
+	   allocation order, as the fast tier does */
+	num_regs = 0;
+	for (reg = JIT_NUM_REGS - 1; reg >= 0 && num_regs < JIT_NUM_GLOBAL_REGS; --reg) {
+		if ((jit_reg_flags(reg) & JIT_REG_GLOBAL) != 0) {
+			free_regs[num_regs] = 1;
+			regs[num_regs++] = reg;
+		}
+	}
+
+	/* Scan the intervals by their first block.  Registers of the intervals
+	   that ended before are reused; when no register is free, the interval
+	   with the least weight among the current one and the active ones
+	   stays in the frame for the whole function */
+	num_active = 0;
+	for (index = 0; index < num_sorted; ++index) {
+		interval = sorted[index];
+		for (posn = 0; posn < num_active; ) {
+			if (active[posn]->end < interval->start) {
+				free_regs[active[posn]->reg] = 1;
+				active[posn] = active[--num_active];
+			}else {
+				++posn;
+			}
+		}
+		if (num_active < num_regs) {
+			for (reg = 0; !(free_regs[reg]); ++reg) {
+			}
+			free_regs[reg] = 0;
+			interval->reg = reg;
+			active[num_active++] = interval;
+			continue;
+		}
+		victim = -1;
+		for (posn = 0; posn < num_active; ++posn) {
+			if (active[posn]->weight < interval->weight
+			    && (victim < 0 || active[posn]->weight < active[victim]->weight)) {
+				victim = posn;
+			}
+		}
+		if (victim >= 0) {
+			interval->reg = active[victim]->reg;
+			active[victim]->reg = -1;
+			active[victim] = interval;
+		}
+	}
+
+	for (index = 0; index < num_intervals; ++index) {
+		if (intervals[index].reg >= 0) {
+			set_global_register(gen, intervals[index].value, regs[intervals[index].reg]);
+		}
+	}
+	result = 1;
+
+ cleanup:
+	for (index = 0; index < num_intervals; ++index) {
+		intervals[index].value->index = -1;
+	}
+	for (index = 0; index <= 4 * num_blocks; ++index) {
+		_jit_bitset_free(&(sets[index]));
+	}
+	jit_free(intervals);
+	jit_free(sorted);
+	jit_free(depths);
+	jit_free(sets);
+	return result;
+}
+#endif
+
+/*@
+ * @deftypefun void _jit_regs_alloc_global (jit_gencode_t gen, jit_function_t func)
+ * Perform global register allocation on the values in @code{func}.
+ * This is called during function compilation just after variable
+ * liveness has been computed.  Optimized functions, which have a
+ * control flow graph, are allocated with a linear scan over the live
+ * intervals of the values weighted by loop nesting; the others give
+ * the global registers to the most used values.
+ * @end deftypefun
+   @*/
+void _jit_regs_alloc_global (jit_gencode_t gen, jit_function_t func){
+#if JIT_NUM_GLOBAL_REGS != 0
+	int reg;
+
+	/* If the function has a "try" block, then don't do global allocation
+	   as the "longjmp" for exception throws will wipe out global registers */
+	if (func->has_try) {
+		return;
+	}
+
+	/* If the current function involves a tail call, then we don't do
+	   global register allocation and we also prevent the code generator
+	   from using any of the callee-saved registers.  This simplifies
+	   tail calls, which don't have to worry about restoring such registers */
+	if (func->builder->has_tail_call) {
+		for (reg = 0; reg < JIT_NUM_REGS; ++reg) {
+			if ((jit_reg_flags(reg) & (JIT_REG_FIXED|JIT_REG_CALL_USED)) == 0) {
+				jit_reg_set_used(gen->permanent, reg);
+			}
+		}
+		return;
+	}
+
+	if (func->optimization_level != JIT_OPTLEVEL_NONE
+	    && func->builder->block_order != 0
+	    && alloc_global_linear_scan(gen, func)) {
+		return;
+	}
+	alloc_global_by_usage(gen, func);
 #endif
 }
 
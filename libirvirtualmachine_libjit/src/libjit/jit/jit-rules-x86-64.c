@@ -998,6 +998,158 @@ _jit_gen_fix_value (jit_value_t value){
 	}
 }
 
+/*
+ * Peephole optimization of the generated code.
+ *
+ * Instructions are selected one IR instruction at a time, so values are
+ * often spilled to the frame and loaded right back, results of comparisons
+ * are tested again by the branch that follows them, and registers are
+ * copied just to be overwritten by an arithmetic operation.  The helpers
+ * below record what spills, register loads and setcc instructions leave
+ * in the general registers, in the flags and in the frame.  A record holds
+ * only while the output position is still at its end: any other code
+ * emitted in the meantime, or the start of a block, discards it.  Code
+ * that has been emitted is never moved, except for the register copy of
+ * the current instruction when it is folded into a lea.
+ */
+
+/*
+ * Size of the values of a normalized type that the peephole optimizer
+ * tracks through the frame, or zero.
+ */
+static int
+peephole_size (jit_type_t type){
+	switch (type->kind) {
+	    case JIT_TYPE_INT:
+	    case JIT_TYPE_UINT:
+		    return 4;
+
+	    case JIT_TYPE_LONG:
+	    case JIT_TYPE_ULONG:
+		    return 8;
+	}
+	return 0;
+}
+
+/*
+ * Discard every peephole record.
+ */
+static void
+peephole_reset (jit_gencode_t gen){
+	gen->peephole.store_end = 0;
+	gen->peephole.flags_end = 0;
+	gen->peephole.move_end = 0;
+}
+
+/*
+ * Update the records after code from start to end that does not change
+ * the flags and writes the general register dreg with the content of
+ * sreg (or with anything else if sreg is -1).  A dreg of -1 means that no
+ * general register has been written.
+ */
+static void
+peephole_update (jit_gencode_t gen, unsigned char *start, unsigned char *end,
+		 int dreg, int sreg){
+	if (start == gen->peephole.flags_end) {
+		if (dreg >= 0) {
+			if (sreg >= 0 && (gen->peephole.flags_regs & (1 << sreg)) != 0) {
+				gen->peephole.flags_regs |= (1 << dreg);
+			}else {
+				gen->peephole.flags_regs &= ~(1 << dreg);
+			}
+		}
+		gen->peephole.flags_end = end;
+	}
+	if (start == gen->peephole.store_end) {
+		if (dreg >= 0 && dreg == gen->peephole.store_reg) {
+			gen->peephole.store_end = 0;
+		}else {
+			gen->peephole.store_end = end;
+		}
+	}
+}
+
+/*
+ * Record the copy of the general register sreg into dreg, which has been
+ * emitted from start to end.
+ */
+static void
+peephole_move (jit_gencode_t gen, unsigned char *start, unsigned char *end,
+	       int dreg, int sreg, int size){
+	peephole_update(gen, start, end, dreg, sreg);
+	if (gen->peephole.enabled) {
+		gen->peephole.move_start = start;
+		gen->peephole.move_end = end;
+		gen->peephole.move_dreg = dreg;
+		gen->peephole.move_sreg = sreg;
+		gen->peephole.move_size = size;
+	}
+}
+
+/*
+ * Check if the last code emitted for the current instruction copied a
+ * register into reg, so that the copy and the operation that follows can
+ * be folded into a lea.  If so, the output position is moved back to the
+ * start of the copy and the register that has been copied is returned;
+ * otherwise -1 is returned.
+ */
+static int
+peephole_fold_move (jit_gencode_t gen, unsigned char **inst_ptr, int reg, int size){
+	int sreg;
+
+	if (*inst_ptr != gen->peephole.move_end
+	    || gen->peephole.move_dreg != reg
+	    || gen->peephole.move_size != size) {
+		return -1;
+	}
+	sreg = gen->peephole.move_sreg;
+	*inst_ptr = gen->peephole.move_start;
+	peephole_reset(gen);
+	return sreg;
+}
+
+/*
+ * Load a value of size bytes that lives in a general register or in the
+ * frame into the general register reg.  Copies of a register into itself
+ * are dropped, and a value that has just been spilled is copied from the
+ * register that has been stored rather than loaded from memory.
+ */
+static void
+peephole_load_value (jit_gencode_t gen, unsigned char **inst_ptr, int reg,
+		     jit_value_t value, int size){
+	unsigned char *inst = *inst_ptr;
+	unsigned char *start = inst;
+	int sreg;
+
+	reg = _jit_reg_info[reg].cpu_reg;
+	if (value->in_register || value->in_global_register) {
+		if (value->in_register) {
+			sreg = _jit_reg_info[value->reg].cpu_reg;
+		}else {
+			sreg = _jit_reg_info[value->global_reg].cpu_reg;
+		}
+	}else {
+		_jit_gen_fix_value(value);
+		if (inst != gen->peephole.store_end
+		    || gen->peephole.store_offset != value->frame_offset
+		    || gen->peephole.store_size != size) {
+			x86_64_mov_reg_membase_size(inst, reg, X86_64_RBP,
+						    value->frame_offset, size);
+			peephole_update(gen, start, inst, reg, -1);
+			*inst_ptr = inst;
+			return;
+		}
+		sreg = gen->peephole.store_reg;
+	}
+
+	/* Moves of 32 bits clear the upper half of the register */
+	if (sreg != reg || size != 8) {
+		x86_64_mov_reg_reg_size(inst, reg, sreg, size);
+	}
+	peephole_move(gen, start, inst, reg, sreg, size);
+	*inst_ptr = inst;
+}
+
 void
 _jit_gen_spill_global (jit_gencode_t gen, int reg, jit_value_t value){
 	jit_cache_setup_output(16);
@@ -1030,15 +1182,22 @@ void
 _jit_gen_spill_reg (jit_gencode_t gen, int reg,
 		    int other_reg, jit_value_t value){
 	jit_type_t type;
+	unsigned char *start;
+	int cpu_reg;
+	int size;
 
 	/* Make sure that we have sufficient space */
 	jit_cache_setup_output(16);
+	start = inst;
 
 	/* If the value is associated with a global register, then copy to that */
 	if (value->has_global_register) {
 		reg = _jit_reg_info[reg].cpu_reg;
 		other_reg = _jit_reg_info[value->global_reg].cpu_reg;
-		x86_64_mov_reg_reg_size(inst, other_reg, reg, sizeof(void *));
+		if (other_reg != reg || !gen->peephole.enabled) {
+			x86_64_mov_reg_reg_size(inst, other_reg, reg, sizeof(void *));
+		}
+		peephole_update(gen, start, inst, other_reg, reg);
 		jit_cache_end_output();
 		return;
 	}
@@ -1049,8 +1208,27 @@ _jit_gen_spill_reg (jit_gencode_t gen, int reg,
 	/* Get the normalized type */
 	type = jit_type_normalize(value->type);
 
+	/* Skip the spill if the same register has just been stored there */
+	size = (IS_GENERAL_REG(reg) ? peephole_size(type) : 0);
+	cpu_reg = _jit_reg_info[reg].cpu_reg;
+	if (size != 0
+	    && inst == gen->peephole.store_end
+	    && gen->peephole.store_reg == cpu_reg
+	    && gen->peephole.store_offset == value->frame_offset
+	    && gen->peephole.store_size == size) {
+		jit_cache_end_output();
+		return;
+	}
+
 	/* and spill the register */
 	_spill_reg(&inst, type, reg, value->frame_offset);
+	peephole_update(gen, start, inst, -1, -1);
+	if (size != 0 && gen->peephole.enabled) {
+		gen->peephole.store_end = inst;
+		gen->peephole.store_reg = cpu_reg;
+		gen->peephole.store_offset = value->frame_offset;
+		gen->peephole.store_size = size;
+	}
 
 	/* End the code output process */
 	jit_cache_end_output();
@@ -1071,10 +1249,22 @@ _jit_gen_free_reg (jit_gencode_t gen, int reg,
  * Set a register value based on a condition code.
  */
 static unsigned char *
-setcc_reg (unsigned char *inst, int reg, int cond, int is_signed){
+setcc_reg (jit_gencode_t gen, unsigned char *inst, int reg, int cond,
+	   int is_signed){
 	/* Use a SETcc instruction if we have a basic register */
 	x86_64_set_reg(inst, cond, reg, is_signed);
 	x86_64_movzx8_reg_reg_size(inst, reg, reg, 4);
+
+	/* The flags still hold the condition that reg has been set to */
+	if (gen->peephole.enabled) {
+		gen->peephole.flags_end = inst;
+		if (is_signed) {
+			gen->peephole.flags_opcode = x86_cc_signed_map[cond];
+		}else {
+			gen->peephole.flags_opcode = x86_cc_unsigned_map[cond];
+		}
+		gen->peephole.flags_regs = (1 << reg);
+	}
 	return inst;
 }
 
@@ -1181,6 +1371,31 @@ output_branch (jit_function_t func, unsigned char *inst, int opcode,
 	return inst;
 }
 
+/*
+ * Output a branch taken if the general register reg is not zero
+ * (or if it is zero, when if_true is not set).  If reg holds the
+ * result of the setcc emitted right before, the test is not needed
+ * and the branch uses the condition of the setcc.
+ */
+static unsigned char *
+output_branch_if (jit_gencode_t gen, jit_function_t func, unsigned char *inst,
+		  int reg, int size, int if_true, jit_insn_t insn){
+	int opcode;
+
+	if (inst == gen->peephole.flags_end
+	    && (gen->peephole.flags_regs & (1 << reg)) != 0) {
+		/* Conditions come in pairs that differ in the lowest bit */
+		opcode = gen->peephole.flags_opcode;
+		if (!if_true) {
+			opcode ^= 1;
+		}
+	}else {
+		x86_64_test_reg_reg_size(inst, reg, reg, size);
+		opcode = (if_true ? 0x75 /* ne */ : 0x74 /* eq */);
+	}
+	return output_branch(func, inst, opcode, insn);
+}
+
 /*
  * Jump to the current function's epilog.
  */
@@ -1511,12 +1726,23 @@ _jit_gen_load_value (jit_gencode_t gen, int reg, int other_reg, jit_value_t valu
 	int src_reg, other_src_reg;
 	void *ptr;
 	int offset;
+	unsigned char *start;
+	int size;
 
 	/* Make sure that we have sufficient space */
 	jit_cache_setup_output(16);
+	start = inst;
 
 	type = jit_type_normalize(value->type);
 
+	/* Integers in general registers go through the peephole optimizer */
+	size = (IS_GENERAL_REG(reg) ? peephole_size(type) : 0);
+	if (size != 0 && !value->is_constant && gen->peephole.enabled) {
+		peephole_load_value(gen, &inst, reg, value, size);
+		jit_cache_end_output();
+		return;
+	}
+
 	/* Load zero */
 	if (value->is_constant) {
 		switch (type->kind) {
@@ -1807,7 +2033,8 @@ _jit_gen_load_value (jit_gencode_t gen, int reg, int other_reg, jit_value_t valu
 					    x86_64_fst_membase_size(inst, X86_64_RBP, offset, 4);
 					    x86_64_movss_reg_membase(inst, _jit_reg_info[reg].cpu_reg,
 								     X86_64_RBP, offset);
-				    }else if (IS_XMM_REG(src_reg)) {
+				    }else if (IS_XMM_REG(src_reg)
+					      && (reg != src_reg || !gen->peephole.enabled)) {
 					    x86_64_movss_reg_reg(inst, _jit_reg_info[reg].cpu_reg,
 								 _jit_reg_info[src_reg].cpu_reg);
 				    }
@@ -1838,7 +2065,8 @@ _jit_gen_load_value (jit_gencode_t gen, int reg, int other_reg, jit_value_t valu
 					    x86_64_fst_membase_size(inst, X86_64_RBP, offset, 8);
 					    x86_64_movsd_reg_membase(inst, _jit_reg_info[reg].cpu_reg,
 								     X86_64_RBP, offset);
-				    }else if (IS_XMM_REG(src_reg)) {
+				    }else if (IS_XMM_REG(src_reg)
+					      && (reg != src_reg || !gen->peephole.enabled)) {
 					    x86_64_movsd_reg_reg(inst, _jit_reg_info[reg].cpu_reg,
 								 _jit_reg_info[src_reg].cpu_reg);
 				    }
@@ -2026,6 +2254,14 @@ _jit_gen_load_value (jit_gencode_t gen, int reg, int other_reg, jit_value_t valu
 		}
 	}
 
+	/* Forget what the registers and the flags were known to hold */
+	peephole_update(gen, start, inst,
+			(IS_GENERAL_REG(reg) ? _jit_reg_info[reg].cpu_reg : -1), -1);
+	if (value->is_constant) {
+		/* Constants may be loaded with instructions that set the flags */
+		gen->peephole.flags_end = 0;
+	}
+
 	/* End the code output process */
 	jit_cache_end_output();
 }
@@ -2379,6 +2615,11 @@ _jit_gen_start_block (jit_gencode_t gen, jit_block_t block){
 		absolute_fixup = absolute_next;
 	}
 	block->fixup_absolute_list = 0;
+
+	/* Nothing is known about the code that branches here */
+	gen->peephole.enabled = !jit_context_get_meta_numeric(block->func->context,
+								JIT_OPTION_DONT_PEEPHOLE);
+	peephole_reset(gen);
 }
 
 void
@@ -2627,6 +2868,9 @@ flush_return_struct (unsigned char *inst, jit_value_t value){
 void
 _jit_gen_insn (jit_gencode_t gen, jit_function_t func,
 	       jit_block_t block, jit_insn_t insn){
+	/* Register copies can only be folded into the instruction they are made for */
+	gen->peephole.move_end = 0;
+
 	switch (insn->opcode) {
 	#define JIT_INCLUDE_RULES
 	#include "jit-rules-x86-64.inc"
@@ -109,16 +109,42 @@ extern  "C" {
  */
 #define JIT_ALIGN_OVERRIDES             1
 
+/*
+ * State of the peephole optimizer: what the last emitted instructions
+ * left in the general registers, in the flags and in the stack frame.
+ * Every record is valid only while the output position is at its end.
+ */
+typedef struct {
+	int enabled;
+	unsigned char *store_end;       /* Spill of store_reg to the frame */
+	int store_reg;
+	int store_offset;
+	int store_size;
+	unsigned char *flags_end;       /* setcc of a condition into flags_regs */
+	int flags_opcode;               /* Short jcc opcode of the condition */
+	int flags_regs;
+	unsigned char *move_start;      /* Copy of move_sreg into move_dreg */
+	unsigned char *move_end;
+	int move_dreg;
+	int move_sreg;
+	int move_size;
+} _jit_peephole_t;
+
 /*
  * Extra state information that is added to the "jit_gencode" structure.
  */
 
 #define jit_extra_gen_state	\
-	void *alloca_fixup
+	void *alloca_fixup;	\
+	_jit_peephole_t peephole
 
 #define jit_extra_gen_init(gen)	\
 	do {	\
 		(gen)->alloca_fixup = 0;	\
+		(gen)->peephole.enabled = 0;	\
+		(gen)->peephole.store_end = 0;	\
+		(gen)->peephole.flags_end = 0;	\
+		(gen)->peephole.move_end = 0;	\
 	} while (0)
 
 #define jit_extra_gen_cleanup(gen)      do {; } while (0)
@@ -48,6 +48,18 @@ jit_mutex_t _jit_global_lock;
  */
 static pthread_key_t control_key;
 
+/*
+ * Free the control object of a thread that exits.
+ */
+static void free_control (void *obj){
+	jit_thread_control_t control = (jit_thread_control_t) obj;
+
+	/* The thread cannot be running compiled code anymore */
+	_jit_reclaim_thread_exit(control->reclaim_threads);
+	jit_stack_trace_free(control->stack_trace);
+	jit_free(control);
+}
+
 /*
  * Initialize the pthread support routines.  Only called once.
  */
@@ -57,7 +69,7 @@ static void init_pthread (void){
 	/* Allocate a thread-specific variable for the JIT's thread
 	   control object, and arrange for it to be freed when the
 	   thread exits or is otherwise terminated */
-	pthread_key_create(&control_key, jit_free);
+	pthread_key_create(&control_key, free_control);
 }
 
 #elif defined(JIT_THREADS_WIN32)
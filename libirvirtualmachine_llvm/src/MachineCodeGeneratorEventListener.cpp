@@ -3,7 +3,9 @@
 #include <assert.h>
 
 // My headers
+#include <compiler_memory_manager.h>
 #include <ir_virtual_machine_backend.h>
+#include <utilities.h>
 #include <MachineCodeGeneratorEventListener.h>
 // End
 
@@ -41,6 +43,17 @@ void MachineCodeGeneratorEventListener::NotifyFunctionEmitted(const Function &F,
 	llvmBackendMethod->entryPoint	= Code;
 	llvmBackendMethod->lastPoint	= (void *)(((JITNUINT)llvmBackendMethod->entryPoint) + Size);
 	assert(llvmBackendMethod->entryPoint < llvmBackendMethod->lastPoint);
+
+	/* Store where the calls of the machine code start: the debug location of each call carries its bytecode offset	*/
+	free_bytecode_offsets_of_llvm_function(llvmBackendMethod);
+	if (Details.LineStarts.size() > 0){
+		llvmBackendMethod->bytecodeOffsetsNumber	= Details.LineStarts.size();
+		llvmBackendMethod->bytecodeOffsets		= (t_llvm_bytecode_offset *)allocMemory(sizeof(t_llvm_bytecode_offset) * llvmBackendMethod->bytecodeOffsetsNumber);
+		for (JITUINT32 count=0; count < llvmBackendMethod->bytecodeOffsetsNumber; count++){
+			(llvmBackendMethod->bytecodeOffsets[count]).machineCodeOffset	= (JITUINT32)((Details.LineStarts[count]).Address - ((JITNUINT)Code));
+			(llvmBackendMethod->bytecodeOffsets[count]).bytecodeOffset	= (Details.LineStarts[count]).Loc.getLine();
+		}
+	}
 	
 	return ;
 }
@@ -57,10 +57,17 @@
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Target/TargetOptions.h>
 #include <llvm/Intrinsics.h>
+#include <llvm/Metadata.h>
+#include <llvm/Support/DebugLoc.h>
 
 using namespace llvm;
 // End
 
+typedef struct {
+    JITUINT32	machineCodeOffset;		/**< Distance from the entry point of the function of the first byte of machine code that belongs to the bytecode offset	*/
+    JITUINT32	bytecodeOffset;			/**< Offset of the CIL instruction that the machine code has been generated for						*/
+} t_llvm_bytecode_offset;
+
 typedef struct {
     void            *entryPoint;			/**< First memory address where the machine code of the function has been stored.				*/
     void		*lastPoint;			/**< Last memory address used to store the machine code of the LLVM function					*/
@@ -72,6 +79,8 @@ typedef struct {
     Value		**finallyBlockReturnAddresses;	/**< Finally block specific variables										*/
     Value		*exceptionThrown;		/**< Pointer to the exception object thrown. The object always resides inside the memory heap			*/
     JITBOOLEAN	isNative;			/**< JITTRUE if the function is native (i.e., C function)							*/
+    t_llvm_bytecode_offset	*bytecodeOffsets;	/**< Bytecode offsets of the calls within the machine code, sorted by machine code offset			*/
+    JITUINT32	bytecodeOffsetsNumber;		/**< Number of elements of bytecodeOffsets								*/
 } t_llvm_function_internal;
 
 typedef struct {
@@ -134,6 +143,7 @@ typedef struct {
     XanHashTable				*llvmFunctions;			/**< Mapping from (ir_method_t *) to (t_jit_function *)					*/
     XanHashTable				*irMethods;			/**< Mapping from (Function *) to (ir_method_t *) 					*/
     XanHashTable				*ilMethods;			/**< Mapping from (ir_method_t *) to input language methods (i.e., IR_ITEM_VALUE) 	*/
+    MDNode					*bytecodeOffsetScope;		/**< Scope of the debug locations that carry the bytecode offsets of the calls		*/
     FunctionPassManager 			*FPM;
     PassManager				*MPM;
 } IRVM_internal_t;
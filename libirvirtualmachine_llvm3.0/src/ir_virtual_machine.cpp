@@ -131,6 +131,7 @@ static inline void setup_llvm_variables (IRVM_t *self, IRVM_internal_t *llvmRoot
 static inline void internal_free_memory_used_for_previous_translations (t_llvm_function_internal *llvmFunction);
 static inline void error_trampoline (void);
 static inline void internal_generate_instruction_range_store (IRVM_t *self, IRVM_internal_t *llvmRoots, ir_method_t *method, ir_instruction_t *inst);
+static inline void internal_set_bytecode_offset_of_calls (IRVM_internal_t *llvmRoots, ir_instruction_t *inst, BasicBlock *llvmBB, Instruction *lastLlvmInst);
 OurUnwindException * createOurException (void *exceptionObject);
 
 void IRVM_optimizeProgram (IRVM_t *self){
@@ -381,6 +382,28 @@ void * IRVM_getEntryPoint (IRVM_t *self, t_jit_function *backendFunction){
 	return llvmFunction->entryPoint;
 }
 
+JITUINT32 IRVM_getCodeSize (IRVM_t *self, t_jit_function *backendFunction){
+	t_llvm_function_internal	*llvmFunction;
+
+	/* Assertions				*/
+	assert(backendFunction != NULL);
+
+	/* Fetch the LLVM function		*/
+	if (backendFunction->data == NULL){
+		return 0;
+	}
+	llvmFunction = (t_llvm_function_internal *) backendFunction->data;
+
+	/* The extent of the code is known once LLVM notifies its emission	*/
+	if (	(llvmFunction->isNative)			||
+		(llvmFunction->entryPoint == NULL)		||
+		(llvmFunction->lastPoint <= llvmFunction->entryPoint)	){
+		return 0;
+	}
+
+	return (JITUINT32)(((JITNUINT)llvmFunction->lastPoint) - ((JITNUINT)llvmFunction->entryPoint));
+}
+
 JITINT32 IRVM_hasTheSignatureBeenTranslated (IRVM_t *self, t_jit_function *backendFunction){
 	t_llvm_function_internal	*llvmFunction;
 
@@ -538,11 +561,19 @@ void IRVM_lowerMethod (IRVM_t *self, ir_method_t *method, t_jit_function *jitFun
 		/* Fill up the basic block		*/
 		for (JITUINT32 instPos=bb->startInst; instPos <= bb->endInst; instPos++){
 			ir_instruction_t	        *currentIRInstruction;
+			Instruction			*lastLlvmInst;
 
 			/* Fetch the instruction		*/
 			currentIRInstruction	= IRMETHOD_getInstructionAtPosition(method, instPos);
 			assert(currentIRInstruction != NULL);
 
+			/* Remember where the code of the	*
+			 * current IR instruction starts	*/
+			lastLlvmInst	= NULL;
+			if (!llvmBB->empty()){
+				lastLlvmInst	= &(llvmBB->back());
+			}
+
 			/* Convert the current IR instruction	*/
 			switch (currentIRInstruction->type) {
 				case IRCHECKNULL:
@@ -768,6 +799,10 @@ void IRVM_lowerMethod (IRVM_t *self, ir_method_t *method, t_jit_function *jitFun
 					fprintf(stderr, "ILDJIT_LLVM: Instruction kind \"%s\" is not handled yet\n", IRMETHOD_getInstructionTypeName(currentIRInstruction->type));
 					abort();
 			}
+
+			/* Map the calls of the IR instruction	*
+			 * back to its bytecode offset		*/
+			internal_set_bytecode_offset_of_calls(llvmRoots, currentIRInstruction, llvmBB, lastLlvmInst);
 		}
 
 		/* Unless current block ends with a
@@ -3502,6 +3537,36 @@ static inline void internal_generate_instruction_range_store (IRVM_t *self, IRVM
 	return ;
 }
 
+static inline void internal_set_bytecode_offset_of_calls (IRVM_internal_t *llvmRoots, ir_instruction_t *inst, BasicBlock *llvmBB, Instruction *lastLlvmInst){
+	BasicBlock::iterator	llvmInst;
+	DebugLoc		bytecodeLocation;
+
+	/* The line of the location is the bytecode offset: LLVM reports where it starts inside the machine code when the function is emitted.
+	 * Only calls are tagged, as their return addresses are the only ones that stack traces hold.
+	 */
+	bytecodeLocation	= DebugLoc::get(inst->byte_offset, 0, llvmRoots->bytecodeOffsetScope);
+
+	/* Tag the calls generated for the IR instruction	*/
+	if (lastLlvmInst == NULL){
+		llvmInst	= llvmBB->begin();
+	} else {
+		llvmInst	= lastLlvmInst;
+		llvmInst++;
+	}
+	while (llvmInst != llvmBB->end()){
+		Instruction	*currentLlvmInst;
+
+		currentLlvmInst	= &(*llvmInst);
+		if (	(isa<CallInst>(currentLlvmInst))		||
+			(isa<InvokeInst>(currentLlvmInst))	){
+			currentLlvmInst->setDebugLoc(bytecodeLocation);
+		}
+		llvmInst++;
+	}
+
+	return ;
+}
+
 static inline Value * internal_allocateANewVariable (Type *llvmType, JITUINT32 alignment, BasicBlock *entryBB){
 	AllocaInst	*allocaInst;
 
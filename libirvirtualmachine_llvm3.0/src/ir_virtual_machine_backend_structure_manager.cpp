@@ -133,6 +133,7 @@ void IRVM_destroyFunction (IRVM_t *self, t_jit_function *backendFunction){
 			 */
 			if (llvmFunction != NULL){
 				free_memory_used_for_llvm_function(llvmFunction);
+				free_bytecode_offsets_of_llvm_function(llvmFunction);
 			}
 
 			/* Remove the element from the table.
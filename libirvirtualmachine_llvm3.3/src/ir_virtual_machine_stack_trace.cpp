@@ -21,6 +21,8 @@
 #include <ir_virtual_machine.h>
 #include <compiler_memory_manager.h>
 #include <iostream>
+#include <execinfo.h>
+#include <pthread.h>
 #include <fstream>
 #include <ir_optimizer.h>
 #include <ir_optimization_interface.h>
@@ -33,39 +35,208 @@
 #include <config.h>
 // End
 
+/* Number of return addresses a new stack trace has room for	*/
+#define STACK_TRACE_INITIAL_SIZE	64
+
+/* Bytecode offset of the frames that do not belong to a method or whose call has no offset	*/
+#define NO_BYTECODE_OFFSET		(~((JITUINT32) 0))
+
+/* Content of a stack trace: the return addresses of the call stack	*/
+typedef struct {
+	void		*exception;
+	void		**items;
+	JITUINT32	size;
+	JITUINT32	capacity;
+} stack_trace_t;
+
+static inline stack_trace_t * internal_newStackTrace (void);
+static inline void internal_captureStackTrace (stack_trace_t *trace);
+static void internal_destroyStackTrace (void *trace);
+static inline t_llvm_function_internal * internal_getFunctionOfFrame (IRVM_t *IRVM, IRVM_stackTrace *stack, JITUINT32 position, ir_method_t **irMethod, void **pc);
+
+/* Stack trace of the last exception thrown by the thread, reused by the next one	*/
+static __thread stack_trace_t *threadStackTrace = NULL;
+static pthread_key_t threadStackTraceKey;
+static pthread_once_t threadStackTraceKeyOnce = PTHREAD_ONCE_INIT;
+
+static void internal_createStackTraceKey (void){
+	pthread_key_create(&threadStackTraceKey, internal_destroyStackTrace);
+}
+
 JITUINT32 IRVM_getStackTraceOffset (IRVM_t *IRVM, IRVM_stackTrace *stack, JITUINT32 position){
-	//TODO: this is important only to handle exceptions
-	abort();
+	t_llvm_function_internal	*llvmFunction;
+	ir_method_t			*irMethod;
+	void				*pc;
+	JITUINT32			machineCodeOffset;
+	JITUINT32			bytecodeOffset;
+
+	/* Fetch the function the frame belongs to	*/
+	llvmFunction	= internal_getFunctionOfFrame(IRVM, stack, position, &irMethod, &pc);
+	if (llvmFunction == NULL) {
+		return NO_BYTECODE_OFFSET;
+	}
+
+	/* Take the bytecode offset of the call, which is the last one that starts before the pc	*/
+	machineCodeOffset	= (JITUINT32)(((JITNUINT)pc) - ((JITNUINT)llvmFunction->entryPoint));
+	bytecodeOffset		= NO_BYTECODE_OFFSET;
+	for (JITUINT32 count=0; count < llvmFunction->bytecodeOffsetsNumber; count++) {
+		if ((llvmFunction->bytecodeOffsets[count]).machineCodeOffset > machineCodeOffset) {
+			break;
+		}
+		bytecodeOffset	= (llvmFunction->bytecodeOffsets[count]).bytecodeOffset;
+	}
 
-	return 0;
+	return bytecodeOffset;
 }
 
 void * IRVM_getStackTraceFunctionAt (IRVM_t *IRVM, IRVM_stackTrace *stack, JITUINT32 position){
-	//TODO: this is important only to handle exceptions
-	abort();
+	IRVM_internal_t			*llvmRoots;
+	t_llvm_function_internal	*llvmFunction;
+	ir_method_t			*irMethod;
+	void				*pc;
 
-	return NULL;
+	/* Fetch the function the frame belongs to	*/
+	llvmFunction	= internal_getFunctionOfFrame(IRVM, stack, position, &irMethod, &pc);
+	if (llvmFunction == NULL) {
+		return NULL;
+	}
+
+	/* Fetch the method of the function		*/
+	llvmRoots	= (IRVM_internal_t *) IRVM->data;
+	assert(llvmRoots != NULL);
+
+	return xanHashTable_lookup(llvmRoots->ilMethods, irMethod);
 }
 
 JITUINT32 IRVM_getStackTraceSize (IRVM_stackTrace *stack){
-	//TODO: this is important only to handle exceptions
-	abort();
+	stack_trace_t	*trace;
 
-	return 0;
+	trace	= (stack_trace_t *)stack->stack_trace;
+	if (trace == NULL) {
+		return 0;
+	}
+
+	return trace->size;
+}
+
+void * IRVM_getStackTraceAddressAt (IRVM_stackTrace *stack, JITUINT32 position){
+	stack_trace_t	*trace;
+
+	trace	= (stack_trace_t *)stack->stack_trace;
+	if (	(trace == NULL)			||
+		(position >= trace->size)	) {
+		return NULL;
+	}
+
+	return trace->items[position];
 }
 
 IRVM_stackTrace * IRVM_getStackTrace (void){
 	IRVM_stackTrace *s;
 
 	s 		= (IRVM_stackTrace *)allocFunction(sizeof(IRVM_stackTrace));
-	//s->stack_trace = jit_exception_get_stack_trace(); TODO
+	s->stack_trace	= internal_newStackTrace();
+	internal_captureStackTrace((stack_trace_t *)s->stack_trace);
 
 	return s;
 }
 
+void IRVM_captureStackTrace (void *exception){
+	if (threadStackTrace == NULL) {
+		pthread_once(&threadStackTraceKeyOnce, internal_createStackTraceKey);
+		threadStackTrace	= internal_newStackTrace();
+		pthread_setspecific(threadStackTraceKey, threadStackTrace);
+	}
+	threadStackTrace->exception	= exception;
+	internal_captureStackTrace(threadStackTrace);
+
+	return ;
+}
+
+JITBOOLEAN IRVM_getExceptionStackTrace (void *exception, IRVM_stackTrace *stack){
+	if (	(threadStackTrace == NULL)			||
+		(threadStackTrace->exception != exception)	) {
+		stack->stack_trace	= NULL;
+		return JITFALSE;
+	}
+	stack->stack_trace	= threadStackTrace;
+
+	return JITTRUE;
+}
+
 void IRVM_destroyStackTrace (IRVM_stackTrace *stack){
-	//TODO: this is important only to handle exceptions
-	abort();
+	if (stack->stack_trace != NULL) {
+		internal_destroyStackTrace(stack->stack_trace);
+	}
+	freeFunction(stack);
+
+	return ;
+}
+
+static inline stack_trace_t * internal_newStackTrace (void){
+	stack_trace_t	*trace;
+
+	trace			= (stack_trace_t *)allocFunction(sizeof(stack_trace_t));
+	trace->capacity		= STACK_TRACE_INITIAL_SIZE;
+	trace->items		= (void **)allocFunction(sizeof(void *) * trace->capacity);
+
+	return trace;
+}
+
+static inline void internal_captureStackTrace (stack_trace_t *trace){
+
+	/* Take the call stack again in the memory of the previous one, growing it until the whole stack fits	*/
+	trace->size	= backtrace(trace->items, trace->capacity);
+	while (trace->size == trace->capacity) {
+		trace->capacity	*= 2;
+		trace->items	= (void **)dynamicReallocFunction(trace->items, sizeof(void *) * trace->capacity);
+		trace->size	= backtrace(trace->items, trace->capacity);
+	}
+
+	return ;
+}
+
+static void internal_destroyStackTrace (void *trace){
+	freeFunction(((stack_trace_t *)trace)->items);
+	freeFunction(trace);
 
 	return ;
 }
+
+static inline t_llvm_function_internal * internal_getFunctionOfFrame (IRVM_t *IRVM, IRVM_stackTrace *stack, JITUINT32 position, ir_method_t **irMethod, void **pc){
+	IRVM_internal_t		*llvmRoots;
+	XanHashTableItem	*item;
+	void			*returnAddress;
+
+	/* Fetch the return address of the frame	*/
+	returnAddress	= IRVM_getStackTraceAddressAt(stack, position);
+	if (returnAddress == NULL) {
+		return NULL;
+	}
+
+	/* The return address follows the call, which can be the last instruction of the function: look up the byte before it	*/
+	(*pc)		= (void *)(((JITNUINT)returnAddress) - 1);
+
+	/* Look for the function whose machine code holds the call.
+	 * This is done only when a stack trace is read, so it is cheaper to scan the functions than to keep them sorted by address.
+	 */
+	llvmRoots	= (IRVM_internal_t *) IRVM->data;
+	assert(llvmRoots != NULL);
+	item		= xanHashTable_first(llvmRoots->llvmFunctions);
+	while (item != NULL) {
+		t_jit_function			*backendFunction;
+		t_llvm_function_internal	*llvmFunction;
+
+		backendFunction	= (t_jit_function *)item->element;
+		llvmFunction	= (t_llvm_function_internal *)backendFunction->data;
+		if (	(llvmFunction != NULL)				&&
+			((*pc) >= llvmFunction->entryPoint)		&&
+			((*pc) < llvmFunction->lastPoint)		) {
+			(*irMethod)	= (ir_method_t *)item->elementID;
+			return llvmFunction;
+		}
+		item		= xanHashTable_next(llvmRoots->llvmFunctions, item);
+	}
+
+	return NULL;
+}
@@ -160,6 +160,25 @@ JITINT32 IRVM_run (IRVM_t *self, t_jit_function *backendFunction, void **args, v
 	return 1;
 }
 
+void IRVM_checkpoint (IRVM_t *self){
+
+	/* The machine code of methods is never replaced, so there is nothing to reclaim.
+	 */
+	return;
+}
+
+void IRVM_enterBlockingRegion (IRVM_t *self){
+	return;
+}
+
+void IRVM_leaveBlockingRegion (IRVM_t *self){
+	return;
+}
+
+void IRVM_registerThread (IRVM_t *self){
+	return;
+}
+
 static Function * internal_get_Function (IRVM_internal_t *llvmRoots){
 	CallFrame	*framePtr;
 	/*#if SIZEOF_VOID_PTR == 8
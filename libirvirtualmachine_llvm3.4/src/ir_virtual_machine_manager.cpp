@@ -138,6 +138,11 @@ void IRVM_init(IRVM_t *self, t_running_garbage_collector *gc, IRVM_type * (*look
 	vm->ilMethods		= xanHashTable_new(11, JITFALSE, allocFunction, dynamicReallocFunction, freeFunction, NULL, NULL);
 	vm->globals		= xanHashTable_new(11, JITFALSE, allocFunction, dynamicReallocFunction, freeFunction, NULL, NULL);
 
+	/* Create the scope of the debug locations	*
+	 * that map calls back to bytecode offsets	*/
+	Value *bytecodeOffsetScopeName[]	= {MDString::get(vm->llvmModule->getContext(), "bytecode offsets")};
+	vm->bytecodeOffsetScope	= MDNode::get(vm->llvmModule->getContext(), ArrayRef<Value*>(bytecodeOffsetScopeName));
+
 	/* Define the important LLVM types	*/
 	llvmPtrType		= get_LLVM_type(self, vm, IRMPOINTER, NULL);
 	llvmIntType		= get_LLVM_type(self, vm, IRINT32, NULL);
@@ -180,6 +185,7 @@ void IRVM_shutdown (IRVM_t *self){
 		/* Free the function.
 		 */
 		free_memory_used_for_llvm_function(llvmFunction);
+		free_bytecode_offsets_of_llvm_function(llvmFunction);
 		
 		item	= xanHashTable_next(vm->llvmFunctions, item);
 	}
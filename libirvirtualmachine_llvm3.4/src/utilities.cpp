@@ -706,6 +706,16 @@ void free_memory_used_for_llvm_function (t_llvm_function_internal *llvmFunction)
 	return ;
 }
 
+void free_bytecode_offsets_of_llvm_function (t_llvm_function_internal *llvmFunction){
+	if (llvmFunction->bytecodeOffsets != NULL){
+		freeMemory(llvmFunction->bytecodeOffsets);
+		llvmFunction->bytecodeOffsets		= NULL;
+	}
+	llvmFunction->bytecodeOffsetsNumber	= 0;
+
+	return ;
+}
+
 extern "C" {
 /// This function is the struct _Unwind_Exception API mandated delete function 
 /// used by foreign exception handlers when deleting our exception 
@@ -56,6 +56,7 @@ GlobalVariable * get_globalVariable_for_data (IRVM_t *self, JITUINT16 irType, co
 void allocateBackendFunction (IRVM_t *self, t_jit_function *f, ir_method_t *irMethod);
 JITINT8 * get_C_function_name (ir_method_t *m);
 void free_memory_used_for_llvm_function (t_llvm_function_internal *llvmFunction);
+void free_bytecode_offsets_of_llvm_function (t_llvm_function_internal *llvmFunction);
 
 extern "C" {
 OurUnwindException * createOurException (void *exceptionObject);
@@ -179,6 +179,14 @@ static inline JITUINT32 optimization_levels_optimizeMethodAOT (ir_optimizer_t *l
     l = IRPROGRAM_getIRMethods();
     assert(l != NULL);
 
+    /* Devirtualize the calls so that the	*
+     * inliner can see their targets	*/
+    item	= xanList_first(l);
+    while (item != NULL) {
+        IROPTIMIZER_callMethodOptimization(lib, item->data, METHOD_DEVIRTUALIZATION);
+        item	= item->next;
+    }
+
     /* Inline the methods			*/
     if (aggressiveOptimizations) {
         IROPTIMIZER_callMethodOptimization(lib, startMethod, METHOD_INLINER);
@@ -382,11 +390,14 @@ static inline JITUINT32 optimizeMethod_O2_checkpointable (ir_optimizer_t *lib, i
     /* Rename the variables		*/
     IROPTIMIZER_callMethodOptimization(lib, method, VARIABLES_RENAMING);
 
+    /* Devirtualize the calls	*/
+    IROPTIMIZER_callMethodOptimization(lib, method, METHOD_DEVIRTUALIZATION);
+
     /* Inline the native methods	*/
     IROPTIMIZER_callMethodOptimization(lib, method, NATIVE_METHODS_ELIMINATION);
 
     /* Move loop invariants		*/
-//	IROPTIMIZER_callMethodOptimization(lib, method, LOOP_INVARIANT_CODE_HOISTING);
+    IROPTIMIZER_callMethodOptimization(lib, method, LOOP_INVARIANT_CODE_HOISTING);
 
     /* Optimize the code at O1	*/
     optimizeMethod_O1_checkpointable(lib, method, state, checkPoint);
@@ -451,6 +462,17 @@ static inline JITUINT32 optimizeMethod_O3_checkpointable (ir_optimizer_t *lib, i
         }
     }
 
+    /* Unroll the loops.
+     * Unrolling is applied once the code has reached a fixed point because it duplicates the body of loops.
+     */
+    if (state == JOB_END) {
+        method->modified = JITFALSE;
+        IROPTIMIZER_callMethodOptimization(lib, method, LOOP_UNROLLING);
+        if (method->modified) {
+            optimizeMethod_O1_checkpointable(lib, method, state, checkPoint);
+        }
+    }
+
     return state;
 }
 
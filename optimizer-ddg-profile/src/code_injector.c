@@ -30,20 +30,19 @@
 #include <runtime.h>
 #include <load_instructions.h>
 #include <load_loops.h>
+#include <ddg_trace_format.h>
 // End
 
 static inline XanHashTable * internal_cache_instruction_positions (void);
 static inline void internal_injectCodeToDumpDependenceTrace(BZFILE *compressedOutputFile, XanHashTable *methods, XanHashTable *insts, XanHashTable *methodsToConsider);
-static inline void internal_inject_code_to_dump_trace_in_method (ir_method_t *m, XanHashTable *instsToConsider, XanHashTable *methodsToConsider);
+static inline void internal_inject_code_to_dump_trace_in_method (ir_method_t *m, JITUINT32 methodID, XanHashTable *instsToConsider, XanHashTable *methodsToConsider);
 static inline void internal_codeBlockExecuted (JITUINT32 cpuCycles, JITUINT32 memoryCycles);
 static inline void internal_massage_code (void);
 
 extern ir_optimizer_t                   *irOptimizer;
 static BZFILE				*compressedOutputFile;
 static FILE				*outputFile 		= NULL;
-XanHashTable				*loopNamesTable		= NULL;
-XanHashTable				*methodNamesTable	= NULL;
-XanHashTable				*loopProfileTable	= NULL;
+static XanList				*loopProfiles		= NULL;
 
 BZFILE * inject_code_to_program (void){
 	XanHashTable		*table;
@@ -53,9 +52,9 @@ BZFILE * inject_code_to_program (void){
 
 	/* Open the output file.
 	 */
-	outputFile              = fopen("ddg_trace.txt.bz2", "w");
+	outputFile              = fopen(DDG_TRACE_FILENAME, "w");
 	if (outputFile == NULL){
-		print_err("ERROR: Opening ddg_trace.txt.bz2 file. ", errno);
+		print_err("ERROR: Opening " DDG_TRACE_FILENAME " file. ", errno);
 		abort();
 	}
 	compressedOutputFile	= BZ2_bzWriteOpen(NULL, outputFile, 9, 0, 250);
@@ -96,6 +95,8 @@ static inline void internal_injectCodeToDumpDependenceTrace(BZFILE *compressedOu
 	XanListItem		*listItem;
 	XanHashTableItem	*item;
 	XanHashTable		*loops;
+	XanHashTable		*loopNamesTable;
+	XanHashTable		*loopProfileTable;
 	JITUINT32		count;
 	JITINT8			filename[DIM_BUF];
 	FILE			*methodHashFile;
@@ -121,7 +122,8 @@ static inline void internal_injectCodeToDumpDependenceTrace(BZFILE *compressedOu
 
 	/* Profile the loops.
 	 */
-	LOOPS_profileLoopsWithNames(irOptimizer, loopsList, JITTRUE, loopsNames, dump_start_loop, dump_end_loop, dump_start_loop_iteration, NULL);
+	loopProfiles		= LOOPS_profileLoopBoundaries(irOptimizer, loopsList, JITTRUE, loopsNames, dump_start_loop, dump_end_loop, dump_start_loop_iteration, NULL);
+	assert(loopProfiles != NULL);
 
 	/* Create the set of loops to analyze.
 	 */
@@ -152,6 +154,18 @@ static inline void internal_injectCodeToDumpDependenceTrace(BZFILE *compressedOu
 		listItem		= listItem->next;
 	}
 
+	/* Store in the profiles the ID of the loops and whether they enable the dumper, so the runtime does not need to look up their names.
+	 */
+	listItem		= xanList_first(loopProfiles);
+	while (listItem != NULL){
+		loop_profile_t	*profile;
+		profile			= listItem->data;
+		assert(profile != NULL);
+		profile->userData	= xanHashTable_lookup(loopNamesTable, profile->loopName);
+		profile->flag1		= (xanHashTable_lookup(loopProfileTable, profile->loopName) != NULL);
+		listItem		= listItem->next;
+	}
+
 	/* Create the hash of method names.
 	 */
 	methodHashFile	= fopen("method_IDs.txt", "w");
@@ -163,7 +177,6 @@ static inline void internal_injectCodeToDumpDependenceTrace(BZFILE *compressedOu
 	/* Inject code to both the parallel method and everything is reachable from it.
 	 */
 	count			= 1;
-	methodNamesTable	= xanHashTable_new(11, JITFALSE, allocFunction, dynamicReallocFunction, freeFunction, NULL, NULL);
 	item			= xanHashTable_first(methods);
 	while (item != NULL){
 		ir_method_t		*m;
@@ -179,12 +192,11 @@ static inline void internal_injectCodeToDumpDependenceTrace(BZFILE *compressedOu
 		methodName 	= IRMETHOD_getSignatureInString(m);
 		assert(methodName != NULL);
 		fprintf(methodHashFile, "%u	%s\n", count, methodName);
-		xanHashTable_insert(methodNamesTable, methodName, (void *)(JITNUINT)count);
-		count++;
 
 		/* Inject code for memory instructions.
 		 */
-		internal_inject_code_to_dump_trace_in_method(m, insts, methodsToConsider);
+		internal_inject_code_to_dump_trace_in_method(m, count, insts, methodsToConsider);
+		count++;
 		
 		/* Fetch the next element.
 		 */
@@ -200,18 +212,20 @@ static inline void internal_injectCodeToDumpDependenceTrace(BZFILE *compressedOu
 	IRLOOP_destroyLoops(loops);
 	xanList_destroyList(loopsList);
 	xanList_destroyList(loopNamesToProfile);
+	xanHashTable_destroyTable(loopNamesTable);
+	xanHashTable_destroyTable(loopProfileTable);
 
 	return ;
 }
 
-static inline void internal_inject_code_to_dump_trace_in_method (ir_method_t *m, XanHashTable *instsToConsider, XanHashTable *methodsToConsider){
+static inline void internal_inject_code_to_dump_trace_in_method (ir_method_t *m, JITUINT32 methodID, XanHashTable *instsToConsider, XanHashTable *methodsToConsider){
 	XanList			*insts;
 	XanList			*callInsts;
 	XanList			*params;
 	XanList			*nativeCalls;
 	XanListItem		*item;
 	XanList			*l;
-	ir_item_t		methodNameParam;
+	ir_item_t		methodIDParam;
 	ir_instruction_t	*firstInst;
 	ir_item_t		instPosParam;
 	ir_item_t		input1Param;
@@ -220,19 +234,14 @@ static inline void internal_inject_code_to_dump_trace_in_method (ir_method_t *m,
 	ir_item_t		input2SizeParam;
 	ir_item_t		outputParam;
 	ir_item_t		outputSizeParam;
-	JITINT8			*methodName;
 	JITBOOLEAN		isAMethodThatContainsAConsideredLoop;
 
 	/* Assertions.
 	 */
 	assert(m != NULL);
+	assert(methodID > 0);
 	assert(instsToConsider != NULL);
 
-	/* Fetch the name of the method.
-	 */
-	methodName	= IRMETHOD_getSignatureInString(m);
-	assert(methodName != NULL);
-
 	/* Check if the current method has been already profiled.
 	 */
 	nativeCalls	= IRMETHOD_getInstructionsOfType(m, IRNATIVECALL);
@@ -291,11 +300,11 @@ static inline void internal_inject_code_to_dump_trace_in_method (ir_method_t *m,
 
 	/* Inject the call for the begin of the method.
 	 */
-	memset(&methodNameParam, 0, sizeof(ir_item_t));
-	methodNameParam.value.v		= (IR_ITEM_VALUE)(JITNUINT)methodName;
-	methodNameParam.internal_type	= IRNUINT;
-	methodNameParam.type		= methodNameParam.internal_type;
-	xanList_insert(params, &methodNameParam);
+	memset(&methodIDParam, 0, sizeof(ir_item_t));
+	methodIDParam.value.v		= methodID;
+	methodIDParam.internal_type	= IRUINT32;
+	methodIDParam.type		= methodIDParam.internal_type;
+	xanList_insert(params, &methodIDParam);
 	IRMETHOD_newNativeCallInstructionBefore(m, firstInst, "MemoryInstructionDumperBeginMethod", dump_start_method, NULL, params);
 	xanList_emptyOutList(params);
 	
@@ -0,0 +1,288 @@
+/*
+ * Copyright (C) 2012  Campanoni Simone
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <bzlib.h>
+#include <jitsystem.h>
+
+// My headers
+#include <ddg_trace_format.h>
+// End
+
+/* Decode the binary trace dumped by the runtime into the text trace:
+ *	LOOP <loop ID>
+ *	ENDLOOP
+ *	METHOD <method ID>
+ *	ENDMETHOD
+ *	ITER
+ *	M <instruction ID> [<input1 first> - <input1 last>] [ <input2 first> - <input2 last>] , [<output first> - <output last>]
+ *	C <instruction ID>
+ *	OS
+ * IDs are the ones of loop_IDs.txt, method_IDs.txt and instruction_IDs.txt.
+ * Events of different threads are separated by a line "THREAD <thread>" every time the thread changes; the first thread is 0.
+ */
+
+#define INPUT_BUF	65536
+
+static inline JITBOOLEAN internal_read_byte (JITUINT8 *byte);
+static inline JITUINT64 internal_read_varint (void);
+static inline JITUINT64 internal_finish_varint (JITUINT8 byte);
+static inline void internal_decode_chunk (JITUINT32 threadID, JITUINT64 bytes, FILE *out);
+static inline void internal_error (char *message);
+
+static BZFILE		*inputFile;
+static JITUINT8		inputBuf[INPUT_BUF];
+static JITINT32		inputBytes	= 0;
+static JITINT32		inputPosition	= 0;
+static JITBOOLEAN	inputEnd	= JITFALSE;
+static JITUINT64	consumedBytes	= 0;
+static JITNUINT		*nextAddresses	= NULL;
+static JITUINT32	threadsNumber	= 0;
+
+int main (int argc, char *argv[]){
+	FILE		*file;
+	FILE		*out;
+	JITUINT32	currentThread;
+	JITUINT8	magic[DDG_TRACE_MAGIC_LENGTH];
+	JITUINT32	count;
+	JITINT32	errorCode;
+
+	/* Check the arguments.
+	 */
+	if (argc > 3){
+		fprintf(stderr, "USAGE: %s [trace (default " DDG_TRACE_FILENAME ")] [output (default stdout)]\n", argv[0]);
+		return 1;
+	}
+
+	/* Open the files.
+	 */
+	file	= fopen(argc > 1 ? argv[1] : DDG_TRACE_FILENAME, "r");
+	if (file == NULL){
+		fprintf(stderr, "ERROR: Opening %s: %s\n", argc > 1 ? argv[1] : DDG_TRACE_FILENAME, strerror(errno));
+		return 1;
+	}
+	inputFile	= BZ2_bzReadOpen(&errorCode, file, 0, 0, NULL, 0);
+	if (errorCode != BZ_OK){
+		internal_error("the trace is not bzip2 compressed");
+	}
+	out		= stdout;
+	if (argc > 2){
+		out	= fopen(argv[2], "w");
+		if (out == NULL){
+			fprintf(stderr, "ERROR: Opening %s: %s\n", argv[2], strerror(errno));
+			return 1;
+		}
+	}
+
+	/* Check the header.
+	 */
+	for (count = 0; count < DDG_TRACE_MAGIC_LENGTH; count++){
+		if (!internal_read_byte(&magic[count])){
+			internal_error("the trace is truncated");
+		}
+	}
+	if (memcmp(magic, DDG_TRACE_MAGIC, DDG_TRACE_MAGIC_LENGTH) != 0){
+		internal_error("the file is not a DDG trace");
+	}
+
+	/* Decode the chunks.
+	 */
+	currentThread	= 0;
+	while (JITTRUE){
+		JITUINT8	byte;
+		JITUINT64	threadID;
+		JITUINT64	bytes;
+
+		/* Fetch the thread of the chunk.
+		 */
+		if (!internal_read_byte(&byte)){
+			break ;
+		}
+		threadID	= internal_finish_varint(byte);
+		bytes		= internal_read_varint();
+
+		/* Allocate the state of new threads.
+		 */
+		if (threadID >= threadsNumber){
+			nextAddresses	= realloc(nextAddresses, sizeof(JITNUINT) * (threadID + 1));
+			if (nextAddresses == NULL){
+				internal_error("out of memory");
+			}
+			memset(nextAddresses + threadsNumber, 0, sizeof(JITNUINT) * (threadID + 1 - threadsNumber));
+			threadsNumber	= threadID + 1;
+		}
+
+		/* Decode the events.
+		 */
+		if (threadID != currentThread){
+			fprintf(out, "THREAD %u\n", (JITUINT32)threadID);
+			currentThread	= threadID;
+		}
+		internal_decode_chunk(threadID, bytes, out);
+	}
+
+	/* Close the files.
+	 */
+	BZ2_bzReadClose(&errorCode, inputFile);
+	fclose(file);
+	if (out != stdout){
+		fclose(out);
+	}
+	free(nextAddresses);
+
+	return 0;
+}
+
+static inline void internal_decode_chunk (JITUINT32 threadID, JITUINT64 bytes, FILE *out){
+	JITUINT64	end;
+
+	end	= consumedBytes + bytes;
+	while (consumedBytes < end){
+		JITUINT8	header;
+		JITUINT32	ID;
+		JITUINT32	count;
+
+		/* Fetch the event.
+		 */
+		if (!internal_read_byte(&header)){
+			internal_error("the trace is truncated");
+		}
+		ID	= 0;
+		if (DDG_eventHasID(header)){
+			ID	= (JITUINT32)internal_read_varint();
+		}
+
+		/* Dump the event.
+		 */
+		switch (header & DDG_EVENT_TYPE_MASK){
+			case DDG_EVENT_LOOP:
+				fprintf(out, "LOOP %u\n", ID);
+				break;
+			case DDG_EVENT_ENDLOOP:
+				fprintf(out, "ENDLOOP\n");
+				break;
+			case DDG_EVENT_METHOD:
+				fprintf(out, "METHOD %u\n", ID);
+				break;
+			case DDG_EVENT_ENDMETHOD:
+				fprintf(out, "ENDMETHOD\n");
+				break;
+			case DDG_EVENT_ITER:
+				fprintf(out, "ITER\n");
+				break;
+			case DDG_EVENT_CALL:
+				fprintf(out, "C %u\n", ID);
+				break;
+			case DDG_EVENT_OS:
+				fprintf(out, "OS\n");
+				break;
+			case DDG_EVENT_MEMORY:
+				fprintf(out, "M %u ", ID);
+				for (count = 0; count < 3; count++){
+					JITNUINT	first;
+					JITUINT32	size;
+
+					/* Dump the separator between input and output.
+					 */
+					if (count == 2){
+						fprintf(out, " , ");
+					}
+					if ((header & (DDG_EVENT_INPUT1 << count)) == 0){
+						continue ;
+					}
+
+					/* Dump the memory range.
+					 */
+					first				= nextAddresses[threadID] + (JITNUINT)DDG_unzigzag(internal_read_varint());
+					size				= (JITUINT32)internal_read_varint();
+					nextAddresses[threadID]		= first + size;
+					fprintf(out, count == 1 ? " %p - %p" : "%p - %p", (void *)first, (void *)(first + size - 1));
+				}
+				fprintf(out, "\n");
+				break;
+			default:
+				internal_error("unknown event");
+		}
+	}
+	if (consumedBytes != end){
+		internal_error("an event crosses the end of its chunk");
+	}
+
+	return ;
+}
+
+static inline JITUINT64 internal_read_varint (void){
+	JITUINT8	byte;
+
+	if (!internal_read_byte(&byte)){
+		internal_error("the trace is truncated");
+	}
+
+	return internal_finish_varint(byte);
+}
+
+/* Decode the varint whose first byte is byte.
+ */
+static inline JITUINT64 internal_finish_varint (JITUINT8 byte){
+	JITUINT64	value;
+	JITUINT32	shift;
+
+	value	= byte & 0x7F;
+	shift	= 7;
+	while (byte & 0x80){
+		if (	(shift > 63)			||
+			(!internal_read_byte(&byte))	){
+			internal_error("the trace is truncated");
+		}
+		value	|= ((JITUINT64)(byte & 0x7F)) << shift;
+		shift	+= 7;
+	}
+
+	return value;
+}
+
+static inline JITBOOLEAN internal_read_byte (JITUINT8 *byte){
+	JITINT32	errorCode;
+
+	if (inputPosition == inputBytes){
+		if (inputEnd){
+			return JITFALSE;
+		}
+		inputBytes	= BZ2_bzRead(&errorCode, inputFile, inputBuf, INPUT_BUF);
+		inputPosition	= 0;
+		if (errorCode == BZ_STREAM_END){
+			inputEnd	= JITTRUE;
+		} else if (errorCode != BZ_OK){
+			internal_error("the trace is corrupted");
+		}
+		if (inputBytes == 0){
+			return JITFALSE;
+		}
+	}
+	(*byte)		= inputBuf[inputPosition++];
+	consumedBytes++;
+
+	return JITTRUE;
+}
+
+static inline void internal_error (char *message){
+	fprintf(stderr, "ERROR: %s\n", message);
+	exit(1);
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2012  Campanoni Simone
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef DDG_TRACE_FORMAT_H
+#define DDG_TRACE_FORMAT_H
+
+#include <jitsystem.h>
+
+/* Binary trace produced by the runtime and decoded by ddg_trace_decode.
+ *
+ * The file (bzip2 compressed) starts with DDG_TRACE_MAGIC followed by a sequence of chunks:
+ *	<thread> <length> <length bytes of events>
+ * Events of a chunk have been generated by the same thread, in order.
+ * Every event starts with a header byte: the type of the event in the low bits and, for memory events, which of the ranges input1, input2 and output are present.
+ * Events LOOP, METHOD, MEMORY and CALL carry the ID of the loop, method or instruction, as written in loop_IDs.txt, method_IDs.txt and instruction_IDs.txt.
+ * Every memory range is the signed difference between its first byte and the byte following the last range of the same thread, followed by its size.
+ * Numbers are varints: 7 bits per byte, least significant first, the top bit set on every byte but the last; signed numbers are zig-zag encoded first.
+ */
+#define DDG_TRACE_MAGIC			"DDGTRACE1\n"
+#define DDG_TRACE_MAGIC_LENGTH		10
+#define DDG_TRACE_FILENAME		"ddg_trace.bin.bz2"
+
+#define DDG_EVENT_LOOP			1
+#define DDG_EVENT_ENDLOOP		2
+#define DDG_EVENT_METHOD		3
+#define DDG_EVENT_ENDMETHOD		4
+#define DDG_EVENT_ITER			5
+#define DDG_EVENT_MEMORY		6
+#define DDG_EVENT_CALL			7
+#define DDG_EVENT_OS			8
+#define DDG_EVENT_TYPE_MASK		0x0F
+
+#define DDG_EVENT_INPUT1		0x10
+#define DDG_EVENT_INPUT2		0x20
+#define DDG_EVENT_OUTPUT		0x40
+
+/* Largest encoding of an event: header, ID and three ranges */
+#define DDG_EVENT_MAX_BYTES		(1 + 5 + (3 * (10 + 5)))
+
+static inline JITBOOLEAN DDG_eventHasID (JITUINT8 type){
+	switch (type & DDG_EVENT_TYPE_MASK){
+		case DDG_EVENT_LOOP:
+		case DDG_EVENT_METHOD:
+		case DDG_EVENT_MEMORY:
+		case DDG_EVENT_CALL:
+			return JITTRUE;
+	}
+	return JITFALSE;
+}
+
+static inline JITUINT32 DDG_writeVarint (JITUINT8 *buf, JITUINT64 value){
+	JITUINT32	bytes;
+
+	bytes	= 0;
+	while (value >= 0x80){
+		buf[bytes++]	= (JITUINT8)(value | 0x80);
+		value		>>= 7;
+	}
+	buf[bytes++]	= (JITUINT8)value;
+
+	return bytes;
+}
+
+static inline JITUINT64 DDG_zigzag (JITINT64 value){
+	return (((JITUINT64)value) << 1) ^ (JITUINT64)(value >> 63);
+}
+
+static inline JITINT64 DDG_unzigzag (JITUINT64 value){
+	return (JITINT64)(value >> 1) ^ -(JITINT64)(value & 1);
+}
+
+#endif
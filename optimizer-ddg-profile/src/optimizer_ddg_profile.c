@@ -27,6 +27,7 @@
 // My headers
 #include <optimizer_ddg_profile.h>
 #include <code_injector.h>
+#include <runtime.h>
 #include <config.h>
 // End
 
@@ -89,6 +90,7 @@ static inline void ddg_profile_shutdown (JITFLOAT32 totalTime){
 	prefix		= NULL;
 
 	if (outputFile != NULL){
+		RUNTIME_shutdown();
 		BZ2_bzWriteClose(NULL, outputFile, 0, NULL, NULL);
 		outputFile	= NULL;
 	}
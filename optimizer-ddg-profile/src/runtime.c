@@ -16,6 +16,7 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 #include <assert.h>
+#include <time.h>
 #include <ir_optimization_interface.h>
 #include <iljit-utils.h>
 #include <jitsystem.h>
@@ -27,33 +28,107 @@
 // My headers
 #include <optimizer_ddg_profile.h>
 #include <code_injector.h>
+#include <runtime.h>
+#include <ddg_trace_format.h>
 // End
 
-static inline void internal_print_cycles (void);
+/* Events buffered per thread, power of two.
+ */
+#define RING_EVENTS		4096
+
+/* Nanoseconds the compressor sleeps when it finds every ring empty.
+ */
+#define COMPRESSOR_IDLE_NS	1000000
 
-extern XanHashTable				*loopNamesTable;
-extern XanHashTable				*methodNamesTable;
-extern XanHashTable				*loopProfileTable;
+/* Event generated by an instrumented thread.
+ */
+typedef struct {
+	JITUINT8	type;
+	JITUINT32	ID;
+	JITNUINT	addresses[3];
+	JITUINT32	sizes[3];
+} ddg_event_t;
+
+/* Single producer single consumer ring of the events of a thread.
+ * The thread is the only writer of head, the compressor is the only writer of tail.
+ */
+typedef struct event_ring_t {
+	ddg_event_t		events[RING_EVENTS];
+	JITUINT32		head;
+	JITUINT8		padding[64];
+	JITUINT32		tail;
+	JITUINT32		threadID;
+	JITNUINT		nextAddress;		/* Byte following the last range compressed */
+	struct event_ring_t	*next;
+} event_ring_t;
+
+static inline void internal_print_cycles (void);
+static inline void internal_push_event (JITUINT8 type, JITUINT32 ID, void *input1, JITUINT32 input1Size, void *input2, JITUINT32 input2Size, void *output, JITUINT32 outputSize);
+static inline event_ring_t * internal_new_ring (void);
+static inline JITBOOLEAN internal_compress_rings (void);
+static inline JITBOOLEAN internal_compress_ring (event_ring_t *ring);
+static inline void internal_write (void *buf, JITUINT32 bytes);
+static void * internal_compressor (void *arg);
 
 static JITBOOLEAN			disableDumper = JITFALSE;
 static BZFILE 				*internalOutputFile;
+static __thread event_ring_t		*threadRing = NULL;
+static event_ring_t			*rings = NULL;
+static JITUINT32			ringsNumber = 0;
+static pthread_mutex_t			ringsMutex;
+static pthread_t			compressorThread;
+static JITBOOLEAN			compressorRunning = JITFALSE;
+static JITBOOLEAN			compressorStop = JITFALSE;
+static JITUINT8				chunk[RING_EVENTS * DDG_EVENT_MAX_BYTES];
 
 void RUNTIME_init (BZFILE *compressedOutputFile){
 	internalOutputFile	= compressedOutputFile;
 	disableDumper 		= JITTRUE;
 
+	/* Dump the header of the trace.
+	 */
+	internal_write(DDG_TRACE_MAGIC, DDG_TRACE_MAGIC_LENGTH);
+
+	/* Start the thread that compresses the events.
+	 */
+	PLATFORM_initMutex(&ringsMutex, NULL);
+	compressorStop		= JITFALSE;
+	if (PLATFORM_createThread(&compressorThread, NULL, internal_compressor, NULL) != 0){
+		abort();
+	}
+	compressorRunning	= JITTRUE;
+
 	return ;
 }
 
-void dump_start_loop (JITINT8 *loopName){
-	JITINT32	loopID;
-	JITINT32 	errorCode;
-	JITINT8         buf[DIM_BUF];
+void RUNTIME_shutdown (void){
+	if (!compressorRunning){
+		return ;
+	}
+
+	/* Drop the events generated from now on.
+	 */
+	__atomic_store_n(&disableDumper, JITTRUE, __ATOMIC_RELEASE);
+
+	/* Wait for the compressor to dump the events left.
+	 */
+	__atomic_store_n(&compressorStop, JITTRUE, __ATOMIC_RELEASE);
+	PLATFORM_joinThread(compressorThread, NULL);
+	compressorRunning	= JITFALSE;
+
+	/* Rings are not freed: instrumented threads can still be running and they keep pointing to their ring until the process exits.
+	 */
+
+	return ;
+}
+
+void dump_start_loop (loop_profile_t *loop){
 
 	/* Check if we need to enable the dumper.
 	 */
 	if (	(disableDumper)							&&
-		(xanHashTable_lookup(loopProfileTable, loopName) != NULL)	){
+		(loop->flag1)							&&
+		(!__atomic_load_n(&compressorStop, __ATOMIC_ACQUIRE))	){
 		disableDumper	= JITFALSE;
 	}
 
@@ -62,183 +137,263 @@ void dump_start_loop (JITINT8 *loopName){
 	}
 	internal_print_cycles();
 
-	loopID	= (JITINT32)(JITNUINT)xanHashTable_lookup(loopNamesTable, loopName);
-	assert(loopID > 0);
-
-	SNPRINTF(buf, DIM_BUF, "LOOP %u\n", loopID);
-	BZ2_bzWrite(&errorCode, internalOutputFile, buf, STRLEN(buf));
-	if (errorCode != BZ_OK){
-		abort();
-	}
+	assert(loop->userData != NULL);
+	internal_push_event(DDG_EVENT_LOOP, (JITUINT32)(JITNUINT)loop->userData, NULL, 0, NULL, 0, NULL, 0);
 
 	return ;
 }
 
 void dump_call_instruction (JITUINT32 instructionID){
-	JITINT32 	errorCode;
-	JITINT8         buf[DIM_BUF];
-
 	if (disableDumper){
 		return ;
 	}
 	internal_print_cycles();
 
-	SNPRINTF(buf, DIM_BUF, "C %u\n", instructionID);
-	BZ2_bzWrite(&errorCode, internalOutputFile, buf, STRLEN(buf));
-	if (errorCode != BZ_OK){
-		abort();
-	}
+	internal_push_event(DDG_EVENT_CALL, instructionID, NULL, 0, NULL, 0, NULL, 0);
 
 	return ;
 }
 
 void dump_os_instruction (void){
-	JITINT32 	errorCode;
-	JITINT8         buf[DIM_BUF];
-
 	if (disableDumper){
 		return ;
 	}
 	internal_print_cycles();
 
-	SNPRINTF(buf, DIM_BUF, "OS\n");
-	BZ2_bzWrite(&errorCode, internalOutputFile, buf, STRLEN(buf));
-	if (errorCode != BZ_OK){
-		abort();
-	}
+	internal_push_event(DDG_EVENT_OS, 0, NULL, 0, NULL, 0, NULL, 0);
 
 	return ;
 }
 
 void dump_end_loop (void){
-	JITINT32 	errorCode;
-	JITINT8         buf[DIM_BUF];
-
 	if (disableDumper){
 		return ;
 	}
 	internal_print_cycles();
 
-	SNPRINTF(buf, DIM_BUF, "ENDLOOP\n");
-	BZ2_bzWrite(&errorCode, internalOutputFile, buf, STRLEN(buf));
-	if (errorCode != BZ_OK){
-		abort();
-	}
+	internal_push_event(DDG_EVENT_ENDLOOP, 0, NULL, 0, NULL, 0, NULL, 0);
 
 	return ;
 }
 
-void dump_start_method (char *methodName){
-	JITINT32 	errorCode;
-	JITINT8         buf[DIM_BUF];
-
+void dump_start_method (JITUINT32 methodID){
 	if (disableDumper){
 		return ;
 	}
 
-	SNPRINTF(buf, DIM_BUF, "METHOD %u\n", (JITUINT32)(JITNUINT)xanHashTable_lookup(methodNamesTable, methodName));
-	BZ2_bzWrite(&errorCode, internalOutputFile, buf, STRLEN(buf));
-	if (errorCode != BZ_OK){
-		abort();
-	}
+	internal_push_event(DDG_EVENT_METHOD, methodID, NULL, 0, NULL, 0, NULL, 0);
 
 	return ;
 }
 
 void dump_end_method (void){
-	JITINT32 	errorCode;
-	JITINT8         buf[DIM_BUF];
-
 	if (disableDumper){
 		return ;
 	}
 
-	SNPRINTF(buf, DIM_BUF, "ENDMETHOD\n");
-	BZ2_bzWrite(&errorCode, internalOutputFile, buf, STRLEN(buf));
-	if (errorCode != BZ_OK){
-		abort();
-	}
+	internal_push_event(DDG_EVENT_ENDMETHOD, 0, NULL, 0, NULL, 0, NULL, 0);
 
 	return ;
 }
 
 void dump_start_loop_iteration (void){
-	JITINT32 	errorCode;
-	JITINT8         buf[DIM_BUF];
-
 	if (disableDumper){
 		return ;
 	}
 	internal_print_cycles();
 
-	SNPRINTF(buf, DIM_BUF, "ITER\n");
-	BZ2_bzWrite(&errorCode, internalOutputFile, buf, STRLEN(buf));
-	if (errorCode != BZ_OK){
-		abort();
-	}
+	internal_push_event(DDG_EVENT_ITER, 0, NULL, 0, NULL, 0, NULL, 0);
 
 	return ;
 }
 
 void dump_memory_instruction (JITUINT32 instructionPosition, void *input1, JITUINT32 input1Size, void *input2, JITUINT32 input2Size, void *output, JITUINT32 outputSize){
-	JITINT32 	errorCode;
-	JITINT8         buf[DIM_BUF];
-
 	if (disableDumper){
 		return ;
 	}
 	internal_print_cycles();
 
-	/* Dump the instruction ID.
+	internal_push_event(DDG_EVENT_MEMORY, instructionPosition, input1, input1Size, input2, input2Size, output, outputSize);
+
+	return ;
+}
+
+static inline void internal_push_event (JITUINT8 type, JITUINT32 ID, void *input1, JITUINT32 input1Size, void *input2, JITUINT32 input2Size, void *output, JITUINT32 outputSize){
+	event_ring_t	*ring;
+	ddg_event_t	*event;
+	JITUINT32	head;
+
+	/* Nobody compresses the events once the runtime has been shut down.
 	 */
-	SNPRINTF(buf, DIM_BUF, "M %u ", instructionPosition);
-	BZ2_bzWrite(&errorCode, internalOutputFile, buf, STRLEN(buf));
-	if (errorCode != BZ_OK){
-		abort();
+	if (__atomic_load_n(&compressorStop, __ATOMIC_ACQUIRE)){
+		return ;
+	}
+
+	/* Fetch the ring of the current thread.
+	 */
+	ring	= threadRing;
+	if (ring == NULL){
+		ring	= internal_new_ring();
+	}
+
+	/* Wait for the compressor to make room for the event.
+	 */
+	head	= ring->head;
+	while ((head - __atomic_load_n(&(ring->tail), __ATOMIC_ACQUIRE)) == RING_EVENTS){
+		if (__atomic_load_n(&compressorStop, __ATOMIC_ACQUIRE)){
+			return ;
+		}
+		PLATFORM_sched_yield();
 	}
 
-	/* Dump the input memory ranges.
+	/* Fill up the event.
+	 * Only memory ranges that exist are recorded.
 	 */
+	event		= &(ring->events[head & (RING_EVENTS - 1)]);
+	event->ID	= ID;
 	if (	(input1 != NULL)	&&
 		(input1Size > 0)	){
-		SNPRINTF(buf, DIM_BUF, "%p - %p", input1, (void *)(((JITNUINT) input1) + input1Size - 1));
-		BZ2_bzWrite(&errorCode, internalOutputFile, buf, STRLEN(buf));
-		if (errorCode != BZ_OK){
-			abort();
-		}
+		type			|= DDG_EVENT_INPUT1;
+		event->addresses[0]	= (JITNUINT)input1;
+		event->sizes[0]		= input1Size;
 	}
 	if (	(input2 != NULL)	&&
 		(input2Size > 0)	){
-		SNPRINTF(buf, DIM_BUF, " %p - %p", input2, (void *)(((JITNUINT) input2) + input2Size - 1));
-		BZ2_bzWrite(&errorCode, internalOutputFile, buf, STRLEN(buf));
-		if (errorCode != BZ_OK){
-			abort();
+		type			|= DDG_EVENT_INPUT2;
+		event->addresses[1]	= (JITNUINT)input2;
+		event->sizes[1]		= input2Size;
+	}
+	if (	(output != NULL)	&&
+		(outputSize > 0)	){
+		type			|= DDG_EVENT_OUTPUT;
+		event->addresses[2]	= (JITNUINT)output;
+		event->sizes[2]		= outputSize;
+	}
+	event->type	= type;
+
+	/* Publish the event.
+	 */
+	__atomic_store_n(&(ring->head), head + 1, __ATOMIC_RELEASE);
+
+	return ;
+}
+
+static inline event_ring_t * internal_new_ring (void){
+	event_ring_t	*ring;
+
+	/* Allocate the ring.
+	 */
+	ring	= allocFunction(sizeof(event_ring_t));
+	assert(ring != NULL);
+
+	/* Make the ring visible to the compressor.
+	 * Rings are only added to the head of the list, so the compressor can walk it without the lock.
+	 */
+	PLATFORM_lockMutex(&ringsMutex);
+	ring->threadID	= ringsNumber++;
+	ring->next	= rings;
+	__atomic_store_n(&rings, ring, __ATOMIC_RELEASE);
+	PLATFORM_unlockMutex(&ringsMutex);
+	threadRing	= ring;
+
+	return ring;
+}
+
+static void * internal_compressor (void *arg){
+	struct timespec		idle;
+
+	idle.tv_sec	= 0;
+	idle.tv_nsec	= COMPRESSOR_IDLE_NS;
+	while (JITTRUE){
+		JITBOOLEAN	stop;
+
+		/* Events published before the stop request are all compressed by the time a pass finds the rings empty.
+		 */
+		stop	= __atomic_load_n(&compressorStop, __ATOMIC_ACQUIRE);
+		if (internal_compress_rings()){
+			continue ;
+		}
+		if (stop){
+			break ;
 		}
+		PLATFORM_nanosleep(&idle, NULL);
 	}
 
-	/* Dump the separator between input and output.
+	return NULL;
+}
+
+static inline JITBOOLEAN internal_compress_rings (void){
+	event_ring_t	*ring;
+	JITBOOLEAN	compressed;
+
+	compressed	= JITFALSE;
+	ring		= __atomic_load_n(&rings, __ATOMIC_ACQUIRE);
+	while (ring != NULL){
+		if (internal_compress_ring(ring)){
+			compressed	= JITTRUE;
+		}
+		ring	= ring->next;
+	}
+
+	return compressed;
+}
+
+static inline JITBOOLEAN internal_compress_ring (event_ring_t *ring){
+	JITUINT8	header[10];
+	JITUINT32	headerBytes;
+	JITUINT32	bytes;
+	JITUINT32	head;
+	JITUINT32	tail;
+
+	/* Fetch the events published.
 	 */
-	SNPRINTF(buf, DIM_BUF, " , ");
-	BZ2_bzWrite(&errorCode, internalOutputFile, buf, STRLEN(buf));
-	if (errorCode != BZ_OK){
-		abort();
+	tail	= ring->tail;
+	head	= __atomic_load_n(&(ring->head), __ATOMIC_ACQUIRE);
+	if (head == tail){
+		return JITFALSE;
 	}
 
-	/* Dump the output memory range.
+	/* Encode the events.
 	 */
-	if (	(output != NULL)	&&
-		(outputSize > 0)	){
-		SNPRINTF(buf, DIM_BUF, "%p - %p", output, (void *)(((JITNUINT) output) + outputSize - 1));
-		BZ2_bzWrite(&errorCode, internalOutputFile, buf, STRLEN(buf));
-		if (errorCode != BZ_OK){
-			abort();
+	bytes	= 0;
+	while (tail != head){
+		ddg_event_t	*event;
+		JITUINT32	count;
+
+		event		= &(ring->events[tail & (RING_EVENTS - 1)]);
+		chunk[bytes++]	= event->type;
+		if (DDG_eventHasID(event->type)){
+			bytes	+= DDG_writeVarint(chunk + bytes, event->ID);
+		}
+		for (count = 0; count < 3; count++){
+			if ((event->type & (DDG_EVENT_INPUT1 << count)) == 0){
+				continue ;
+			}
+			bytes			+= DDG_writeVarint(chunk + bytes, DDG_zigzag((JITINT64)(JITNINT)(event->addresses[count] - ring->nextAddress)));
+			bytes			+= DDG_writeVarint(chunk + bytes, event->sizes[count]);
+			ring->nextAddress	= event->addresses[count] + event->sizes[count];
 		}
+		tail++;
 	}
 
-	/* Dump the terminator.
+	/* Give the slots back to the thread.
 	 */
-	SNPRINTF(buf, DIM_BUF, "\n");
-	BZ2_bzWrite(&errorCode, internalOutputFile, buf, STRLEN(buf));
+	__atomic_store_n(&(ring->tail), tail, __ATOMIC_RELEASE);
+
+	/* Dump the chunk.
+	 */
+	headerBytes	= DDG_writeVarint(header, ring->threadID);
+	headerBytes	+= DDG_writeVarint(header + headerBytes, bytes);
+	internal_write(header, headerBytes);
+	internal_write(chunk, bytes);
+
+	return JITTRUE;
+}
+
+static inline void internal_write (void *buf, JITUINT32 bytes){
+	JITINT32 	errorCode;
+
+	BZ2_bzWrite(&errorCode, internalOutputFile, buf, bytes);
 	if (errorCode != BZ_OK){
 		abort();
 	}
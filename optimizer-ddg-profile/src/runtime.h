@@ -20,11 +20,13 @@
 
 #include <zlib.h>
 #include <jitsystem.h>
+#include <chiara.h>
 
 void RUNTIME_init (BZFILE *compressedOutputFile);
-void dump_start_loop (JITINT8 *loopName);
+void RUNTIME_shutdown (void);
+void dump_start_loop (loop_profile_t *loop);
 void dump_end_loop (void);
-void dump_start_method (char *methodName);
+void dump_start_method (JITUINT32 methodID);
 void dump_end_method (void);
 void dump_start_loop_iteration (void);
 void dump_memory_instruction (JITUINT32 instructionPosition, void *input1, JITUINT32 input1Size, void *input2, JITUINT32 input2Size, void *output, JITUINT32 outputSize);
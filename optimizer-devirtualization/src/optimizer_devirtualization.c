@@ -0,0 +1,286 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <ir_optimization_interface.h>
+#include <ir_language.h>
+#include <iljit-utils.h>
+#include <compiler_memory_manager.h>
+#include <ildjit.h>
+
+// My headers
+#include <optimizer_devirtualization.h>
+#include <config.h>
+// End
+
+#define INFORMATIONS 	"Transforms virtual calls into direct calls by using the class hierarchy"
+#define	AUTHOR		"ILDJIT developers"
+#define JOB		METHOD_DEVIRTUALIZATION
+
+static inline JITUINT64 devirtualization_get_ID_job (void);
+static inline char * devirtualization_get_version (void);
+static inline void devirtualization_do_job (ir_method_t * method);
+static inline char * devirtualization_get_informations (void);
+static inline char * devirtualization_get_author (void);
+static inline JITUINT64 devirtualization_get_dependences (void);
+static inline void devirtualization_shutdown (JITFLOAT32 totalTime);
+static inline void devirtualization_init (ir_lib_t *lib, ir_optimizer_t *optimizer, char *outputPrefix);
+static inline JITUINT64 devirtualization_get_invalidations (void);
+static inline void devirtualization_getCompilationTime (char *buffer, JITINT32 bufferLength);
+static inline void devirtualization_getCompilationFlags (char *buffer, JITINT32 bufferLength);
+static inline void internal_convert_to_direct_call (ir_method_t *method, ir_instruction_t *inst, IR_ITEM_VALUE targetID);
+static inline void internal_guard_direct_call (ir_method_t *method, ir_instruction_t *inst, IR_ITEM_VALUE targetID);
+
+ir_lib_t	*irLib		= NULL;
+ir_optimizer_t	*irOptimizer	= NULL;
+char 	        *prefix		= NULL;
+
+ir_optimization_interface_t plugin_interface = {
+    devirtualization_get_ID_job,
+    devirtualization_get_dependences,
+    devirtualization_init,
+    devirtualization_shutdown,
+    devirtualization_do_job,
+    devirtualization_get_version,
+    devirtualization_get_informations,
+    devirtualization_get_author,
+    devirtualization_get_invalidations,
+    NULL,
+    devirtualization_getCompilationFlags,
+    devirtualization_getCompilationTime
+};
+
+static inline void devirtualization_init (ir_lib_t *lib, ir_optimizer_t *optimizer, char *outputPrefix) {
+
+    /* Assertions			*/
+    assert(lib != NULL);
+    assert(optimizer != NULL);
+    assert(outputPrefix != NULL);
+
+    irLib		= lib;
+    irOptimizer	= optimizer;
+    prefix		= outputPrefix;
+}
+
+static inline void devirtualization_shutdown (JITFLOAT32 totalTime) {
+    irLib		= NULL;
+    irOptimizer	= NULL;
+    prefix		= NULL;
+}
+
+static inline JITUINT64 devirtualization_get_ID_job (void) {
+    return JOB;
+}
+
+static inline JITUINT64 devirtualization_get_dependences (void) {
+    return 0;
+}
+
+static inline JITUINT64 devirtualization_get_invalidations (void) {
+    return INVALIDATE_ALL;
+}
+
+static inline void devirtualization_do_job (ir_method_t * method) {
+    XanList			*vcalls;
+    XanListItem		*item;
+    JITBOOLEAN		dynamicScheme;
+    JITUINT32		instructionsNumber;
+    JITUINT32		count;
+
+    /* Assertions			*/
+    assert(method != NULL);
+
+    /* The class hierarchy is known only for the types laid out so far, whatever the compilation scheme is.
+     * Hence every direct call is guarded; dynamic schemes also recompile the method when a new type overrides the callee.
+     */
+    dynamicScheme	= !ILDJIT_isAStaticCompilationScheme(ILDJIT_compilationSchemeInUse());
+
+    /* Fetch the virtual calls.
+     * They are collected first because the guards add instructions to the method.
+     * Calls left on the slow path of a guard are skipped, so running the pass again does not guard them twice.
+     */
+    vcalls			= xanList_new(allocFunction, freeFunction, NULL);
+    instructionsNumber	= IRMETHOD_getInstructionsNumber(method);
+    for (count = 0; count < instructionsNumber; count++) {
+        ir_instruction_t	*inst;
+        inst	= IRMETHOD_getInstructionAtPosition(method, count);
+        if (	(IRMETHOD_getInstructionType(inst) == IRVCALL)				&&
+                (IRMETHOD_getInstructionMetadata(inst, JOB) == NULL)	) {
+            xanList_append(vcalls, inst);
+        }
+    }
+
+    /* Devirtualize the calls	*/
+    item	= xanList_first(vcalls);
+    while (item != NULL) {
+        ir_instruction_t	*inst;
+        IR_ITEM_VALUE		calleeID;
+        IR_ITEM_VALUE		targetID;
+
+        /* Fetch the only implementation of the called method.
+         */
+        inst		= item->data;
+        calleeID	= IRMETHOD_getInstructionParameter1Value(inst);
+        targetID	= IRPROGRAM_getTheOnlyImplementationOfMethod(calleeID);
+        if (targetID == 0) {
+            item	= item->next;
+            continue ;
+        }
+
+        /* Tail calls have to stay the last instruction before returning and the function pointer has to be a variable to be compared.
+         */
+        if (	(IRMETHOD_getInstructionParameter2Value(inst) != 0)	||
+                (IRMETHOD_getInstructionParameter3Type(inst) != IROFFSET)	) {
+            item	= item->next;
+            continue ;
+        }
+
+        /* Transform the call.
+         */
+        PDEBUG("%s: call to %s is guarded\n", IRMETHOD_getCompleteMethodName(method), IRMETHOD_getCompleteMethodName(IRMETHOD_getIRMethodFromMethodID(method, targetID)));
+        internal_guard_direct_call(method, inst, targetID);
+        method->modified	= JITTRUE;
+
+        /* The guard keeps the call correct if a new type overrides the called method, but the fast path becomes useless.
+         * Ask to recompile the method in that case.
+         */
+        if (dynamicScheme) {
+            IRPROGRAM_addImplementationsDependence(method, calleeID);
+        }
+
+        /* Fetch the next element	*/
+        item	= item->next;
+    }
+
+    /* Free the memory		*/
+    xanList_destroyList(vcalls);
+
+    return ;
+}
+
+static inline void internal_convert_to_direct_call (ir_method_t *method, ir_instruction_t *inst, IR_ITEM_VALUE targetID) {
+
+    /* Assertions			*/
+    assert(method != NULL);
+    assert(inst != NULL);
+    assert(targetID != 0);
+
+    /* The parameters of the call do not change: the body overrides the called method, so they share the signature.
+     * The tail flag (the second parameter) is kept.
+     */
+    IRMETHOD_setInstructionType(method, inst, IRCALL);
+    IRMETHOD_setInstructionParameter1(method, inst, targetID, 0, IRMETHODID, IRMETHODID, NULL);
+    IRMETHOD_setInstructionParameter3Type(method, inst, NOPARAM);
+
+    return ;
+}
+
+static inline void internal_guard_direct_call (ir_method_t *method, ir_instruction_t *inst, IR_ITEM_VALUE targetID) {
+    ir_instruction_t	*compare;
+    ir_instruction_t	*branch;
+    ir_instruction_t	*directCall;
+    ir_instruction_t	*slowPathLabel;
+    ir_instruction_t	*endLabel;
+    ir_item_t		entryPoint;
+
+    /* Assertions			*/
+    assert(method != NULL);
+    assert(inst != NULL);
+    assert(targetID != 0);
+
+    /* The code becomes:
+     *	t = fp == entryPoint(target)
+     *	branchifnot t L_slow
+     *	call target
+     *	branch L_end
+     * L_slow:
+     *	vcall fp
+     * L_end:
+     */
+    slowPathLabel	= IRMETHOD_newLabelBefore(method, inst);
+    endLabel	= IRMETHOD_newLabelAfter(method, inst);
+
+    /* Compare the function pointer loaded from the virtual table with the entry point of the expected body.
+     */
+    IRDATA_setFunctionPointerOfMethod(&entryPoint, targetID);
+    compare		= IRMETHOD_newInstructionOfTypeBefore(method, slowPathLabel, IREQ);
+    IRMETHOD_cpInstructionParameter(method, inst, 3, compare, 1);
+    IRMETHOD_setInstructionParameter2(method, compare, (entryPoint.value).v, 0, entryPoint.type, entryPoint.internal_type, NULL);
+    IRMETHOD_setInstructionParameterWithANewVariable(method, compare, IRINT32, NULL, 0);
+
+    /* Take the virtual call if the object has another type.
+     */
+    branch		= IRMETHOD_newInstructionOfTypeBefore(method, slowPathLabel, IRBRANCHIFNOT);
+    IRMETHOD_cpInstructionParameter(method, compare, 0, branch, 1);
+    IRMETHOD_setInstructionParameter2(method, branch, IRMETHOD_getInstructionParameter1Value(slowPathLabel), 0, IRLABELITEM, IRLABELITEM, NULL);
+
+    /* Fast path: the direct call can be inlined.
+     */
+    directCall	= IRMETHOD_cloneInstructionAndInsertBefore(method, inst, slowPathLabel);
+    internal_convert_to_direct_call(method, directCall, targetID);
+    IRMETHOD_newBranchToLabelBefore(method, endLabel, slowPathLabel);
+
+    /* Mark the virtual call as guarded	*/
+    if (inst->metadata == NULL) {
+        IRMETHOD_allocateMethodExtraMemory(method);
+    }
+    IRMETHOD_setInstructionMetadata(inst, JOB, inst);
+
+    return ;
+}
+
+static inline char * devirtualization_get_version (void) {
+    return VERSION;
+}
+
+static inline char * devirtualization_get_informations (void) {
+    return INFORMATIONS;
+}
+
+static inline char * devirtualization_get_author (void) {
+    return AUTHOR;
+}
+
+static inline void devirtualization_getCompilationFlags (char *buffer, JITINT32 bufferLength) {
+
+    /* Assertions				*/
+    assert(buffer != NULL);
+
+    snprintf(buffer, sizeof(char) * bufferLength, " ");
+#ifdef DEBUG
+    strncat(buffer, "DEBUG ", sizeof(char) * bufferLength);
+#endif
+#ifdef PRINTDEBUG
+    strncat(buffer, "PRINTDEBUG ", sizeof(char) * bufferLength);
+#endif
+#ifdef PROFILE
+    strncat(buffer, "PROFILE ", sizeof(char) * bufferLength);
+#endif
+}
+
+static inline void devirtualization_getCompilationTime (char *buffer, JITINT32 bufferLength) {
+
+    /* Assertions				*/
+    assert(buffer != NULL);
+
+    snprintf(buffer, sizeof(char) * bufferLength, "%s %s", __DATE__, __TIME__);
+
+    /* Return				*/
+    return;
+}
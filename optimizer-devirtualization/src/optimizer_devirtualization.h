@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef OPTIMIZER_DEVIRTUALIZATION_H
+#define OPTIMIZER_DEVIRTUALIZATION_H
+
+#include <xanlib.h>
+#include <jitsystem.h>
+#include <ir_method.h>
+
+#ifdef PRINTDEBUG
+#define PDEBUG(fmt, args...) fprintf(stderr, "DEVIRTUALIZATION: " fmt, ## args)
+#else
+#define PDEBUG(fmt, args...)
+#endif
+
+#endif
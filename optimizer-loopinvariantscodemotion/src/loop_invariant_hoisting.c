@@ -17,14 +17,14 @@
  */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 #include <ir_method.h>
 #include <ir_optimization_interface.h>
 #include <jitsystem.h>
 #include <ir_language.h>
-#include <xanlib.h>
+#include <iljit-utils.h>
 #include <compiler_memory_manager.h>
-#include <chiara.h>
 
 // My headers
 #include <loop_invariant_hoisting.h>
@@ -43,139 +43,372 @@ static inline JITUINT64 loop_invariant_get_invalidations (void);
 static inline char *get_version (void);
 static inline char * get_informations (void) ;
 static inline char *get_author (void);
-static inline JITBOOLEAN internal_move_loop_invariant (loop_t *loop);
+static inline void loop_invariant_getCompilationTime (char *buffer, JITINT32 bufferLength);
+static inline void loop_invariant_getCompilationFlags (char *buffer, JITINT32 bufferLength);
+static inline JITBOOLEAN internal_move_loop_invariant (ir_method_t *method, circuit_t *loop);
+static inline JITBOOLEAN internal_is_hoistable_instruction_type (ir_instruction_t *inst);
+static inline JITBOOLEAN internal_is_hoistable (ir_method_t *method, circuit_t *loop, ir_instruction_t *header, XanList *loopInsts, ir_instruction_t *inst);
+static inline JITBOOLEAN internal_are_operands_available (ir_method_t *method, ir_instruction_t *inst, XanList *loopInsts, XanHashTable *hoisted);
+static inline void internal_compute_loops_information (ir_method_t *method);
 
 ir_lib_t *irLib = NULL;
 ir_optimizer_t	*irOptimizer	= NULL;
 
 ir_optimization_interface_t plugin_interface = {
-  loop_invariant_get_ID_job,
-  loop_invariant_get_dependences,
-  loop_invariant_init,
-  loop_invariant_shutdown,
-  loop_invariant_do_job,
-  get_version,
-  get_informations,
-  get_author,
-  loop_invariant_get_invalidations
+    loop_invariant_get_ID_job,
+    loop_invariant_get_dependences,
+    loop_invariant_init,
+    loop_invariant_shutdown,
+    loop_invariant_do_job,
+    get_version,
+    get_informations,
+    get_author,
+    loop_invariant_get_invalidations,
+    NULL,
+    loop_invariant_getCompilationFlags,
+    loop_invariant_getCompilationTime
 };
 
-static inline JITUINT64 loop_invariant_get_invalidations (void){
-	return INVALIDATE_ALL;
+static inline JITUINT64 loop_invariant_get_invalidations (void) {
+    return INVALIDATE_ALL;
 }
 
-static inline void loop_invariant_init (ir_lib_t * lib, ir_optimizer_t * optimizer, char *outputPrefix){
-  irLib 	= lib;
-  irOptimizer	= optimizer;
+static inline void loop_invariant_init (ir_lib_t * lib, ir_optimizer_t * optimizer, char *outputPrefix) {
+    irLib 		= lib;
+    irOptimizer	= optimizer;
 }
 
 static inline void loop_invariant_shutdown (JITFLOAT32 totalTime) {
-  irLib = NULL;
+    irLib 		= NULL;
+    irOptimizer	= NULL;
 }
 
 static inline JITUINT64 loop_invariant_get_ID_job (void) {
-  return LOOP_INVARIANT_CODE_HOISTING;
+    return LOOP_INVARIANT_CODE_HOISTING;
 }
 
 static inline JITUINT64 loop_invariant_get_dependences (void) {
-  return LIVENESS_ANALYZER | REACHING_DEFINITIONS_ANALYZER | LOOP_IDENTIFICATION;
+    return LIVENESS_ANALYZER | REACHING_DEFINITIONS_ANALYZER | ESCAPES_ANALYZER | PRE_DOMINATOR_COMPUTER | LOOP_IDENTIFICATION | LOOP_INVARIANTS_IDENTIFICATION;
 }
 
-static inline void loop_invariant_do_job (ir_method_t * method){
-	XanHashTable *loops;
-	XanNode *loopsTree;
-	XanList *loopsOrder;
-	XanListItem *item;
+static inline void loop_invariant_do_job (ir_method_t * method) {
+    JITBOOLEAN	modified;
+    JITUINT32	rounds;
 
-	/* Check if the method has some loops		*/
-	if (	(!IRMETHOD_hasMethodInstructions(method))	||
-		(!IRMETHOD_hasMethodLoops(method))		){
-		return;
-	}
+    /* Assertions				*/
+    assert(method != NULL);
 
-	/* Fetch the list of loops			*/
-	loops = LOOPS_analyzeMethodLoops(irOptimizer, method);
-	assert(loops != NULL);
+    /* Check if the method has some loops	*/
+    if (!IRMETHOD_hasMethodInstructions(method)) {
+        return;
+    }
 
-	/* Fetch the tree of loops			*/
-	loopsTree = LOOPS_getMethodLoopsNestingTree(loops, method);
-	assert(loopsTree != NULL);
+    /* Hoist the invariants of one circuit at a time.
+     * Adding a pre-header changes the positions of instructions and therefore it invalidates the information about every circuit of the method.
+     */
+    rounds		= 0;
+    modified	= JITTRUE;
+    while (	modified 				&&
+            (rounds < MAX_HOISTING_ROUNDS)		&&
+            IRMETHOD_hasMethodCircuits(method)	) {
+        XanList		*loops;
+        XanListItem	*item;
 
-	/* Fetch the order to consider the loops	*/
-	loopsOrder = loopsTree->toPreOrderList(loopsTree);
-	assert(loopsOrder != NULL);
+        /* Consider outermost circuits last; this way invariants of inner circuits can be hoisted further out in the next rounds.
+         */
+        modified	= JITFALSE;
+        loops		= IRMETHOD_getMethodCircuits(method);
+        item		= xanList_last(loops);
+        while (item != NULL) {
+            circuit_t	*loop;
 
-	/* Optimize the loops				*/
-	item = xanList_first(loopsOrder);
-	while (item != NULL){
-		loop_t *loop;
+            /* Fetch the loop		*/
+            loop	= item->data;
+            assert(loop != NULL);
 
-		/* Fetch the loop				*/
-		loop = item->data;
-		if (loop != NULL){
+            /* Optimize the loop		*/
+            if (	(loop->loop_id != 0)				&&
+                    (internal_move_loop_invariant(method, loop))	) {
+                modified	= JITTRUE;
+                break ;
+            }
 
-			/* Optimize the loop				*/
-			internal_move_loop_invariant(loop);
-		}
+            /* Fetch the next loop		*/
+            item	= item->prev;
+        }
+        xanList_destroyList(loops);
 
-		/* Fetch the next loop				*/
-		item = item->next;
-	}
+        /* Refresh the information.
+         */
+        if (modified) {
+            internal_compute_loops_information(method);
+        }
+        rounds++;
+    }
 
-	/* Free the memory				*/
-	LOOPS_destroyLoops(loops);
-	xanList_destroyList(loopsOrder);
-	loopsTree->destroyTree(loopsTree);
+    return ;
+}
+
+static inline JITBOOLEAN internal_move_loop_invariant (ir_method_t *method, circuit_t *loop) {
+    XanList			*invariants;
+    XanList			*candidates;
+    XanList			*loopInsts;
+    XanList			*toHoist;
+    XanHashTable		*hoisted;
+    XanListItem		*item;
+    ir_instruction_t	*header;
+    ir_instruction_t	*preHeader;
+    JITBOOLEAN		added;
+
+    /* Assertions					*/
+    assert(method != NULL);
+    assert(loop != NULL);
+
+    /* Check if there are invariants		*/
+    if (loop->invariants == NULL) {
+        return JITFALSE;
+    }
+    header	= IRMETHOD_getTheDestinationOfTheCircuitBackedge(loop);
+    if (header == NULL) {
+        return JITFALSE;
+    }
+
+    /* Fetch the instructions of the loop.
+     * Circuits that share the header are considered together because the pre-header is shared as well.
+     */
+    loopInsts	= IRMETHOD_getInstructionsWithinAnyCircuitsOfSameHeader(method, header);
+
+    /* Select the invariants that are safe to execute before the loop.
+     */
+    candidates	= xanList_new(allocFunction, freeFunction, NULL);
+    invariants	= IRMETHOD_getCircuitInvariants(method, loop);
+    item		= xanList_first(invariants);
+    while (item != NULL) {
+        ir_instruction_t	*inv;
+        inv	= item->data;
+        assert(inv != NULL);
+        if (internal_is_hoistable(method, loop, header, loopInsts, inv)) {
+            xanList_append(candidates, inv);
+        }
+        item	= item->next;
+    }
+    xanList_destroyList(invariants);
+
+    /* Order the candidates by their dependences: an instruction is hoisted only after every definition of its operands within the loop has been hoisted.
+     */
+    toHoist	= xanList_new(allocFunction, freeFunction, NULL);
+    hoisted	= xanHashTable_new(11, JITFALSE, allocFunction, dynamicReallocFunction, freeFunction, NULL, NULL);
+    do {
+        added	= JITFALSE;
+        item	= xanList_first(candidates);
+        while (item != NULL) {
+            ir_instruction_t	*inv;
+            XanListItem		*next;
+            inv	= item->data;
+            next	= item->next;
+            if (internal_are_operands_available(method, inv, loopInsts, hoisted)) {
+                xanList_append(toHoist, inv);
+                xanHashTable_insert(hoisted, inv, inv);
+                xanList_deleteItem(candidates, item);
+                added	= JITTRUE;
+            }
+            item	= next;
+        }
+    } while (added);
+    xanList_destroyList(candidates);
+    xanHashTable_destroyTable(hoisted);
+    xanList_destroyList(loopInsts);
+
+    /* Check if there is something to hoist	*/
+    if (xanList_length(toHoist) == 0) {
+        xanList_destroyList(toHoist);
+        return JITFALSE;
+    }
 
-	/* Return					*/
-	return ;
+    /* Add the preheader				*/
+    preHeader	= IRMETHOD_addCircuitPreHeader(method, loop);
+    if (preHeader == NULL) {
+        xanList_destroyList(toHoist);
+        return JITFALSE;
+    }
+
+    /* Move every invariants outside the loop	*/
+    item = xanList_first(toHoist);
+    while (item != NULL) {
+        ir_instruction_t *inv;
+        inv = item->data;
+        assert(inv != NULL);
+        PDEBUG("LICM: %s: hoist instruction %u\n", IRMETHOD_getSignatureInString(method), inv->ID);
+        IRMETHOD_moveInstructionBefore(method, inv, preHeader);
+        item = item->next;
+    }
+    method->modified	= JITTRUE;
+
+    /* Free the memory				*/
+    xanList_destroyList(toHoist);
+
+    return JITTRUE;
 }
 
-static inline JITBOOLEAN internal_move_loop_invariant (loop_t *loop){
-	XanListItem *item;
-	ir_instruction_t *preheader;
+static inline JITBOOLEAN internal_is_hoistable (ir_method_t *method, circuit_t *loop, ir_instruction_t *header, XanList *loopInsts, ir_instruction_t *inst) {
+    IR_ITEM_VALUE	var;
+    XanList		*defs;
+    XanListItem	*item;
+    JITUINT32	defsNumber;
 
-	/* Assertions					*/
-	assert(loop != NULL);
+    /* Only instructions that cannot throw exceptions and that do not access memory can be executed speculatively before the loop.
+     */
+    if (!internal_is_hoistable_instruction_type(inst)) {
+        return JITFALSE;
+    }
 
-	/* Check if there are invariants		*/
-	if (loop->invariants == NULL){
-		return JITFALSE;
-	}
-	if (xanList_length(loop->invariants) == 0) {
-		return JITFALSE;
-	}
+    /* The result has to be a variable that is not accessed through memory.
+     */
+    if (IRMETHOD_getInstructionResultType(inst) != IROFFSET) {
+        return JITFALSE;
+    }
+    var	= IRMETHOD_getInstructionResultValue(inst);
+    if (IRMETHOD_isAnEscapedVariable(method, var)) {
+        return JITFALSE;
+    }
 
-	/* Peel out the first iteration			*/
-	LOOPS_peelOutFirstIteration(loop);
+    /* The instruction has to be the only definition of the variable within the loop.
+     */
+    defs		= IRMETHOD_getVariableDefinitionsWithinInstructions(method, var, loopInsts);
+    defsNumber	= xanList_length(defs);
+    xanList_destroyList(defs);
+    if (defsNumber != 1) {
+        return JITFALSE;
+    }
 
-	/* Add the preheader				*/	
-	preheader = LOOPS_addPreHeader(loop, NULL);
-	preheader = IRMETHOD_getNextInstruction(loop->method, preheader);
-	assert(preheader != NULL);
+    /* Uses within the loop must not observe values of the variable defined before the loop.
+     */
+    if (IRMETHOD_isVariableLiveIN(method, header, var)) {
+        return JITFALSE;
+    }
 
-	/* Move every invariants outside the loop	*/
-	item = xanList_first(loop->invariants);
-	while (item != NULL){
-		ir_instruction_t *inv;
-		inv = item->data;
-		assert(inv != NULL);
-		IRMETHOD_moveInstructionBefore(loop->method, inv, preheader);
-		item = item->next;
-	}
+    /* The value of the variable that flows out of the loop must be the one produced by the instruction.
+     * This is the case when the instruction dominates the exit or when the variable is dead after it.
+     */
+    item	= xanList_first(loop->loopExits);
+    while (item != NULL) {
+        ir_instruction_t	*exitInst;
+        exitInst	= item->data;
+        assert(exitInst != NULL);
+        if (	(!IRMETHOD_isInstructionAPredominator(method, inst, exitInst))	&&
+                (IRMETHOD_isVariableLiveOUT(method, exitInst, var))		) {
+            return JITFALSE;
+        }
+        item	= item->next;
+    }
 
-	/* Return					*/
-	return JITTRUE;
+    return JITTRUE;
 }
 
-static inline char *get_version (void){
-  return VERSION;
+static inline JITBOOLEAN internal_are_operands_available (ir_method_t *method, ir_instruction_t *inst, XanList *loopInsts, XanHashTable *hoisted) {
+    JITUINT32	count;
+
+    for (count = 1; count <= IRMETHOD_getInstructionParametersNumber(inst); count++) {
+        ir_item_t	*par;
+        XanList		*defs;
+        XanListItem	*item;
+
+        /* Constants are always available.
+         */
+        par	= IRMETHOD_getInstructionParameter(inst, count);
+        if (par->type != IROFFSET) {
+            continue ;
+        }
+
+        /* Every definition within the loop has to be moved before the current one.
+         */
+        defs	= IRMETHOD_getVariableDefinitionsWithinInstructions(method, (par->value).v, loopInsts);
+        item	= xanList_first(defs);
+        while (item != NULL) {
+            if (xanHashTable_lookup(hoisted, item->data) == NULL) {
+                break ;
+            }
+            item	= item->next;
+        }
+        xanList_destroyList(defs);
+        if (item != NULL) {
+            return JITFALSE;
+        }
+    }
+
+    return JITTRUE;
+}
+
+static inline JITBOOLEAN internal_is_hoistable_instruction_type (ir_instruction_t *inst) {
+    switch (IRMETHOD_getInstructionType(inst)) {
+        case IRMOVE:
+        case IRADD:
+        case IRSUB:
+        case IRMUL:
+        case IRAND:
+        case IROR:
+        case IRXOR:
+        case IRNOT:
+        case IRNEG:
+        case IRSHL:
+        case IRSHR:
+        case IRCONV:
+        case IRBITCAST:
+        case IRLT:
+        case IRGT:
+        case IREQ:
+            return JITTRUE;
+    }
+
+    return JITFALSE;
+}
+
+static inline void internal_compute_loops_information (ir_method_t *method) {
+    IROPTIMIZER_invalidateInformation(method, INVALIDATE_ALL);
+    IROPTIMIZER_callMethodOptimization(irOptimizer, method, LIVENESS_ANALYZER);
+    IROPTIMIZER_callMethodOptimization(irOptimizer, method, REACHING_DEFINITIONS_ANALYZER);
+    IROPTIMIZER_callMethodOptimization(irOptimizer, method, ESCAPES_ANALYZER);
+    IROPTIMIZER_callMethodOptimization(irOptimizer, method, PRE_DOMINATOR_COMPUTER);
+    IROPTIMIZER_callMethodOptimization(irOptimizer, method, LOOP_IDENTIFICATION);
+    IROPTIMIZER_callMethodOptimization(irOptimizer, method, LOOP_INVARIANTS_IDENTIFICATION);
+}
+
+static inline char *get_version (void) {
+    return VERSION;
 }
 
 static inline char * get_informations (void) {
-  return INFORMATIONS;
+    return INFORMATIONS;
+}
+
+static inline char *get_author (void) {
+    return AUTHOR;
 }
 
-static inline char *get_author (void){
-  return AUTHOR;
+static inline void loop_invariant_getCompilationFlags (char *buffer, JITINT32 bufferLength) {
+
+    /* Assertions				*/
+    assert(buffer != NULL);
+
+    snprintf(buffer, sizeof(char) * bufferLength, " ");
+#ifdef DEBUG
+    strncat(buffer, "DEBUG ", sizeof(char) * bufferLength);
+#endif
+#ifdef PRINTDEBUG
+    strncat(buffer, "PRINTDEBUG ", sizeof(char) * bufferLength);
+#endif
+#ifdef PROFILE
+    strncat(buffer, "PROFILE ", sizeof(char) * bufferLength);
+#endif
+}
+
+static inline void loop_invariant_getCompilationTime (char *buffer, JITINT32 bufferLength) {
+
+    /* Assertions				*/
+    assert(buffer != NULL);
+
+    snprintf(buffer, sizeof(char) * bufferLength, "%s %s", __DATE__, __TIME__);
+
+    /* Return				*/
+    return;
 }
@@ -21,6 +21,9 @@
 #include <xanlib.h>
 #include <jitsystem.h>
 
+/* Maximum number of circuits transformed for each method	*/
+#define MAX_HOISTING_ROUNDS	64
+
 #ifdef PRINTDEBUG
 #define PDEBUG(fmt, args...) fprintf(stderr, fmt, ## args)
 #else
@@ -0,0 +1,675 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <ir_optimization_interface.h>
+#include <ir_language.h>
+#include <iljit-utils.h>
+#include <compiler_memory_manager.h>
+
+// My headers
+#include <optimizer_loopunrolling.h>
+#include <loop_unrolling.h>
+// End
+
+/**
+ * Condition that keeps the loop running, after moving the induction variable to the left side of the comparison.
+ */
+typedef enum {
+    CONTINUE_IF_LT,		/**< i < n	*/
+    CONTINUE_IF_LE,		/**< i <= n	*/
+    CONTINUE_IF_GT,		/**< i > n	*/
+    CONTINUE_IF_GE		/**< i >= n	*/
+} loop_condition_t;
+
+typedef struct {
+    ir_instruction_t	*header;	/**< First instruction of the body; it is a label			*/
+    ir_instruction_t	*testLabel;	/**< Label of the loop test; loop entries jump here			*/
+    ir_instruction_t	*compare;	/**< t = i < n								*/
+    ir_instruction_t	*backedge;	/**< branchif t header							*/
+    XanList			*body;		/**< Instructions strictly between header and testLabel		*/
+    XanList			*entries;	/**< Branches outside the loop that jump to testLabel		*/
+    basic_induction_t	iv;		/**< Induction variable i						*/
+    ir_item_t		*bound;		/**< n									*/
+    loop_condition_t	condition;	/**< Condition to keep iterating					*/
+} counted_loop_t;
+
+static inline JITBOOLEAN internal_fetch_counted_loop (ir_method_t *method, circuit_t *loop, counted_loop_t *l);
+static inline JITBOOLEAN internal_fetch_loop_condition (ir_method_t *method, circuit_t *loop, XanList *loopInsts, counted_loop_t *l);
+static inline JITBOOLEAN internal_is_body_unrollable (ir_method_t *method, counted_loop_t *l);
+static inline JITBOOLEAN internal_is_innermost (ir_method_t *method, circuit_t *loop);
+static inline JITBOOLEAN internal_has_exception_handlers (ir_method_t *method);
+static inline JITBOOLEAN internal_fetch_trip_count (ir_method_t *method, counted_loop_t *l, JITUINT32 *tripCount);
+static inline JITBOOLEAN internal_is_condition_true (loop_condition_t condition, JITINT64 value, JITINT64 bound);
+static inline void internal_fully_unroll (ir_method_t *method, counted_loop_t *l, JITUINT32 tripCount);
+static inline void internal_partially_unroll (ir_method_t *method, counted_loop_t *l, JITUINT32 factor);
+static inline void internal_clone_body_before (ir_method_t *method, XanList *body, ir_instruction_t *beforeInst);
+static inline void internal_free_counted_loop (counted_loop_t *l);
+
+JITBOOLEAN LOOP_UNROLLING_fullyUnrollLoop (ir_method_t *method, circuit_t *loop) {
+    counted_loop_t	l;
+    JITUINT32	tripCount;
+    JITBOOLEAN	unrolled;
+
+    /* Assertions				*/
+    assert(method != NULL);
+    assert(loop != NULL);
+
+    /* Replace the loop with its iterations if they are few.
+     */
+    memset(&l, 0, sizeof(counted_loop_t));
+    unrolled	= JITFALSE;
+    if (	internal_fetch_counted_loop(method, loop, &l)					&&
+            internal_fetch_trip_count(method, &l, &tripCount)				&&
+            (tripCount <= FULL_UNROLL_MAX_TRIPS)						&&
+            ((tripCount * xanList_length(l.body)) <= FULL_UNROLL_MAX_INSTRUCTIONS)	) {
+        PDEBUG("%s: fully unroll the loop %u (%u iterations)\n", IRMETHOD_getSignatureInString(method), loop->loop_id, tripCount);
+        internal_fully_unroll(method, &l, tripCount);
+        unrolled	= JITTRUE;
+    }
+    internal_free_counted_loop(&l);
+
+    return unrolled;
+}
+
+JITBOOLEAN LOOP_UNROLLING_unrollLoop (ir_method_t *method, circuit_t *loop) {
+    counted_loop_t	l;
+    JITUINT32	bodySize;
+    JITUINT32	factor;
+
+    /* Assertions				*/
+    assert(method != NULL);
+    assert(loop != NULL);
+
+    /* Check the loop			*/
+    memset(&l, 0, sizeof(counted_loop_t));
+    if (!internal_fetch_counted_loop(method, loop, &l)) {
+        internal_free_counted_loop(&l);
+        return JITFALSE;
+    }
+    bodySize	= xanList_length(l.body);
+
+    /* Choose the unrolling factor		*/
+    if (bodySize > PARTIAL_UNROLL_MAX_BODY) {
+        internal_free_counted_loop(&l);
+        return JITFALSE;
+    }
+    factor	= PARTIAL_UNROLL_MAX_FACTOR;
+    while (	(factor > 1)						&&
+            ((factor * bodySize) > PARTIAL_UNROLL_MAX_INSTRUCTIONS)	) {
+        factor	= factor / 2;
+    }
+    if (factor <= 1) {
+        internal_free_counted_loop(&l);
+        return JITFALSE;
+    }
+
+    /* Unroll the loop			*/
+    PDEBUG("%s: unroll the loop %u by %u\n", IRMETHOD_getSignatureInString(method), loop->loop_id, factor);
+    internal_partially_unroll(method, &l, factor);
+    internal_free_counted_loop(&l);
+
+    return JITTRUE;
+}
+
+static inline JITBOOLEAN internal_fetch_counted_loop (ir_method_t *method, circuit_t *loop, counted_loop_t *l) {
+    ir_instruction_t	*inst;
+    XanList			*loopInsts;
+    XanListItem		*item;
+    JITUINT32		instsNumber;
+
+    /* Fetch the header and the backedge.
+     * The header is marked once the loop has been unrolled; the loop left is the one that runs the remaining iterations.
+     */
+    l->header	= IRMETHOD_getTheDestinationOfTheCircuitBackedge(loop);
+    l->backedge	= IRMETHOD_getTheSourceOfTheCircuitBackedge(loop);
+    if (	(l->header == NULL)							||
+            (l->backedge == NULL)							||
+            (IRMETHOD_getInstructionType(l->header) != IRLABEL)			||
+            (IRMETHOD_getInstructionMetadata(l->header, LOOP_UNROLLING) != NULL)	) {
+        return JITFALSE;
+    }
+    if (	(IRMETHOD_getInstructionType(l->backedge) != IRBRANCHIF)		&&
+            (IRMETHOD_getInstructionType(l->backedge) != IRBRANCHIFNOT)		) {
+        return JITFALSE;
+    }
+    if (IRMETHOD_getBranchDestination(method, l->backedge) != l->header) {
+        return JITFALSE;
+    }
+    if (IRMETHOD_getNextInstruction(method, l->backedge) == NULL) {
+        return JITFALSE;
+    }
+
+    /* Check the shape of the CFG		*/
+    if (	(!LOOPUNROLLING_isTheOnlyCircuitOfItsHeader(method, loop))	||
+            (!internal_is_innermost(method, loop))				||
+            (internal_has_exception_handlers(method))			) {
+        return JITFALSE;
+    }
+    if (	(loop->loopExits == NULL)							||
+            (xanList_length(loop->loopExits) != 1)						||
+            (xanList_first(loop->loopExits)->data != l->backedge)				) {
+        return JITFALSE;
+    }
+
+    /* The loop has to be stored contiguously between the header and the backedge.
+     */
+    loopInsts	= IRMETHOD_getCircuitInstructions(method, loop);
+    instsNumber	= 0;
+    inst		= l->header;
+    while (inst != NULL) {
+        if (!IRMETHOD_doesInstructionBelongToCircuit(method, loop, inst)) {
+            break ;
+        }
+        instsNumber++;
+        if (inst == l->backedge) {
+            break ;
+        }
+        inst	= IRMETHOD_getNextInstruction(method, inst);
+    }
+    if (	(inst != l->backedge)				||
+            (instsNumber != xanList_length(loopInsts))	) {
+        xanList_destroyList(loopInsts);
+        return JITFALSE;
+    }
+
+    /* Fetch the loop test: L_c: t = cmp(i, n); branchif t H	*/
+    l->compare	= IRMETHOD_getPrevInstruction(method, l->backedge);
+    l->testLabel	= IRMETHOD_getPrevInstruction(method, l->compare);
+    if (	(l->testLabel == NULL)						||
+            (l->testLabel == l->header)					||
+            (IRMETHOD_getInstructionType(l->testLabel) != IRLABEL)	) {
+        xanList_destroyList(loopInsts);
+        return JITFALSE;
+    }
+    if (!internal_fetch_loop_condition(method, loop, loopInsts, l)) {
+        xanList_destroyList(loopInsts);
+        return JITFALSE;
+    }
+
+    /* The header can be reached only through the backedge and the loop can be entered only through the test.
+     */
+    l->entries	= xanList_new(allocFunction, freeFunction, NULL);
+    item		= xanList_first(loopInsts);
+    while (item != NULL) {
+        XanList		*preds;
+        XanListItem	*item2;
+        inst	= item->data;
+        preds	= IRMETHOD_getInstructionPredecessors(method, inst);
+        item2	= xanList_first(preds);
+        while (item2 != NULL) {
+            ir_instruction_t	*pred;
+            pred	= item2->data;
+            if (!IRMETHOD_doesInstructionBelongToCircuit(method, loop, pred)) {
+                if (	(inst != l->testLabel)						||
+                        (!IRMETHOD_doesInstructionUseLabel(method, pred, IRMETHOD_getInstructionParameter1Value(l->testLabel)))	) {
+                    break ;
+                }
+                xanList_append(l->entries, pred);
+            }
+            item2	= item2->next;
+        }
+        xanList_destroyList(preds);
+        if (item2 != NULL) {
+            break ;
+        }
+        item	= item->next;
+    }
+    xanList_destroyList(loopInsts);
+    if (	(item != NULL)				||
+            (xanList_length(l->entries) == 0)	) {
+        return JITFALSE;
+    }
+
+    /* Check the body			*/
+    l->body		= xanList_new(allocFunction, freeFunction, NULL);
+    inst		= IRMETHOD_getNextInstruction(method, l->header);
+    while (inst != l->testLabel) {
+        xanList_append(l->body, inst);
+        inst	= IRMETHOD_getNextInstruction(method, inst);
+    }
+
+    return internal_is_body_unrollable(method, l);
+}
+
+static inline JITBOOLEAN internal_fetch_loop_condition (ir_method_t *method, circuit_t *loop, XanList *loopInsts, counted_loop_t *l) {
+    ir_item_t	*par1;
+    ir_item_t	*par2;
+    ir_item_t	*var;
+    XanList		*uses;
+    JITUINT32	usesNumber;
+    JITBOOLEAN	varOnTheLeft;
+    JITBOOLEAN	lessThan;
+
+    /* Check the comparison			*/
+    if (	(IRMETHOD_getInstructionType(l->compare) != IRLT)	&&
+            (IRMETHOD_getInstructionType(l->compare) != IRGT)	) {
+        return JITFALSE;
+    }
+    if (	(IRMETHOD_getInstructionResultType(l->compare) != IROFFSET)					||
+            (IRMETHOD_getInstructionParameter1Type(l->backedge) != IROFFSET)				||
+            (IRMETHOD_getInstructionParameter1Value(l->backedge) != IRMETHOD_getInstructionResultValue(l->compare))	) {
+        return JITFALSE;
+    }
+
+    /* The result of the comparison cannot be used elsewhere because the unrolled code does not compute it.
+     */
+    uses		= IRMETHOD_getVariableUses(method, IRMETHOD_getInstructionResultValue(l->compare));
+    usesNumber	= xanList_length(uses);
+    xanList_destroyList(uses);
+    if (usesNumber != 1) {
+        return JITFALSE;
+    }
+
+    /* Fetch the induction variable and the bound	*/
+    par1	= IRMETHOD_getInstructionParameter1(l->compare);
+    par2	= IRMETHOD_getInstructionParameter2(l->compare);
+    if (	(par1->internal_type != IRINT32)	||
+            (par2->internal_type != IRINT32)	) {
+        return JITFALSE;
+    }
+    varOnTheLeft	= JITTRUE;
+    var		= par1;
+    l->bound	= par2;
+    if (	(var->type != IROFFSET)										||
+            (!LOOPUNROLLING_getBasicInductionVariable(method, loop, loopInsts, (var->value).v, &(l->iv)))	) {
+        varOnTheLeft	= JITFALSE;
+        var		= par2;
+        l->bound	= par1;
+        if (	(var->type != IROFFSET)										||
+                (!LOOPUNROLLING_getBasicInductionVariable(method, loop, loopInsts, (var->value).v, &(l->iv)))	) {
+            return JITFALSE;
+        }
+    }
+    if (	(IRMETHOD_getInstructionResultInternalType(l->iv.update) != IRINT32)	||
+            (!LOOPUNROLLING_isItemInvariant(method, l->bound, loopInsts))		) {
+        return JITFALSE;
+    }
+
+    /* The induction variable has to be updated exactly once per iteration.
+     */
+    if (	(!IRMETHOD_isInstructionAPredominator(method, l->iv.update, l->backedge))	||
+            (!IRMETHOD_isInstructionAPredominator(method, l->header, l->iv.update))	) {
+        return JITFALSE;
+    }
+
+    /* Normalize the condition to keep iterating as "i op n".
+     */
+    lessThan	= (IRMETHOD_getInstructionType(l->compare) == IRLT);
+    if (!varOnTheLeft) {
+        lessThan	= !lessThan;
+    }
+    if (IRMETHOD_getInstructionType(l->backedge) == IRBRANCHIF) {
+        l->condition	= lessThan ? CONTINUE_IF_LT : CONTINUE_IF_GT;
+    } else {
+        l->condition	= lessThan ? CONTINUE_IF_GE : CONTINUE_IF_LE;
+    }
+
+    /* The induction variable has to move toward the bound	*/
+    switch (l->condition) {
+        case CONTINUE_IF_LT:
+        case CONTINUE_IF_LE:
+            return (l->iv.step > 0);
+        case CONTINUE_IF_GT:
+        case CONTINUE_IF_GE:
+            return (l->iv.step < 0);
+    }
+
+    return JITFALSE;
+}
+
+static inline JITBOOLEAN internal_is_body_unrollable (ir_method_t *method, counted_loop_t *l) {
+    XanHashTable	*bodyInsts;
+    XanListItem	*item;
+    JITBOOLEAN	unrollable;
+
+    /* Fetch the instructions of the body	*/
+    bodyInsts	= xanHashTable_new(11, JITFALSE, allocFunction, dynamicReallocFunction, freeFunction, NULL, NULL);
+    item		= xanList_first(l->body);
+    while (item != NULL) {
+        xanHashTable_insert(bodyInsts, item->data, item->data);
+        item	= item->next;
+    }
+
+    /* Branches of the body have to jump within the body itself, so every copy can be linked to its own labels.
+     */
+    unrollable	= JITTRUE;
+    item		= xanList_first(l->body);
+    while (item != NULL) {
+        ir_instruction_t	*inst;
+        inst	= item->data;
+        if (IRMETHOD_isACallInstruction(inst)) {
+            unrollable	= JITFALSE;
+            break ;
+        }
+        switch (IRMETHOD_getInstructionType(inst)) {
+            case IRBRANCH:
+            case IRBRANCHIF:
+            case IRBRANCHIFNOT:
+                if (xanHashTable_lookup(bodyInsts, IRMETHOD_getBranchDestination(method, inst)) == NULL) {
+                    unrollable	= JITFALSE;
+                }
+                break;
+            default:
+                if (	IRMETHOD_isAJumpInstruction(inst)				||
+                        (!IRMETHOD_canTheNextInstructionBeASuccessor(method, inst))	) {
+                    unrollable	= JITFALSE;
+                }
+        }
+        if (!unrollable) {
+            break ;
+        }
+        item	= item->next;
+    }
+
+    /* Free the memory			*/
+    xanHashTable_destroyTable(bodyInsts);
+
+    return unrollable;
+}
+
+static inline JITBOOLEAN internal_fetch_trip_count (ir_method_t *method, counted_loop_t *l, JITUINT32 *tripCount) {
+    ir_instruction_t	*entry;
+    ir_instruction_t	*inst;
+    JITINT64		value;
+    JITINT64		bound;
+    JITUINT32		trips;
+
+    /* The bound has to be a constant	*/
+    if (l->bound->type == IROFFSET) {
+        return JITFALSE;
+    }
+    bound	= LOOPUNROLLING_getIntegerConstant(l->bound);
+
+    /* Fetch the initial value of the induction variable.
+     * It has to be a constant assigned within the straight-line code that jumps to the loop test.
+     */
+    if (xanList_length(l->entries) != 1) {
+        return JITFALSE;
+    }
+    entry	= xanList_first(l->entries)->data;
+    if (IRMETHOD_getInstructionType(entry) != IRBRANCH) {
+        return JITFALSE;
+    }
+    inst	= IRMETHOD_getPrevInstruction(method, entry);
+    while (inst != NULL) {
+        ir_item_t	*result;
+        if (IRMETHOD_getInstructionType(inst) == IRLABEL) {
+            return JITFALSE;
+        }
+        result	= IRMETHOD_getInstructionResult(inst);
+        if (	(result->type == IROFFSET)			&&
+                ((result->value).v == l->iv.var)	) {
+            break ;
+        }
+        inst	= IRMETHOD_getPrevInstruction(method, inst);
+    }
+    if (	(inst == NULL)								||
+            (IRMETHOD_getInstructionType(inst) != IRMOVE)				||
+            (IRMETHOD_getInstructionParameter1Type(inst) == IROFFSET)		||
+            (!IRMETHOD_isAnIntType(IRMETHOD_getInstructionParameter1(inst)->internal_type))	) {
+        return JITFALSE;
+    }
+    value	= LOOPUNROLLING_getIntegerConstant(IRMETHOD_getInstructionParameter1(inst));
+
+    /* Count the iterations		*/
+    trips	= 0;
+    while (internal_is_condition_true(l->condition, value, bound)) {
+        value	+= l->iv.step;
+        trips++;
+        if (	(trips > FULL_UNROLL_MAX_TRIPS)	||
+                (value > INT32_MAX)		||
+                (value < INT32_MIN)		) {
+            return JITFALSE;
+        }
+    }
+    (*tripCount)	= trips;
+
+    return JITTRUE;
+}
+
+static inline JITBOOLEAN internal_is_condition_true (loop_condition_t condition, JITINT64 value, JITINT64 bound) {
+    switch (condition) {
+        case CONTINUE_IF_LT:
+            return (value < bound);
+        case CONTINUE_IF_LE:
+            return (value <= bound);
+        case CONTINUE_IF_GT:
+            return (value > bound);
+        case CONTINUE_IF_GE:
+            return (value >= bound);
+    }
+    abort();
+}
+
+static inline void internal_fully_unroll (ir_method_t *method, counted_loop_t *l, JITUINT32 tripCount) {
+    ir_instruction_t	*entry;
+    ir_instruction_t	*exitLabel;
+    JITUINT32		count;
+
+    /* Fetch the jump to the loop		*/
+    entry		= xanList_first(l->entries)->data;
+
+    /* Fetch the code executed after the loop	*/
+    exitLabel	= IRMETHOD_getNextInstruction(method, l->backedge);
+    if (IRMETHOD_getInstructionType(exitLabel) != IRLABEL) {
+        exitLabel	= IRMETHOD_newLabelAfter(method, l->backedge);
+    }
+
+    /* Replicate the body once per iteration just before the jump to the loop	*/
+    for (count = 0; count < tripCount; count++) {
+        internal_clone_body_before(method, l->body, entry);
+    }
+
+    /* Skip the loop; it is now unreachable and it will be removed by the dead code elimination.
+     */
+    IRMETHOD_setBranchDestination(method, entry, IRMETHOD_getInstructionParameter1Value(exitLabel));
+
+    return ;
+}
+
+static inline void internal_partially_unroll (ir_method_t *method, counted_loop_t *l, JITUINT32 factor) {
+    ir_instruction_t	*guardLabel;
+    ir_instruction_t	*inst;
+    ir_instruction_t	*guard;
+    ir_item_t		typeItem;
+    ir_item_t		offsetItem;
+    ir_item_t		boundItem;
+    ir_item_t		*var;
+    IR_ITEM_VALUE		guardLabelID;
+    IR_ITEM_VALUE		testLabelID;
+    XanListItem		*item;
+    JITUINT32		count;
+    JITUINT16		guardCompareType;
+    JITUINT16		guardBranchType;
+
+    /* Fetch the labels			*/
+    testLabelID	= IRMETHOD_getInstructionParameter1Value(l->testLabel);
+    guardLabel	= IRMETHOD_newLabelBefore(method, l->header);
+    guardLabelID	= IRMETHOD_getInstructionParameter1Value(guardLabel);
+
+    /* Check whether the next factor iterations will all run: i + (factor - 1) * step op n.
+     * The check is performed with 64 bits integers to avoid overflows.
+     */
+    memset(&typeItem, 0, sizeof(ir_item_t));
+    (typeItem.value).v		= IRINT64;
+    typeItem.type			= IRTYPE;
+    typeItem.internal_type		= IRTYPE;
+    memset(&offsetItem, 0, sizeof(ir_item_t));
+    (offsetItem.value).v		= (IR_ITEM_VALUE) (((JITINT64) (factor - 1)) * l->iv.step);
+    offsetItem.type			= IRINT64;
+    offsetItem.internal_type	= IRINT64;
+    var	= IRMETHOD_getInstructionResult(l->iv.update);
+    inst	= LOOPUNROLLING_newInstructionBefore(method, l->header, IRCONV, var, &typeItem, IRINT64);
+    inst	= LOOPUNROLLING_newInstructionBefore(method, l->header, IRADD, IRMETHOD_getInstructionResult(inst), &offsetItem, IRINT64);
+    var	= IRMETHOD_getInstructionResult(inst);
+    memset(&boundItem, 0, sizeof(ir_item_t));
+    if (l->bound->type == IROFFSET) {
+        inst	= LOOPUNROLLING_newInstructionBefore(method, l->header, IRCONV, l->bound, &typeItem, IRINT64);
+        memcpy(&boundItem, IRMETHOD_getInstructionResult(inst), sizeof(ir_item_t));
+    } else {
+        (boundItem.value).v		= (IR_ITEM_VALUE) LOOPUNROLLING_getIntegerConstant(l->bound);
+        boundItem.type			= IRINT64;
+        boundItem.internal_type		= IRINT64;
+    }
+    switch (l->condition) {
+        case CONTINUE_IF_LT:
+            guardCompareType	= IRLT;
+            guardBranchType		= IRBRANCHIFNOT;
+            break;
+        case CONTINUE_IF_LE:
+            guardCompareType	= IRGT;
+            guardBranchType		= IRBRANCHIF;
+            break;
+        case CONTINUE_IF_GT:
+            guardCompareType	= IRGT;
+            guardBranchType		= IRBRANCHIFNOT;
+            break;
+        default:
+            assert(l->condition == CONTINUE_IF_GE);
+            guardCompareType	= IRLT;
+            guardBranchType		= IRBRANCHIF;
+    }
+    inst	= LOOPUNROLLING_newInstructionBefore(method, l->header, guardCompareType, var, &boundItem, IRMETHOD_getInstructionResultInternalType(l->compare));
+
+    /* Leave to the original loop the remaining iterations	*/
+    guard	= IRMETHOD_newInstructionOfTypeBefore(method, l->header, guardBranchType);
+    IRMETHOD_cpInstructionParameter(method, inst, 0, guard, 1);
+    IRMETHOD_setInstructionParameter2(method, guard, testLabelID, 0, IRLABELITEM, IRLABELITEM, NULL);
+
+    /* Replicate the body			*/
+    for (count = 0; count < factor; count++) {
+        internal_clone_body_before(method, l->body, l->header);
+    }
+    IRMETHOD_newBranchToLabelBefore(method, guardLabel, l->header);
+
+    /* Enter the unrolled loop first	*/
+    item	= xanList_first(l->entries);
+    while (item != NULL) {
+        IRMETHOD_substituteLabel(method, item->data, testLabelID, guardLabelID);
+        item	= item->next;
+    }
+
+    /* Mark the original loop		*/
+    if (l->header->metadata == NULL) {
+        IRMETHOD_allocateMethodExtraMemory(method);
+    }
+    IRMETHOD_setInstructionMetadata(l->header, LOOP_UNROLLING, l->header);
+
+    return ;
+}
+
+static inline void internal_clone_body_before (ir_method_t *method, XanList *body, ir_instruction_t *beforeInst) {
+    XanHashTable	*clones;
+    XanListItem	*item;
+
+    /* Clone the instructions; every label gets a new identifier	*/
+    clones	= xanHashTable_new(11, JITFALSE, allocFunction, dynamicReallocFunction, freeFunction, NULL, NULL);
+    item	= xanList_first(body);
+    while (item != NULL) {
+        ir_instruction_t	*inst;
+        ir_instruction_t	*clone;
+        inst	= item->data;
+        clone	= IRMETHOD_cloneInstructionAndInsertBefore(method, inst, beforeInst);
+        if (IRMETHOD_getInstructionType(inst) == IRLABEL) {
+            IRMETHOD_setInstructionToANewLabel(method, clone);
+        }
+        xanHashTable_insert(clones, inst, clone);
+        item	= item->next;
+    }
+
+    /* Link the branches to the new labels				*/
+    item	= xanList_first(body);
+    while (item != NULL) {
+        ir_instruction_t	*inst;
+        inst	= item->data;
+        if (IRMETHOD_isABranchInstruction(inst)) {
+            ir_instruction_t	*clone;
+            ir_instruction_t	*label;
+            clone	= xanHashTable_lookup(clones, inst);
+            label	= xanHashTable_lookup(clones, IRMETHOD_getBranchDestination(method, inst));
+            assert(clone != NULL);
+            assert(label != NULL);
+            IRMETHOD_setBranchDestination(method, clone, IRMETHOD_getInstructionParameter1Value(label));
+        }
+        item	= item->next;
+    }
+
+    /* Free the memory						*/
+    xanHashTable_destroyTable(clones);
+
+    return ;
+}
+
+static inline JITBOOLEAN internal_is_innermost (ir_method_t *method, circuit_t *loop) {
+    XanList		*loops;
+    XanListItem	*item;
+    JITBOOLEAN	innermost;
+
+    innermost	= JITTRUE;
+    loops		= IRMETHOD_getMethodCircuits(method);
+    item		= xanList_first(loops);
+    while (item != NULL) {
+        circuit_t	*otherLoop;
+        otherLoop	= item->data;
+        if (	(otherLoop != loop)										&&
+                (otherLoop->loop_id != 0)									&&
+                (IRMETHOD_doesInstructionBelongToCircuit(method, loop, otherLoop->backEdge.dst))	) {
+            innermost	= JITFALSE;
+            break ;
+        }
+        item	= item->next;
+    }
+    xanList_destroyList(loops);
+
+    return innermost;
+}
+
+static inline JITBOOLEAN internal_has_exception_handlers (ir_method_t *method) {
+    JITUINT32	instID;
+    JITUINT32	instructionsNumber;
+
+    if (IRMETHOD_hasCatchBlocks(method)) {
+        return JITTRUE;
+    }
+    instructionsNumber	= IRMETHOD_getInstructionsNumber(method);
+    for (instID = 0; instID < instructionsNumber; instID++) {
+        switch (IRMETHOD_getInstructionType(IRMETHOD_getInstructionAtPosition(method, instID))) {
+            case IRSTARTCATCHER:
+            case IRSTARTFINALLY:
+            case IRSTARTFILTER:
+            case IRCALLFINALLY:
+            case IRBRANCHIFPCNOTINRANGE:
+                return JITTRUE;
+        }
+    }
+
+    return JITFALSE;
+}
+
+static inline void internal_free_counted_loop (counted_loop_t *l) {
+    if (l->body != NULL) {
+        xanList_destroyList(l->body);
+    }
+    if (l->entries != NULL) {
+        xanList_destroyList(l->entries);
+    }
+}
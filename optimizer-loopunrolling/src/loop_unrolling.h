@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef LOOP_UNROLLING_H
+#define LOOP_UNROLLING_H
+
+#include <jitsystem.h>
+#include <ir_method.h>
+
+/**
+ * @brief Replace a counted loop with its iterations
+ *
+ * The loop has to be in the rotated form generated by CIL compilers for <code> for </code> loops:
+ * <code>
+ *	br L_c
+ * H:	body (including i = i + k)
+ * L_c:	t = i < n
+ *	branchif t H
+ * </code>
+ *
+ * Both the initial value of <code> i </code>, assigned just before the jump to the test, and <code> n </code> have to be constants, and the loop has to be small.
+ * This shape is lost once a pre-header is added to the loop; therefore this transformation has to be tried before the other ones.
+ *
+ * Information about circuits is not valid anymore if the function returns JITTRUE.
+ *
+ * @return JITTRUE if the code has been changed
+ */
+JITBOOLEAN LOOP_UNROLLING_fullyUnrollLoop (ir_method_t *method, circuit_t *loop);
+
+/**
+ * @brief Unroll a counted loop
+ *
+ * The loop has to be in the rotated form accepted by \ref LOOP_UNROLLING_fullyUnrollLoop.
+ * The body is replicated 8, 4 or 2 times within a new loop that runs while there are enough iterations left; the original loop executes the remaining ones.
+ *
+ * Information about circuits is not valid anymore if the function returns JITTRUE.
+ *
+ * @return JITTRUE if the code has been changed
+ */
+JITBOOLEAN LOOP_UNROLLING_unrollLoop (ir_method_t *method, circuit_t *loop);
+
+#endif
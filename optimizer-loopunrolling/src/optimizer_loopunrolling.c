@@ -0,0 +1,413 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <ir_optimization_interface.h>
+#include <ir_language.h>
+#include <iljit-utils.h>
+#include <compiler_memory_manager.h>
+
+// My headers
+#include <optimizer_loopunrolling.h>
+#include <strength_reduction.h>
+#include <loop_unrolling.h>
+#include <config.h>
+// End
+
+#define INFORMATIONS 	"Reduces the strength of induction variable multiplications and unrolls counted loops"
+#define	AUTHOR		"ILDJIT developers"
+#define JOB		LOOP_UNROLLING
+
+static inline JITUINT64 loopunrolling_get_ID_job (void);
+static inline char * loopunrolling_get_version (void);
+static inline void loopunrolling_do_job (ir_method_t * method);
+static inline char * loopunrolling_get_informations (void);
+static inline char * loopunrolling_get_author (void);
+static inline JITUINT64 loopunrolling_get_dependences (void);
+static inline void loopunrolling_shutdown (JITFLOAT32 totalTime);
+static inline void loopunrolling_init (ir_lib_t *lib, ir_optimizer_t *optimizer, char *outputPrefix);
+static inline JITUINT64 loopunrolling_get_invalidations (void);
+static inline void loopunrolling_getCompilationTime (char *buffer, JITINT32 bufferLength);
+static inline void loopunrolling_getCompilationFlags (char *buffer, JITINT32 bufferLength);
+static inline JITBOOLEAN internal_transform_one_loop (ir_method_t *method);
+static inline void internal_compute_loops_information (ir_method_t *method);
+
+ir_lib_t	*irLib		= NULL;
+ir_optimizer_t	*irOptimizer	= NULL;
+char 	        *prefix		= NULL;
+
+ir_optimization_interface_t plugin_interface = {
+    loopunrolling_get_ID_job,
+    loopunrolling_get_dependences,
+    loopunrolling_init,
+    loopunrolling_shutdown,
+    loopunrolling_do_job,
+    loopunrolling_get_version,
+    loopunrolling_get_informations,
+    loopunrolling_get_author,
+    loopunrolling_get_invalidations,
+    NULL,
+    loopunrolling_getCompilationFlags,
+    loopunrolling_getCompilationTime
+};
+
+static inline void loopunrolling_init (ir_lib_t *lib, ir_optimizer_t *optimizer, char *outputPrefix) {
+
+    /* Assertions			*/
+    assert(lib != NULL);
+    assert(optimizer != NULL);
+    assert(outputPrefix != NULL);
+
+    irLib		= lib;
+    irOptimizer	= optimizer;
+    prefix		= outputPrefix;
+}
+
+static inline void loopunrolling_shutdown (JITFLOAT32 totalTime) {
+    irLib		= NULL;
+    irOptimizer	= NULL;
+    prefix		= NULL;
+}
+
+static inline JITUINT64 loopunrolling_get_ID_job (void) {
+    return JOB;
+}
+
+static inline JITUINT64 loopunrolling_get_dependences (void) {
+    return LIVENESS_ANALYZER | REACHING_DEFINITIONS_ANALYZER | ESCAPES_ANALYZER | PRE_DOMINATOR_COMPUTER | LOOP_IDENTIFICATION | LOOP_INVARIANTS_IDENTIFICATION | INDUCTION_VARIABLES_IDENTIFICATION;
+}
+
+static inline JITUINT64 loopunrolling_get_invalidations (void) {
+    return INVALIDATE_ALL;
+}
+
+static inline void loopunrolling_do_job (ir_method_t * method) {
+    JITUINT32	rounds;
+
+    /* Assertions			*/
+    assert(method != NULL);
+
+    /* Transform one loop at a time.
+     * Every transformation adds instructions to the method and therefore it invalidates the information about circuits.
+     */
+    rounds	= 0;
+    while (	(rounds < MAX_TRANSFORMATION_ROUNDS)	&&
+            IRMETHOD_hasMethodCircuits(method)	) {
+
+        /* Transform a loop		*/
+        if (!internal_transform_one_loop(method)) {
+            break ;
+        }
+        method->modified	= JITTRUE;
+
+        /* Refresh the information	*/
+        internal_compute_loops_information(method);
+        rounds++;
+    }
+
+    return ;
+}
+
+static inline JITBOOLEAN internal_transform_one_loop (ir_method_t *method) {
+    XanList		*loops;
+    XanListItem	*item;
+    JITBOOLEAN	modified;
+
+    /* Fetch the circuits		*/
+    modified	= JITFALSE;
+    loops		= IRMETHOD_getMethodCircuits(method);
+
+    /* Full unrolling comes first because it needs the loop to be entered straight from the code that initializes the induction variable, which is not the case once a pre-header has been added.
+     */
+    item		= xanList_first(loops);
+    while ((item != NULL) && (!modified)) {
+        circuit_t	*loop;
+        loop	= item->data;
+        if (loop->loop_id != 0) {
+            modified	= LOOP_UNROLLING_fullyUnrollLoop(method, loop);
+        }
+        item	= item->next;
+    }
+
+    /* Strength reduction comes next because it makes the body of loops smaller and because the unrolled copies would otherwise contain the multiplications.
+     */
+    item		= xanList_first(loops);
+    while ((item != NULL) && (!modified)) {
+        circuit_t	*loop;
+        loop	= item->data;
+        if (loop->loop_id != 0) {
+            modified	= STRENGTH_REDUCTION_reduceLoop(method, loop);
+        }
+        item	= item->next;
+    }
+
+    /* Unroll a loop		*/
+    item		= xanList_first(loops);
+    while ((item != NULL) && (!modified)) {
+        circuit_t	*loop;
+        loop	= item->data;
+        if (loop->loop_id != 0) {
+            modified	= LOOP_UNROLLING_unrollLoop(method, loop);
+        }
+        item	= item->next;
+    }
+
+    /* Free the memory		*/
+    xanList_destroyList(loops);
+
+    return modified;
+}
+
+JITBOOLEAN LOOPUNROLLING_getBasicInductionVariable (ir_method_t *method, circuit_t *loop, XanList *loopInsts, IR_ITEM_VALUE varID, basic_induction_t *iv) {
+    XanList			*ivs;
+    XanList			*defs;
+    XanListItem		*item;
+    ir_instruction_t	*update;
+    ir_item_t		*par1;
+    ir_item_t		*par2;
+    JITBOOLEAN		found;
+
+    /* Assertions			*/
+    assert(method != NULL);
+    assert(loop != NULL);
+    assert(iv != NULL);
+
+    /* Check the variable		*/
+    if (IRMETHOD_isAnEscapedVariable(method, varID)) {
+        return JITFALSE;
+    }
+
+    /* Check that the variable has been identified as a basic induction variable.
+     */
+    found	= JITFALSE;
+    ivs	= IRMETHOD_getCircuitInductionVariables(method, loop);
+    item	= xanList_first(ivs);
+    while (item != NULL) {
+        induction_variable_t	*currentIV;
+        currentIV	= item->data;
+        assert(currentIV != NULL);
+        if (	(currentIV->ID == varID)		&&
+                (currentIV->i == varID)			&&
+                (currentIV->b.type == IRINT64)		&&
+                (currentIV->c.type == IRINT64)		&&
+                (currentIV->c.value == 0)		) {
+            found	= JITTRUE;
+            break ;
+        }
+        item	= item->next;
+    }
+    xanList_destroyList(ivs);
+    if (!found) {
+        return JITFALSE;
+    }
+
+    /* Fetch the only definition of the variable within the loop.
+     * The sign of the step is not stored in the induction table, so it is recomputed from the instruction.
+     */
+    defs	= IRMETHOD_getVariableDefinitionsWithinInstructions(method, varID, loopInsts);
+    if (xanList_length(defs) != 1) {
+        xanList_destroyList(defs);
+        return JITFALSE;
+    }
+    update	= xanList_first(defs)->data;
+    xanList_destroyList(defs);
+    if (	(IRMETHOD_getInstructionType(update) != IRADD)	&&
+            (IRMETHOD_getInstructionType(update) != IRSUB)	) {
+        return JITFALSE;
+    }
+    par1	= IRMETHOD_getInstructionParameter1(update);
+    par2	= IRMETHOD_getInstructionParameter2(update);
+    if (	(par1->type != IROFFSET)			||
+            ((par1->value).v != varID)			||
+            (par2->type == IROFFSET)			||
+            (!IRMETHOD_isAnIntType(par2->internal_type))	) {
+        return JITFALSE;
+    }
+    if (LOOPUNROLLING_getIntegerConstant(par2) == 0) {
+        return JITFALSE;
+    }
+
+    /* Fill up the information	*/
+    iv->var		= varID;
+    iv->update	= update;
+    iv->step	= LOOPUNROLLING_getIntegerConstant(par2);
+    if (IRMETHOD_getInstructionType(update) == IRSUB) {
+        iv->step	= -(iv->step);
+    }
+
+    return JITTRUE;
+}
+
+JITINT64 LOOPUNROLLING_getIntegerConstant (ir_item_t *item) {
+
+    /* Assertions			*/
+    assert(item != NULL);
+    assert(item->type != IROFFSET);
+
+    switch (item->internal_type) {
+        case IRINT8:
+            return (JITINT8) (item->value).v;
+        case IRINT16:
+            return (JITINT16) (item->value).v;
+        case IRINT32:
+            return (JITINT32) (item->value).v;
+        case IRUINT8:
+            return (JITUINT8) (item->value).v;
+        case IRUINT16:
+            return (JITUINT16) (item->value).v;
+        case IRUINT32:
+            return (JITUINT32) (item->value).v;
+    }
+
+    return (JITINT64) (item->value).v;
+}
+
+IR_ITEM_VALUE LOOPUNROLLING_toIntegerConstant (JITINT64 value, JITUINT16 internalType) {
+    switch (internalType) {
+        case IRINT8:
+            return (IR_ITEM_VALUE) (JITINT64) (JITINT8) value;
+        case IRINT16:
+            return (IR_ITEM_VALUE) (JITINT64) (JITINT16) value;
+        case IRINT32:
+            return (IR_ITEM_VALUE) (JITINT64) (JITINT32) value;
+        case IRUINT8:
+            return (IR_ITEM_VALUE) (JITUINT8) value;
+        case IRUINT16:
+            return (IR_ITEM_VALUE) (JITUINT16) value;
+        case IRUINT32:
+            return (IR_ITEM_VALUE) (JITUINT32) value;
+    }
+
+    return (IR_ITEM_VALUE) value;
+}
+
+JITBOOLEAN LOOPUNROLLING_isTheOnlyCircuitOfItsHeader (ir_method_t *method, circuit_t *loop) {
+    XanList		*loops;
+    XanListItem	*item;
+    JITBOOLEAN	only;
+
+    only	= JITTRUE;
+    loops	= IRMETHOD_getMethodCircuits(method);
+    item	= xanList_first(loops);
+    while (item != NULL) {
+        circuit_t	*otherLoop;
+        otherLoop	= item->data;
+        if (	(otherLoop != loop)					&&
+                (otherLoop->loop_id != 0)				&&
+                (otherLoop->backEdge.dst == loop->backEdge.dst)		) {
+            only	= JITFALSE;
+            break ;
+        }
+        item	= item->next;
+    }
+    xanList_destroyList(loops);
+
+    return only;
+}
+
+JITBOOLEAN LOOPUNROLLING_isItemInvariant (ir_method_t *method, ir_item_t *item, XanList *loopInsts) {
+    XanList		*defs;
+    JITUINT32	defsNumber;
+
+    /* Constants never change	*/
+    if (item->type != IROFFSET) {
+        return JITTRUE;
+    }
+
+    /* Variables stored in memory can be changed by stores and calls	*/
+    if (IRMETHOD_isAnEscapedVariable(method, (item->value).v)) {
+        return JITFALSE;
+    }
+
+    /* Check the definitions	*/
+    defs		= IRMETHOD_getVariableDefinitionsWithinInstructions(method, (item->value).v, loopInsts);
+    defsNumber	= xanList_length(defs);
+    xanList_destroyList(defs);
+
+    return (defsNumber == 0);
+}
+
+ir_instruction_t * LOOPUNROLLING_newInstructionBefore (ir_method_t *method, ir_instruction_t *beforeInst, JITUINT16 type, ir_item_t *par1, ir_item_t *par2, JITUINT16 resultType) {
+    ir_instruction_t	*inst;
+
+    /* Assertions			*/
+    assert(method != NULL);
+    assert(beforeInst != NULL);
+    assert(par1 != NULL);
+
+    inst	= IRMETHOD_newInstructionOfTypeBefore(method, beforeInst, type);
+    IRMETHOD_setInstructionParameter1(method, inst, (par1->value).v, (par1->value).f, par1->type, par1->internal_type, par1->type_infos);
+    if (par2 != NULL) {
+        IRMETHOD_setInstructionParameter2(method, inst, (par2->value).v, (par2->value).f, par2->type, par2->internal_type, par2->type_infos);
+    }
+    IRMETHOD_setInstructionParameterWithANewVariable(method, inst, resultType, NULL, 0);
+
+    return inst;
+}
+
+static inline void internal_compute_loops_information (ir_method_t *method) {
+    IROPTIMIZER_invalidateInformation(method, INVALIDATE_ALL);
+    IROPTIMIZER_callMethodOptimization(irOptimizer, method, LIVENESS_ANALYZER);
+    IROPTIMIZER_callMethodOptimization(irOptimizer, method, REACHING_DEFINITIONS_ANALYZER);
+    IROPTIMIZER_callMethodOptimization(irOptimizer, method, ESCAPES_ANALYZER);
+    IROPTIMIZER_callMethodOptimization(irOptimizer, method, PRE_DOMINATOR_COMPUTER);
+    IROPTIMIZER_callMethodOptimization(irOptimizer, method, LOOP_IDENTIFICATION);
+    IROPTIMIZER_callMethodOptimization(irOptimizer, method, LOOP_INVARIANTS_IDENTIFICATION);
+    IROPTIMIZER_callMethodOptimization(irOptimizer, method, INDUCTION_VARIABLES_IDENTIFICATION);
+}
+
+static inline char * loopunrolling_get_version (void) {
+    return VERSION;
+}
+
+static inline char * loopunrolling_get_informations (void) {
+    return INFORMATIONS;
+}
+
+static inline char * loopunrolling_get_author (void) {
+    return AUTHOR;
+}
+
+static inline void loopunrolling_getCompilationFlags (char *buffer, JITINT32 bufferLength) {
+
+    /* Assertions				*/
+    assert(buffer != NULL);
+
+    snprintf(buffer, sizeof(char) * bufferLength, " ");
+#ifdef DEBUG
+    strncat(buffer, "DEBUG ", sizeof(char) * bufferLength);
+#endif
+#ifdef PRINTDEBUG
+    strncat(buffer, "PRINTDEBUG ", sizeof(char) * bufferLength);
+#endif
+#ifdef PROFILE
+    strncat(buffer, "PROFILE ", sizeof(char) * bufferLength);
+#endif
+}
+
+static inline void loopunrolling_getCompilationTime (char *buffer, JITINT32 bufferLength) {
+
+    /* Assertions				*/
+    assert(buffer != NULL);
+
+    snprintf(buffer, sizeof(char) * bufferLength, "%s %s", __DATE__, __TIME__);
+
+    /* Return				*/
+    return;
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef OPTIMIZER_LOOPUNROLLING_H
+#define OPTIMIZER_LOOPUNROLLING_H
+
+#include <xanlib.h>
+#include <jitsystem.h>
+#include <ir_method.h>
+
+/* Maximum number of loops transformed for each method		*/
+#define MAX_TRANSFORMATION_ROUNDS	64
+
+/* Thresholds for the full unrolling: the loop is replaced by	*
+ * its iterations when the trip count is known at compile time	*/
+#define FULL_UNROLL_MAX_TRIPS		16
+#define FULL_UNROLL_MAX_INSTRUCTIONS	160
+
+/* Thresholds for the partial unrolling: the body of the loop	*
+ * is replicated 8, 4 or 2 times				*/
+#define PARTIAL_UNROLL_MAX_FACTOR	8
+#define PARTIAL_UNROLL_MAX_BODY		32
+#define PARTIAL_UNROLL_MAX_INSTRUCTIONS	64
+
+#ifdef PRINTDEBUG
+#define PDEBUG(fmt, args...) fprintf(stderr, "LOOP_UNROLLING: " fmt, ## args)
+#else
+#define PDEBUG(fmt, args...)
+#endif
+
+/**
+ * @brief Basic induction variable of a circuit.
+ *
+ * The variable is updated by a single instruction within the circuit that has the form <code> var = var + step </code>.
+ */
+typedef struct {
+    IR_ITEM_VALUE		var;		/**< ID of the variable.						*/
+    JITINT64		step;		/**< Value added to the variable at every iteration.			*/
+    ir_instruction_t	*update;	/**< The only definition of the variable within the circuit.		*/
+} basic_induction_t;
+
+/**
+ * @brief Check whether a variable is a basic induction variable with a constant step.
+ *
+ * Only the variables identified by the INDUCTION_VARIABLES_IDENTIFICATION codetool are considered.
+ *
+ * @param loopInsts List of (ir_instruction_t *) that belong to <code> loop </code>
+ * @param iv Filled with the information about the induction variable when the function returns JITTRUE
+ */
+JITBOOLEAN LOOPUNROLLING_getBasicInductionVariable (ir_method_t *method, circuit_t *loop, XanList *loopInsts, IR_ITEM_VALUE varID, basic_induction_t *iv);
+
+/**
+ * @brief Return the value of an integer constant sign extended (or zero extended for unsigned types) to 64 bits.
+ */
+JITINT64 LOOPUNROLLING_getIntegerConstant (ir_item_t *item);
+
+/**
+ * @brief Wrap a value to the width of the integer type <code> internalType </code>.
+ *
+ * The returned value can be used as value of a constant of type <code> internalType </code>.
+ */
+IR_ITEM_VALUE LOOPUNROLLING_toIntegerConstant (JITINT64 value, JITUINT16 internalType);
+
+/**
+ * @brief Check whether a circuit is the only one of its header.
+ */
+JITBOOLEAN LOOPUNROLLING_isTheOnlyCircuitOfItsHeader (ir_method_t *method, circuit_t *loop);
+
+/**
+ * @brief Check whether no variable defined within the circuit can change the value of <code> item </code>.
+ */
+JITBOOLEAN LOOPUNROLLING_isItemInvariant (ir_method_t *method, ir_item_t *item, XanList *loopInsts);
+
+/**
+ * @brief Create a new instruction <code> result = par1 op par2 </code> before <code> beforeInst </code>.
+ *
+ * The result is a new variable of type <code> resultType </code>.
+ * <code> par2 </code> can be NULL for unary instructions.
+ */
+ir_instruction_t * LOOPUNROLLING_newInstructionBefore (ir_method_t *method, ir_instruction_t *beforeInst, JITUINT16 type, ir_item_t *par1, ir_item_t *par2, JITUINT16 resultType);
+
+#endif
@@ -0,0 +1,523 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <ir_optimization_interface.h>
+#include <ir_language.h>
+#include <iljit-utils.h>
+#include <compiler_memory_manager.h>
+
+// My headers
+#include <optimizer_loopunrolling.h>
+#include <strength_reduction.h>
+// End
+
+typedef struct {
+    ir_instruction_t	*mul;		/**< t = i * c						*/
+    ir_instruction_t	*conv;		/**< t' = conv(t); it can be NULL			*/
+    ir_instruction_t	*add;		/**< a = base + t'; it is NULL if the address cannot be reduced	*/
+    JITUINT32		addOffsetPar;	/**< Parameter of add that is t'			*/
+    JITINT64		c;		/**< Constant of the multiplication			*/
+    basic_induction_t	iv;		/**< Induction variable i				*/
+} reduction_t;
+
+static inline reduction_t * internal_fetch_candidate (ir_method_t *method, circuit_t *loop, XanList *loopInsts, ir_instruction_t *mul);
+static inline void internal_fetch_address_computation (ir_method_t *method, circuit_t *loop, XanList *loopInsts, reduction_t *r);
+static inline ir_instruction_t * internal_fetch_single_use (ir_method_t *method, ir_instruction_t *inst);
+static inline JITBOOLEAN internal_is_index_checked (ir_method_t *method, XanList *loopInsts, reduction_t *r, ir_instruction_t *add, ir_item_t *base);
+static inline JITBOOLEAN internal_is_redefined_after_check (ir_method_t *method, reduction_t *r, ir_instruction_t *check);
+static inline JITBOOLEAN internal_is_variable (ir_item_t *item, IR_ITEM_VALUE varID);
+static inline JITBOOLEAN internal_is_defined_once (ir_method_t *method, IR_ITEM_VALUE varID);
+static inline void internal_reduce_multiplication (ir_method_t *method, reduction_t *r, ir_instruction_t *preHeader);
+static inline void internal_reduce_address (ir_method_t *method, reduction_t *r, ir_instruction_t *preHeader);
+static inline void internal_add_increment_after (ir_method_t *method, ir_instruction_t *afterInst, ir_item_t *var, JITINT64 increment, JITUINT16 incrementType);
+
+JITBOOLEAN STRENGTH_REDUCTION_reduceLoop (ir_method_t *method, circuit_t *loop) {
+    XanList			*loopInsts;
+    XanList			*candidates;
+    XanListItem		*item;
+    ir_instruction_t	*header;
+    ir_instruction_t	*preHeader;
+
+    /* Assertions				*/
+    assert(method != NULL);
+    assert(loop != NULL);
+
+    /* Check the loop			*/
+    header	= IRMETHOD_getTheDestinationOfTheCircuitBackedge(loop);
+    if (	(header == NULL)					||
+            (IRMETHOD_getInstructionType(header) != IRLABEL)	||
+            (loop->induction_table == NULL)			) {
+        return JITFALSE;
+    }
+    if (!LOOPUNROLLING_isTheOnlyCircuitOfItsHeader(method, loop)) {
+        return JITFALSE;
+    }
+
+    /* Fetch the multiplications to reduce	*/
+    candidates	= xanList_new(allocFunction, freeFunction, NULL);
+    loopInsts	= IRMETHOD_getCircuitInstructions(method, loop);
+    item		= xanList_first(loopInsts);
+    while (item != NULL) {
+        ir_instruction_t	*inst;
+        reduction_t		*r;
+        inst	= item->data;
+        assert(inst != NULL);
+        if (IRMETHOD_getInstructionType(inst) == IRMUL) {
+            r	= internal_fetch_candidate(method, loop, loopInsts, inst);
+            if (r != NULL) {
+                xanList_append(candidates, r);
+            }
+        }
+        item	= item->next;
+    }
+    xanList_destroyList(loopInsts);
+
+    /* Check if there is something to do	*/
+    if (xanList_length(candidates) == 0) {
+        xanList_destroyList(candidates);
+        return JITFALSE;
+    }
+
+    /* Add the pre-header where new induction variables are initialized.
+     */
+    preHeader	= IRMETHOD_addCircuitPreHeader(method, loop);
+    if (preHeader == NULL) {
+        xanList_destroyListAndData(candidates);
+        return JITFALSE;
+    }
+
+    /* Reduce the multiplications		*/
+    item		= xanList_first(candidates);
+    while (item != NULL) {
+        reduction_t	*r;
+        r	= item->data;
+        assert(r != NULL);
+        if (r->add != NULL) {
+            PDEBUG("%s: reduce the address computed by instruction %u\n", IRMETHOD_getSignatureInString(method), r->add->ID);
+            internal_reduce_address(method, r, preHeader);
+        } else {
+            PDEBUG("%s: reduce the multiplication %u\n", IRMETHOD_getSignatureInString(method), r->mul->ID);
+            internal_reduce_multiplication(method, r, preHeader);
+        }
+        item	= item->next;
+    }
+
+    /* Free the memory			*/
+    xanList_destroyListAndData(candidates);
+
+    return JITTRUE;
+}
+
+static inline reduction_t * internal_fetch_candidate (ir_method_t *method, circuit_t *loop, XanList *loopInsts, ir_instruction_t *mul) {
+    ir_item_t		*result;
+    ir_item_t		*par1;
+    ir_item_t		*par2;
+    ir_item_t		*var;
+    ir_item_t		*constant;
+    basic_induction_t	iv;
+    reduction_t		*r;
+
+    /* Fetch the parameters			*/
+    result	= IRMETHOD_getInstructionResult(mul);
+    par1	= IRMETHOD_getInstructionParameter1(mul);
+    par2	= IRMETHOD_getInstructionParameter2(mul);
+    if (	(result->type != IROFFSET)						||
+            (!IRMETHOD_isAnIntType(result->internal_type))			||
+            (IRMETHOD_isAnEscapedVariable(method, (result->value).v))	) {
+        return NULL;
+    }
+
+    /* The multiplication has to be between a variable and a constant	*/
+    if (	(par1->type == IROFFSET)	&&
+            (par2->type != IROFFSET)	) {
+        var		= par1;
+        constant	= par2;
+    } else if (	(par1->type != IROFFSET)	&&
+                (par2->type == IROFFSET)	) {
+        var		= par2;
+        constant	= par1;
+    } else {
+        return NULL;
+    }
+
+    /* The identity (i + k) * c = i * c + k * c holds in modular arithmetic only if every operation is performed with the same type.
+     */
+    if (	(var->internal_type != result->internal_type)		||
+            (constant->internal_type != result->internal_type)	) {
+        return NULL;
+    }
+    if (LOOPUNROLLING_getIntegerConstant(constant) == 0) {
+        return NULL;
+    }
+
+    /* The variable has to be a basic induction variable		*/
+    if (!LOOPUNROLLING_getBasicInductionVariable(method, loop, loopInsts, (var->value).v, &iv)) {
+        return NULL;
+    }
+    if (IRMETHOD_getInstructionResultInternalType(iv.update) != result->internal_type) {
+        return NULL;
+    }
+
+    /* Allocate the candidate					*/
+    r			= allocFunction(sizeof(reduction_t));
+    r->mul			= mul;
+    r->c			= LOOPUNROLLING_getIntegerConstant(constant);
+    memcpy(&(r->iv), &iv, sizeof(basic_induction_t));
+
+    /* Check whether the address computation can be reduced as well	*/
+    internal_fetch_address_computation(method, loop, loopInsts, r);
+
+    return r;
+}
+
+static inline void internal_fetch_address_computation (ir_method_t *method, circuit_t *loop, XanList *loopInsts, reduction_t *r) {
+    ir_instruction_t	*use;
+    ir_instruction_t	*add;
+    ir_item_t		*offset;
+    ir_item_t		*base;
+    ir_item_t		*result;
+    XanList			*uses;
+    XanListItem		*item;
+    JITUINT32		offsetPar;
+
+    /* Follow the conversion to the native integer, if any.
+     */
+    use	= internal_fetch_single_use(method, r->mul);
+    if (	(use == NULL)						||
+            (!IRMETHOD_doesInstructionBelongToCircuit(method, loop, use))	) {
+        return ;
+    }
+    if (IRMETHOD_getInstructionType(use) == IRCONV) {
+        if (	(IRMETHOD_getInstructionResultType(use) != IROFFSET)				||
+                (!IRMETHOD_isAnIntType(IRMETHOD_getInstructionResultInternalType(use)))		||
+                (IRMETHOD_isAnEscapedVariable(method, IRMETHOD_getInstructionResultValue(use)))	) {
+            return ;
+        }
+        r->conv	= use;
+        use	= internal_fetch_single_use(method, r->conv);
+        if (	(use == NULL)						||
+                (!IRMETHOD_doesInstructionBelongToCircuit(method, loop, use))	) {
+            r->conv	= NULL;
+            return ;
+        }
+    }
+
+    /* Check the address computation a = base + t'		*/
+    add	= use;
+    if (IRMETHOD_getInstructionType(add) != IRADD) {
+        r->conv	= NULL;
+        return ;
+    }
+    offset	= IRMETHOD_getInstructionResult((r->conv != NULL) ? r->conv : r->mul);
+    if (	(IRMETHOD_getInstructionParameter1(add)->type == IROFFSET)					&&
+            ((IRMETHOD_getInstructionParameter1(add)->value).v == (offset->value).v)	) {
+        offsetPar	= 1;
+        base		= IRMETHOD_getInstructionParameter2(add);
+    } else {
+        offsetPar	= 2;
+        base		= IRMETHOD_getInstructionParameter1(add);
+    }
+    result	= IRMETHOD_getInstructionResult(add);
+    if (	(!LOOPUNROLLING_isItemInvariant(method, base, loopInsts))		||
+            (result->type != IROFFSET)						||
+            (IRMETHOD_isAnEscapedVariable(method, (result->value).v))	||
+            (!internal_is_defined_once(method, (result->value).v))		) {
+        r->conv	= NULL;
+        return ;
+    }
+
+    /* Computing the offset in the native integer type is exact only if i * c does not overflow where the address is used.
+     * This is the case when the index is checked against the bounds of the array before the address is computed.
+     */
+    if (!internal_is_index_checked(method, loopInsts, r, add, base)) {
+        r->conv	= NULL;
+        return ;
+    }
+
+    /* The address has to be used only to access memory.
+     */
+    uses	= IRMETHOD_getVariableUses(method, (result->value).v);
+    item	= xanList_first(uses);
+    while (item != NULL) {
+        ir_instruction_t	*addressUse;
+        addressUse	= item->data;
+        if (	(IRMETHOD_getInstructionType(addressUse) != IRLOADREL)	&&
+                (IRMETHOD_getInstructionType(addressUse) != IRSTOREREL)	) {
+            break ;
+        }
+        item	= item->next;
+    }
+    xanList_destroyList(uses);
+    if (item != NULL) {
+        r->conv	= NULL;
+        return ;
+    }
+
+    /* The address can be reduced				*/
+    r->add		= add;
+    r->addOffsetPar	= offsetPar;
+
+    return ;
+}
+
+static inline void internal_reduce_multiplication (ir_method_t *method, reduction_t *r, ir_instruction_t *preHeader) {
+    ir_instruction_t	*init;
+    ir_instruction_t	*move;
+    ir_item_t		*s;
+
+    /* Initialize the new induction variable s = i * c before the loop	*/
+    init	= IRMETHOD_cloneInstructionAndInsertBefore(method, r->mul, preHeader);
+    IRMETHOD_setInstructionParameterWithANewVariable(method, init, IRMETHOD_getInstructionResultInternalType(r->mul), NULL, 0);
+    s	= IRMETHOD_getInstructionResult(init);
+
+    /* Update s together with i					*/
+    internal_add_increment_after(method, r->iv.update, s, r->iv.step * r->c, s->internal_type);
+
+    /* Replace the multiplication					*/
+    move	= IRMETHOD_newInstructionOfTypeBefore(method, r->mul, IRMOVE);
+    IRMETHOD_setInstructionParameter1(method, move, (s->value).v, 0, IROFFSET, s->internal_type, NULL);
+    IRMETHOD_cpInstructionParameter(method, r->mul, 0, move, 0);
+    IRMETHOD_deleteInstruction(method, r->mul);
+
+    return ;
+}
+
+static inline void internal_reduce_address (ir_method_t *method, reduction_t *r, ir_instruction_t *preHeader) {
+    ir_instruction_t	*init;
+    ir_instruction_t	*move;
+    ir_item_t		*offset;
+    ir_item_t		*p;
+
+    /* Compute the first address before the loop: p = base + conv(i * c)	*/
+    init	= IRMETHOD_cloneInstructionAndInsertBefore(method, r->mul, preHeader);
+    IRMETHOD_setInstructionParameterWithANewVariable(method, init, IRMETHOD_getInstructionResultInternalType(r->mul), NULL, 0);
+    offset	= IRMETHOD_getInstructionResult(init);
+    if (r->conv != NULL) {
+        init	= IRMETHOD_cloneInstructionAndInsertBefore(method, r->conv, preHeader);
+        IRMETHOD_setInstructionParameter1(method, init, (offset->value).v, 0, IROFFSET, offset->internal_type, NULL);
+        IRMETHOD_setInstructionParameterWithANewVariable(method, init, IRMETHOD_getInstructionResultInternalType(r->conv), NULL, 0);
+        offset	= IRMETHOD_getInstructionResult(init);
+    }
+    init	= IRMETHOD_cloneInstructionAndInsertBefore(method, r->add, preHeader);
+    IRMETHOD_setInstructionParameter(method, init, (offset->value).v, 0, IROFFSET, offset->internal_type, NULL, r->addOffsetPar);
+    IRMETHOD_setInstructionParameterWithANewVariable(method, init, IRMETHOD_getInstructionResultInternalType(r->add), IRMETHOD_getInstructionResult(r->add)->type_infos, 0);
+    p	= IRMETHOD_getInstructionResult(init);
+
+    /* Move the address to the next element together with i			*/
+    internal_add_increment_after(method, r->iv.update, p, r->iv.step * r->c, offset->internal_type);
+
+    /* Replace the address computation					*/
+    move	= IRMETHOD_newInstructionOfTypeBefore(method, r->add, IRMOVE);
+    IRMETHOD_setInstructionParameter1(method, move, (p->value).v, 0, IROFFSET, p->internal_type, p->type_infos);
+    IRMETHOD_cpInstructionParameter(method, r->add, 0, move, 0);
+    IRMETHOD_deleteInstruction(method, r->add);
+    if (r->conv != NULL) {
+        IRMETHOD_deleteInstruction(method, r->conv);
+    }
+    IRMETHOD_deleteInstruction(method, r->mul);
+
+    return ;
+}
+
+static inline void internal_add_increment_after (ir_method_t *method, ir_instruction_t *afterInst, ir_item_t *var, JITINT64 increment, JITUINT16 incrementType) {
+    ir_instruction_t	*inc;
+
+    inc	= IRMETHOD_newInstructionOfTypeAfter(method, afterInst, IRADD);
+    IRMETHOD_setInstructionParameter1(method, inc, (var->value).v, 0, IROFFSET, var->internal_type, var->type_infos);
+    IRMETHOD_setInstructionParameter2(method, inc, LOOPUNROLLING_toIntegerConstant(increment, incrementType), 0, incrementType, incrementType, NULL);
+    IRMETHOD_setInstructionResult(method, inc, (var->value).v, 0, IROFFSET, var->internal_type, var->type_infos);
+
+    return ;
+}
+
+static inline ir_instruction_t * internal_fetch_single_use (ir_method_t *method, ir_instruction_t *inst) {
+    XanList			*uses;
+    ir_instruction_t	*use;
+
+    use	= NULL;
+    uses	= IRMETHOD_getVariableUses(method, IRMETHOD_getInstructionResultValue(inst));
+    if (xanList_length(uses) == 1) {
+        use	= xanList_first(uses)->data;
+    }
+    xanList_destroyList(uses);
+
+    return use;
+}
+
+/* Look for the bounds check emitted for ldelem and stelem:
+ *	u = conv(i)
+ *	t = u < arraylength(base)
+ *	branchif t L
+ * The branch has to predominate the address computation and i cannot be updated on any path in between.
+ */
+static inline JITBOOLEAN internal_is_index_checked (ir_method_t *method, XanList *loopInsts, reduction_t *r, ir_instruction_t *add, ir_item_t *base) {
+    XanListItem		*item;
+
+    /* Assertions				*/
+    assert(method != NULL);
+    assert(loopInsts != NULL);
+    assert(r != NULL);
+    assert(add != NULL);
+    assert(base != NULL);
+
+    /* The base has to be the array itself	*/
+    if (base->type != IROFFSET) {
+        return JITFALSE;
+    }
+
+    /* Look for the checks of the index	*/
+    item	= xanList_first(loopInsts);
+    while (item != NULL) {
+        ir_instruction_t	*branch;
+        ir_instruction_t	*compare;
+        ir_instruction_t	*def;
+        ir_item_t		*index;
+        ir_item_t		*length;
+
+        /* Fetch the comparison feeding a conditional branch	*/
+        branch	= item->data;
+        item	= item->next;
+        if (	(IRMETHOD_getInstructionType(branch) != IRBRANCHIF)		||
+                (IRMETHOD_getInstructionParameter1Type(branch) != IROFFSET)	) {
+            continue ;
+        }
+        compare	= IRMETHOD_getPrevInstruction(method, branch);
+        if (	(compare == NULL)										||
+                (IRMETHOD_getInstructionType(compare) != IRLT)							||
+                (IRMETHOD_getInstructionResultValue(compare) != IRMETHOD_getInstructionParameter1Value(branch))	) {
+            continue ;
+        }
+
+        /* The index compared has to be i, possibly converted	*/
+        index	= IRMETHOD_getInstructionParameter1(compare);
+        if (!internal_is_variable(index, r->iv.var)) {
+            if (index->type != IROFFSET) {
+                continue ;
+            }
+            def	= IRMETHOD_getPrevInstruction(method, compare);
+            while (	(def != NULL)									&&
+                    (!internal_is_variable(IRMETHOD_getInstructionResult(def), (index->value).v))	) {
+                def	= IRMETHOD_getPrevInstruction(method, def);
+            }
+            if (	(def == NULL)									||
+                    (IRMETHOD_getInstructionType(def) != IRCONV)					||
+                    (!internal_is_variable(IRMETHOD_getInstructionParameter1(def), r->iv.var))	||
+                    (!internal_is_defined_once(method, (index->value).v))			) {
+                continue ;
+            }
+        }
+
+        /* The bound has to be the length of the array	*/
+        length	= IRMETHOD_getInstructionParameter2(compare);
+        if (	(length->type != IROFFSET)						||
+                (!internal_is_defined_once(method, (length->value).v))	) {
+            continue ;
+        }
+        def	= IRMETHOD_getPrevInstruction(method, compare);
+        while (	(def != NULL)									&&
+                (!internal_is_variable(IRMETHOD_getInstructionResult(def), (length->value).v))	) {
+            def	= IRMETHOD_getPrevInstruction(method, def);
+        }
+        if (	(def == NULL)								||
+                (IRMETHOD_getInstructionType(def) != IRARRAYLENGTH)			||
+                (!internal_is_variable(IRMETHOD_getInstructionParameter1(def), (base->value).v))	) {
+            continue ;
+        }
+
+        /* The check has to guard the address computation, for the same value of i	*/
+        if (	(!IRMETHOD_isInstructionAPredominator(method, branch, add))		||
+                (!IRMETHOD_isInstructionAPredominator(method, branch, r->mul))		) {
+            continue ;
+        }
+        if (internal_is_redefined_after_check(method, r, branch)) {
+            continue ;
+        }
+
+        return JITTRUE;
+    }
+
+    return JITFALSE;
+}
+
+/* Check whether i is defined by an instruction that lies on a path from the bounds check to the multiplication.
+ * Paths that go through the check again do not count, as they check the new value of i.
+ */
+static inline JITBOOLEAN internal_is_redefined_after_check (ir_method_t *method, reduction_t *r, ir_instruction_t *check) {
+    XanBitSet		*visited;
+    XanList			*workList;
+    JITBOOLEAN		redefined;
+
+    /* Allocate the memory			*/
+    visited		= xanBitSet_new(IRMETHOD_getInstructionsNumber(method) + 1);
+    workList	= xanList_new(allocFunction, freeFunction, NULL);
+
+    /* Visit the instructions reachable from the check without going through the multiplication	*/
+    redefined	= JITFALSE;
+    xanBitSet_setBit(visited, check->ID);
+    xanList_append(workList, check);
+    while (	(!redefined)			&&
+            (xanList_length(workList) > 0)	) {
+        XanListItem		*item;
+        ir_instruction_t	*inst;
+        ir_instruction_t	*succ;
+
+        /* Fetch the next instruction		*/
+        item	= xanList_first(workList);
+        inst	= item->data;
+        assert(inst != NULL);
+        xanList_deleteItem(workList, item);
+
+        /* Visit its successors			*/
+        succ	= IRMETHOD_getSuccessorInstruction(method, inst, NULL);
+        while (succ != NULL) {
+            if (	(succ != r->mul)				&&
+                    (!xanBitSet_isBitSet(visited, succ->ID))	) {
+                xanBitSet_setBit(visited, succ->ID);
+                if (IRMETHOD_doesInstructionDefineVariable(method, succ, r->iv.var)) {
+                    redefined	= JITTRUE;
+                }
+                xanList_append(workList, succ);
+            }
+            succ	= IRMETHOD_getSuccessorInstruction(method, inst, succ);
+        }
+    }
+
+    /* Free the memory			*/
+    xanBitSet_free(visited);
+    xanList_destroyList(workList);
+
+    return redefined;
+}
+
+static inline JITBOOLEAN internal_is_variable (ir_item_t *item, IR_ITEM_VALUE varID) {
+    return (	(item->type == IROFFSET)	&&
+                ((item->value).v == varID)	);
+}
+
+static inline JITBOOLEAN internal_is_defined_once (ir_method_t *method, IR_ITEM_VALUE varID) {
+    XanList		*defs;
+    JITUINT32	defsNumber;
+
+    defs		= IRMETHOD_getVariableDefinitions(method, varID);
+    defsNumber	= xanList_length(defs);
+    xanList_destroyList(defs);
+
+    return (defsNumber == 1);
+}
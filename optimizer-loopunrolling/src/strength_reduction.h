@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2026 ILDJIT developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef STRENGTH_REDUCTION_H
+#define STRENGTH_REDUCTION_H
+
+#include <jitsystem.h>
+#include <ir_method.h>
+
+/**
+ * @brief Reduce the strength of the multiplications of a circuit
+ *
+ * Every multiplication <code> t = i * c </code> where <code> i </code> is a basic induction variable and <code> c </code> is a constant is replaced by a new induction variable that is incremented by <code> step * c </code> right after <code> i </code>.
+ * When <code> t </code> is only used to compute an address (e.g., <code> a = base + conv(t) </code> as generated by <code> ldelem </code>) and a bounds check of <code> i </code> against <code> base </code> predominates it, the address itself becomes the new induction variable.
+ *
+ * Information about circuits is not valid anymore if the function returns JITTRUE.
+ *
+ * @return JITTRUE if the code has been changed
+ */
+JITBOOLEAN STRENGTH_REDUCTION_reduceLoop (ir_method_t *method, circuit_t *loop);
+
+#endif
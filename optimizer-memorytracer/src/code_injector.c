@@ -23,6 +23,7 @@
 #include <compiler_memory_manager.h>
 #include <platform_API.h>
 #include <chiara.h>
+#include <cam.h>
 
 // My headers
 #include <optimizer_memorytracer.h>
@@ -297,6 +298,10 @@ static inline void internal_inject_code_to_dump_trace_in_method (ir_method_t *m,
              */
             if (instPosParam.value.v != 0) {
 
+                /* Map the position to the dense index used by the tracer at run time.
+                 */
+                instPosParam.value.v		= CAM_registerMemInstruction(instPosParam.value.v);
+
                 /* Set the types of the parameters of the call.
                  */
                 input1Param.internal_type	= IRNUINT;
@@ -448,6 +453,7 @@ static inline void internal_inject_code_to_dump_trace_in_method (ir_method_t *m,
 
                 /* Inject the code.
                  */
+                instPosParam.value.v		= CAM_registerMemInstruction(instPosParam.value.v);
                 nativeCall  = IRMETHOD_newNativeCallInstructionBefore(m, inst, "OSDumper", dump_os_instruction, NULL, NULL);
                 IRMETHOD_addInstructionCallParameter(m, nativeCall, &instPosParam);
 
@@ -71,9 +71,9 @@ void dump_call_instruction (JITUINT32 instructionID) {
     return ;
 }
 
-void dump_os_instruction (JITUINT32 instructionPosition) {
+void dump_os_instruction (JITUINT32 instructionIndex) {
     if (enablePrinter){
-    	CAM_mem(instructionPosition, 0, JITMAXUINT32, 0, 0, 0, JITMAXUINT32);
+    	CAM_memIndexed(instructionIndex, 0, JITMAXUINT32, 0, 0, 0, JITMAXUINT32);
     }
 
     return ;
@@ -87,9 +87,9 @@ void dump_end_method (void) {
     return ;
 }
 
-void dump_memory_instruction (JITUINT32 instructionPosition, void *input1, JITUINT32 input1Size, void *input2, JITUINT32 input2Size, void *output, JITUINT32 outputSize) {
+void dump_memory_instruction (JITUINT32 instructionIndex, void *input1, JITUINT32 input1Size, void *input2, JITUINT32 input2Size, void *output, JITUINT32 outputSize) {
     if (enablePrinter) {
-        CAM_mem(instructionPosition, (JITNUINT)input1, input1Size, (JITNUINT)input2, input2Size, (JITNUINT)output, outputSize);
+        CAM_memIndexed(instructionIndex, (JITNUINT)input1, input1Size, (JITNUINT)input2, input2Size, (JITNUINT)output, outputSize);
     }
 
     return ;
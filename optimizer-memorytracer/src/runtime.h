@@ -36,8 +36,8 @@ void dump_end_method (void);
 
 /* Instructions.
  */
-void dump_memory_instruction (JITUINT32 instructionPosition, void *input1, JITUINT32 input1Size, void *input2, JITUINT32 input2Size, void *output, JITUINT32 outputSize);
-void dump_os_instruction (JITUINT32 instructionPosition);
+void dump_memory_instruction (JITUINT32 instructionIndex, void *input1, JITUINT32 input1Size, void *input2, JITUINT32 input2Size, void *output, JITUINT32 outputSize);
+void dump_os_instruction (JITUINT32 instructionIndex);
 void dump_call_instruction (JITUINT32 instructionID);
 
 #endif